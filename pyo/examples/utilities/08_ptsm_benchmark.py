@@ -0,0 +1,46 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Benchmark of the particle trajectory (PTSM) kernels.
+
+Integrates a particle in the potential field of a random clustered
+dataset with every computation kernel supported by the cpu and prints
+the number of integration steps computed per second. The "scalar" kernel
+performs the same computation as the Cython PTSM function of the Mode
+Explorer notebook (double precision, libm exp) and serves as the
+reference. The last line of each size uses the fastest kernel with a
+spatial index (cutoff of 4 sigma).
+
+Requires numpy.
+
+"""
+import time
+import numpy as np
+from pyo import *
+
+SIZES = [(10000, 8), (100000, 8), (100000, 32)]
+STEPS = 64
+CLUSTERS = 100
+
+for npoints, dim in SIZES:
+    centers = np.random.uniform(-50, 50, size=(CLUSTERS, dim))
+    data = centers[np.arange(npoints) % CLUSTERS] + np.random.normal(size=(npoints, dim))
+    pos = data[0].copy()
+    vel = np.random.rand(dim) * 0.03
+    print "%d points, %d dimensions" % (npoints, dim)
+    ref = None
+    for kernel, cutoff in [("scalar", 0), ("avx2", 0), ("avx512", 0), ("auto", 4)]:
+        try:
+            d = PTSMData(data, kernel, cutoff)
+        except ValueError:
+            print "    %-8s not supported by this cpu" % kernel
+            continue
+        if cutoff > 0:
+            kernel = "%s+tree" % d.getKernel()
+        t = time.time()
+        trj, sig, lastpos, lastvel = PTSM(d, pos, vel, 0.6, 1, 0.999, 0.1, STEPS)
+        rate = STEPS / (time.time() - t)
+        if ref is None:
+            ref = (rate, sig)
+        err = np.max(np.abs(sig - ref[1]) / np.maximum(np.abs(ref[1]), 1e-300))
+        print "    %-8s %10.1f steps/sec  x%5.2f  (max rel. error %.1e)" % (kernel, rate, rate / ref[0], err)
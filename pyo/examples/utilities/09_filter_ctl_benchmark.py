@@ -0,0 +1,54 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Benchmark of the control-rate coefficients of the filters.
+
+Renders offline, as fast as possible, a bank of filters whose frequency
+is modulated by slow LFOs, once with the coefficients computed at every
+sample (period 0, the reference) and then with increasing values of
+setCtlPeriod(). Prints the rendering time and the maximum and RMS
+differences of the output against the reference.
+
+"""
+import time, math
+from pyo import *
+
+FILTERS = [("Biquad", lambda n, f: Biquad(n, freq=f, q=5, type=2)),
+           ("EQ", lambda n, f: EQ(n, freq=f, q=2, boost=-6)),
+           ("SVF", lambda n, f: SVF(n, freq=f, q=3, type=0.25)),
+           ("ButLP", lambda n, f: ButLP(n, freq=f)),
+           ("ButBP", lambda n, f: ButBP(n, freq=f, q=4))]
+PERIODS = [0, 8, 32, 128]
+NUM = 50
+DUR = 5
+
+s = Server(audio="offline")
+
+def render(make, period):
+    s.boot()
+    s.recordOptions(dur=DUR)
+    # Same noise for every rendering.
+    s.setGlobalSeed(1)
+    src = Noise(.1)
+    lfos = Sine(freq=[.1 + .02 * i for i in range(NUM)], mul=400, add=1000)
+    filters = make(src, lfos)
+    filters.setCtlPeriod(period)
+    table = NewTable(DUR)
+    rec = TableRec(filters.mix(1), table).play()
+    t = time.time()
+    s.start()
+    elapsed = time.time() - t
+    samples = table.getTable()
+    s.shutdown()
+    return elapsed, samples
+
+for name, make in FILTERS:
+    print "%s, %d filters, %d seconds" % (name, NUM, DUR)
+    ref = None
+    for period in PERIODS:
+        elapsed, samples = render(make, period)
+        if ref is None:
+            ref = (elapsed, samples)
+        diffs = [abs(a - b) for a, b in zip(samples, ref[1])]
+        rms = math.sqrt(sum(d * d for d in diffs) / len(diffs))
+        print "    period %3d  %6.3f sec  x%5.2f  (max error %.1e, rms %.1e)" % (period, elapsed, ref[0] / elapsed, max(diffs), rms)
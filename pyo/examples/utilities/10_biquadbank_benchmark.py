@@ -0,0 +1,54 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Benchmark of the BiquadBank object.
+
+Renders offline, as fast as possible, a bank of bandpass filters on a
+single noise source, once with one Biquad object per filter and then with
+a BiquadBank object and every computation kernel supported by the cpu.
+The rendering of the noise alone is measured first and subtracted, the
+times printed are the cost of the filters.
+
+"""
+import time
+from pyo import *
+
+SIZES = [16, 64, 256]
+DUR = 10
+
+s = Server(audio="offline")
+
+def render(num, kind, kernel="auto"):
+    s.boot()
+    s.recordOptions(dur=DUR)
+    src = Noise(.1)
+    freqs = [100 * (i + 1) for i in range(num)]
+    if kind == "none":
+        f = src
+    elif kind == "biquad":
+        f = Biquad(src, freq=freqs, q=10, type=2)
+    else:
+        f = BiquadBank(src, freq=freqs, q=10, type=2, kernel=kernel)
+        kind = f.getKernel()
+    out = f.mix(1).out()
+    t = time.time()
+    s.start()
+    elapsed = time.time() - t
+    s.shutdown()
+    return kind, elapsed
+
+for num in SIZES:
+    print "%d filters, %d seconds" % (num, DUR)
+    base = render(num, "none")[1]
+    ref = None
+    runs = [("biquad", "auto")] + [("bank", k) for k in ["scalar", "vector", "avx"]]
+    for kind, kernel in runs:
+        try:
+            name, elapsed = render(num, kind, kernel)
+        except ValueError:
+            print "    %-8s not supported by this cpu" % kernel
+            continue
+        elapsed = max(elapsed - base, 1e-6)
+        if ref is None:
+            ref = elapsed
+        print "    %-8s %7.3f sec  %6.2f usec/filter/sec  x%5.2f" % (name, elapsed, elapsed / num / DUR * 1e6, ref / elapsed)
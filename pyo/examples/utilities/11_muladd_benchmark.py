@@ -0,0 +1,47 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Benchmark of the mul and add post-processing stage.
+
+Renders offline, as fast as possible, a large number of oscillators using
+every combination of scalar, audio and reversed (sub and div) mul and add
+attributes. The oscillator alone is measured first and subtracted, the
+times printed are the cost of the mul and add stage.
+
+"""
+import time
+from pyo import *
+
+NUM = 500
+DUR = 5
+
+s = Server(audio="offline")
+
+CASES = [("none", lambda src, m: src),
+         ("mul", lambda src, m: src * 0.5 + 0.1),
+         ("mul audio", lambda src, m: src * m + 0.1),
+         ("add audio", lambda src, m: src * 0.5 + m),
+         ("mul add audio", lambda src, m: src * m + m),
+         ("sub", lambda src, m: 0.5 - src),
+         ("div audio", lambda src, m: src / m),
+         ("rsub rdiv", lambda src, m: (1.0 - src) / m)]
+
+def render(make):
+    s.boot()
+    s.recordOptions(dur=DUR)
+    m = Sig(0.5)
+    src = Sine(freq=[100 + i for i in range(NUM)])
+    objs = make(src, m)
+    out = Mix(objs, 1).out()
+    t = time.time()
+    s.start()
+    elapsed = time.time() - t
+    s.shutdown()
+    return elapsed
+
+print "%d oscillators, %d seconds" % (NUM, DUR)
+base = render(CASES[0][1])
+print "    %-14s %7.3f sec" % (CASES[0][0], base)
+for name, make in CASES[1:]:
+    elapsed = max(render(make) - base, 1e-6)
+    print "    %-14s %7.3f sec  %6.2f usec/object/sec" % (name, elapsed, elapsed / NUM / DUR * 1e6)
@@ -0,0 +1,38 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Benchmark of the interpolation methods of the table readers.
+
+Renders offline, as fast as possible, a large number of Osc objects
+reading a table with each interpolation method (1 = no interpolation,
+2 = linear, 3 = cosine, 4 = cubic). The rendering with no object at all
+is measured first and subtracted.
+
+"""
+import time
+from pyo import *
+
+NUM = 200
+DUR = 10
+
+s = Server(audio="offline")
+
+def render(interp):
+    s.boot()
+    s.recordOptions(dur=DUR)
+    t = HarmTable([1, .5, .33, .25, .2, .16])
+    if interp == 0:
+        out = Sig(0).out()
+    else:
+        out = Osc(t, freq=[100 + i * 1.5 for i in range(NUM)], interp=interp, mul=.01).mix(1).out()
+    start = time.time()
+    s.start()
+    elapsed = time.time() - start
+    s.shutdown()
+    return elapsed
+
+print "%d oscillators, %d seconds" % (NUM, DUR)
+base = render(0)
+for interp, name in [(1, "none"), (2, "linear"), (3, "cosine"), (4, "cubic")]:
+    elapsed = max(render(interp) - base, 1e-6)
+    print "    %-8s %7.3f sec  %6.2f usec/object/sec" % (name, elapsed, elapsed / NUM / DUR * 1e6)
@@ -0,0 +1,58 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Benchmark of the OfflineBatch object.
+
+Renders, as fast as possible, a set of independent jobs (a bank of
+bandpass filters on a noise source, with a different frequency for each
+job), once in a loop with a single offline server and then with an
+OfflineBatch object and an increasing number of threads. Every job
+writes its own file. Prints the throughput, in sample frames per second,
+and the speed relative to real time. The building of the jobs is not
+measured.
+
+"""
+import os, time, multiprocessing
+from pyo import *
+
+JOBS = 32
+DUR = 5
+FILTERS = 20
+
+def job(freq):
+    src = Noise(.1)
+    filters = ButBP(src, freq=[freq * (i + 1) for i in range(FILTERS)], q=4)
+    out = filters.mix(2).out()
+    return src, filters, out
+
+freqs = [100 + 25 * i for i in range(JOBS)]
+paths = [os.path.join(os.path.expanduser("~"), "pyo_batch_%02d.wav" % i) for i in range(JOBS)]
+
+s = Server(audio="offline")
+s.setVerbosity(1)
+elapsed = 0
+for freq, path in zip(freqs, paths):
+    s.boot()
+    s.recordOptions(dur=DUR, filename=path)
+    objs = job(freq)
+    t = time.time()
+    s.start()
+    elapsed += time.time() - t
+    s.shutdown()
+ref = JOBS * DUR * s.getSamplingRate() / elapsed
+print "%d jobs, %d seconds each" % (JOBS, DUR)
+print "    loop        %10.0f frames/sec  x%6.1f real time" % (ref, ref / s.getSamplingRate())
+
+threads = 1
+while threads <= multiprocessing.cpu_count():
+    batch = OfflineBatch(threads=threads)
+    for freq, path in zip(freqs, paths):
+        batch.add(job, dur=DUR, filename=path, args=(freq,))
+    results = batch.render()
+    rate = batch.getThroughput()
+    print "    %2d threads  %10.0f frames/sec  x%6.1f real time  (x%.2f)" % (threads, rate, rate / s.getSamplingRate(), rate / ref)
+    del results, batch
+    threads *= 2
+
+for path in paths:
+    os.remove(path)
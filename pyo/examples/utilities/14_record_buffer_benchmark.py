@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Benchmark of the offline rendering into memory.
+
+Renders offline, as fast as possible, the same short process, once to a
+sound file read back with SndTable, then directly into an array given to
+Server.setRecordBuffer(), in float32 and in float64, and finally into a
+small array emptied by a callback. Prints the time needed to get the
+samples back in python.
+
+"""
+import os, time, ctypes
+from pyo import *
+
+DUR = 30
+RUNS = 5
+path = os.path.join(os.path.expanduser("~"), "pyo_record_buffer.wav")
+
+s = Server(audio="offline")
+s.setVerbosity(1)
+
+def render(buffer=None, callback=None):
+    s.boot()
+    if buffer is None:
+        s.recordOptions(dur=DUR, filename=path, fileformat=0, sampletype=3)
+    else:
+        s.recordOptions(dur=DUR if callback else -1)
+        s.setRecordBuffer(buffer, callback)
+    src = Sine(freq=[200, 300], mul=.2)
+    out = src.out()
+    t = time.time()
+    s.start()
+    if buffer is None:
+        samples = SndTable(path).getTable(all=True)
+    elapsed = time.time() - t
+    s.setRecordBuffer(None)
+    del src, out
+    s.shutdown()
+    return elapsed
+
+frames = int(DUR * s.getSamplingRate())
+chunk = (ctypes.c_float * (1024 * 2))()
+def flush(n):
+    pass
+
+tests = [("file", lambda: render()),
+         ("float32", lambda: render((ctypes.c_float * (frames * 2))())),
+         ("float64", lambda: render((ctypes.c_double * (frames * 2))())),
+         ("callback", lambda: render(chunk, flush))]
+
+print "%d seconds, stereo, best of %d" % (DUR, RUNS)
+ref = None
+for name, func in tests:
+    elapsed = min(func() for i in range(RUNS))
+    if ref is None:
+        ref = elapsed
+    print "    %-8s %7.3f sec  x%5.2f" % (name, elapsed, ref / elapsed)
+
+os.remove(path)
@@ -0,0 +1,45 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Benchmark of the batched writing into a FIFOPlayer.
+
+Feeds a FIFOPlayer, as fast as possible, with small chunks of samples
+(the size of the chunks produced by a typical synthesis loop), once with
+one put() call per chunk and then with write() and batches of chunks of
+increasing size. The ring is large enough to hold every sample, so only
+the cost of the producer side is measured. Prints the time needed and
+the number of calls per second.
+
+"""
+import time, ctypes
+from pyo import *
+
+CHUNK = 256
+CHUNKS = 4096
+RUNS = 5
+BATCHES = [8, 32, 128]
+
+s = Server(audio="offline").boot()
+chunks = [(ctypes.c_float * CHUNK)() for i in range(CHUNKS)]
+
+def feed(batch):
+    fifo = FIFOPlayer(size=CHUNK * CHUNKS)
+    t = time.time()
+    if batch == 1:
+        for chunk in chunks:
+            fifo.put(chunk)
+    else:
+        for i in range(0, CHUNKS, batch):
+            fifo.write(chunks[i:i+batch])
+    elapsed = time.time() - t
+    assert fifo.getFillLevel() == CHUNK * CHUNKS
+    return elapsed
+
+print "%d chunks of %d samples, best of %d" % (CHUNKS, CHUNK, RUNS)
+ref = None
+for batch in [1] + BATCHES:
+    elapsed = min(feed(batch) for i in range(RUNS))
+    if ref is None:
+        ref = elapsed
+    name = "put" if batch == 1 else "write %d" % batch
+    print "    %-10s %7.4f sec  %9.0f calls/sec  x%5.2f" % (name, elapsed, CHUNKS / batch / elapsed, ref / elapsed)
@@ -0,0 +1,37 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Benchmark of the sample-rate conversion of FIFOPlayer.
+
+Puts, as fast as possible, a few seconds of stereo samples given at
+different rates into a FIFOPlayer, once at the rate of the server (no
+conversion) and then at other rates, converted by put() to the server
+rate. The ring is large enough to hold every frame, so only the cost of
+the producer side is measured. Prints the time needed and the speed
+relative to real time, at the server rate.
+
+"""
+import time, ctypes
+from pyo import *
+
+DUR = 5
+CHUNK = 512
+RUNS = 3
+RATES = [11025, 22050, 48000, 96000]
+
+s = Server(audio="offline").boot()
+sr = int(s.getSamplingRate())
+
+def feed(rate):
+    frames = DUR * rate
+    chunk = (ctypes.c_float * (CHUNK * 2))()
+    fifo = FIFOPlayer(size=DUR * sr + CHUNK * 8, chnls=2)
+    t = time.time()
+    for i in range(frames // CHUNK):
+        fifo.put(chunk, sr=rate)
+    return time.time() - t
+
+print "%d seconds, stereo, chunks of %d frames, best of %d" % (DUR, CHUNK, RUNS)
+for rate in [sr] + RATES:
+    elapsed = min(feed(rate) for i in range(RUNS))
+    print "    %6d Hz  %7.4f sec  x%7.1f real time" % (rate, elapsed, DUR / elapsed)
@@ -33,6 +33,7 @@ typedef struct {
 int jack_callback(jack_nframes_t nframes, void *arg);
 int jack_srate_cb(jack_nframes_t nframes, void *arg);
 int jack_bufsize_cb(jack_nframes_t nframes, void *arg);
+int jack_xrun_cb(void *arg);
 void jack_error_cb(const char *desc);
 void jack_shutdown_cb(void *arg);
 int Server_jack_autoconnect(Server *self);
@@ -0,0 +1,67 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "pyomodule.h"
+
+#ifndef _BIQUADBANK_
+#define _BIQUADBANK_
+
+/* Biquad filters processed BQBANK_LANES at a time.
+**
+** The filters of a group run the same recurrence on different lanes of a
+** vector register. The signals are interleaved, sample i of lane k is at
+** index i * BQBANK_LANES + k. The coefficients are normalized by a0:
+**
+**     y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+**
+** and advanced by their increments before every sample, which lets the
+** caller ramp from one set of coefficients to the next. All the kernels
+** perform the same operations in the same order, their outputs are equal. */
+
+#define BQBANK_LANES 8
+
+/* Kernel identifiers, BQBANK_KERNEL_AUTO selects the best one supported by the cpu. */
+#define BQBANK_KERNEL_AUTO 0
+#define BQBANK_KERNEL_SCALAR 1
+#define BQBANK_KERNEL_VECTOR 2 /* baseline SIMD of the build target (SSE2, NEON) */
+#define BQBANK_KERNEL_AVX 3
+
+typedef struct {
+    MYFLT coeffs[5][BQBANK_LANES]; /* b0, b1, b2, a1, a2 */
+    MYFLT incs[5][BQBANK_LANES];
+    MYFLT x1[BQBANK_LANES];
+    MYFLT x2[BQBANK_LANES];
+    MYFLT y1[BQBANK_LANES];
+    MYFLT y2[BQBANK_LANES];
+} BqBankGroup;
+
+/* Filters count frames of in into the interleaved out, which can be in. If
+** shared is not 0, in is a single signal filtered by every lane, otherwise
+** it is interleaved. */
+typedef void (*bqbank_kernel_func)(BqBankGroup *group, const MYFLT *in, int shared, MYFLT *out, int count);
+
+/* Returns 1 if the kernel can run on this cpu. */
+int bqbank_kernel_available(int kernel);
+/* Resolves BQBANK_KERNEL_AUTO and unsupported kernels to the best supported one. */
+int bqbank_kernel_resolve(int kernel);
+bqbank_kernel_func bqbank_get_kernel(int kernel);
+const char * bqbank_kernel_name(int kernel);
+
+#endif
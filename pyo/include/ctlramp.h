@@ -0,0 +1,56 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "pyomodule.h"
+
+#ifndef _CTLRAMP_
+#define _CTLRAMP_
+
+/* Filter coefficients computed at control rate.
+**
+** With a period of K samples, a filter whose parameters are audio signals
+** computes its coefficients once every K samples, from the parameters at
+** the end of the segment, and ramps linearly from the previous ones. When
+** the parameters did not move since the last segment, nothing is computed.
+** A period of 0 keeps the computation at every sample. */
+
+#define CTLRAMP_MAX_COEFFS 5
+#define CTLRAMP_MAX_PARAMS 3
+
+typedef struct {
+    int period; /* samples, 0 means audio rate coefficients */
+    int ready; /* 0 until the first target, which is used without ramp */
+    int count; /* coefficients in use */
+    MYFLT params[CTLRAMP_MAX_PARAMS]; /* parameters of the current target */
+    MYFLT coeffs[CTLRAMP_MAX_COEFFS]; /* advanced by incs at every sample */
+    MYFLT incs[CTLRAMP_MAX_COEFFS];
+    MYFLT target[CTLRAMP_MAX_COEFFS];
+} CtlRamp;
+
+void CtlRamp_init(CtlRamp *ramp, int count);
+void CtlRamp_setPeriod(CtlRamp *ramp, int period);
+/* Length of the segment starting at sample i of a buffer of size bufsize. */
+int CtlRamp_segment(CtlRamp *ramp, int i, int bufsize);
+/* Starts a segment of len samples. Returns 1 if the parameters changed, the
+** caller then computes the new coefficients and passes them to
+** CtlRamp_setTarget. Otherwise the coefficients stay on the last target. */
+int CtlRamp_begin(CtlRamp *ramp, MYFLT p0, MYFLT p1, MYFLT p2);
+void CtlRamp_setTarget(CtlRamp *ramp, const MYFLT *target, int len);
+#endif
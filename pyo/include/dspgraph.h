@@ -0,0 +1,125 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#ifndef _DSPGRAPH_
+#define _DSPGRAPH_
+
+#include "streammodule.h"
+
+/* Parallel processing of the server's streams.
+**
+** Every stream keeps the list of the resources its processing function
+** touched (other streams, tables, matrices, the random generator). The
+** pool orders the streams with these lists, a stream runs only after every
+** earlier stream writing something it reads, or reading something it
+** writes, is done. Independent streams are spread over the worker threads,
+** the calling thread waits until the whole buffer is computed. A stream
+** whose list is not known yet runs alone, between everything before and
+** everything after it, and the graph is rebuilt at the next buffer. The
+** same happens when its inputs change (setInput, setTable...), its list
+** is recorded again. The lists and the graph are allocated with the GIL,
+** when the streams are published, a run lacking room leaves the buffer to
+** the serial loop.
+**
+** Streams are mixed by the calling thread in the list order. With inline
+** calls (the caller holds the GIL), the streams calling Python or having a
+** duration also run alone, on the calling thread, after every stream
+** before them is mixed, so their calls see the same state as in the
+** serial loop. Otherwise the calls are kept and replayed after the run. */
+
+#if defined(_MSC_VER)
+#define PYO_THREAD_LOCAL __declspec(thread)
+#else
+#define PYO_THREAD_LOCAL __thread
+#endif
+
+#define PYO_GRAPH_MAX_ACCESSES 32
+#define PYO_GRAPH_CALLS 256
+
+typedef struct {
+    void *resource;
+    int write;
+} PyoGraphAccess;
+
+typedef struct PyoGraphAccessList {
+    int count;
+    int overflow; /* too many resources, the stream always runs alone */
+    int calls; /* the processing function made deferred calls */
+    int reset; /* the inputs changed, see PyoGraph_resetAccesses */
+    PyoGraphAccess items[PYO_GRAPH_MAX_ACCESSES];
+} PyoGraphAccessList;
+
+/* Same signature as the server's deferred calls. */
+typedef void (*PyoGraphCallFunc)(PyObject *obj, double value);
+
+typedef struct {
+    int task;
+    int order;
+    PyObject *obj;
+    PyoGraphCallFunc func;
+    double value;
+} PyoGraphCall;
+
+typedef struct {
+    /* Processes one stream, returns 1 if it was active. */
+    int (*process)(void *ctx, Stream *stream);
+    /* Adds an active stream to the output, always on the calling thread. */
+    void (*mix)(void *ctx, Stream *stream);
+    /* After the mix of an active stream, may make deferred calls. */
+    void (*finish)(void *ctx, Stream *stream);
+    void *ctx;
+} PyoGraphFuncs;
+
+typedef struct PyoGraphThread PyoGraphThread;
+typedef struct PyoGraph PyoGraph;
+typedef struct PyoGraphPool PyoGraphPool;
+
+/* Set while a thread runs a stream for the pool, NULL otherwise. */
+extern PYO_THREAD_LOCAL PyoGraphThread *pyo_graph_thread;
+
+extern void PyoGraph_record(void *resource, int write);
+/* Returns 1 if the call was kept to be replayed after the buffer. */
+extern int PyoGraph_deferCall(PyObject *obj, PyoGraphCallFunc func, double value);
+/* Called with the GIL before the stream is published to the pool. */
+extern void PyoGraph_initAccesses(Stream *stream);
+/* Called with the GIL after a change of the streams or tables read by a
+** stream. It runs alone at the next buffer and its list is recorded again. */
+extern void PyoGraph_resetAccesses(Stream *stream);
+
+#define PYO_GRAPH_READ(res) do { if (pyo_graph_thread != NULL) PyoGraph_record((void *)(res), 0); } while (0)
+#define PYO_GRAPH_WRITE(res) do { if (pyo_graph_thread != NULL) PyoGraph_record((void *)(res), 1); } while (0)
+
+/* nthreads includes the thread calling PyoGraphPool_run. */
+PyoGraphPool * PyoGraphPool_new(int nthreads);
+void PyoGraphPool_free(PyoGraphPool *pool);
+/* Called with the GIL. Allocates the graph of count streams, with room for
+** the accesses recorded so far and for those a previous build was short of.
+** The runs never allocate, NULL if the memory is missing. */
+PyoGraph * PyoGraphPool_newGraph(PyoGraphPool *pool, Stream **streams, int count);
+void PyoGraph_free(PyoGraph *graph);
+/* Processes the streams of graph. Returns 0, without processing anything,
+** if graph is too small for the accesses recorded since it was allocated
+** or comes from another pool, a new graph must then be allocated. */
+int PyoGraphPool_run(PyoGraphPool *pool, PyoGraph *graph, int inlineCalls, PyoGraphFuncs *funcs);
+/* Moves the calls made by the streams during the last run into calls, in the
+** order the serial loop would have made them. Returns the number of calls. */
+int PyoGraphPool_takeCalls(PyoGraphPool *pool, PyoGraphCall *calls, int size);
+unsigned long PyoGraphPool_getDroppedCalls(PyoGraphPool *pool);
+#endif
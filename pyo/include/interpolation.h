@@ -27,4 +27,16 @@ MYFLT linear(MYFLT *buf, int index, MYFLT frac, int size);
 MYFLT cosine(MYFLT *buf, int index, MYFLT frac, int size);
 MYFLT cubic(MYFLT *buf, int index, MYFLT frac, int size);
 
+/* Block versions, out[i] is the value read at index[i] + frac[i] in buf,
+** for i in 0 .. num-1. */
+typedef void (*interp_block_func)(MYFLT *buf, int size, const int *index, const MYFLT *frac, MYFLT *out, int num);
+
+/* Returns the block function of an interp value (1 = nointerp, 2 = linear,
+** 3 = cosine, 4 = cubic) for the instruction set of the cpu. */
+interp_block_func interp_get_block_func(int interp);
+
+/* Fills the cosine curve table and selects the block functions, called once
+** when the module is imported. */
+void interp_init(void);
+
 #endif
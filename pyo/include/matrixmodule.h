@@ -27,7 +27,11 @@ typedef struct {
     PyObject_HEAD
     int width;
     int height;
-    MYFLT **data;
+    MYFLT **data; /* rows of a single block, with a guard point at the end of each */
+    PyObject *owner; /* matrix object owning data, kept alive by the buffer views */
+    int exports; /* buffer views in use, the data can't be resized or replaced meanwhile */
+    Py_ssize_t viewShape[2];
+    Py_ssize_t viewStrides[2];
 } MatrixStream;
 
 
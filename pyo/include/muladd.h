@@ -0,0 +1,48 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#ifndef _MULADD_
+#define _MULADD_
+
+/* Kernels of the POST_PROCESSING macros, applying mul and add to the
+** output of an audio object. "a" is an audio signal, "i" a number, the
+** "rev" variants divide by mul or subtract add. A divisor between
+** -0.00001 and 0.00001 is replaced by 0.00001.
+**
+** The kernels are selected for the cpu by PyoMulAdd_init, called once when
+** the module is loaded. All of them give the results of the scalar code. */
+
+typedef struct {
+    void (*ii)(MYFLT *data, int size, MYFLT mul, MYFLT add);
+    void (*ai)(MYFLT *data, int size, const MYFLT *mul, MYFLT add);
+    void (*ia)(MYFLT *data, int size, MYFLT mul, const MYFLT *add);
+    void (*aa)(MYFLT *data, int size, const MYFLT *mul, const MYFLT *add);
+    void (*revai)(MYFLT *data, int size, const MYFLT *mul, MYFLT add);
+    void (*revaa)(MYFLT *data, int size, const MYFLT *mul, const MYFLT *add);
+    void (*ireva)(MYFLT *data, int size, MYFLT mul, const MYFLT *add);
+    void (*areva)(MYFLT *data, int size, const MYFLT *mul, const MYFLT *add);
+    void (*revareva)(MYFLT *data, int size, const MYFLT *mul, const MYFLT *add);
+} PyoMulAddFuncs;
+
+extern PyoMulAddFuncs pyo_muladd;
+
+void PyoMulAdd_init(void);
+
+#endif
@@ -0,0 +1,79 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#ifndef _PTSMKERNEL_
+#define _PTSMKERNEL_
+
+/* Kernel identifiers, PTSM_KERNEL_AUTO selects the best one supported by the cpu. */
+#define PTSM_KERNEL_AUTO 0
+#define PTSM_KERNEL_SCALAR 1
+#define PTSM_KERNEL_AVX2 2
+#define PTSM_KERNEL_AVX512 3
+
+/* Gaussian sum over the points [start, end) of a structure-of-arrays dataset.
+** Dimension k of point j is soa[k * stride + j]. Returns the sum of the weights
+** w_j = exp(-scale * |x_j - pos|^2). If acc is not NULL, the weighted offsets
+** (x_j[k] - pos[k]) * w_j are summed and added to acc[k]. */
+typedef double (*ptsm_kernel_func)(const double *soa, int stride, int dim, int start, int end,
+                                   const double *pos, double scale, double *acc);
+
+/* Returns 1 if the kernel can run on this cpu. */
+int ptsm_kernel_available(int kernel);
+/* Resolves PTSM_KERNEL_AUTO and unsupported kernels to the best supported one. */
+int ptsm_kernel_resolve(int kernel);
+ptsm_kernel_func ptsm_get_kernel(int kernel);
+const char * ptsm_kernel_name(int kernel);
+
+/* Gaussian sums of nparticles positions (nparticles x dim, row-major) over the points
+** [start, end). The data is traversed once, in cache sized blocks, each block being
+** applied to all the particles for which active is not 0 (active can be NULL).
+** sums (nparticles) and acc (nparticles x dim) are accumulated, both can be NULL. */
+void ptsm_batch_sum(ptsm_kernel_func kernel, const double *soa, int stride, int dim, int start, int end,
+                    int nparticles, const double *pos, const char *active, double scale,
+                    double *sums, double *acc);
+
+/* Transposes a row-major (npoints x dim) array into a (dim x stride) soa array. */
+void ptsm_to_soa(const double *rows, int npoints, int dim, double *soa, int stride);
+
+/* k-d tree over a soa dataset. Each node covers the points [start, end) of the
+** reordered dataset, leaves have no children (left == right == -1). */
+typedef struct {
+    int start;
+    int end;
+    int left;
+    int right;
+} PtsmNode;
+
+typedef struct {
+    int dim;
+    int nnodes;
+    int size; /* allocated nodes */
+    PtsmNode *nodes;
+    double *bounds; /* per node, dim lower bounds followed by dim upper bounds */
+} PtsmTree;
+
+/* Builds the tree and reorders the points of soa so that every node is a contiguous range. */
+PtsmTree * ptsm_tree_new(double *soa, int npoints, int dim, int stride);
+void ptsm_tree_free(PtsmTree *tree);
+/* Same as the kernel over all the points, but skips the leaves farther than radius from pos. */
+double ptsm_tree_sum(const PtsmTree *tree, ptsm_kernel_func kernel, const double *soa, int stride,
+                     const double *pos, double scale, double radius, double *acc);
+
+#endif
@@ -23,6 +23,7 @@
 
 typedef struct {
     PyObject_HEAD
+    PyObject *owner; /* stream of the object computing the frames */
     int fftsize;
     int olaps;
     MYFLT **magn;
@@ -40,6 +41,7 @@ extern void PVStream_setOlaps(PVStream * self, int olaps);
 extern void PVStream_setMagn(PVStream * self, MYFLT **data);
 extern void PVStream_setFreq(PVStream * self, MYFLT **data);
 extern void PVStream_setCount(PVStream * self, int *data);
+extern void PVStream_setOwner(PVStream * self, PyObject *stream);
 extern PyTypeObject PVStreamType;
 
 #define MAKE_NEW_PV_STREAM(self, type, rt_error) \
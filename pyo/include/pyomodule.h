@@ -54,6 +54,7 @@
 #define TYPE_S_FIFF "s|fiff"
 #define TYPE_S_FFIFF "s|ffiff"
 #define TYPE_S__OIFI "s|Oifi"
+#define TYPE__FOO "|fOO"
 #define TYPE__FFFOO "|fffOO"
 #define TYPE__FFFIOO "|fffiOO"
 #define TYPE__FFFFFOO "|fffffOO"
@@ -139,6 +140,7 @@
 #define TYPE_S_FIFF "s|didd"
 #define TYPE_S_FFIFF "s|ddidd"
 #define TYPE_S__OIFI "s|Oidi"
+#define TYPE__FOO "|dOO"
 #define TYPE__FFFOO "|dddOO"
 #define TYPE__FFFIOO "|dddiOO"
 #define TYPE__FFFFFOO "|dddddOO"
@@ -199,6 +201,8 @@
 #endif
 #endif
 
+#include "muladd.h"
+
 #ifdef COMPILE_EXTERNALS
 #include "externalmodule.h"
 #endif
@@ -287,6 +291,8 @@ extern PyTypeObject XnoiseDurType;
 extern PyTypeObject UrnType;
 extern PyTypeObject BiquadType;
 extern PyTypeObject BiquadxType;
+extern PyTypeObject BiquadBankMainType;
+extern PyTypeObject BiquadBankType;
 extern PyTypeObject BiquadaType;
 extern PyTypeObject EQType;
 extern PyTypeObject ToneType;
@@ -344,6 +350,7 @@ extern PyTypeObject CompareType;
 extern PyTypeObject MixType;
 extern PyTypeObject SigType;
 extern PyTypeObject SigToType;
+extern PyTypeObject SigQueueType;
 extern PyTypeObject VarPortType;
 extern PyTypeObject InputFaderType;
 extern PyTypeObject HarmTableType;
@@ -503,6 +510,12 @@ extern PyTypeObject ResampleType;
 extern PyTypeObject ExprType;
 extern PyTypeObject PadSynthTableType;
 extern PyTypeObject FIFOPlayerType;
+extern PyTypeObject FIFOPlayType;
+extern PyTypeObject ParticleTrajectoryType;
+extern PyTypeObject PTSMDataType;
+
+/* Windowed-sinc lowpass impulse response, cutoff freq in radians (see upsamp and downsamp). */
+extern void gen_lp_impulse(MYFLT *array, int size, float freq);
 
 /* Constants */
 #define E M_E
@@ -691,9 +704,17 @@ extern PyTypeObject FIFOPlayerType;
     else if (self->interp == 4) \
         self->interp_func_ptr = cubic; \
 
+/* Same as above for the objects using the block functions. */
+#define SET_INTERP_BLOCK_POINTER \
+    if (self->interp == 0) \
+        self->interp = 2; \
+    self->interp_func_ptr = interp_get_block_func(self->interp);
+
 /* Set data */
 #define SET_TABLE_DATA \
     int i; \
+    if (TableStream_checkExports(self->tablestream) < 0) \
+        return NULL; \
     if (! PyList_Check(arg)) { \
         PyErr_SetString(PyExc_TypeError, "The data must be a list of floats."); \
         return PyInt_FromLong(-1); \
@@ -715,15 +736,18 @@ extern PyTypeObject FIFOPlayerType;
     int i, j; \
     PyObject *innerlist; \
  \
+    if (MatrixStream_checkExports(self->matrixstream) < 0) \
+        return NULL; \
     if (! PyList_Check(arg)) { \
         PyErr_SetString(PyExc_TypeError, "The data must be a list of list of floats."); \
         return PyInt_FromLong(-1); \
     } \
     self->height = PyList_Size(arg); \
     self->width = PyList_Size(PyList_GetItem(arg, 0)); \
-    self->data = (MYFLT **)realloc(self->data, (self->height + 1) * sizeof(MYFLT)); \
-    for (i=0; i<(self->height+1); i++) { \
-        self->data[i] = (MYFLT *)realloc(self->data[i], (self->width + 1) * sizeof(MYFLT)); \
+    self->data = (MYFLT **)realloc(self->data, (self->height + 1) * sizeof(MYFLT *)); \
+    self->data[0] = (MYFLT *)realloc(self->data[0], (self->height + 1) * (self->width + 1) * sizeof(MYFLT)); \
+    for (i=1; i<(self->height+1); i++) { \
+        self->data[i] = self->data[0] + i * (self->width + 1); \
     } \
     MatrixStream_setWidth(self->matrixstream, self->width); \
     MatrixStream_setHeight(self->matrixstream, self->height); \
@@ -1646,111 +1670,49 @@ extern PyTypeObject FIFOPlayerType;
 
 /* Post processing (mul & add) macros */
 #define POST_PROCESSING_II \
-    MYFLT mul, add, old, val; \
-    int i; \
+    MYFLT mul, add; \
     mul = PyFloat_AS_DOUBLE(self->mul); \
     add = PyFloat_AS_DOUBLE(self->add); \
-    if (mul != 1 || add != 0) { \
-        for (i=0; i<self->bufsize; i++) { \
-            old = self->data[i]; \
-            val = mul * old + add; \
-            self->data[i] = val; \
-        } \
-    }
+    if (mul != 1 || add != 0) \
+        (*pyo_muladd.ii)(self->data, self->bufsize, mul, add);
 
 #define POST_PROCESSING_AI \
-    MYFLT add, old, val; \
-    int i; \
-    MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    add = PyFloat_AS_DOUBLE(self->add); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul[i] * old + add; \
-        self->data[i] = val; \
-    }
+    (*pyo_muladd.ai)(self->data, self->bufsize, Stream_getData((Stream *)self->mul_stream), PyFloat_AS_DOUBLE(self->add));
 
 #define POST_PROCESSING_IA \
-    MYFLT mul, old, val; \
-    int i; \
-    mul = PyFloat_AS_DOUBLE(self->mul); \
-    MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul * old + add[i]; \
-        self->data[i] = val; \
-    }
+    (*pyo_muladd.ia)(self->data, self->bufsize, PyFloat_AS_DOUBLE(self->mul), Stream_getData((Stream *)self->add_stream));
 
 #define POST_PROCESSING_AA \
-    MYFLT old, val; \
-    int i; \
-    MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul[i] * old + add[i]; \
-        self->data[i] = val; \
-    }
+    (*pyo_muladd.aa)(self->data, self->bufsize, Stream_getData((Stream *)self->mul_stream), Stream_getData((Stream *)self->add_stream));
 
 #define POST_PROCESSING_REVAI \
-    MYFLT tmp, add, old, val; \
-    int i; \
-    MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    add = PyFloat_AS_DOUBLE(self->add); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        tmp = mul[i]; \
-        if (tmp < 0.00001 && tmp > -0.00001) \
-            tmp = 0.00001; \
-        val = old / tmp + add; \
-        self->data[i] = val; \
-    }
+    (*pyo_muladd.revai)(self->data, self->bufsize, Stream_getData((Stream *)self->mul_stream), PyFloat_AS_DOUBLE(self->add));
 
 #define POST_PROCESSING_REVAA \
-    MYFLT tmp, old, val; \
-    int i; \
-    MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        tmp = mul[i]; \
-        if (tmp < 0.00001 && tmp > -0.00001) \
-            tmp = 0.00001; \
-        val = old / tmp + add[i]; \
-        self->data[i] = val; \
-    }
+    (*pyo_muladd.revaa)(self->data, self->bufsize, Stream_getData((Stream *)self->mul_stream), Stream_getData((Stream *)self->add_stream));
 
 #define POST_PROCESSING_IREVA \
-    MYFLT mul, old, val; \
-    int i; \
-    mul = PyFloat_AS_DOUBLE(self->mul); \
-    MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul * old - add[i]; \
-        self->data[i] = val; \
-    }
+    (*pyo_muladd.ireva)(self->data, self->bufsize, PyFloat_AS_DOUBLE(self->mul), Stream_getData((Stream *)self->add_stream));
 
 #define POST_PROCESSING_AREVA \
-    MYFLT old, val; \
-    int i; \
-    MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul[i] * old - add[i]; \
-        self->data[i] = val; \
-    }
+    (*pyo_muladd.areva)(self->data, self->bufsize, Stream_getData((Stream *)self->mul_stream), Stream_getData((Stream *)self->add_stream));
 
 #define POST_PROCESSING_REVAREVA \
-    MYFLT tmp, old, val; \
-    int i; \
-    MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        tmp = mul[i]; \
-        if (tmp < 0.00001 && tmp > -0.00001) \
-            tmp = 0.00001; \
-        val = old / tmp - add[i]; \
-        self->data[i] = val; \
+    (*pyo_muladd.revareva)(self->data, self->bufsize, Stream_getData((Stream *)self->mul_stream), Stream_getData((Stream *)self->add_stream));
+
+/* Fused mul & add, for objects that apply a scalar mul & add while they
+   write their output samples. FUSED_MULADD_INIT must be declared at the top
+   of the processing function, FUSED_MULADD(x) wraps the value written in
+   self->data[i] and the ii post processing function uses
+   POST_PROCESSING_FUSED. In any other mode, mul is 1 and add is 0 and the
+   post processing function does the job. */
+#define FUSED_MULADD_INIT \
+    MYFLT fmul = 1.0, fadd = 0.0; \
+    if (self->modebuffer[0] == 0 && self->modebuffer[1] == 0) { \
+        fmul = PyFloat_AS_DOUBLE(self->mul); \
+        fadd = PyFloat_AS_DOUBLE(self->add); \
     }
+
+#define FUSED_MULADD(x) ((MYFLT)(x) * fmul + fadd)
+
+#define POST_PROCESSING_FUSED
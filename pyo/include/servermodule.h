@@ -28,8 +28,13 @@
 extern "C" {
 #endif
 
+#include <pthread.h>
 #include "sndfile.h"
+#include "sfwriter.h"
 #include "pyomodule.h"
+#include "streammodule.h"
+#include "dspgraph.h"
+#include "telemetry.h"
 
 typedef enum {
     PyoPortaudio = 0,
@@ -62,6 +67,48 @@ typedef struct {
     PyoMidiTimestamp    timestamp;
 } PyoMidiEvent;
 
+/* Number of random object types, each one counts its seeds. */
+#define num_rnd_objs 29
+
+/************************************************/
+
+/* Python calls requested by the audio thread when the stream loop runs
+** without the GIL. They are executed, in order, by the message thread. */
+#define PYO_DEFERRED_SIZE 4096
+
+typedef void (*PyoDeferredFunc)(PyObject *obj, double value);
+
+typedef struct {
+    PyObject *obj; /* NULL if cancelled */
+    PyoDeferredFunc func;
+    double value;
+} PyoDeferredCall;
+
+/* Parameter changes posted by Python for a sample time, with a linear ramp
+** in samples. The audio thread hands them to their object at the start of
+** the next buffer, the object applies them at the right sample. */
+#define PYO_PARAM_SIZE 4096
+
+/* Returns 0 if the object can't hold the event. */
+typedef int (*PyoParamFunc)(PyObject *obj, double value, unsigned long time, long ramp);
+
+typedef struct {
+    PyObject *obj; /* NULL if cancelled */
+    PyoParamFunc func;
+    double value;
+    unsigned long time;
+    long ramp;
+} PyoParamEvent;
+
+/* Immutable snapshot of the streams list read by the audio thread. */
+typedef struct PyoStreamArray {
+    PyoGraph *graph; /* with DSP threads, allocated for these streams */
+    int graphShort; /* the graph lacked room, a new snapshot is requested */
+    struct PyoStreamArray *next; /* replaced during a parallel run, freed after it */
+    int count;
+    Stream *streams[1];
+} PyoStreamArray;
+
 /************************************************/
 
 typedef struct {
@@ -124,8 +171,20 @@ typedef struct {
     int recformat;
     int rectype;
     double recquality;
-    SNDFILE *recfile;
+    double recqueue; /* seconds of sound waiting for the disk */
+    SfWriter *recwriter;
     SF_INFO recinfo;
+    int recBusy; /* set by the audio thread while it pushes to recwriter */
+    unsigned long recOverruns; /* of the last recording */
+
+    /* Offline rendering into memory, instead of recpath. record is 2 while it is written. */
+    Py_buffer recview;
+    char *recbuf; /* recview.buf, NULL without a record buffer */
+    int recbufDouble; /* float64 items, float32 otherwise */
+    int recbufFrames;
+    int recbufPos;
+    unsigned long recbufLost; /* frames discarded, the buffer was full */
+    PyObject *recbufCallback; /* called with the number of frames each time the buffer is full */
 
     /* GUI VUMETER */
     int withGUI;
@@ -145,9 +204,52 @@ typedef struct {
     int verbosity; /* a sum of values to display different levels: 1 = error */
                    /* 2 = message, 4 = warning , 8 = debug. Default 7.*/
     int globalSeed; /* initial seed for random objects. If <= 0, objects are seeded with the clock. */
+    unsigned int randState; /* random generator of the server during a batch render */
+    int batch; /* 1 for the servers of an OfflineBatch, their objects are seeded on their own */
+    int rndObjsCount[num_rnd_objs]; /* seed counters of a batch server, reset on boot */
+
+    /* DSP profiling */
+    int profiling;
+    PyoProfile callbackProfile; /* total time of Server_process_buffers */
+    unsigned long overruns; /* callbacks longer than the buffer duration */
+
+    /* Callback telemetry, allocated the first time it is turned on and kept
+    ** until the server is deleted, the audio thread never sees it freed. */
+    PyoTelemetry *telemetry;
+    int telemetryOn;
+    unsigned long long gilWait; /* nanoseconds spent waiting for the GIL in the current callback */
+
+    /* GIL-free processing (real-time backends only) */
+    int gilFree; /* requested by the user */
+    int deferCalls; /* 1 while the audio callback runs without the GIL */
+    PyoStreamArray *rtStreams;
+    int rtBusy; /* set by the audio thread during a GIL-free callback */
+    unsigned int rtEpoch; /* incremented at the end of every GIL-free callback */
+    PyoDeferredCall *deferred;
+    unsigned int deferredHead;
+    unsigned int deferredTail;
+    unsigned long deferredDropped;
+    pthread_t messageThread;
+    int messageThreadRunning;
+
+    /* Parameter events, written with the GIL and read by the audio thread */
+    PyoParamEvent *params;
+    unsigned int paramHead;
+    unsigned int paramTail;
+    unsigned long paramDropped; /* refused by their object, which was full */
+
+    /* Parallel processing of the streams */
+    int dspThreads; /* requested by the user, 1 means serial processing */
+    PyoGraphPool *dspPool;
+    PyoGraphCall *dspCalls; /* calls made by the streams, replayed after the buffer */
+    int dspCallCount;
+    int dspRunning; /* 1 during a parallel run holding the GIL */
+    PyoStreamArray *dspRetired;
 } Server;
 
 PyObject * PyServer_get_server();
+extern PyObject * Server_get_current(PyObject *self);
+extern PyObject * Server_offline_batch(PyObject *self, PyObject *args);
 extern unsigned int pyorand();
 extern PyObject * Server_removeStream(Server *self, int sid);
 extern MYFLT * Server_getInputBuffer(Server *self);
@@ -156,9 +258,26 @@ extern int Server_getMidiEventCount(Server *self);
 extern int Server_getCurrentResamplingFactor(Server *self);
 extern int Server_getLastResamplingFactor(Server *self);
 extern int Server_generateSeed(Server *self, int oid);
+/* Calls func(obj, value) now if the caller holds the GIL, otherwise queues it
+** for the message thread. Must only be called from the processing functions. */
+extern void Server_defer(Server *self, PyObject *obj, PyoDeferredFunc func, double value);
+extern void Server_deferStop(Server *self, PyObject *obj);
+/* Called with the GIL, returns once the audio thread is out of the buffer
+** it was computing (if any), e.g. before freeing what a stream writes to. */
+extern void Server_waitForCallback(Server *self);
+/* Called with the GIL. Stores value in *ptr, which the processing functions
+** read once per buffer, and returns the previous value once no callback can
+** use it anymore, e.g. a table or a sound file prepared by a setter. */
+extern void * Server_swapPointer(Server *self, void **ptr, void *value);
+/* Called with the GIL. time is in samples since the server was booted (see
+** elapsedSamples), events already due are applied at the next buffer.
+** Returns 0 if the queue is full. */
+extern int Server_postParam(Server *self, PyObject *obj, PyoParamFunc func, double value, unsigned long time, long ramp);
 extern PyTypeObject ServerType;
 void pyoGetMidiEvents(Server *self);
 void Server_process_buffers(Server *server);
+/* Called by the audio backends when they detect an xrun, from any thread. */
+void Server_xrun(Server *self);
 void Server_error(Server *self, char * format, ...);
 void Server_message(Server *self, char * format, ...);
 void Server_warning(Server *self, char * format, ...);
@@ -168,6 +287,7 @@ PyObject *Server_stop(Server *self);
 void Server_process_gui(Server *server);
 void Server_process_time(Server *server);
 int Server_start_rec_internal(Server *self, char *filename);
+int Server_stop_rec_internal(Server *self);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,61 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "pyomodule.h"
+#include "sndfile.h"
+
+#ifndef _SFSTREAMER_
+#define _SFSTREAMER_
+
+/* Sound file read from disk by a background thread.
+**
+** The frames are kept in blocks, block n always lives in the slot
+** n % SFSTREAMER_BLOCKS. After every buffer, the audio thread tells where
+** it is reading, in which direction, how many frames a buffer uses and
+** where the reading continues after a jump (loop start, next marker). The
+** I/O thread loads the blocks ahead of the position, the audio thread only
+** copies from memory and never waits. A slot is versioned, a copy racing
+** with a new load is detected and counted as missing.
+**
+** A blocking streamer has no I/O thread, the missing blocks are read by
+** the caller of SfStreamer_read. It is used by offline servers, where a
+** late block would otherwise be rendered as silence. */
+
+#define SFSTREAMER_BLOCK_SIZE 2048 /* frames */
+#define SFSTREAMER_BLOCKS 32
+#define SFSTREAMER_AHEAD 32 /* buffers read ahead */
+
+typedef struct SfStreamer SfStreamer;
+
+/* Opens path, fills info. Returns NULL if the file can't be opened. */
+SfStreamer * SfStreamer_open(const char *path, SF_INFO *info, int blocking);
+void SfStreamer_close(SfStreamer *self);
+/* Copies the interleaved frames [start, start+count) into buffer. Frames
+** outside the file, or not loaded yet, are zeros. Returns the number of
+** frames that were not loaded. */
+int SfStreamer_read(SfStreamer *self, sf_count_t start, int count, MYFLT *buffer);
+/* Reading position pos, moving in direction dir (1 or -1) by about span
+** frames per buffer, then jumping to next (-1 if none) and going in
+** direction nextDir. Called by the audio thread after every buffer. */
+void SfStreamer_prefetch(SfStreamer *self, sf_count_t pos, int dir, int span, sf_count_t next, int nextDir);
+/* Not from the audio thread. Moves the reading position to pos and waits,
+** at most timeout milliseconds, until its block is loaded. */
+void SfStreamer_seek(SfStreamer *self, sf_count_t pos, int dir, int span, int timeout);
+#endif
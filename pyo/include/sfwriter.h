@@ -0,0 +1,53 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "pyomodule.h"
+#include "sndfile.h"
+#include "spscring.h"
+
+#ifndef _SFWRITER_
+#define _SFWRITER_
+
+/* Sound file written to disk by a background thread.
+**
+** The audio thread pushes interleaved frames in a lock-free ring, a writer
+** thread owned by the SfWriter empties it in the file. The ring holds a
+** bounded amount of sound, when the disk is too slow to keep up, the frames
+** that don't fit are dropped and counted as an overrun, the audio thread
+** never waits. A blocking writer (offline servers) waits for room instead. */
+
+#define SFWRITER_DEFAULT_QUEUE 2.0 /* seconds */
+
+typedef struct SfWriter SfWriter;
+
+/* Takes ownership of file. capacity is the size of the queue, in frames,
+** and chunk the number of frames the writer thread waits for before each
+** write to the disk. */
+SfWriter * SfWriter_new(SNDFILE *file, int chnls, int capacity, int chunk, int blocking);
+/* Pushes frames, from the audio thread. Returns 0 if they were dropped. */
+int SfWriter_write(SfWriter *self, const MYFLT *data, int frames);
+/* Same, from a float buffer (the server's output). */
+int SfWriter_writeFloat(SfWriter *self, const float *data, int frames);
+/* Writes what is left in the queue and closes the file. Frames pushed after
+** this call are ignored, the SfWriter stays valid until SfWriter_free. */
+void SfWriter_close(SfWriter *self);
+void SfWriter_free(SfWriter *self);
+unsigned long SfWriter_getOverruns(SfWriter *self);
+#endif
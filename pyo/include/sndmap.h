@@ -0,0 +1,51 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "pyomodule.h"
+#include "sndfile.h"
+
+#ifndef _SNDMAP_
+#define _SNDMAP_
+
+/* Sound table data mapped from a file instead of read in memory.
+**
+** A mono WAV file of MYFLT floats is mapped as is. Any other sound is
+** decoded once, one channel at a time, in a sidecar file of the cache
+** directory, and the sidecar is mapped. Sidecars are named after the file,
+** its size and modification time, the channel and the frame range, they
+** are shared by every process using the same cache directory.
+**
+** The mapping is private, pages are read from the disk when first used
+** and shared with the other processes mapping the same file. Writing the
+** data (normalize, put, etc.) copies the pages written, the file is never
+** modified. */
+
+typedef struct {
+    void *base; /* NULL when nothing is mapped */
+    size_t length;
+} SndMap;
+
+/* Maps frames [start, stop) of channel chnl. Returns stop - start + 1
+** samples, the last one is a copy of the first, or NULL if the sound can't
+** be mapped. cachedir may be NULL, only direct mappings are then used. */
+MYFLT * SndMap_open(SndMap *map, const char *path, int chnl, sf_count_t start, sf_count_t stop,
+                    const char *cachedir);
+void SndMap_close(SndMap *map);
+#endif
@@ -0,0 +1,53 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+#include "pyomodule.h"
+
+#ifndef _SPSCRING_
+#define _SPSCRING_
+
+#define SPSC_CACHE_LINE 64
+
+/* Lock-free single-producer/single-consumer ring of samples. One thread
+** writes, one other thread reads, neither of them ever blocks or allocates.
+** head and tail are free running counters, each on its own cache line so
+** that the producer and the consumer do not invalidate each other's line. */
+typedef struct {
+    MYFLT *buffer;
+    unsigned int size; /* power of two */
+    unsigned int mask;
+    char pad0[SPSC_CACHE_LINE];
+    unsigned int head; /* written by the producer only */
+    char pad1[SPSC_CACHE_LINE - sizeof(unsigned int)];
+    unsigned int tail; /* written by the consumer only */
+    char pad2[SPSC_CACHE_LINE - sizeof(unsigned int)];
+} SPSCRing;
+
+/* capacity is rounded up to the next power of two. */
+SPSCRing * SPSCRing_new(int capacity);
+void SPSCRing_free(SPSCRing *ring);
+int SPSCRing_getSize(SPSCRing *ring);
+/* Number of samples ready to be read, consumer side. */
+int SPSCRing_readable(SPSCRing *ring);
+/* Number of free slots, producer side. */
+int SPSCRing_writable(SPSCRing *ring);
+/* Both return the number of samples actually copied, at most n. */
+int SPSCRing_write(SPSCRing *ring, const MYFLT *data, int n);
+int SPSCRing_read(SPSCRing *ring, MYFLT *data, int n);
+#endif
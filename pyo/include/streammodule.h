@@ -18,9 +18,33 @@
  * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
  *************************************************************************/
 
+#ifndef Py_STREAMMODULE_H
+#define Py_STREAMMODULE_H
+
 #include <Python.h>
 #include "pyomodule.h"
 
+/* Execution time statistics of a processing callback, in nanoseconds.
+** The histogram has PYO_PROFILE_BINS_PER_OCTAVE bins per octave starting
+** at PYO_PROFILE_MIN_TIME, the last bin collects everything above. */
+#define PYO_PROFILE_BINS 96
+#define PYO_PROFILE_BINS_PER_OCTAVE 4
+#define PYO_PROFILE_MIN_TIME 32.0
+
+typedef struct {
+    unsigned long count;
+    double sum;
+    double min;
+    double max;
+    unsigned int hist[PYO_PROFILE_BINS];
+} PyoProfile;
+
+extern double PyoProfile_getTime();
+extern void PyoProfile_reset(PyoProfile *self);
+extern void PyoProfile_add(PyoProfile *self, double time);
+extern double PyoProfile_percentile(PyoProfile *self, double p);
+extern PyObject * PyoProfile_toDict(PyoProfile *self);
+
 typedef struct {
     PyObject_HEAD
     PyObject *streamobject;
@@ -34,6 +58,15 @@ typedef struct {
     int bufferCountWait;
     int bufferCount;
     MYFLT *data;
+    int needsgil; /* processing function uses the Python API */
+    PyoProfile *profile; /* NULL unless the server is profiling */
+    struct PyoGraphAccessList *accesses; /* resources used, see dspgraph.h */
+    /* Copies of the last two blocks, for the buffer protocol. Allocated by the
+    ** first view, the last completed block is the row viewCount % 2. */
+    MYFLT *views;
+    unsigned long viewCount;
+    Py_ssize_t viewShape[2];
+    Py_ssize_t viewStrides[2];
 } Stream;
 
 extern int Stream_getNewStreamId();
@@ -44,29 +77,39 @@ extern int Stream_getBufferCountWait(Stream *self);
 extern int Stream_getDuration(Stream *self);
 extern int Stream_getStreamChnl(Stream *self);
 extern int Stream_getStreamToDac(Stream *self);
+extern int Stream_getStreamNeedsGIL(Stream *self);
 extern MYFLT * Stream_getData(Stream *self);
 extern void Stream_setData(Stream * self, MYFLT *data);
 extern void Stream_setFunctionPtr(Stream *self, void *ptr);
 extern void Stream_callFunction(Stream *self);
 extern void Stream_IncrementBufferCount(Stream *self);
-extern void Stream_IncrementDurationCount(Stream *self);
+extern int Stream_IncrementDurationCount(Stream *self);
+extern void Stream_setProfiling(Stream *self, int state);
+extern PyoProfile * Stream_getProfile(Stream *self);
+/* Called by the audio thread after the stream is computed, if it has views. */
+extern void Stream_publishView(Stream *self);
+/* Fills a buffer protocol view of an array of samples, strides are in bytes. */
+extern int PyoBuffer_fillView(Py_buffer *view, PyObject *obj, MYFLT *data, int ndim, Py_ssize_t *shape,
+                              Py_ssize_t *strides, int readonly, int flags);
 extern PyTypeObject StreamType;
 
 #define MAKE_NEW_STREAM(self, type, rt_error) \
   (self) = (Stream *)(type)->tp_alloc((type), 0); \
   if ((self) == rt_error) { return rt_error; } \
  \
-  (self)->sid = (self)->chnl = (self)->todac = (self)->bufferCountWait = (self)->bufferCount = (self)->bufsize = (self)->duration = 0; \
+  (self)->sid = (self)->chnl = (self)->todac = (self)->bufferCountWait = (self)->bufferCount = (self)->bufsize = (self)->duration = (self)->needsgil = 0; \
   (self)->active = 1;
 
 
 typedef struct {
     PyObject_HEAD
+    PyObject *owner; /* stream of the object computing the triggers */
     MYFLT *data;
 } TriggerStream;
 
 extern MYFLT * TriggerStream_getData(TriggerStream *self);
 extern void TriggerStream_setData(TriggerStream * self, MYFLT *data);
+extern void TriggerStream_setOwner(TriggerStream * self, PyObject *stream);
 extern PyTypeObject TriggerStreamType;
 
 #define MAKE_NEW_TRIGGER_STREAM(self, type, rt_error) \
@@ -87,6 +130,10 @@ extern PyTypeObject TriggerStreamType;
 #define Stream_setBufferCountWait(op, v) (((Stream *)(op))->bufferCountWait = (v))
 #define Stream_setDuration(op, v) (((Stream *)(op))->duration = (v))
 #define Stream_setBufferSize(op, v) (((Stream *)(op))->bufsize = (v))
+#define Stream_setStreamNeedsGIL(op, v) (((Stream *)(op))->needsgil = (v))
+
+#endif
+/* __STREAMMODULE */
 
 #endif
-/* __STREAMMODULE */
\ No newline at end of file
+/* Py_STREAMMODULE_H */
@@ -28,6 +28,10 @@ typedef struct {
     int size;
     double samplingRate;
     MYFLT *data;
+    PyObject *owner; /* table object owning data, kept alive by the buffer views */
+    int exports; /* buffer views in use, the data can't be resized or replaced meanwhile */
+    Py_ssize_t viewShape[1];
+    Py_ssize_t viewStrides[1];
 } TableStream;
 
 
@@ -42,6 +46,7 @@ if ((self) == rt_error) { return rt_error; }	\
 int TableStream_getSize(PyObject *self);
 double TableStream_getSamplingRate(PyObject *self);
 MYFLT * TableStream_getData(PyObject *self);
+MYFLT * TableStream_getWritableData(PyObject *self);
 extern PyTypeObject TableStreamType;
 
 #endif
\ No newline at end of file
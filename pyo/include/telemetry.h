@@ -0,0 +1,90 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "pyomodule.h"
+
+#ifndef _TELEMETRY_
+#define _TELEMETRY_
+
+/* Timing telemetry of the audio callbacks.
+**
+** The audio thread pushes one record per callback in a ring of
+** PYO_TELEMETRY_SIZE records, it never blocks and never allocates. When
+** nobody reads fast enough, the oldest records are overwritten. Readers
+** (Python snapshots, the file writer thread) keep their own cursor and
+** never modify the ring, a record overwritten while it was copied is
+** discarded. Times are in nanoseconds, on the clock of PyoProfile_getTime. */
+
+#define PYO_TELEMETRY_SIZE 4096 /* power of two */
+
+/* Record flags. */
+#define PYO_TELEMETRY_OVERRUN 1 /* the callback took longer than the buffer duration */
+#define PYO_TELEMETRY_XRUN 2 /* the audio backend reported an xrun since the previous callback */
+#define PYO_TELEMETRY_LATE 4 /* the callback started more than one buffer late */
+
+typedef struct {
+    unsigned long long index; /* callback number, from 0 */
+    double start; /* seconds since the epoch, comparable with time.time() */
+    double duration;
+    double slack; /* deadline - duration, negative on overruns */
+    double interval; /* since the start of the previous callback */
+    double gilwait; /* time spent waiting for the GIL */
+    unsigned int flags;
+} PyoTelemetryRecord;
+
+typedef struct {
+    unsigned long long callbacks;
+    unsigned long overruns;
+    unsigned long xruns; /* reported by the backend */
+    unsigned long late;
+    double maxDuration;
+    double minSlack;
+    double gilwait; /* total */
+} PyoTelemetryCounters;
+
+typedef struct PyoTelemetry PyoTelemetry;
+
+PyoTelemetry * PyoTelemetry_new(void);
+/* Stops the file writer, no callback may use self anymore. */
+void PyoTelemetry_free(PyoTelemetry *self);
+
+/* Audio thread. start and end come from PyoProfile_getTime. */
+void PyoTelemetry_push(PyoTelemetry *self, double start, double end, double deadline, double gilwait);
+/* Any thread, typically an xrun callback or the audio callback itself. */
+void PyoTelemetry_xrun(PyoTelemetry *self);
+
+/* Readers. Copies at most max records, from *cursor to the newest one, and
+** moves the cursor after them. Records lost since the last read are skipped.
+** A cursor of 0 on the first call starts at the oldest available record. */
+int PyoTelemetry_read(PyoTelemetry *self, unsigned long long *cursor, PyoTelemetryRecord *out, int max);
+/* Index of the next record to be pushed. */
+unsigned long long PyoTelemetry_getHead(PyoTelemetry *self);
+void PyoTelemetry_getCounters(PyoTelemetry *self, PyoTelemetryCounters *counters);
+/* Applied by the audio thread at the next callback. */
+void PyoTelemetry_reset(PyoTelemetry *self);
+
+/* Appends the records to a text file, one line per callback, from a
+** background thread. Returns -1 if the file can't be opened. Opening a
+** new file closes the previous one. */
+int PyoTelemetry_openFile(PyoTelemetry *self, const char *path);
+void PyoTelemetry_closeFile(PyoTelemetry *self);
+/* Records overwritten before the file writer could read them. */
+unsigned long PyoTelemetry_getFileLost(PyoTelemetry *self);
+#endif
@@ -66,6 +66,8 @@ from pyolib._core import *
 from pyolib.wxgui import *
 import pyolib.wxgui as wxgui
 from pyolib.fifoplayer import FIFOPlayer
+import pyolib.ptsm as ptsm
+from pyolib.ptsm import *
 if WITH_EXTERNALS:
     import pyolib.external as external
     from pyolib.external import *
@@ -91,17 +93,17 @@ OBJECTS_TREE = {'functions': sorted(['pa_count_devices', 'pa_get_default_input',
                                                       'Spectrum', 'PeakAmp']),
                                   'arithmetic': sorted(['Sin', 'Cos', 'Tan', 'Abs', 'Sqrt', 'Log', 'Log2', 'Log10', 'Pow', 'Atan2', 'Floor',
                                                         'Round', 'Ceil', 'Tanh', 'Exp']),
-                                  'controls': sorted(['Fader', 'Sig', 'SigTo', 'Adsr', 'Linseg', 'Expseg']),
+                                  'controls': sorted(['Fader', 'Sig', 'SigTo', 'SigQueue', 'Adsr', 'Linseg', 'Expseg']),
                                   'dynamics': sorted(['Clip', 'Compress', 'Degrade', 'Mirror', 'Wrap', 'Gate', 'Balance', 'Min', 'Max']),
                                   'effects': sorted(['Delay', 'SDelay', 'Disto', 'Freeverb', 'Waveguide', 'Convolve', 'WGVerb', 'SmoothDelay',
                                                      'Harmonizer', 'Chorus', 'AllpassWG', 'FreqShift', 'Vocoder', 'Delay1', 'STRev']),
                                   'filters': sorted(['Biquad', 'BandSplit', 'Port', 'Hilbert', 'Tone', 'DCBlock', 'EQ', 'Allpass',
-                                                     'Allpass2', 'Phaser', 'Biquadx', 'IRWinSinc', 'IRAverage', 'IRPulse', 'IRFM',
+                                                     'Allpass2', 'Phaser', 'Biquadx', 'BiquadBank', 'IRWinSinc', 'IRAverage', 'IRPulse', 'IRFM',
                                                      'FourBand', 'Biquada', 'Atone', 'SVF', 'Average', 'Reson', 'Resonx', 'ButLP',
                                                      'ButHP', 'ButBP', 'ButBR', 'ComplexRes', 'MoogLP']),
                                   'generators': sorted(['Noise', 'Phasor', 'Sine', 'Input', 'FM', 'SineLoop', 'Blit', 'PinkNoise', 'CrossFM',
                                                         'BrownNoise', 'Rossler', 'Lorenz', 'ChenLee', 'LFO', 'SumOsc', 'SuperSaw', 'RCOsc',
-                                                        'FastSine']),
+                                                        'FastSine', 'ParticleTrajectory']),
                                   'internals': sorted(['Dummy', 'InputFader', 'Mix', 'VarPort']),
                                   'midi': sorted(['Midictl', 'CtlScan', 'CtlScan2', 'Notein', 'MidiAdsr', 'MidiDelAdsr', 'Bendin',
                                                   'Touchin', 'Programin', 'RawMidi']),
@@ -125,6 +127,7 @@ OBJECTS_TREE = {'functions': sorted(['pa_count_devices', 'pa_get_default_input',
                                   'fourier': sorted(['FFT', 'IFFT', 'CarToPol', 'PolToCar', 'FrameDelta', 'FrameAccum', 'Vectral', 'CvlVerb'])}},
                 'Map': {'SLMap': sorted(['SLMapFreq', 'SLMapMul', 'SLMapPhase', 'SLMapQ', 'SLMapDur', 'SLMapPan'])},
                 'Server': [],
+                'OfflineBatch': [],
                 'MidiListener': [],
                 'OscListener': [],
                 'Stream': [],
@@ -157,7 +160,7 @@ def getPyoKeywords():
             for val in tree[k1]:
                 _list.append(val)
     _list.extend(["PyoObjectBase", "PyoObject", "PyoTableObject", "PyoMatrixObject", "PyoPVObject"])
-    _list.extend(["Server", "Map", "SLMap", "MidiListener", "OscListener", "Stream", "TableStream"])
+    _list.extend(["Server", "OfflineBatch", "Map", "SLMap", "MidiListener", "OscListener", "Stream", "TableStream"])
     return _list
 
 OBJECTS_TREE["functions"] = sorted(OBJECTS_TREE["functions"] + ["getPyoKeywords"])
@@ -795,6 +795,53 @@ class PyoObject(PyoObjectBase):
         else:
             return [obj._getStream().getValue() for obj in self._base_objs]
 
+    def getBuffer(self, chnl=0):
+        """
+        Return a zero-copy view of the last blocks computed by a stream.
+
+        The view is a read-only memoryview of shape (2, buffersize),
+        usable by numpy.asarray() or numpy.frombuffer(). The stream copies
+        each block it computes in the row getBlockCount() % 2, the other
+        row being the previous block, so a Python thread can read the last
+        completed block without the GIL being held by the audio thread.
+        A row is overwritten two blocks after it was completed, the read
+        is valid if getBlockCount() didn't increase by more than one in
+        the meantime.
+
+        The view keeps the object alive. The blocks are copied only for
+        the streams whose view was requested at least once.
+
+        :Args:
+
+            chnl : int, optional
+                Index of the stream. Defaults to 0.
+
+        >>> s = Server().boot()
+        >>> s.start()
+        >>> a = Sine(freq=500)
+        >>> view = numpy.asarray(a.getBuffer())
+        >>> count = a.getBlockCount()
+        >>> block = view[count % 2]
+
+        """
+        pyoArgsAssert(self, "I", chnl)
+        return memoryview(self._base_objs[chnl]._getStream())
+
+    def getBlockCount(self, chnl=0):
+        """
+        Return the number of blocks copied to the view of a stream.
+
+        See getBuffer() method.
+
+        :Args:
+
+            chnl : int, optional
+                Index of the stream. Defaults to 0.
+
+        """
+        pyoArgsAssert(self, "I", chnl)
+        return self._base_objs[chnl]._getStream().getBlockCount()
+
     def play(self, dur=0, delay=0):
         """
         Start processing without sending samples to output.
@@ -1038,6 +1085,55 @@ class PyoObject(PyoObjectBase):
             setattr(self, attr, self._target_dict[attr])
         self._signal_dict[attr].stop()
 
+    def post(self, attr, value, time=None, ramp=0):
+        """
+        Changes any attribute, at a given sample, with the server's event queue.
+
+        The first call replaces the attribute with a SigQueue object,
+        initialized with the current value of the attribute. The next
+        calls only post an event to the server, without the GIL in the
+        audio thread, which applies it at the exact sample.
+
+        This method is intended to be applied on attributes that are not
+        already assigned to PyoObjects. It will work only with floats or
+        list of floats.
+
+        Returns False if the event couldn't be queued.
+
+        :Args:
+
+            attr : string
+                Name of the attribute as a string.
+            value : float
+                New value.
+            time : int, optional
+                Server time, in samples, of the change (see
+                Server.getElapsedSamples). None, the default, means as
+                soon as possible.
+            ramp : float, optional
+                Time, in seconds, of a linear ramp to the new value.
+                Defaults to 0.
+
+        >>> s = Server().boot()
+        >>> s.start()
+        >>> a = Sine(freq=500, mul=.2).out()
+        >>> now = s.getElapsedSamples() + s.getBufferSize() * 4
+        >>> a.post("freq", 600, time=now, ramp=0.01)
+        >>> a.post("freq", 500, time=now + 22050, ramp=0.01)
+
+        """
+        pyoArgsAssert(self, "Sn", attr, value)
+        queue = self._signal_dict.get(attr)
+        if not isinstance(queue, SigQueue) or getattr(self, attr) is not queue:
+            init = getattr(self, attr)
+            if not isinstance(init, (ListType, FloatType, IntType, LongType)):
+                init = value
+            elif type(value) is ListType and type(init) is not ListType:
+                init = [init] * len(value)
+            queue = self._signal_dict[attr] = SigQueue(init)
+            setattr(self, attr, queue)
+        return queue.post(value, time, ramp)
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         """
         Opens a sliders window to control the parameters of the object.
@@ -1318,6 +1414,26 @@ class PyoTableObject(PyoObjectBase):
         else:
             return self._base_objs[0].getTable()
 
+    def getBuffer(self, chnl=0):
+        """
+        Return a zero-copy view of the samples of the table.
+
+        The view is a writable memoryview of shape (size,), usable by
+        numpy.asarray() or numpy.frombuffer(). Objects writing into the
+        table, like TableRec, are seen as they record. The view keeps the
+        table alive, and resizing or replacing the samples of the table
+        (setSize, setData, setSound...) raises a BufferError until it is
+        released.
+
+        :Args:
+
+            chnl : int, optional
+                Index of the sub table. Defaults to 0.
+
+        """
+        pyoArgsAssert(self, "I", chnl)
+        return memoryview(self._base_objs[chnl].getTableStream())
+
     def normalize(self):
         """
         Normalize table samples between -1 and 1.
@@ -1709,6 +1825,17 @@ class PyoMatrixObject(PyoObjectBase):
         """
         return self._size
 
+    def getBuffer(self):
+        """
+        Return a zero-copy view of the points of the matrix.
+
+        The view is a writable and strided memoryview of shape
+        (height, width), usable by numpy.asarray(). It keeps the matrix
+        alive, and setData raises a BufferError until it is released.
+
+        """
+        return memoryview(self._base_objs[0].getMatrixStream())
+
     def normalize(self):
         """
         Normalize matrix samples between -1 and 1.
@@ -2309,6 +2436,87 @@ class VarPort(PyoObject):
     @function.setter
     def function(self, x): self.setFunction(x)
 
+class SigQueue(PyoObject):
+    """
+    Convert numeric value to PyoObject signal changed by timestamped events.
+
+    The changes are posted to a lock-free queue of the server and applied
+    by the audio thread at the exact sample, with an optional linear ramp.
+    The audio thread never touches Python objects to read them, the
+    object can be used when the server runs without the GIL.
+
+    :Parent: :py:class:`PyoObject`
+
+    :Args:
+
+        value : float, optional
+            Initial value of the signal. Defaults to 0.
+
+    .. note::
+
+        PyoObject.post() creates a SigQueue to change an attribute.
+
+    >>> s = Server().boot()
+    >>> s.start()
+    >>> fr = SigQueue(value=400)
+    >>> a = SineLoop(freq=fr, feedback=0.08, mul=.3).out()
+    >>> now = s.getElapsedSamples()
+    >>> for i in range(8):
+    ...     fr.post(400 + 50 * i, time=now + i * 11025, ramp=0.005)
+
+    """
+    def __init__(self, value=0, mul=1, add=0):
+        pyoArgsAssert(self, "nOO", value, mul, add)
+        PyoObject.__init__(self, mul, add)
+        self._value = value
+        value, mul ,add, lmax = convertArgsToLists(value, mul, add)
+        self._base_objs = [SigQueue_base(wrap(value,i), wrap(mul,i), wrap(add,i)) for i in range(lmax)]
+
+    def post(self, value, time=None, ramp=0):
+        """
+        Posts a new value to the server's event queue.
+
+        Returns False if the queue is full and the event was dropped.
+
+        :Args:
+
+            value : float
+                New value.
+            time : int, optional
+                Server time, in samples, of the change (see
+                Server.getElapsedSamples). A time already passed, or None,
+                the default, means at the start of the next buffer.
+            ramp : float, optional
+                Time, in seconds, of a linear ramp from the current value.
+                Defaults to 0.
+
+        """
+        pyoArgsAssert(self, "n", value)
+        self._value = value
+        if time is None:
+            time = 0
+        value, time, ramp, lmax = convertArgsToLists(value, time, ramp)
+        return all([obj.post(wrap(value,i), wrap(time,i), wrap(ramp,i)) for i, obj in enumerate(self._base_objs)])
+
+    def setValue(self, x):
+        """
+        Changes the value of the signal stream at the start of the next buffer.
+
+        :Args:
+
+            x : float
+                New value.
+
+        """
+        self.post(x)
+
+    @property
+    def value(self):
+        """float. Last value posted."""
+        return self._value
+    @value.setter
+    def value(self, x): self.setValue(x)
+
 class Pow(PyoObject):
     """
     Performs a power function on audio signal.
@@ -793,8 +793,12 @@ class Convolve(PyoObject):
 
     .. note::
 
-        Convolution is very expensive to compute, so the impulse response must
-        be kept very short to run in real time.
+        When the buffer size is a power of two, impulse responses longer than
+        64 samples are computed with a partitioned FFT convolution, so
+        impulse responses of several seconds can run in real time. The
+        spectrum of one buffer-sized partition of the table is refreshed at
+        every buffer, changes made to the table content are heard after
+        `size` samples at most.
 
         Usually convolution generates a high amplitude level, take care of the
         `mul` parameter!
@@ -1,5 +1,4 @@
 from pyolib._core import *
-import Queue
 
 
 class FIFOPlayer(PyoObject):
@@ -8,42 +7,78 @@ class FIFOPlayer(PyoObject):
     """
     Directly feed a FIFO buffer with audio samples (from NumPy arrays).
 
-    You can call put(x) to add to the buffer, which is implemented as a Python
-    stdlib queue. FIFOPlayer will accept any objects supporting the Python
-    Buffer protocol as long as the type of the elements is matching either
-    float (32Bit) or double (64Bit) depending on the pyo variant
-    (import pyo or pyo64). The number of elements in the array does not matter.
-    FIFOPlayer is thread-save.
+    You can call put(x) to add to the buffer, which is implemented as a
+    preallocated lock-free ring of samples shared by the calling thread and
+    the audio thread. The audio callback only copies samples out of the
+    ring, it never calls into Python nor waits for a lock. FIFOPlayer will
+    accept any objects supporting the Python Buffer protocol as long as the
+    type of the elements is float (32Bit) or double (64Bit). The elements
+    are converted if they don't match the pyo variant (import pyo or
+    pyo64). The number of frames in the array does not matter.
+    Only one thread at a time may call put().
+
+    With more than one channel, the ring holds interleaved frames and the
+    audio thread splits them into one stream per channel, so the channels
+    are always sample-aligned. By default put() expects interleaved frames,
+    a 1-D array or a (frames, chnls) array. With planar=True, it expects
+    one row per channel, a (chnls, frames) array, interleaved on the
+    calling thread. The layout is never guessed from the shape, a
+    (chnls, chnls) array is read as interleaved unless planar is True, and
+    a 2-D array whose rows are not frames of `chnls` samples is rejected
+    with a ValueError.
+
+    The samples may be given at any rate, put(x, sr=rate) converts them
+    to the rate of the server, on the calling thread, with a polyphase
+    windowed-sinc filter (the upsamp/downsamp lowpass filter). A
+    generator can run at its natural rate while the server runs at the
+    production rate. The filter state is kept from one call to the next,
+    the conversion adds a latency of 32 frames at the source rate.
 
     Parentclass: PyoObject
 
     Parameters:
 
-    maxsize : int
-        The maximum number of objects in the queue until the next call to
-        put(x) blocks. The size of each array does not matter. (Default 100)
-
-    copy_free : Boolean
-        If set to True (Default:False), the FIFOPlayer attemps to avoid memcpy
-        and just sets the pointer to point into the memory of the array in the
-        queue. This is slightly faster (however, getting an object from the
-        queue is the bigger overhead). Even if copy_free is True, sometimes
-        memcpy cannot be avoided if the size of an array is *not* a multiple
-        of the buffer size of the server. Remaining samples have to be copied.
-        Beware, `mul` and `add` (and any other) postprocessing will be ignored!
+    size : int
+        Capacity of the ring, in frames, rounded up so that size * chnls
+        is a power of two. put(x) blocks while the ring is full.
+        (Default 32768)
+    chnls : int
+        Number of channels. (Default 1)
 
     Methods:
 
-    put(x) : Feed x into the queue. The dtype of x must be correct but the
-             size does not matter. put() actually adds a reference.
-             Therefore, you should not change the contents of x, after putting
-             it into the FIFOPlayer.
-             If you use `import pyo` (the 32Bit version), make sure to
-             use dtype=numpy.float32 or the numpy methond `.astype(np.float32)`
-             on the numpy array.
-             If the FIFOPlayer has multiple streams, you may use the keyword
-             stream=i to put into the specific stream (this feature is
-             experimental).
+    put(x, stream=0, block=True, timeout=None, sr=None, planar=False) : Copy
+             the frames of x into the ring. If `size` is a list, there is
+             one ring for each size and `stream` is the index of the one
+             to put into. If the ring is full and `block` is True, wait
+             (without holding the GIL) until the audio thread has consumed
+             enough frames or until `timeout` seconds have elapsed.
+             Without a timeout, the wait also ends when the server is not
+             running, nothing would consume the frames. Returns the number
+             of frames written, which is less than the frames of x only if
+             `block` is False, the timeout expired or the server is
+             stopped. If `sr`, the rate of the samples of x, is given and
+             differs from the server rate, the samples are converted
+             first, the number of frames returned is then at the server
+             rate and the converted frames that do not fit in the ring are
+             lost. If `planar` is True, x holds one row per channel.
+    write(x, stream=0, block=True, timeout=None, sr=None, planar=False) : Copy
+             a batch of arrays into the ring, in order, with a single call.
+             `x` is either a list of arrays, each laid out as for put(), or
+             a single array of interleaved frames, written row after row.
+             `stream`, `block`, `timeout`, `sr` and `planar` are the same
+             as for put(), the timeout applies to the whole batch. Returns
+             the total number of frames written.
+    getFillLevel(stream=0) : Returns the number of frames waiting in the
+             `stream`-th ring.
+    getCapacity(stream=0) : Returns the size of the `stream`-th ring, in
+             frames.
+
+    A producer can batch its chunks and pace itself on the fill level
+    instead of sleeping: with a blocking put() or write(), it runs ahead
+    of the audio thread by at most the size of the ring, and it may
+    compute a new batch only when getFillLevel() is lower than the
+    latency it wants to keep.
 
     Examples:
 
@@ -72,27 +107,45 @@ class FIFOPlayer(PyoObject):
     >>> producer.start()
     >>>
     >>> s.gui(locals())
-    >>> # Remember, the producer may be blocked at fifo.put, because the queue is full,
-    >>> # so we set the stopevent and additionally, we have to remove one item from
-    >>> # the queue, so that the last fifo.put() call returns.
+    >>> # The producer may be blocked at fifo.put while the ring is full, it
+    >>> # returns as soon as the server consumes the samples.
     >>> stopevent.set()
-    >>> fifo._base_objs[0]._queue.get_nowait()
     >>>
 
 
     """
     # Do not forget "mul" and "add" attributes.
-    def __init__(self, maxsize=100, mul=1, add=0, always_memcpy=True):
+    def __init__(self, size=32768, chnls=1, mul=1, add=0):
         PyoObject.__init__(self)
+        self._size = size
+        self._chnls = chnls
         self._mul = mul
         self._add = add
         # Converts every arguments to lists (for multi-channel expansion).
-        mul, add, always_memcpy, lmax = convertArgsToLists(mul, add, always_memcpy)
-        # self._base_objs contains the list of XXX_base objects. Use "wrap" function to prevent "out of range" errors.
-        self._base_objs = [FIFOPlayer_base(wrap(mul,i), wrap(add,i), wrap(always_memcpy,i)) for i in range(lmax)]
-        for bo in self._base_objs:
-            # One queue for each channel
-            bo._queue = Queue.Queue(maxsize=maxsize)
-
-    def put(self, x, stream=0,  block=True, timeout=None):
-        self._base_objs[stream].put(x)
+        size, mul, add, lmax = convertArgsToLists(size, mul, add)
+        # One ring for each size, read by one FIFOPlay_base object per channel.
+        self._base_players = [FIFOPlayer_base(wrap(size,i), chnls) for i in range(lmax)]
+        self._base_objs = []
+        for i in range(lmax):
+            for j in range(chnls):
+                self._base_objs.append(FIFOPlay_base(self._base_players[i], j, wrap(mul,i), wrap(add,i)))
+
+    def put(self, x, stream=0, block=True, timeout=None, sr=None, planar=False):
+        if timeout is None:
+            timeout = -1
+        if sr is None:
+            sr = 0
+        return self._base_players[stream].put(x, block, timeout, sr, planar)
+
+    def write(self, x, stream=0, block=True, timeout=None, sr=None, planar=False):
+        if timeout is None:
+            timeout = -1
+        if sr is None:
+            sr = 0
+        return self._base_players[stream].write(x, block, timeout, sr, planar)
+
+    def getFillLevel(self, stream=0):
+        return self._base_players[stream].getFillLevel()
+
+    def getCapacity(self, stream=0):
+        return self._base_players[stream].getCapacity()
@@ -145,6 +145,26 @@ class Biquad(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setType(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCtlPeriod(self, x):
+        """
+        Sets how often, in samples, the filter coefficients are computed.
+
+        When freq or q are audio signals, the coefficients are normally
+        computed at every sample. With a period of `x` samples, they are
+        computed once per period, from the parameter values at the end of
+        the period, and linearly interpolated in between. This is a lot
+        cheaper for slowly moving parameters. 0 (the default) computes
+        them at every sample.
+
+        :Args:
+
+            x : int
+                Period in samples, 0 to compute at every sample.
+
+        """
+        pyoArgsAssert(self, "I", x)
+        [obj.setCtlPeriod(x) for obj in self._base_objs]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapQ(self._q),
                           SLMap(0, 4, 'lin', 'type', self._type, res="int", dataOnly=True),
@@ -309,6 +329,26 @@ class Biquadx(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setStages(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCtlPeriod(self, x):
+        """
+        Sets how often, in samples, the filter coefficients are computed.
+
+        When freq or q are audio signals, the coefficients are normally
+        computed at every sample. With a period of `x` samples, they are
+        computed once per period, from the parameter values at the end of
+        the period, and linearly interpolated in between. This is a lot
+        cheaper for slowly moving parameters. 0 (the default) computes
+        them at every sample.
+
+        :Args:
+
+            x : int
+                Period in samples, 0 to compute at every sample.
+
+        """
+        pyoArgsAssert(self, "I", x)
+        [obj.setCtlPeriod(x) for obj in self._base_objs]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapQ(self._q),
                           SLMap(0, 4, 'lin', 'type', self._type, res="int", dataOnly=True),
@@ -350,6 +390,196 @@ class Biquadx(PyoObject):
     @stages.setter
     def stages(self, x): self.setStages(x)
 
+BIQUADBANK_KERNELS = {"auto": 0, "scalar": 1, "vector": 2, "avx": 3}
+
+class BiquadBank(PyoObject):
+    """
+    A bank of biquadratic filters processed in parallel.
+
+    BiquadBank computes many independent Biquad filters in a single
+    object. The filters are processed eight at a time in the vector
+    registers of the cpu, which makes each filter of a large bank several
+    times cheaper than a Biquad object. Every filter has its own input,
+    frequency, Q and type, and its own output stream.
+
+    The number of filters is the length of the longest of `input`, `freq`,
+    `q` and `type`, the shorter ones are wrapped around.
+
+    :Parent: :py:class:`PyoObject`
+
+    :Args:
+
+        input : PyoObject
+            Input signal to process. Filter i processes the stream i of
+            the input.
+        freq : float, PyoObject or list, optional
+            Cutoff or center frequency of each filter. Defaults to 1000.
+        q : float, PyoObject or list, optional
+            Q of each filter, defined (for bandpass filters) as freq/bandwidth.
+            Should be between 1 and 500. Defaults to 1.
+        type : int or list of int, optional
+            Type of each filter. Five possible values :
+                0. lowpass (default)
+                1. highpass
+                2. bandpass
+                3. bandstop
+                4. allpass
+        kernel : string, optional
+            Computation kernel, one of "auto", "scalar", "vector" or "avx".
+            "auto" selects the fastest kernel supported by the cpu. All the
+            kernels give the same output. Defaults to "auto".
+
+    .. note::
+
+        `freq` and `q` are read once per buffer, at its last sample, and
+        the coefficients are linearly interpolated over the buffer. A
+        modulation faster than the buffer size is smoothed out.
+
+    >>> s = Server().boot()
+    >>> s.start()
+    >>> a = Noise(.1)
+    >>> lfos = Sine(freq=[.1 * i + .1 for i in range(32)], mul=.2, add=1)
+    >>> freqs = [100 * (i + 1) * lfos[i] for i in range(32)]
+    >>> f = BiquadBank(a, freq=freqs, q=20, type=2).mix(2).out()
+
+    """
+    def __init__(self, input, freq=1000, q=1, type=0, kernel="auto", mul=1, add=0):
+        pyoArgsAssert(self, "oOOiSOO", input, freq, q, type, kernel, mul, add)
+        PyoObject.__init__(self, mul, add)
+        self._input = input
+        self._freq = freq
+        self._q = q
+        self._type = type
+        self._in_fader = InputFader(input)
+        in_fader, freq, q, type, lmax = convertArgsToLists(self._in_fader, freq, q, type)
+        self._num = lmax
+        mul, add, lmax2 = convertArgsToLists(mul, add)
+        self._base_players = [BiquadBankMain_base([wrap(in_fader,i) for i in range(lmax)], [wrap(freq,i) for i in range(lmax)],
+                                                  [wrap(q,i) for i in range(lmax)], [wrap(type,i) for i in range(lmax)])]
+        self._base_objs = [BiquadBank_base(self._base_players[0], i, wrap(mul,i), wrap(add,i)) for i in range(lmax)]
+        self.setKernel(kernel)
+
+    def setInput(self, x, fadetime=0.05):
+        """
+        Replace the `input` attribute.
+
+        :Args:
+
+            x : PyoObject
+                New signal to process.
+            fadetime : float, optional
+                Crossfade time between old and new input. Defaults to 0.05.
+
+        """
+        pyoArgsAssert(self, "oN", x, fadetime)
+        self._input = x
+        self._in_fader.setInput(x, fadetime)
+
+    def setFreq(self, x):
+        """
+        Replace the `freq` attribute.
+
+        :Args:
+
+            x : float, PyoObject or list
+                New `freq` attribute.
+
+        """
+        pyoArgsAssert(self, "O", x)
+        self._freq = x
+        x, lmax = convertArgsToLists(x)
+        self._base_players[0].setFreq([wrap(x,i) for i in range(self._num)])
+
+    def setQ(self, x):
+        """
+        Replace the `q` attribute. Should be between 1 and 500.
+
+        :Args:
+
+            x : float, PyoObject or list
+                New `q` attribute.
+
+        """
+        pyoArgsAssert(self, "O", x)
+        self._q = x
+        x, lmax = convertArgsToLists(x)
+        self._base_players[0].setQ([wrap(x,i) for i in range(self._num)])
+
+    def setType(self, x):
+        """
+        Replace the `type` attribute.
+
+        :Args:
+
+            x : int or list of int
+                New `type` attribute.
+                    0. lowpass
+                    1. highpass
+                    2. bandpass
+                    3. bandstop
+                    4. allpass
+
+        """
+        pyoArgsAssert(self, "i", x)
+        self._type = x
+        x, lmax = convertArgsToLists(x)
+        self._base_players[0].setType([wrap(x,i) for i in range(self._num)])
+
+    def setKernel(self, x):
+        """
+        Replace the computation kernel.
+
+        Raises a ValueError if the kernel is not supported by the cpu.
+
+        :Args:
+
+            x : string
+                "auto", "scalar", "vector" or "avx".
+
+        """
+        if x not in BIQUADBANK_KERNELS:
+            raise ValueError("BiquadBank: unknown kernel '%s'." % x)
+        self._base_players[0].setKernel(BIQUADBANK_KERNELS[x])
+
+    def getKernel(self):
+        """
+        Return the name of the kernel in use ("scalar", "vector" or "avx").
+
+        """
+        return self._base_players[0].getKernel()
+
+    def ctrl(self, map_list=None, title=None, wxnoserver=False):
+        self._map_list = [SLMapMul(self._mul)]
+        PyoObject.ctrl(self, map_list, title, wxnoserver)
+
+    @property
+    def input(self):
+        """PyoObject. Input signal to process."""
+        return self._input
+    @input.setter
+    def input(self, x): self.setInput(x)
+
+    @property
+    def freq(self):
+        """float, PyoObject or list. Cutoff or center frequencies of the filters."""
+        return self._freq
+    @freq.setter
+    def freq(self, x): self.setFreq(x)
+
+    @property
+    def q(self):
+        """float, PyoObject or list. Q of the filters."""
+        return self._q
+    @q.setter
+    def q(self, x): self.setQ(x)
+
+    @property
+    def type(self):
+        """int or list of int. Filter types."""
+        return self._type
+    @type.setter
+    def type(self, x): self.setType(x)
+
 class Biquada(PyoObject):
     """
     A general purpose biquadratic digital filter (floating-point arguments).
@@ -710,6 +940,26 @@ class EQ(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setType(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCtlPeriod(self, x):
+        """
+        Sets how often, in samples, the filter coefficients are computed.
+
+        When freq or q are audio signals, the coefficients are normally
+        computed at every sample. With a period of `x` samples, they are
+        computed once per period, from the parameter values at the end of
+        the period, and linearly interpolated in between. This is a lot
+        cheaper for slowly moving parameters. 0 (the default) computes
+        them at every sample.
+
+        :Args:
+
+            x : int
+                Period in samples, 0 to compute at every sample.
+
+        """
+        pyoArgsAssert(self, "I", x)
+        [obj.setCtlPeriod(x) for obj in self._base_objs]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapQ(self._q),
                           SLMap(-40.0, 40.0, "lin", "boost", self._boost),
@@ -2738,6 +2988,26 @@ class SVF(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setType(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCtlPeriod(self, x):
+        """
+        Sets how often, in samples, the filter coefficients are computed.
+
+        When freq or q are audio signals, the coefficients are normally
+        computed at every sample. With a period of `x` samples, they are
+        computed once per period, from the parameter values at the end of
+        the period, and linearly interpolated in between. This is a lot
+        cheaper for slowly moving parameters. 0 (the default) computes
+        them at every sample.
+
+        :Args:
+
+            x : int
+                Period in samples, 0 to compute at every sample.
+
+        """
+        pyoArgsAssert(self, "I", x)
+        [obj.setCtlPeriod(x) for obj in self._base_objs]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMap(20, 7350, "log", "freq", self._freq),
                           SLMap(0.5, 10, "log", "q", self._q),
@@ -3170,6 +3440,26 @@ class ButLP(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setFreq(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCtlPeriod(self, x):
+        """
+        Sets how often, in samples, the filter coefficients are computed.
+
+        When freq or q are audio signals, the coefficients are normally
+        computed at every sample. With a period of `x` samples, they are
+        computed once per period, from the parameter values at the end of
+        the period, and linearly interpolated in between. This is a lot
+        cheaper for slowly moving parameters. 0 (the default) computes
+        them at every sample.
+
+        :Args:
+
+            x : int
+                Period in samples, 0 to compute at every sample.
+
+        """
+        pyoArgsAssert(self, "I", x)
+        [obj.setCtlPeriod(x) for obj in self._base_objs]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapMul(self._mul)]
         PyoObject.ctrl(self, map_list, title, wxnoserver)
@@ -3252,6 +3542,26 @@ class ButHP(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setFreq(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCtlPeriod(self, x):
+        """
+        Sets how often, in samples, the filter coefficients are computed.
+
+        When freq or q are audio signals, the coefficients are normally
+        computed at every sample. With a period of `x` samples, they are
+        computed once per period, from the parameter values at the end of
+        the period, and linearly interpolated in between. This is a lot
+        cheaper for slowly moving parameters. 0 (the default) computes
+        them at every sample.
+
+        :Args:
+
+            x : int
+                Period in samples, 0 to compute at every sample.
+
+        """
+        pyoArgsAssert(self, "I", x)
+        [obj.setCtlPeriod(x) for obj in self._base_objs]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapMul(self._mul)]
         PyoObject.ctrl(self, map_list, title, wxnoserver)
@@ -3353,6 +3663,26 @@ class ButBP(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setQ(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCtlPeriod(self, x):
+        """
+        Sets how often, in samples, the filter coefficients are computed.
+
+        When freq or q are audio signals, the coefficients are normally
+        computed at every sample. With a period of `x` samples, they are
+        computed once per period, from the parameter values at the end of
+        the period, and linearly interpolated in between. This is a lot
+        cheaper for slowly moving parameters. 0 (the default) computes
+        them at every sample.
+
+        :Args:
+
+            x : int
+                Period in samples, 0 to compute at every sample.
+
+        """
+        pyoArgsAssert(self, "I", x)
+        [obj.setCtlPeriod(x) for obj in self._base_objs]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq),
                           SLMap(1, 100, "log", "q", self._q), SLMapMul(self._mul)]
@@ -3462,6 +3792,26 @@ class ButBR(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setQ(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
 
+    def setCtlPeriod(self, x):
+        """
+        Sets how often, in samples, the filter coefficients are computed.
+
+        When freq or q are audio signals, the coefficients are normally
+        computed at every sample. With a period of `x` samples, they are
+        computed once per period, from the parameter values at the end of
+        the period, and linearly interpolated in between. This is a lot
+        cheaper for slowly moving parameters. 0 (the default) computes
+        them at every sample.
+
+        :Args:
+
+            x : int
+                Period in samples, 0 to compute at every sample.
+
+        """
+        pyoArgsAssert(self, "I", x)
+        [obj.setCtlPeriod(x) for obj in self._base_objs]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq),
                           SLMap(1, 100, "log", "q", self._q), SLMapMul(self._mul)]
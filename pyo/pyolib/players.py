@@ -85,6 +85,10 @@ class SfPlayer(PyoObject):
         >>> sf = SfPlayer("/stereo/sound/file.aif").out()
         >>> trig = TrigFunc(sf['trig'][0], printing)
 
+        The sound is read from the disk by a background thread, ahead of
+        the playback position. With an offline server, the reads are done
+        in the processing loop, no sample is ever missed.
+
     >>> s = Server().boot()
     >>> s.start()
     >>> snd = SNDS_PATH + "/transparent.aif"
@@ -0,0 +1,603 @@
+"""
+Particle Trajectory Sonification (PTSM).
+
+A particle moves in the potential field built by placing a gaussian well
+on every point of a dataset. The squared norm of its velocity, computed at
+every integration step, is the audio signal.
+
+"""
+
+"""
+Copyright 2009-2015 Olivier Belanger
+
+This file is part of pyo, a python module to help digital signal
+processing script creation.
+
+pyo is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3 of the
+License, or (at your option) any later version.
+
+pyo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with pyo.  If not, see <http://www.gnu.org/licenses/>.
+"""
+from _core import *
+from _maps import *
+
+class ParticleTrajectory(PyoObject):
+    """
+    Particle trajectory sonification of a dataset.
+
+    The object owns a copy of the dataset and the position and velocity of
+    a particle. On every sample, the particle is attracted by a gaussian
+    potential centered on each data point (width `sigma`), its velocity is
+    damped by `r` and the squared norm of the velocity is written to the
+    output. The integration runs inside the audio callback, so there is no
+    need for a producer thread feeding a FIFOPlayer.
+
+    :Parent: :py:class:`PyoObject`
+
+    :Args:
+
+        data : numpy.array or list of lists
+            Dataset, one row per point (N x dim). float32 and float64 arrays
+            are accepted, the object keeps a double precision copy.
+        sigma : float or PyoObject, optional
+            Width of the gaussian potential around each data point.
+            Defaults to 0.25.
+        mass : float, optional
+            Mass of the particle. Defaults to 1.
+        r : float or PyoObject, optional
+            Velocity damping factor, 1 means no damping. The smaller, the
+            shorter the sound. Defaults to 0.99.
+        dt : float, optional
+            Integration time step. Defaults to 0.01.
+
+    .. note::
+
+        The cost of one sample is proportional to the number of points times
+        the number of dimensions of the dataset.
+
+    >>> s = Server(sr=11025, nchnls=1).boot()
+    >>> s.start()
+    >>> import numpy as np
+    >>> data = np.random.normal(size=(400, 6))
+    >>> a = ParticleTrajectory(data, sigma=0.6*data.std(), r=0.999, dt=0.1, mul=0.2)
+    >>> a.setPosition(data[0])
+    >>> a.setVelocity(np.random.rand(6) * 0.03)
+    >>> b = Biquad(a, freq=5000, q=1, type=0).out()
+
+    """
+    def __init__(self, data, sigma=0.25, mass=1, r=0.99, dt=0.01, mul=1, add=0):
+        pyoArgsAssert(self, "zOnOnOO", data, sigma, mass, r, dt, mul, add)
+        PyoObject.__init__(self, mul, add)
+        self._sigma = sigma
+        self._mass = mass
+        self._r = r
+        self._dt = dt
+        sigma, mass, r, dt, mul, add, lmax = convertArgsToLists(sigma, mass, r, dt, mul, add)
+        self._base_objs = [ParticleTrajectory_base(data, wrap(sigma,i), wrap(mass,i), wrap(r,i), wrap(dt,i),
+                                                   wrap(mul,i), wrap(add,i)) for i in range(lmax)]
+
+    def setData(self, x):
+        """
+        Replace the dataset.
+
+        If the number of dimensions changes, the particle is reset at the
+        origin, at rest.
+
+        :Args:
+
+            x : numpy.array or list of lists
+                New dataset, one row per point.
+
+        """
+        [obj.setData(x) for obj in self._base_objs]
+
+    def setPosition(self, x):
+        """
+        Move the particle.
+
+        :Args:
+
+            x : numpy.array or list
+                New position, one value per dimension of the dataset.
+
+        """
+        [obj.setPosition(x) for obj in self._base_objs]
+
+    def setVelocity(self, x):
+        """
+        Replace the velocity of the particle.
+
+        :Args:
+
+            x : numpy.array or list
+                New velocity, one value per dimension of the dataset.
+
+        """
+        [obj.setVelocity(x) for obj in self._base_objs]
+
+    def getPosition(self, all=False):
+        """
+        Return the current position of the particle.
+
+        :Args:
+
+            all : boolean, optional
+                If True, the positions of all streams are returned in a list.
+                Otherwise, only the first one is returned. Defaults to False.
+
+        """
+        if all:
+            return [obj.getPosition() for obj in self._base_objs]
+        return self._base_objs[0].getPosition()
+
+    def getVelocity(self, all=False):
+        """
+        Return the current velocity of the particle.
+
+        :Args:
+
+            all : boolean, optional
+                If True, the velocities of all streams are returned in a list.
+                Otherwise, only the first one is returned. Defaults to False.
+
+        """
+        if all:
+            return [obj.getVelocity() for obj in self._base_objs]
+        return self._base_objs[0].getVelocity()
+
+    def setSigma(self, x):
+        """
+        Replace the `sigma` attribute.
+
+        :Args:
+
+            x : float or PyoObject
+                new `sigma` attribute.
+
+        """
+        pyoArgsAssert(self, "O", x)
+        self._sigma = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setSigma(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
+
+    def setMass(self, x):
+        """
+        Replace the `mass` attribute.
+
+        :Args:
+
+            x : float
+                new `mass` attribute.
+
+        """
+        pyoArgsAssert(self, "n", x)
+        self._mass = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setMass(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
+
+    def setR(self, x):
+        """
+        Replace the `r` attribute.
+
+        :Args:
+
+            x : float or PyoObject
+                new `r` attribute.
+
+        """
+        pyoArgsAssert(self, "O", x)
+        self._r = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setR(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
+
+    def setDt(self, x):
+        """
+        Replace the `dt` attribute.
+
+        :Args:
+
+            x : float
+                new `dt` attribute.
+
+        """
+        pyoArgsAssert(self, "n", x)
+        self._dt = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setDt(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
+
+    def ctrl(self, map_list=None, title=None, wxnoserver=False):
+        self._map_list = [SLMap(0.001, 10., "log", "sigma", self._sigma),
+                          SLMap(0.9, 1., "lin", "r", self._r),
+                          SLMap(0.001, 1., "log", "dt", self._dt, dataOnly=True),
+                          SLMapMul(self._mul)]
+        PyoObject.ctrl(self, map_list, title, wxnoserver)
+
+    @property
+    def sigma(self):
+        """float or PyoObject. Width of the gaussian potential."""
+        return self._sigma
+    @sigma.setter
+    def sigma(self, x): self.setSigma(x)
+
+    @property
+    def mass(self):
+        """float. Mass of the particle."""
+        return self._mass
+    @mass.setter
+    def mass(self, x): self.setMass(x)
+
+    @property
+    def r(self):
+        """float or PyoObject. Velocity damping factor."""
+        return self._r
+    @r.setter
+    def r(self, x): self.setR(x)
+
+    @property
+    def dt(self):
+        """float. Integration time step."""
+        return self._dt
+    @dt.setter
+    def dt(self, x): self.setDt(x)
+
+PTSM_KERNELS = {"auto": 0, "scalar": 1, "avx2": 2, "avx512": 3}
+
+class PTSMData(object):
+    """
+    Dataset prepared for offline particle trajectory computations.
+
+    The data is copied once in a structure-of-arrays layout (one contiguous
+    row per dimension) on which the force and potential kernels operate.
+    Creating a PTSMData and reusing it avoids copying the dataset on every
+    call to :py:func:`PTSM` or :py:func:`potential`.
+
+    :Args:
+
+        data : numpy.array or list of lists
+            Dataset, one row per point (N x dim).
+        kernel : string, optional
+            Computation kernel, one of "auto", "scalar", "avx2" or "avx512".
+            "auto" selects the fastest kernel supported by the cpu. The SIMD
+            kernels use an exp approximation accurate to a few ulps.
+            Defaults to "auto".
+        cutoff : float, optional
+            Search radius, in multiples of sigma. When greater than 0, a
+            k-d tree is built over the dataset and the points farther than
+            `cutoff * sigma` from the particle are ignored. The tree is
+            built once and stays valid when sigma changes. 0 means that all
+            the points are used (exact computation). Defaults to 0.
+
+    .. note::
+
+        Error bound of the cutoff (k = cutoff, M = number of points farther
+        than k * sigma, at most the size of the dataset):
+
+        - potential: |error| <= M * exp(-k^2 / 2).
+        - force, for k >= 0.71: |error| <= M * k * exp(-k^2) / sigma on each
+          dimension, the velocity error per step is this bound times
+          dt * sigma^2 / mass.
+
+        With k = 4, the force error is below 5e-7 * M / sigma, and k = 9
+        keeps the potential error below 3e-18 * M. The speedup depends on
+        how clustered the data is. The pruning gets less effective as the
+        number of dimensions grows.
+
+    >>> import numpy as np
+    >>> data = PTSMData(np.random.normal(size=(100000, 16)))
+    >>> trj, sig, lastpos, lastvel = PTSM(data, np.zeros(16), np.random.rand(16)*0.03, 1.2, 1, 0.999, 0.1, 1024)
+
+    """
+    def __init__(self, data, kernel="auto", cutoff=0):
+        self._data = data
+        self._base = PTSMData_base(data, cutoff)
+        self.setKernel(kernel)
+
+    def setData(self, x):
+        """
+        Replace the dataset.
+
+        :Args:
+
+            x : numpy.array or list of lists
+                New dataset, one row per point.
+
+        """
+        self._base.setData(x)
+        self._data = x
+
+    def setKernel(self, x):
+        """
+        Replace the computation kernel.
+
+        Raises a ValueError if the kernel is not supported by the cpu.
+
+        :Args:
+
+            x : string
+                "auto", "scalar", "avx2" or "avx512".
+
+        """
+        if x not in PTSM_KERNELS:
+            raise ValueError("PTSMData: unknown kernel '%s'." % x)
+        self._base.setKernel(PTSM_KERNELS[x])
+
+    def setCutoff(self, x):
+        """
+        Replace the search radius, in multiples of sigma.
+
+        :Args:
+
+            x : float
+                New search radius, 0 disables the spatial index.
+
+        """
+        self._base.setCutoff(x)
+
+    def getCutoff(self):
+        """
+        Return the search radius, in multiples of sigma.
+
+        """
+        return self._base.getCutoff()
+
+    def getKernel(self):
+        """
+        Return the name of the kernel in use ("scalar", "avx2" or "avx512").
+
+        """
+        return self._base.getKernel()
+
+    def getSize(self):
+        """
+        Return the number of points of the dataset.
+
+        """
+        return self._base.getSize()
+
+    def getDim(self):
+        """
+        Return the number of dimensions of the dataset.
+
+        """
+        return self._base.getDim()
+
+    def findModes(self, sigma, seeds=None, mass=1, dt=0.1, tol=1e-5, maxIter=10000, merge=0.1, threads=0):
+        """
+        Compute the modes (local minima of the potential) of the dataset.
+
+        A particle without inertia (r = 0) descends the potential from
+        every seed until the norm of its velocity falls below `tol`. The
+        seeds are shared between `threads` threads, the GIL is released
+        during the computation. Returns a :py:class:`PTSMModeTable`.
+
+        Requires numpy.
+
+        :Args:
+
+            sigma : float
+                Width of the gaussian potential.
+            seeds : None, int or numpy.array, optional
+                Starting positions. None uses every point of the dataset,
+                an integer draws that many points at random, an array
+                gives the positions (seeds x dim). Defaults to None.
+            mass : float, optional
+                Mass of the particle. Defaults to 1.
+            dt : float, optional
+                Integration time step. Defaults to 0.1.
+            tol : float, optional
+                Convergence threshold on the velocity norm. Defaults to 1e-5.
+            maxIter : int, optional
+                Maximum number of steps per seed, seeds that did not
+                converge are not assigned to any mode. Defaults to 10000.
+            merge : float, optional
+                Converged positions closer than `merge * sigma` belong to
+                the same mode. Defaults to 0.1.
+            threads : int, optional
+                Number of threads, 0 means one per cpu core. Defaults to 0.
+
+        """
+        import numpy as np
+        data = np.asarray(self._data, dtype=np.float64)
+        if seeds is None:
+            seeds = data
+        elif type(seeds) in [IntType, LongType]:
+            seeds = data[np.random.choice(len(data), min(seeds, len(data)), replace=False)]
+        seeds = np.ascontiguousarray(seeds, dtype=np.float64)
+        if threads <= 0:
+            import multiprocessing
+            threads = multiprocessing.cpu_count()
+        modes, depths, basins = self._base.findModes(seeds, sigma, mass, dt, tol, maxIter, merge, threads)
+        return PTSMModeTable(np.array(modes, dtype=np.float64).reshape(-1, data.shape[1]),
+                             np.array(depths), seeds, np.array(basins), sigma)
+
+class PTSMModeTable(object):
+    """
+    Modes of a dataset, as computed by :py:meth:`PTSMData.findModes`.
+
+    Holds the mode positions, their depth (potential energy) and the mode
+    reached from every seed, so that finding the mode under the mouse is a
+    nearest neighbour lookup instead of a gradient descent.
+
+    :Attributes:
+
+        modes : numpy.array
+            Mode positions (modes x dim).
+        depths : numpy.array
+            Potential energy at each mode, the lower the deeper.
+        seeds : numpy.array
+            Starting positions (seeds x dim).
+        basins : numpy.array
+            Index of the mode reached from each seed, -1 if the descent
+            did not converge.
+        sigma : float
+            Width of the gaussian potential used for the computation.
+
+    """
+    def __init__(self, modes, depths, seeds, basins, sigma):
+        self.modes = modes
+        self.depths = depths
+        self.seeds = seeds
+        self.basins = basins
+        self.sigma = sigma
+
+    def __len__(self):
+        return len(self.modes)
+
+    def lookup(self, pos, dims=None):
+        """
+        Return the index of the mode reached from the seed nearest to `pos`,
+        -1 if that seed did not converge.
+
+        :Args:
+
+            pos : numpy.array or list
+                Position to look up.
+            dims : list of int, optional
+                If given, the distance is computed only on these dimensions
+                and `pos` holds one value per listed dimension, for example
+                the two axes of a scatter plot. Defaults to None.
+
+        """
+        import numpy as np
+        seeds = self.seeds if dims is None else self.seeds[:, dims]
+        dist = np.sum((seeds - np.asarray(pos, dtype=np.float64)) ** 2, axis=1)
+        return int(self.basins[np.argmin(dist)])
+
+    def getMode(self, index):
+        """
+        Return the tuple (position, depth) of a mode.
+
+        :Args:
+
+            index : int
+                Index of the mode.
+
+        """
+        return self.modes[index], self.depths[index]
+
+def potential(data, pos, sigma=0.2):
+    """
+    Potential energy of a particle at a given position.
+
+    The potential is the sum of -exp(-|x - pos|^2 / (2 * sigma^2)) over all
+    the data points x.
+
+    :Args:
+
+        data : PTSMData, numpy.array or list of lists
+            Dataset, one row per point.
+        pos : numpy.array or list
+            Position of the particle.
+        sigma : float, optional
+            Width of the gaussian potential. Defaults to 0.2.
+
+    """
+    if not isinstance(data, PTSMData):
+        data = PTSMData(data)
+    return data._base.potential(pos, sigma)
+
+def PTSM(data, initialpos, initialvel, sigma=0.25, mass=1, r=0.99, dt=0.01, nrSteps=1000):
+    """
+    Particle trajectory, computed offline.
+
+    Integrates `nrSteps` steps of the movement of a particle in the potential
+    field of the dataset and returns the tuple (trj, sig, lastpos, lastvel),
+    numpy arrays holding respectively the position at every step
+    (nrSteps x dim), the squared norm of the velocity at every step (the
+    audio signal), the last position and the last velocity.
+
+    Requires numpy.
+
+    :Args:
+
+        data : PTSMData, numpy.array or list of lists
+            Dataset, one row per point.
+        initialpos : numpy.array or list
+            Initial position of the particle.
+        initialvel : numpy.array or list
+            Initial velocity of the particle.
+        sigma : float, optional
+            Width of the gaussian potential. Defaults to 0.25.
+        mass : float, optional
+            Mass of the particle. Defaults to 1.
+        r : float, optional
+            Velocity damping factor. Defaults to 0.99.
+        dt : float, optional
+            Integration time step. Defaults to 0.01.
+        nrSteps : int, optional
+            Number of integration steps. Defaults to 1000.
+
+    """
+    import numpy as np
+    if not isinstance(data, PTSMData):
+        data = PTSMData(data)
+    lastpos = np.array(initialpos, dtype=np.float64)
+    lastvel = np.array(initialvel, dtype=np.float64)
+    trj = np.zeros((nrSteps, data.getDim()), dtype=np.float64)
+    sig = np.zeros(nrSteps, dtype=np.float64)
+    data._base.integrate(lastpos, lastvel, sig, trj, sigma, mass, r, dt)
+    return trj, sig, lastpos, lastvel
+
+def PTSMBatch(data, initialpos, initialvel, sigma=0.25, mass=1, r=0.99, dt=0.01, nrSteps=1000, tol=0):
+    """
+    Trajectories of many particles, computed offline in a single pass.
+
+    Advances all the particles at once: on every step, each block of the
+    dataset is loaded once and applied to all the particles still moving,
+    instead of streaming the whole dataset once per particle. This is much
+    faster than calling :py:func:`PTSM` in a loop to find modes from many
+    seeds, to calibrate amplitudes or to explore with several voices.
+
+    Returns the tuple (sig, lastpos, lastvel, steps), numpy arrays holding
+    respectively the squared norm of the velocity of each particle at
+    every step (particles x nrSteps), the last positions, the last
+    velocities (particles x dim) and the number of steps computed for each
+    particle.
+
+    Requires numpy.
+
+    :Args:
+
+        data : PTSMData, numpy.array or list of lists
+            Dataset, one row per point.
+        initialpos : numpy.array or list of lists
+            Initial positions, one row per particle.
+        initialvel : numpy.array or list of lists
+            Initial velocities, one row per particle.
+        sigma : float, optional
+            Width of the gaussian potential. Defaults to 0.25.
+        mass : float, optional
+            Mass of the particles. Defaults to 1.
+        r : float, optional
+            Velocity damping factor. Defaults to 0.99.
+        dt : float, optional
+            Integration time step. Defaults to 0.01.
+        nrSteps : int, optional
+            Maximum number of integration steps. Defaults to 1000.
+        tol : float, optional
+            Convergence threshold. When greater than 0, a particle stops
+            moving as soon as the norm of its velocity falls below `tol`,
+            its remaining `sig` values are 0. Defaults to 0.
+
+    >>> import numpy as np
+    >>> data = PTSMData(np.random.normal(size=(10000, 8)))
+    >>> seeds = np.random.normal(size=(64, 8))
+    >>> sig, modes, vel, steps = PTSMBatch(data, seeds, np.zeros((64, 8)), 0.5, 1, 0, 0.1, 10000, 1e-5)
+
+    """
+    import numpy as np
+    if not isinstance(data, PTSMData):
+        data = PTSMData(data)
+    lastpos = np.array(initialpos, dtype=np.float64, ndmin=2)
+    lastvel = np.array(initialvel, dtype=np.float64, ndmin=2)
+    sig = np.zeros((lastpos.shape[0], nrSteps), dtype=np.float64)
+    steps = data._base.integrateBatch(lastpos, lastvel, sig, sigma, mass, r, dt, tol)
+    return sig, lastpos, lastvel, np.array(steps)
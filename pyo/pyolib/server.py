@@ -444,6 +444,137 @@ class Server(object):
         self._verbosity = x
         self._server.setVerbosity(x)
 
+    def setGILFree(self, x):
+        """
+        Run the audio callback without holding Python's GIL.
+
+        By default, the audio thread holds the GIL while computing the
+        audio streams, so any Python thread doing heavy work can delay
+        the audio callback. When this mode is on, the streams are computed
+        without the GIL and the Python calls requested during processing
+        (Pattern, CallAfter, TrigFunc and VarPort functions, midi scan
+        callbacks, automatic stop of objects, GUI meters and time display)
+        are executed, in order, by a separate message thread, slightly
+        after the buffer that triggered them.
+
+        Mixer, Selector, TableMorph, MatrixMorph, TableWrite, FrameDelta,
+        FrameAccum, Vectral, ControlRec, NoteinRec and the OSC objects
+        still use Python objects in their processing and take the GIL for
+        their own computation.
+
+        Only the real-time audio backends (portaudio, coreaudio and jack)
+        use this mode, it takes effect the next time the server is started.
+        The offline servers of an OfflineBatch always use it.
+
+        :Args:
+
+            x : boolean
+                True to run the audio callback without the GIL.
+
+        """
+        self._server.setGILFree(x)
+
+    def setDSPThreads(self, x):
+        """
+        Set the number of threads computing the audio streams.
+
+        With more than one thread, the server follows the connections
+        between the objects (audio inputs, tables, matrices and phase
+        vocoder streams) and computes the independent chains at the same
+        time. An object always runs after the objects it reads from, so
+        the output is identical to the single thread processing. Objects
+        calling Python (Pattern, TrigFunc, automatic stop, etc.) are
+        computed alone, in their usual place. When the GIL is released
+        (see `setGILFree`), their calls are executed, in the usual order,
+        at the end of the buffer instead.
+
+        The connections are learned while the objects run, a new object
+        is computed alone during its first buffer.
+
+        Takes effect the next time the server is started. Defaults to 1.
+
+        :Args:
+
+            x : int
+                Number of threads, including the audio thread.
+
+        """
+        self._server.setDSPThreads(x)
+
+    def setProfiling(self, x):
+        """
+        Turn on or off the DSP profiling.
+
+        When on, the server measures the time spent in every audio
+        stream and in the whole processing callback. Statistics are
+        cleared each time the profiling is turned on and can be queried
+        with the getProfile() method while the server is running.
+
+        :Args:
+
+            x : boolean
+                True to enable profiling, False to disable it.
+
+        """
+        self._server.setProfiling(x)
+
+    def resetProfile(self):
+        """
+        Clear the DSP profiling statistics.
+
+        """
+        self._server.resetProfile()
+
+    def setTelemetry(self, x):
+        """
+        Turn on or off the callback telemetry.
+
+        When on, every audio callback records its duration, the slack
+        left before the deadline (the duration of one buffer), the time
+        since the previous callback, the time spent waiting for the GIL
+        and the xruns reported by the audio backend. The last 4096
+        records are kept in memory and can be queried with the
+        getTelemetry() method, or streamed to a file with the
+        setTelemetryFile() method. The recording never blocks the audio
+        thread.
+
+        :Args:
+
+            x : boolean
+                True to enable the telemetry, False to disable it.
+
+        """
+        self._server.setTelemetry(x)
+
+    def resetTelemetry(self):
+        """
+        Clear the callback telemetry counters.
+
+        """
+        self._server.resetTelemetry()
+
+    def setTelemetryFile(self, path=None):
+        """
+        Write the callback telemetry records to a text file.
+
+        A background thread appends one comma-separated line per audio
+        callback: index, start, duration, slack, interval, gilwait and
+        flags (1 = overrun, 2 = xrun, 4 = late). Times are in microseconds
+        except the start of the callback, in seconds since the epoch (same
+        clock as time.time()). The telemetry must be turned on with the
+        setTelemetry() method.
+
+        :Args:
+
+            path : string, optional
+                Path of the file, overwritten if it exists. None closes the
+                current file. Defaults to None.
+
+        """
+        if path is not None:
+            path = os.path.expanduser(path)
+        self._server.setTelemetryFile(path)
+
     def setJackAuto(self, xin=True, xout=True):
         """
         Tells the server to auto-connect (or not) Jack ports to System ports.
@@ -618,7 +749,7 @@ class Server(object):
         """
         self._server.stop()
 
-    def recordOptions(self, dur=-1, filename=None, fileformat=0, sampletype=0, quality=0.4):
+    def recordOptions(self, dur=-1, filename=None, fileformat=0, sampletype=0, quality=0.4, queuedur=2.0):
         """
         Sets options for soundfile created by offline rendering or global recording.
 
@@ -659,6 +790,13 @@ class Server(object):
                 The encoding quality value, between 0.0 (lowest quality) and 
                 1.0 (highest quality). This argument has an effect only with
                 FLAC and OGG compressed formats. Defaults to 0.4.
+            queuedur : float, optional
+                Maximum duration, in seconds, of sound waiting to be
+                written to disk. The file is written by a background
+                thread, when the disk falls behind by more than this
+                duration, the buffers that don't fit are dropped (see
+                getRecordOverruns). Offline rendering never drops buffers.
+                Defaults to 2.
 
         """
 
@@ -677,7 +815,45 @@ class Server(object):
             print 'Warning: Filename has no extension. Using fileformat value.'
         self._fileformat = fileformat
         self._sampletype = sampletype
-        self._server.recordOptions(dur, filename, fileformat, sampletype, quality)
+        self._server.recordOptions(dur, filename, fileformat, sampletype, quality, queuedur)
+
+    def setRecordBuffer(self, buffer, callback=None):
+        """
+        Sets a buffer receiving the output of the offline renderings instead of a file.
+
+        The samples are written interleaved, without going through the disk.
+        A float32 array receives them as computed, a float64 array receives
+        them converted.
+
+        For renderings longer than the buffer, `callback` is called, with the
+        number of frames written, each time the buffer is full and at the end
+        of the rendering. The writing starts again at the beginning of the
+        buffer when the callback returns. Without callback, the frames that
+        don't fit in the buffer are discarded, and if the duration is not set
+        (see `recordOptions`), the rendering lasts exactly the buffer.
+
+        The callback is called from the rendering thread, `Server.start` doesn't
+        return before the end of the rendering with the 'offline' audio backend.
+
+        :Args:
+
+            buffer : writable buffer
+                Array (ie. a numpy array) of float32 or float64 of shape
+                (frames, nchnls), or of frames * nchnls items. None goes back
+                to the file set with `recordOptions`.
+            callback : callable, optional
+                Function called with the number of frames written each time
+                the buffer is full. Defaults to None.
+
+        >>> import numpy as np
+        >>> s = Server(audio="offline").boot()
+        >>> out = np.zeros((44100, 2), dtype=np.float32)
+        >>> s.setRecordBuffer(out)
+        >>> a = Sine(freq=[500, 600], mul=.2).out()
+        >>> s.start()
+
+        """
+        self._server.setRecordBuffer(buffer, callback)
 
     def recstart(self, filename=None):
         """
@@ -922,6 +1098,17 @@ class Server(object):
         """
         return self._server.getBufferSize()
 
+    def getElapsedSamples(self):
+        """
+        Return the number of samples computed since the server was booted.
+
+        This is the time base of the events posted with PyoObject.post()
+        and SigQueue.post(). The value is updated at the end of every
+        buffer.
+
+        """
+        return self._server.getElapsedSamples()
+
     def getGlobalSeed(self):
         """
         Return the current global seed.
@@ -971,6 +1158,77 @@ class Server(object):
         """
         return len(self._server.getStreams())
 
+    def getProfile(self):
+        """
+        Returns a snapshot of the DSP profiling statistics.
+
+        The result is a dictionary with the following keys:
+            - enabled : True if profiling is currently on.
+            - deadline : Duration of one buffer, in microseconds.
+            - callback : Processing time of the whole callback.
+            - load : Callback time as a fraction of the deadline,
+              a dictionary with keys "mean", "p99" and "max".
+            - overruns : Number of callbacks that exceeded the deadline.
+            - streams : A list, in processing order, with one entry per
+              profiled stream. Each entry holds the stream "id" and the
+              "object" class name.
+
+        Time statistics are dictionaries with keys "count" (number of
+        callbacks), "min", "mean", "p99" (99th percentile, estimated
+        to a quarter of an octave) and "max", in microseconds.
+
+        """
+        profile = self._server.getProfile()
+        for stream in profile["streams"]:
+            name = stream["object"].split(".")[-1]
+            if name.endswith("_base"):
+                name = name[:-5]
+            stream["object"] = name
+        return profile
+
+    def getTelemetry(self, num=0):
+        """
+        Returns a snapshot of the callback telemetry.
+
+        The result is a dictionary with the following keys:
+            - enabled : True if the telemetry is currently on.
+            - deadline : Duration of one buffer, in microseconds.
+            - callbacks : Number of recorded callbacks.
+            - overruns : Number of callbacks that exceeded the deadline.
+            - xruns : Number of xruns reported by the audio backend.
+            - late : Number of callbacks that started more than one
+              buffer late.
+            - max : Longest callback, in microseconds.
+            - minslack : Smallest time left before the deadline, in
+              microseconds (negative after an overrun).
+            - gilwait : Total time spent waiting for the GIL, in
+              microseconds.
+            - filelost : Number of records overwritten before the file
+              writer could save them.
+            - records : The last `num` records, oldest first.
+
+        Each record is a dictionary with keys "index" (callback number),
+        "start" (seconds since the epoch, comparable with time.time()),
+        "duration", "slack", "interval" (since the previous callback),
+        "gilwait" (in microseconds) and the booleans "overrun", "xrun"
+        and "late".
+
+        :Args:
+
+            num : int, optional
+                Number of records to return, at most 4096. Defaults to 0.
+
+        """
+        return self._server.getTelemetry(num)
+
+    def getRecordOverruns(self):
+        """
+        Returns the number of buffers dropped by the current, or the last,
+        recording because the disk was too slow.
+
+        """
+        return self._server.getRecordOverruns()
+
     def setServer(self):
         """
         Sets this server as the one to use for new objects when using the embedded device
@@ -1048,3 +1306,192 @@ class Server(object):
             self.setGlobalSeed(x)
         else:
             raise Exception("global seed must be an integer")
+
+######################################################################
+### Concurrent offline rendering
+######################################################################
+class OfflineBatch(object):
+    """
+    Renders many independent processing chains concurrently.
+
+    Every job added to the batch is built on an offline Server of its
+    own. The jobs are built one after the other, in the order they were
+    added, then rendered as fast as possible by a pool of threads, each
+    thread rendering a whole job before taking the next one.
+
+    The servers of a batch compute their streams without holding
+    Python's GIL (see `Server.setGILFree`). The Python calls requested
+    during processing (Pattern, TrigFunc, automatic stop, etc.) are made
+    by the rendering thread, right after the buffer that requested them.
+    Each server draws its random numbers from its own generator, so the
+    output of a job with a `seed` doesn't depend on the other jobs or on
+    the number of threads.
+
+    The jobs must not share objects (tables, matrices, etc.). The servers
+    are reused from one group of jobs to the next and kept until the batch
+    is deleted, the objects created by the jobs must not outlive it.
+
+    :Args:
+
+        sr : int, optional
+            Sampling rate of the servers. Defaults to 44100.
+        nchnls : int, optional
+            Number of output channels of the servers. Defaults to 2.
+        buffersize : int, optional
+            Buffer size of the servers. Defaults to 256.
+        threads : int, optional
+            Number of rendering threads. 0 means one thread per cpu core.
+            Defaults to 0.
+        maxservers : int, optional
+            Maximum number of servers, hence of jobs built and held in
+            memory at the same time. The jobs are rendered by groups of
+            this size. pyo can hold at most 256 servers at the same time.
+            Defaults to 64.
+
+    >>> def note(freq):
+    ...     env = Adsr(attack=0.005, decay=0.15, sustain=0.7, release=1, dur=2).play()
+    ...     return SineLoop(freq, feedback=0.075, mul=env).out()
+    >>> batch = OfflineBatch(threads=4)
+    >>> for i in range(48, 72):
+    ...     job = batch.add(note, dur=2.5, filename="note_%d.wav" % i, args=(midiToHz(i),))
+    >>> results = batch.render()
+    >>> print batch.getThroughput()
+
+    """
+    def __init__(self, sr=44100, nchnls=2, buffersize=256, threads=0, maxservers=64):
+        self._sr = sr
+        self._nchnls = nchnls
+        self._buffersize = buffersize
+        if threads <= 0:
+            import multiprocessing
+            threads = multiprocessing.cpu_count()
+        self._threads = threads
+        self._maxservers = max(maxservers, 1)
+        self._servers = []
+        self._jobs = []
+        self._frames = 0
+        self._elapsed = 0.0
+
+    def add(self, func, dur, filename=None, fileformat=0, sampletype=0, quality=0.4, seed=0, args=(), kwargs=None,
+            buffer=None, callback=None):
+        """
+        Adds a job to the batch. Returns the index of the job.
+
+        :Args:
+
+            func : callable
+                Function creating the processing chain of the job. It is
+                called, with `args` and `kwargs`, when the job's server is
+                booted. The objects it returns are kept alive until the end
+                of the rendering and returned by `render`.
+            dur : float
+                Duration, in seconds, of the rendering. -1 renders exactly
+                `buffer` when there is no `callback`.
+            filename : string, optional
+                Full path of the file to create. If None, and without `buffer`,
+                no file is written, the result is kept by the objects returned
+                by `func` (ie. a NewTable recorded with TableRec). Defaults to None.
+            fileformat : int, optional
+                Format type of the audio file, see `Server.recordOptions`.
+                Defaults to 0.
+            sampletype : int, optional
+                Bit depth encoding of the audio file, see `Server.recordOptions`.
+                Defaults to 0.
+            quality : float, optional
+                The encoding quality of FLAC and OGG files. Defaults to 0.4.
+            seed : int, optional
+                Global seed of the job's server, see `Server.setGlobalSeed`.
+                0 means that the random objects are seeded with the clock.
+                Defaults to 0.
+            args : tuple, optional
+                Positional arguments given to `func`. Defaults to ().
+            kwargs : dict, optional
+                Keyword arguments given to `func`. Defaults to None.
+            buffer : writable buffer, optional
+                Array receiving the output of the job instead of a file, see
+                `Server.setRecordBuffer`. Defaults to None.
+            callback : callable, optional
+                Function called, from a rendering thread, each time `buffer`
+                is full, see `Server.setRecordBuffer`. Defaults to None.
+
+        """
+        if kwargs == None:
+            kwargs = {}
+        self._jobs.append((func, dur, filename, (fileformat, sampletype, quality), seed, args, kwargs, (buffer, callback)))
+        return len(self._jobs) - 1
+
+    def clear(self):
+        """
+        Removes every job not rendered yet.
+
+        """
+        self._jobs = []
+
+    def getNumberOfJobs(self):
+        """
+        Returns the number of jobs waiting to be rendered.
+
+        """
+        return len(self._jobs)
+
+    def render(self):
+        """
+        Renders every job added since the last rendering. Returns the values
+        returned by the jobs' functions, in the order of the jobs.
+
+        """
+        jobs, self._jobs = self._jobs, []
+        current = currentServer()
+        results = []
+        self._frames, self._elapsed = 0, 0.0
+        for first in range(0, len(jobs), self._maxservers):
+            group = jobs[first:first+self._maxservers]
+            while len(self._servers) < len(group):
+                self._servers.append(Server(self._sr, self._nchnls, self._buffersize, duplex=0, audio="offline"))
+                self._servers[-1]._server.setBatch(1)
+            for server, job in zip(self._servers, group):
+                func, dur, filename, options, seed, args, kwargs, target = job
+                server.setServer()
+                server.setGlobalSeed(seed)
+                server.boot()
+                server.setRecordBuffer(*target)
+                if filename == None:
+                    server._server.recordOptions(dur, "")
+                else:
+                    server.recordOptions(dur, filename, *options)
+                results.append(func(*args, **kwargs))
+            frames, elapsed = offlineBatch([server._server for server in self._servers[:len(group)]], self._threads)
+            self._frames += frames
+            self._elapsed += elapsed
+            for server in self._servers[:len(group)]:
+                server.setRecordBuffer(None)
+                server.shutdown()
+        if current != None:
+            current.setServer()
+        return results
+
+    def getThroughput(self):
+        """
+        Returns the throughput of the last rendering, in sample frames per
+        second, summed over all the jobs. Divided by the sampling rate, it
+        gives the speed of the rendering relative to real time.
+
+        """
+        if self._elapsed <= 0.0:
+            return 0.0
+        return self._frames / self._elapsed
+
+    def getRenderedFrames(self):
+        """
+        Returns the number of sample frames computed by the last rendering.
+
+        """
+        return self._frames
+
+    def getRenderTime(self):
+        """
+        Returns the duration, in seconds, of the last rendering, the
+        building of the jobs excluded.
+
+        """
+        return self._elapsed
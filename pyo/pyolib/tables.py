@@ -22,7 +22,7 @@ from _maps import *
 from _widgets import createGraphWindow, createDataGraphWindow, createSndViewTableWindow
 from types import ListType
 from math import pi
-import copy
+import copy, os, tempfile
 
 ######################################################################
 ### Tables
@@ -1380,6 +1380,22 @@ class SndTable(PyoTableObject):
             Stops reading at `stop` seconds into the file. Available at
             initialization time only. The default (None) means the end of
             the file.
+        mapped : boolean, optional
+            If True, the table data is mapped from the disk instead of
+            being read in memory. Available at initialization time only.
+            Defaults to False.
+
+    .. note::
+
+        With `mapped` set to True, a mono WAV file of floats (32 bits,
+        or 64 bits with pyo64) is used directly. Any other sound is
+        decoded once, one file per channel, in the `pyo_tables` folder of
+        the temporary directory, and the decoded file is used by the next
+        loads, in every process. The samples are read from the disk when
+        first accessed and the memory is shared by all the processes
+        using the same sound. Modifying the table (normalize, put, etc.)
+        never writes to the file. Not available on Windows, where the
+        table is always read in memory.
 
     >>> s = Server().boot()
     >>> s.start()
@@ -1389,16 +1405,26 @@ class SndTable(PyoTableObject):
     >>> a = Osc(table=t, freq=[freq, freq*.995], mul=.3).out()
 
     """
-    def __init__(self, path=None, chnl=None, start=0, stop=None, initchnls=1):
+    def __init__(self, path=None, chnl=None, start=0, stop=None, initchnls=1, mapped=False):
         PyoTableObject.__init__(self)
         self._path = path
         self._chnl = chnl
         self._start = start
         self._stop = stop
+        self._mapped = mapped
         self._size = []
         self._dur = []
         self._base_objs = []
         path, lmax = convertArgsToLists(path)
+        if mapped:
+            cachedir = os.path.join(tempfile.gettempdir(), "pyo_tables")
+            if not os.path.isdir(cachedir):
+                try:
+                    os.makedirs(cachedir)
+                except OSError:
+                    pass
+        else:
+            cachedir = ""
         if self._path == None:
             self._base_objs = [SndTable_base("", 0, 0) for i in range(initchnls)]
         else:
@@ -1406,14 +1432,14 @@ class SndTable(PyoTableObject):
                 _size, _dur, _snd_sr, _snd_chnls, _format, _type = sndinfo(p)
                 if chnl == None:
                     if stop == None:
-                        self._base_objs.extend([SndTable_base(p, i, start) for i in range(_snd_chnls)])
+                        self._base_objs.extend([SndTable_base(p, i, start, mapped=mapped, cachedir=cachedir) for i in range(_snd_chnls)])
                     else:
-                        self._base_objs.extend([SndTable_base(p, i, start, stop) for i in range(_snd_chnls)])
+                        self._base_objs.extend([SndTable_base(p, i, start, stop, mapped, cachedir) for i in range(_snd_chnls)])
                 else:
                     if stop == None:
-                        self._base_objs.append(SndTable_base(p, chnl, start))
+                        self._base_objs.append(SndTable_base(p, chnl, start, mapped=mapped, cachedir=cachedir))
                     else:
-                        self._base_objs.append(SndTable_base(p, chnl, start, stop))
+                        self._base_objs.append(SndTable_base(p, chnl, start, stop, mapped, cachedir))
                 self._size.append(self._base_objs[-1].getSize())
                 self._dur.append(self._size[-1] / float(_snd_sr))
             if lmax == 1:
@@ -591,6 +591,9 @@ class Record(PyoObject):
             The encoding quality value, between 0.0 (lowest quality) and 
             1.0 (highest quality). This argument has an effect only with
             FLAC and OGG compressed formats. Defaults to 0.4.
+        queuedur : float, optional
+            Maximum duration, in seconds, of sound waiting to be written
+            to disk. Defaults to 2.
 
     .. note::
 
@@ -599,6 +602,12 @@ class Record(PyoObject):
         The stop() method must be called on the object to close the file
         properly.
 
+        The file is written by a background thread, the audio callback
+        never waits for the disk. If the disk falls more than `queuedur`
+        seconds behind, the buffers that don't fit are dropped and counted,
+        see the getOverruns() method. With an offline server, nothing is
+        ever dropped.
+
         The out() method is bypassed. Record's signal can not be sent to
         audio outs.
 
@@ -618,8 +627,8 @@ class Record(PyoObject):
     >>> clean.start()
 
     """
-    def __init__(self, input, filename, chnls=2, fileformat=0, sampletype=0, buffering=4, quality=0.4):
-        pyoArgsAssert(self, "oSIIIIN", input, filename, chnls, fileformat, sampletype, buffering, quality)
+    def __init__(self, input, filename, chnls=2, fileformat=0, sampletype=0, buffering=4, quality=0.4, queuedur=2.0):
+        pyoArgsAssert(self, "oSIIIINN", input, filename, chnls, fileformat, sampletype, buffering, quality, queuedur)
         PyoObject.__init__(self)
         self._input = input
         self._in_fader = InputFader(input)
@@ -632,11 +641,18 @@ class Record(PyoObject):
                 print 'Warning: Unknown file extension. Using fileformat value.'
         else:
             print 'Warning: Filename has no extension. Using fileformat value.'
-        self._base_objs = [Record_base(self._in_fader.getBaseObjects(), filename, chnls, fileformat, sampletype, buffering, quality)]
+        self._base_objs = [Record_base(self._in_fader.getBaseObjects(), filename, chnls, fileformat, sampletype, buffering, quality, queuedur)]
 
     def out(self, chnl=0, inc=1, dur=0, delay=0):
         return self.play(dur, delay)
 
+    def getOverruns(self):
+        """
+        Returns the number of buffers dropped because the disk was too slow.
+
+        """
+        return self._base_objs[0].getOverruns()
+
     def setInput(self, x, fadetime=0.05):
         """
         Replace the `input` attribute.
@@ -108,7 +108,7 @@ if sys.platform == "darwin":
 path = 'src/engine'
 files = ['pyomodule.c', 'streammodule.c', 'servermodule.c', 'pvstreammodule.c',
          'dummymodule.c', 'mixmodule.c', 'inputfadermodule.c', 'interpolation.c',
-         'fft.c', "wind.c"] + ad_files
+         'fft.c', "wind.c", 'ptsmkernel.c', 'spscring.c', 'dspgraph.c', 'sfstreamer.c', 'sfwriter.c', 'sndmap.c', 'ctlramp.c', 'biquadbank.c', 'muladd.c', 'telemetry.c'] + ad_files
 source_files = [os.path.join(path, f) for f in files]
 
 path = 'src/objects'
@@ -121,7 +121,7 @@ files = ['filtremodule.c', 'arithmeticmodule.c', 'oscilmodule.c',
          'trigmodule.c', 'patternmodule.c', 'bandsplitmodule.c', 'hilbertmodule.c',
          'panmodule.c', 'selectmodule.c', 'compressmodule.c',  'freeverbmodule.c',
          'phasevocmodule.c', 'fftmodule.c', 'convolvemodule.c', 'sigmodule.c',
-         'matrixprocessmodule.c', 'harmonizermodule.c', 'chorusmodule.c', 'fifoplayer.c'] + obj_files
+         'matrixprocessmodule.c', 'harmonizermodule.c', 'chorusmodule.c', 'fifoplayer.c', 'ptsmmodule.c'] + obj_files
 
 if compile_externals:
     source_files = source_files + \
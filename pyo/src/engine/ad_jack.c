@@ -72,6 +72,12 @@ jack_bufsize_cb(jack_nframes_t nframes, void *arg) {
     return 0;
 }
 
+int
+jack_xrun_cb(void *arg) {
+    Server_xrun((Server *) arg);
+    return 0;
+}
+
 void
 jack_error_cb(const char *desc) {
     printf("JACK error: %s\n", desc);
@@ -259,6 +265,7 @@ Server_jack_init(Server *self) {
     jack_set_sample_rate_callback(be_data->jack_client, jack_srate_cb, (void *) self);
     jack_on_shutdown(be_data->jack_client, jack_shutdown_cb, (void *) self);
     jack_set_buffer_size_callback(be_data->jack_client, jack_bufsize_cb, (void *) self);
+    jack_set_xrun_callback(be_data->jack_client, jack_xrun_cb, (void *) self);
     return 0;
 }
 
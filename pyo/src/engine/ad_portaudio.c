@@ -48,7 +48,9 @@ pa_callback_interleaved( const void *inputBuffer, void *outputBuffer,
 
     /* avoid unused variable warnings */
     (void) timeInfo;
-    (void) statusFlags;
+
+    if (statusFlags & (paInputUnderflow | paInputOverflow | paOutputUnderflow | paOutputOverflow))
+        Server_xrun(server);
 
     if (server->withPortMidi == 1) {
         pyoGetMidiEvents(server);
@@ -100,7 +102,9 @@ pa_callback_nonInterleaved( const void *inputBuffer, void *outputBuffer,
 
     /* avoid unused variable warnings */
     (void) timeInfo;
-    (void) statusFlags;
+
+    if (statusFlags & (paInputUnderflow | paInputOverflow | paOutputUnderflow | paOutputOverflow))
+        Server_xrun(server);
 
     if (server->withPortMidi == 1) {
         pyoGetMidiEvents(server);
@@ -0,0 +1,191 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "biquadbank.h"
+#include <string.h>
+
+#if defined(__GNUC__)
+#define BQBANK_VECTOR_EXT
+/* BQBANK_LANES filters in one variable, one or more registers depending on the target. */
+typedef MYFLT bqbank_vec __attribute__((vector_size(BQBANK_LANES * sizeof(MYFLT))));
+#if defined(__x86_64__) || defined(__i386__)
+#define BQBANK_X86_SIMD
+#endif
+#endif
+
+static void
+bqbank_kernel_scalar(BqBankGroup *g, const MYFLT *in, int shared, MYFLT *out, int count)
+{
+    int i, k;
+    MYFLT x, y;
+
+    for (i=0; i<count; i++) {
+        for (k=0; k<BQBANK_LANES; k++) {
+            g->coeffs[0][k] += g->incs[0][k];
+            g->coeffs[1][k] += g->incs[1][k];
+            g->coeffs[2][k] += g->incs[2][k];
+            g->coeffs[3][k] += g->incs[3][k];
+            g->coeffs[4][k] += g->incs[4][k];
+            x = shared ? in[i] : in[i * BQBANK_LANES + k];
+            y = g->coeffs[0][k] * x + g->coeffs[1][k] * g->x1[k] + g->coeffs[2][k] * g->x2[k] -
+                g->coeffs[3][k] * g->y1[k] - g->coeffs[4][k] * g->y2[k];
+            g->x2[k] = g->x1[k];
+            g->x1[k] = x;
+            g->y2[k] = g->y1[k];
+            out[i * BQBANK_LANES + k] = g->y1[k] = y;
+        }
+    }
+}
+
+#ifdef BQBANK_VECTOR_EXT
+/* Body of the vector kernels, inlined in functions compiled for different
+** instruction sets. memcpy compiles to unaligned vector moves. */
+static inline __attribute__((always_inline)) void
+bqbank_kernel_body(BqBankGroup *g, const MYFLT *in, int shared, MYFLT *out, int count)
+{
+    int i;
+    bqbank_vec b0, b1, b2, a1, a2, ib0, ib1, ib2, ia1, ia2, x, x1, x2, y, y1, y2;
+    bqbank_vec zero = {0};
+
+    memcpy(&b0, g->coeffs[0], sizeof(bqbank_vec));
+    memcpy(&b1, g->coeffs[1], sizeof(bqbank_vec));
+    memcpy(&b2, g->coeffs[2], sizeof(bqbank_vec));
+    memcpy(&a1, g->coeffs[3], sizeof(bqbank_vec));
+    memcpy(&a2, g->coeffs[4], sizeof(bqbank_vec));
+    memcpy(&ib0, g->incs[0], sizeof(bqbank_vec));
+    memcpy(&ib1, g->incs[1], sizeof(bqbank_vec));
+    memcpy(&ib2, g->incs[2], sizeof(bqbank_vec));
+    memcpy(&ia1, g->incs[3], sizeof(bqbank_vec));
+    memcpy(&ia2, g->incs[4], sizeof(bqbank_vec));
+    memcpy(&x1, g->x1, sizeof(bqbank_vec));
+    memcpy(&x2, g->x2, sizeof(bqbank_vec));
+    memcpy(&y1, g->y1, sizeof(bqbank_vec));
+    memcpy(&y2, g->y2, sizeof(bqbank_vec));
+
+    for (i=0; i<count; i++) {
+        b0 += ib0;
+        b1 += ib1;
+        b2 += ib2;
+        a1 += ia1;
+        a2 += ia2;
+        if (shared)
+            x = zero + in[i];
+        else
+            memcpy(&x, in + i * BQBANK_LANES, sizeof(bqbank_vec));
+        y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+        memcpy(out + i * BQBANK_LANES, &y, sizeof(bqbank_vec));
+    }
+
+    memcpy(g->coeffs[0], &b0, sizeof(bqbank_vec));
+    memcpy(g->coeffs[1], &b1, sizeof(bqbank_vec));
+    memcpy(g->coeffs[2], &b2, sizeof(bqbank_vec));
+    memcpy(g->coeffs[3], &a1, sizeof(bqbank_vec));
+    memcpy(g->coeffs[4], &a2, sizeof(bqbank_vec));
+    memcpy(g->x1, &x1, sizeof(bqbank_vec));
+    memcpy(g->x2, &x2, sizeof(bqbank_vec));
+    memcpy(g->y1, &y1, sizeof(bqbank_vec));
+    memcpy(g->y2, &y2, sizeof(bqbank_vec));
+}
+
+static void
+bqbank_kernel_vector(BqBankGroup *g, const MYFLT *in, int shared, MYFLT *out, int count)
+{
+    bqbank_kernel_body(g, in, shared, out, count);
+}
+
+#ifdef BQBANK_X86_SIMD
+/* No fma, a fused multiply-add would round differently from the other kernels. */
+__attribute__((target("avx")))
+static void
+bqbank_kernel_avx(BqBankGroup *g, const MYFLT *in, int shared, MYFLT *out, int count)
+{
+    bqbank_kernel_body(g, in, shared, out, count);
+}
+#endif
+#endif
+
+int
+bqbank_kernel_available(int kernel)
+{
+    switch (kernel) {
+        case BQBANK_KERNEL_AUTO:
+        case BQBANK_KERNEL_SCALAR:
+            return 1;
+#ifdef BQBANK_VECTOR_EXT
+        case BQBANK_KERNEL_VECTOR:
+            return 1;
+#endif
+#ifdef BQBANK_X86_SIMD
+        case BQBANK_KERNEL_AVX:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx");
+#endif
+        default:
+            return 0;
+    }
+}
+
+int
+bqbank_kernel_resolve(int kernel)
+{
+    if (kernel != BQBANK_KERNEL_AUTO && bqbank_kernel_available(kernel))
+        return kernel;
+    if (bqbank_kernel_available(BQBANK_KERNEL_AVX))
+        return BQBANK_KERNEL_AVX;
+    if (bqbank_kernel_available(BQBANK_KERNEL_VECTOR))
+        return BQBANK_KERNEL_VECTOR;
+    return BQBANK_KERNEL_SCALAR;
+}
+
+bqbank_kernel_func
+bqbank_get_kernel(int kernel)
+{
+    switch (bqbank_kernel_resolve(kernel)) {
+#ifdef BQBANK_X86_SIMD
+        case BQBANK_KERNEL_AVX:
+            return bqbank_kernel_avx;
+#endif
+#ifdef BQBANK_VECTOR_EXT
+        case BQBANK_KERNEL_VECTOR:
+            return bqbank_kernel_vector;
+#endif
+        default:
+            return bqbank_kernel_scalar;
+    }
+}
+
+const char *
+bqbank_kernel_name(int kernel)
+{
+    switch (kernel) {
+        case BQBANK_KERNEL_SCALAR:
+            return "scalar";
+        case BQBANK_KERNEL_VECTOR:
+            return "vector";
+        case BQBANK_KERNEL_AVX:
+            return "avx";
+        default:
+            return "auto";
+    }
+}
@@ -0,0 +1,91 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "ctlramp.h"
+
+void
+CtlRamp_init(CtlRamp *ramp, int count)
+{
+    int i;
+
+    ramp->period = 0;
+    ramp->ready = 0;
+    ramp->count = count;
+    for (i=0; i<CTLRAMP_MAX_PARAMS; i++)
+        ramp->params[i] = 0.0;
+    for (i=0; i<CTLRAMP_MAX_COEFFS; i++)
+        ramp->coeffs[i] = ramp->incs[i] = ramp->target[i] = 0.0;
+}
+
+void
+CtlRamp_setPeriod(CtlRamp *ramp, int period)
+{
+    ramp->period = period < 0 ? 0 : period;
+    ramp->ready = 0;
+}
+
+int
+CtlRamp_segment(CtlRamp *ramp, int i, int bufsize)
+{
+    int len = bufsize - i;
+
+    if (ramp->period > 0 && ramp->period < len)
+        len = ramp->period;
+    return len;
+}
+
+int
+CtlRamp_begin(CtlRamp *ramp, MYFLT p0, MYFLT p1, MYFLT p2)
+{
+    int i;
+
+    if (ramp->ready && p0 == ramp->params[0] && p1 == ramp->params[1] && p2 == ramp->params[2]) {
+        /* Lands exactly on the target, the increments are not exact. */
+        for (i=0; i<ramp->count; i++) {
+            ramp->coeffs[i] = ramp->target[i];
+            ramp->incs[i] = 0.0;
+        }
+        return 0;
+    }
+    ramp->params[0] = p0;
+    ramp->params[1] = p1;
+    ramp->params[2] = p2;
+    return 1;
+}
+
+void
+CtlRamp_setTarget(CtlRamp *ramp, const MYFLT *target, int len)
+{
+    int i;
+
+    for (i=0; i<ramp->count; i++) {
+        if (ramp->ready) {
+            /* Starts from the last target, reached at the end of the last segment. */
+            ramp->coeffs[i] = ramp->target[i];
+            ramp->incs[i] = (target[i] - ramp->coeffs[i]) / len;
+        }
+        else {
+            ramp->coeffs[i] = target[i];
+            ramp->incs[i] = 0.0;
+        }
+        ramp->target[i] = target[i];
+    }
+    ramp->ready = 1;
+}
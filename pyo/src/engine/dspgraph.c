@@ -0,0 +1,731 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+#include "dspgraph.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+#if defined(__GNUC__)
+#define GRAPH_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define GRAPH_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#define GRAPH_DECREMENT(x) __atomic_sub_fetch(&(x), 1, __ATOMIC_ACQ_REL)
+#define GRAPH_TRYLOCK(x) (__atomic_exchange_n(&(x), 1, __ATOMIC_ACQUIRE) == 0)
+#define GRAPH_UNLOCK(x) __atomic_store_n(&(x), 0, __ATOMIC_RELEASE)
+#else
+#define GRAPH_LOAD(x) (__sync_synchronize(), *(volatile int *)&(x))
+#define GRAPH_STORE(x, v) do { __sync_synchronize(); *(volatile int *)&(x) = (v); __sync_synchronize(); } while (0)
+#define GRAPH_DECREMENT(x) __sync_sub_and_fetch(&(x), 1)
+#define GRAPH_TRYLOCK(x) (__sync_lock_test_and_set(&(x), 1) == 0)
+#define GRAPH_UNLOCK(x) __sync_lock_release(&(x))
+#endif
+
+/* Tasks ready to run. The owner pushes and pops at the bottom, the other
+** threads steal at the top. Every task is pushed at most once per buffer
+** so a deque never holds more than the number of streams. */
+typedef struct {
+    int *items;
+    int top;
+    int bottom;
+    int lock;
+} PyoGraphDeque;
+
+struct PyoGraphThread {
+    PyoGraphPool *pool;
+    int index; /* 0 is the thread calling PyoGraphPool_run */
+    pthread_t thread;
+    PyoGraphDeque deque;
+    Stream *stream; /* stream being processed */
+    int task;
+    int inlineTask; /* running alone on the calling thread, with the GIL */
+    void *lastResource;
+    int lastWrite;
+    PyoGraphCall calls[PYO_GRAPH_CALLS];
+    int ncalls;
+};
+
+typedef struct {
+    void *resource;
+    int writer; /* last task writing the resource */
+    int readers; /* tasks reading it since, linked through readerNext */
+} PyoGraphEntry;
+
+/* The graph of one list of streams, in compressed rows of successors. The
+** arrays are allocated with the GIL, a run never grows them. */
+struct PyoGraph {
+    Stream **streams;
+    int count;
+    int nthreads;
+    int built;
+    int inlineCalls;
+    int *indeg;
+    int *pending;
+    int *mark;
+    int *since;
+    int *succStart;
+    char *ran;
+    char *barrier;
+    char *mainOnly;
+    int *deques; /* items of the threads deques, then of the main deque */
+    int *edgeFrom;
+    int *edgeTo;
+    int *succ;
+    int nedges;
+    int edgeCapacity;
+    PyoGraphEntry *map;
+    int mapCapacity;
+    int *readerTask;
+    int *readerNext;
+    int readerCapacity;
+    int nreaders;
+};
+
+struct PyoGraphPool {
+    int nthreads;
+    PyoGraphThread *threads;
+    PyoGraphDeque mainDeque; /* streams using the Python API, run by thread 0 only */
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    unsigned int generation;
+    int quit;
+    int busy; /* workers still inside the current run */
+    int remaining; /* tasks not finished yet */
+    int stale; /* an access list changed, rebuild before the next run */
+    unsigned long dropped;
+    int needAccesses; /* sizes a build was short of, for the next graphs */
+    int needEdges;
+
+    PyoGraphFuncs funcs;
+    int mixed; /* streams before this index are mixed */
+    PyoGraph *graph; /* graph of the current run */
+};
+
+PYO_THREAD_LOCAL PyoGraphThread *pyo_graph_thread = NULL;
+
+/** Access recording. **/
+/***********************/
+
+void
+PyoGraph_record(void *resource, int write)
+{
+    int i;
+    PyoGraphAccessList *list;
+    PyoGraphThread *state = pyo_graph_thread;
+
+    if (state->stream == NULL || resource == NULL || resource == (void *)state->stream)
+        return;
+    if (resource == state->lastResource && write <= state->lastWrite)
+        return;
+    state->lastResource = resource;
+    state->lastWrite = write;
+
+    list = state->stream->accesses;
+    if (list == NULL)
+        return;
+    for (i=0; i<list->count; i++) {
+        if (list->items[i].resource == resource) {
+            if (write && !list->items[i].write) {
+                list->items[i].write = 1;
+                GRAPH_STORE(state->pool->stale, 1);
+            }
+            return;
+        }
+    }
+    if (list->count == PYO_GRAPH_MAX_ACCESSES) {
+        if (!list->overflow) {
+            list->overflow = 1;
+            GRAPH_STORE(state->pool->stale, 1);
+        }
+        return;
+    }
+    list->items[list->count].resource = resource;
+    list->items[list->count].write = write;
+    list->count++;
+    GRAPH_STORE(state->pool->stale, 1);
+}
+
+void
+PyoGraph_initAccesses(Stream *stream)
+{
+    /* Unknown until the stream has run alone once. */
+    if (stream->accesses == NULL) {
+        stream->accesses = (PyoGraphAccessList *)calloc(1, sizeof(PyoGraphAccessList));
+        if (stream->accesses != NULL)
+            stream->accesses->reset = 1;
+    }
+}
+
+void
+PyoGraph_resetAccesses(Stream *stream)
+{
+    /* NULL until the stream is first published, it is then unknown anyway. */
+    PyoGraphAccessList *list = stream->accesses;
+
+    if (list != NULL)
+        GRAPH_STORE(list->reset, 1);
+}
+
+int
+PyoGraph_deferCall(PyObject *obj, PyoGraphCallFunc func, double value)
+{
+    PyoGraphCall *call;
+    PyoGraphThread *state = pyo_graph_thread;
+
+    if (state == NULL || state->stream == NULL || state->inlineTask)
+        return 0;
+
+    if (state->stream->accesses != NULL && !state->stream->accesses->calls) {
+        state->stream->accesses->calls = 1;
+        GRAPH_STORE(state->pool->stale, 1);
+    }
+    if (state->ncalls == PYO_GRAPH_CALLS) {
+        state->pool->dropped++;
+        return 1;
+    }
+    call = &state->calls[state->ncalls];
+    call->task = state->task;
+    call->order = state->ncalls++;
+    call->obj = obj;
+    call->func = func;
+    call->value = value;
+    return 1;
+}
+
+/** Graph construction. **/
+/*************************/
+
+void
+PyoGraph_free(PyoGraph *graph)
+{
+    if (graph == NULL)
+        return;
+    free(graph->indeg);
+    free(graph->pending);
+    free(graph->mark);
+    free(graph->since);
+    free(graph->succStart);
+    free(graph->ran);
+    free(graph->barrier);
+    free(graph->mainOnly);
+    free(graph->deques);
+    free(graph->edgeFrom);
+    free(graph->edgeTo);
+    free(graph->succ);
+    free(graph->map);
+    free(graph->readerTask);
+    free(graph->readerNext);
+    free(graph);
+}
+
+/* Number of map entries and readers needed by the lists of the streams. */
+static int
+PyoGraph_countAccesses(Stream **streams, int count)
+{
+    int i, total = 0;
+    PyoGraphAccessList *list;
+
+    for (i=0; i<count; i++) {
+        list = streams[i]->accesses;
+        total += 1 + (list != NULL ? list->count : 0);
+    }
+    return total;
+}
+
+PyoGraph *
+PyoGraphPool_newGraph(PyoGraphPool *pool, Stream **streams, int count)
+{
+    int accesses, edges, size = 16;
+    PyoGraph *graph = (PyoGraph *)calloc(1, sizeof(PyoGraph));
+
+    if (graph == NULL)
+        return NULL;
+    graph->streams = streams;
+    graph->count = count;
+    graph->nthreads = pool->nthreads;
+
+    /* Twice the accesses recorded so far, the new streams still record theirs. */
+    accesses = 2 * PyoGraph_countAccesses(streams, count);
+    if (accesses < GRAPH_LOAD(pool->needAccesses))
+        accesses = GRAPH_LOAD(pool->needAccesses);
+    edges = 2 * accesses;
+    if (edges < GRAPH_LOAD(pool->needEdges))
+        edges = GRAPH_LOAD(pool->needEdges);
+    while (size < accesses * 2)
+        size *= 2;
+
+    graph->indeg = (int *)malloc(count * sizeof(int));
+    graph->pending = (int *)malloc(count * sizeof(int));
+    graph->mark = (int *)malloc(count * sizeof(int));
+    graph->since = (int *)malloc(count * sizeof(int));
+    graph->succStart = (int *)malloc((count + 1) * sizeof(int));
+    graph->ran = (char *)malloc(count * sizeof(char));
+    graph->barrier = (char *)malloc(count * sizeof(char));
+    graph->mainOnly = (char *)malloc(count * sizeof(char));
+    graph->deques = (int *)malloc((pool->nthreads + 1) * count * sizeof(int));
+    graph->edgeFrom = (int *)malloc(edges * sizeof(int));
+    graph->edgeTo = (int *)malloc(edges * sizeof(int));
+    graph->succ = (int *)malloc(edges * sizeof(int));
+    graph->edgeCapacity = edges;
+    graph->map = (PyoGraphEntry *)malloc(size * sizeof(PyoGraphEntry));
+    graph->mapCapacity = size;
+    graph->readerTask = (int *)malloc(accesses * sizeof(int));
+    graph->readerNext = (int *)malloc(accesses * sizeof(int));
+    graph->readerCapacity = accesses;
+
+    if (graph->indeg == NULL || graph->pending == NULL || graph->mark == NULL || graph->since == NULL ||
+        graph->succStart == NULL || graph->ran == NULL || graph->barrier == NULL || graph->mainOnly == NULL ||
+        graph->deques == NULL || graph->edgeFrom == NULL || graph->edgeTo == NULL || graph->succ == NULL ||
+        graph->map == NULL || graph->readerTask == NULL || graph->readerNext == NULL) {
+        PyoGraph_free(graph);
+        return NULL;
+    }
+    return graph;
+}
+
+static PyoGraphEntry *
+PyoGraph_lookup(PyoGraph *graph, void *resource)
+{
+    unsigned int mask = graph->mapCapacity - 1;
+    unsigned int h = (unsigned int)(((size_t)resource >> 4) * 2654435761u) & mask;
+
+    while (graph->map[h].resource != NULL && graph->map[h].resource != resource)
+        h = (h + 1) & mask;
+    if (graph->map[h].resource == NULL) {
+        graph->map[h].resource = resource;
+        graph->map[h].writer = -1;
+        graph->map[h].readers = -1;
+    }
+    return &graph->map[h];
+}
+
+/* Past the capacity, the edges are only counted, the build then fails. */
+static void
+PyoGraph_addEdge(PyoGraph *graph, int from, int to)
+{
+    if (from < 0 || from == to || graph->mark[from] == to)
+        return;
+    graph->mark[from] = to;
+    if (graph->nedges < graph->edgeCapacity) {
+        graph->edgeFrom[graph->nedges] = from;
+        graph->edgeTo[graph->nedges] = to;
+    }
+    graph->nedges++;
+    graph->indeg[to]++;
+}
+
+static void
+PyoGraph_addAccess(PyoGraph *graph, int task, void *resource, int write)
+{
+    int r;
+    PyoGraphEntry *entry = PyoGraph_lookup(graph, resource);
+
+    /* Read after write. */
+    PyoGraph_addEdge(graph, entry->writer, task);
+    if (write) {
+        /* Write after read, the readers expect the previous content. */
+        for (r=entry->readers; r>=0; r=graph->readerNext[r])
+            PyoGraph_addEdge(graph, graph->readerTask[r], task);
+        entry->writer = task;
+        entry->readers = -1;
+    }
+    else {
+        r = graph->nreaders++;
+        graph->readerTask[r] = task;
+        graph->readerNext[r] = entry->readers;
+        entry->readers = r;
+    }
+}
+
+/* Runs after every task before it and before every task after it. */
+static int
+PyoGraph_isBarrier(PyoGraph *graph, Stream *stream)
+{
+    PyoGraphAccessList *list = stream->accesses;
+
+    if (list == NULL || list->overflow || GRAPH_LOAD(list->reset))
+        return 1;
+    return graph->inlineCalls && (list->calls || Stream_getStreamNeedsGIL(stream) ||
+                                  Stream_getDuration(stream) != 0);
+}
+
+/* Returns 0 if the graph is too small for the recorded accesses, the sizes
+** needed are then kept for the next graphs. */
+static int
+PyoGraphPool_build(PyoGraphPool *pool, PyoGraph *graph)
+{
+    int i, j, k, total, nsince = 0, barrier = -1, count = graph->count;
+    Stream **streams = graph->streams;
+    PyoGraphAccessList *list;
+
+    graph->built = 0;
+    total = PyoGraph_countAccesses(streams, count);
+    if (total > graph->readerCapacity || total * 2 > graph->mapCapacity) {
+        GRAPH_STORE(pool->needAccesses, total * 2);
+        return 0;
+    }
+    memset(graph->map, 0, graph->mapCapacity * sizeof(PyoGraphEntry));
+    graph->nreaders = 0;
+    graph->nedges = 0;
+
+    for (i=0; i<count; i++) {
+        graph->indeg[i] = 0;
+        graph->mark[i] = -1;
+    }
+
+    for (i=0; i<count; i++) {
+        list = streams[i]->accesses;
+        graph->barrier[i] = (char)PyoGraph_isBarrier(graph, streams[i]);
+        graph->mainOnly[i] = Stream_getStreamNeedsGIL(streams[i]) || (graph->inlineCalls && graph->barrier[i]);
+        if (graph->barrier[i]) {
+            for (j=0; j<nsince; j++)
+                PyoGraph_addEdge(graph, graph->since[j], i);
+            PyoGraph_addEdge(graph, barrier, i);
+            barrier = i;
+            nsince = 0;
+            continue;
+        }
+        PyoGraph_addEdge(graph, barrier, i);
+        for (k=0; k<list->count; k++)
+            PyoGraph_addAccess(graph, i, list->items[k].resource, list->items[k].write);
+        PyoGraph_addAccess(graph, i, (void *)streams[i], 1);
+        graph->since[nsince++] = i;
+    }
+    if (graph->nedges > graph->edgeCapacity) {
+        GRAPH_STORE(pool->needEdges, graph->nedges * 2);
+        return 0;
+    }
+
+    /* Successor lists. */
+    memset(graph->succStart, 0, (count + 1) * sizeof(int));
+    for (k=0; k<graph->nedges; k++)
+        graph->succStart[graph->edgeFrom[k] + 1]++;
+    for (i=0; i<count; i++)
+        graph->succStart[i + 1] += graph->succStart[i];
+    for (i=0; i<count; i++)
+        graph->mark[i] = graph->succStart[i];
+    for (k=0; k<graph->nedges; k++)
+        graph->succ[graph->mark[graph->edgeFrom[k]]++] = graph->edgeTo[k];
+
+    graph->built = 1;
+    return 1;
+}
+
+/** Execution. **/
+/****************/
+
+static void
+PyoGraphDeque_push(PyoGraphDeque *deque, int task)
+{
+    while (!GRAPH_TRYLOCK(deque->lock))
+        ;
+    deque->items[deque->bottom++] = task;
+    GRAPH_UNLOCK(deque->lock);
+}
+
+static int
+PyoGraphDeque_pop(PyoGraphDeque *deque, int steal)
+{
+    int task = -1;
+
+    while (!GRAPH_TRYLOCK(deque->lock))
+        ;
+    if (deque->bottom > deque->top) {
+        if (steal)
+            task = deque->items[deque->top++];
+        else
+            task = deque->items[--deque->bottom];
+    }
+    GRAPH_UNLOCK(deque->lock);
+    return task;
+}
+
+static void
+PyoGraph_yield()
+{
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+/* Only on the calling thread, every task before upto is done. */
+static void
+PyoGraph_mixUpTo(PyoGraphPool *pool, int upto)
+{
+    int i;
+    PyoGraph *graph = pool->graph;
+
+    for (i=pool->mixed; i<upto; i++) {
+        if (graph->ran[i])
+            (*pool->funcs.mix)(pool->funcs.ctx, graph->streams[i]);
+    }
+    if (upto > pool->mixed)
+        pool->mixed = upto;
+}
+
+static void
+PyoGraph_execute(PyoGraphPool *pool, PyoGraphThread *state, int task)
+{
+    int i, next;
+    PyoGraph *graph = pool->graph;
+    Stream *stream = graph->streams[task];
+
+    /* Alone after a change of its inputs, the old list may miss some of them. */
+    if (graph->barrier[task] && stream->accesses != NULL && GRAPH_LOAD(stream->accesses->reset)) {
+        stream->accesses->count = 0;
+        stream->accesses->overflow = 0;
+        stream->accesses->calls = 0;
+        GRAPH_STORE(stream->accesses->reset, 0);
+        GRAPH_STORE(pool->stale, 1);
+    }
+    state->stream = stream;
+    state->task = task;
+    state->lastResource = NULL;
+    /* Alone on the calling thread, its calls are made right away. */
+    state->inlineTask = graph->inlineCalls && graph->barrier[task];
+    if (state->inlineTask)
+        PyoGraph_mixUpTo(pool, task);
+    graph->ran[task] = (char)(*pool->funcs.process)(pool->funcs.ctx, stream);
+    if (state->inlineTask)
+        PyoGraph_mixUpTo(pool, task + 1);
+    if (graph->ran[task])
+        (*pool->funcs.finish)(pool->funcs.ctx, stream);
+    state->stream = NULL;
+    state->inlineTask = 0;
+
+    for (i=graph->succStart[task]; i<graph->succStart[task+1]; i++) {
+        next = graph->succ[i];
+        if (GRAPH_DECREMENT(graph->pending[next]) == 0) {
+            if (graph->mainOnly[next])
+                PyoGraphDeque_push(&pool->mainDeque, next);
+            else
+                PyoGraphDeque_push(&state->deque, next);
+        }
+    }
+    GRAPH_DECREMENT(pool->remaining);
+}
+
+static void
+PyoGraph_work(PyoGraphPool *pool, PyoGraphThread *state)
+{
+    int i, task, idle = 0;
+
+    while (GRAPH_LOAD(pool->remaining) > 0) {
+        task = PyoGraphDeque_pop(&state->deque, 0);
+        if (task < 0 && state->index == 0)
+            task = PyoGraphDeque_pop(&pool->mainDeque, 0);
+        for (i=1; task<0 && i<pool->nthreads; i++)
+            task = PyoGraphDeque_pop(&pool->threads[(state->index + i) % pool->nthreads].deque, 1);
+        if (task < 0) {
+            if (++idle > 64)
+                PyoGraph_yield();
+            continue;
+        }
+        idle = 0;
+        PyoGraph_execute(pool, state, task);
+    }
+}
+
+static void *
+PyoGraph_worker(void *arg)
+{
+    PyoGraphThread *state = (PyoGraphThread *)arg;
+    PyoGraphPool *pool = state->pool;
+    unsigned int generation = 0;
+
+    pyo_graph_thread = state;
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (pool->generation == generation && !pool->quit)
+            pthread_cond_wait(&pool->cond, &pool->mutex);
+        if (pool->quit)
+            break;
+        generation = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+        PyoGraph_work(pool, state);
+        GRAPH_DECREMENT(pool->busy);
+        pthread_mutex_lock(&pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+PyoGraphPool *
+PyoGraphPool_new(int nthreads)
+{
+    int i;
+    PyoGraphPool *pool = (PyoGraphPool *)calloc(1, sizeof(PyoGraphPool));
+
+    if (pool == NULL)
+        return NULL;
+    pool->nthreads = nthreads;
+    pool->threads = (PyoGraphThread *)calloc(nthreads, sizeof(PyoGraphThread));
+    if (pool->threads == NULL) {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+    for (i=0; i<nthreads; i++) {
+        pool->threads[i].pool = pool;
+        pool->threads[i].index = i;
+    }
+
+    for (i=1; i<nthreads; i++) {
+        if (pthread_create(&pool->threads[i].thread, NULL, PyoGraph_worker, &pool->threads[i])) {
+            pool->nthreads = i;
+            PyoGraphPool_free(pool);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+void
+PyoGraphPool_free(PyoGraphPool *pool)
+{
+    int i;
+
+    if (pool == NULL)
+        return;
+    pthread_mutex_lock(&pool->mutex);
+    pool->quit = 1;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->mutex);
+    for (i=1; i<pool->nthreads; i++)
+        pthread_join(pool->threads[i].thread, NULL);
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->cond);
+
+    free(pool->threads);
+    free(pool);
+}
+
+int
+PyoGraphPool_run(PyoGraphPool *pool, PyoGraph *graph, int inlineCalls, PyoGraphFuncs *funcs)
+{
+    int i, rebuild, count = graph->count;
+    PyoGraphThread *caller = &pool->threads[0];
+
+    if (graph->nthreads != pool->nthreads)
+        return 0;
+    if (count == 0)
+        return 1;
+    rebuild = !graph->built || pool->graph != graph || graph->inlineCalls != inlineCalls ||
+              GRAPH_LOAD(pool->stale);
+    graph->inlineCalls = inlineCalls;
+    /* A duration can be given from Python between two buffers. */
+    for (i=0; i<count && !rebuild; i++) {
+        if (PyoGraph_isBarrier(graph, graph->streams[i]) != graph->barrier[i])
+            rebuild = 1;
+    }
+    pool->graph = graph;
+    if (rebuild) {
+        GRAPH_STORE(pool->stale, 0);
+        if (!PyoGraphPool_build(pool, graph))
+            return 0;
+    }
+
+    pool->funcs = *funcs;
+    pool->mixed = 0;
+    for (i=0; i<pool->nthreads; i++) {
+        pool->threads[i].deque.items = graph->deques + i * count;
+        pool->threads[i].deque.top = pool->threads[i].deque.bottom = 0;
+    }
+    pool->mainDeque.items = graph->deques + pool->nthreads * count;
+    pool->mainDeque.top = pool->mainDeque.bottom = 0;
+    for (i=0; i<count; i++) {
+        graph->pending[i] = graph->indeg[i];
+        graph->ran[i] = 0;
+    }
+    /* Pushed in reverse, the calling thread pops the first streams first. */
+    for (i=count-1; i>=0; i--) {
+        if (graph->indeg[i] == 0) {
+            if (graph->mainOnly[i])
+                pool->mainDeque.items[pool->mainDeque.bottom++] = i;
+            else
+                caller->deque.items[caller->deque.bottom++] = i;
+        }
+    }
+    GRAPH_STORE(pool->remaining, count);
+
+    if (pool->nthreads > 1) {
+        GRAPH_STORE(pool->busy, pool->nthreads - 1);
+        pthread_mutex_lock(&pool->mutex);
+        pool->generation++;
+        pthread_cond_broadcast(&pool->cond);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+
+    pyo_graph_thread = caller;
+    PyoGraph_work(pool, caller);
+    pyo_graph_thread = NULL;
+
+    /* Barrier, no worker touches the pool after this loop. */
+    while (GRAPH_LOAD(pool->busy) > 0)
+        PyoGraph_yield();
+
+    PyoGraph_mixUpTo(pool, count);
+    return 1;
+}
+
+static int
+PyoGraph_compareCalls(const void *a, const void *b)
+{
+    const PyoGraphCall *c1 = (const PyoGraphCall *)a;
+    const PyoGraphCall *c2 = (const PyoGraphCall *)b;
+
+    if (c1->task != c2->task)
+        return c1->task < c2->task ? -1 : 1;
+    return c1->order < c2->order ? -1 : (c1->order > c2->order);
+}
+
+int
+PyoGraphPool_takeCalls(PyoGraphPool *pool, PyoGraphCall *calls, int size)
+{
+    int i, j, n = 0;
+    PyoGraphThread *state;
+
+    for (i=0; i<pool->nthreads; i++) {
+        state = &pool->threads[i];
+        for (j=0; j<state->ncalls; j++) {
+            if (n < size)
+                calls[n++] = state->calls[j];
+            else
+                pool->dropped++;
+        }
+        state->ncalls = 0;
+    }
+    if (n > 1)
+        qsort(calls, n, sizeof(PyoGraphCall), PyoGraph_compareCalls);
+    return n;
+}
+
+unsigned long
+PyoGraphPool_getDroppedCalls(PyoGraphPool *pool)
+{
+    return pool->dropped;
+}
@@ -220,6 +220,7 @@ InputFader_setInput(InputFader *self, PyObject *args, PyObject *kwds)
         self->input2_stream = (Stream *)streamtmp;
         self->proc_func_ptr = InputFader_process_two;
 	}
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -21,6 +21,25 @@
 #include "interpolation.h"
 #include "pyomodule.h"
 #include <math.h>
+#include <string.h>
+
+/* Half a cosine period, from 0 to 1, (1 - cos(x * pi)) / 2 sampled at
+** INTERP_COS_SIZE + 1 points and read with linear interpolation. The
+** error is below the precision of a float. */
+#define INTERP_COS_SIZE 4096
+static MYFLT INTERP_COS_TABLE[INTERP_COS_SIZE + 1];
+
+static inline MYFLT
+interp_cos_curve(MYFLT frac) {
+    MYFLT pos = frac * INTERP_COS_SIZE;
+    int ipart = (int)pos;
+    if (ipart < 0)
+        ipart = 0;
+    else if (ipart > (INTERP_COS_SIZE - 1))
+        ipart = INTERP_COS_SIZE - 1;
+    pos -= ipart;
+    return INTERP_COS_TABLE[ipart] + (INTERP_COS_TABLE[ipart+1] - INTERP_COS_TABLE[ipart]) * pos;
+}
 
 MYFLT nointerp(MYFLT *buf, int index, MYFLT frac, int size) {
     return  buf[index];
@@ -37,7 +56,7 @@ MYFLT cosine(MYFLT *buf, int index, MYFLT frac, int size) {
     MYFLT x1 = buf[index];
     MYFLT x2 = buf[index+1];
 
-    frac2 = (1.0 - MYCOS(frac * M_PI)) * 0.5;
+    frac2 = interp_cos_curve(frac);
     return (x1 + (x2 - x1) * frac2);
 }
 
@@ -65,4 +84,203 @@ MYFLT cubic(MYFLT *buf, int index, MYFLT frac, int size) {
     a0 *= frac; a1 *= frac; a2 *= frac; a3 *= frac; a1 += 1.0;
 
     return (a0*x0+a1*x1+a2*x2+a3*x3);
-}
\ No newline at end of file
+}
+
+/******************************************************
+**  Block functions. The vector versions process 8
+**  positions at a time, the samples are gathered with
+**  the AVX2 gather instructions when the cpu supports
+**  them, with scalar loads otherwise. They return the
+**  same values as the functions above.
+****************************************************** */
+#define INTERP_BLOCK_SCALAR(name, func) \
+static void \
+name##_block_scalar(MYFLT *buf, int size, const int *index, const MYFLT *frac, MYFLT *out, int num) { \
+    int i; \
+    for (i=0; i<num; i++) \
+        out[i] = func(buf, index[i], frac[i], size); \
+}
+
+INTERP_BLOCK_SCALAR(nointerp, nointerp)
+INTERP_BLOCK_SCALAR(linear, linear)
+INTERP_BLOCK_SCALAR(cosine, cosine)
+INTERP_BLOCK_SCALAR(cubic, cubic)
+
+static interp_block_func interp_block_funcs[4] = {nointerp_block_scalar, linear_block_scalar,
+                                                  cosine_block_scalar, cubic_block_scalar};
+
+#if defined(__GNUC__)
+#define INTERP_VECTOR_EXT
+#define INTERP_LANES 8
+typedef MYFLT interp_vec __attribute__((vector_size(INTERP_LANES * sizeof(MYFLT))));
+typedef double interp_dvec __attribute__((vector_size(INTERP_LANES * sizeof(double))));
+typedef int interp_ivec __attribute__((vector_size(INTERP_LANES * sizeof(int))));
+typedef void (*interp_gather_func)(const MYFLT *, const interp_ivec *, interp_vec *);
+#if defined(__x86_64__) || defined(__i386__)
+#define INTERP_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/* Vectors are passed by address, the helpers are always inlined. */
+static inline __attribute__((always_inline)) void
+interp_gather_vector(const MYFLT *buf, const interp_ivec *index, interp_vec *v) {
+    int k;
+    for (k=0; k<INTERP_LANES; k++)
+        (*v)[k] = buf[(*index)[k]];
+}
+
+#ifdef INTERP_X86_SIMD
+__attribute__((target("avx2")))
+static inline void
+interp_gather_avx2(const MYFLT *buf, const interp_ivec *index, interp_vec *v) {
+    __m256i ix;
+    memcpy(&ix, index, sizeof(ix));
+#ifdef USE_DOUBLE
+    __m256d lo = _mm256_i32gather_pd(buf, _mm256_castsi256_si128(ix), sizeof(MYFLT));
+    __m256d hi = _mm256_i32gather_pd(buf, _mm256_extracti128_si256(ix, 1), sizeof(MYFLT));
+    memcpy(v, &lo, sizeof(lo));
+    memcpy((char *)v + sizeof(lo), &hi, sizeof(hi));
+#else
+    __m256 r = _mm256_i32gather_ps(buf, ix, sizeof(MYFLT));
+    memcpy(v, &r, sizeof(r));
+#endif
+}
+#endif
+
+static inline __attribute__((always_inline)) void
+nointerp_block_body(MYFLT *buf, int size, const int *index, const MYFLT *frac, MYFLT *out, int num,
+                    interp_gather_func gather) {
+    int i;
+    interp_ivec ix;
+    interp_vec x;
+    for (i=0; i+INTERP_LANES<=num; i+=INTERP_LANES) {
+        memcpy(&ix, index + i, sizeof(ix));
+        gather(buf, &ix, &x);
+        memcpy(out + i, &x, sizeof(x));
+    }
+    nointerp_block_scalar(buf, size, index + i, frac + i, out + i, num - i);
+}
+
+static inline __attribute__((always_inline)) void
+linear_block_body(MYFLT *buf, int size, const int *index, const MYFLT *frac, MYFLT *out, int num,
+                  interp_gather_func gather) {
+    int i;
+    interp_ivec ix;
+    interp_vec x1, x2, f;
+    for (i=0; i+INTERP_LANES<=num; i+=INTERP_LANES) {
+        memcpy(&ix, index + i, sizeof(ix));
+        memcpy(&f, frac + i, sizeof(f));
+        gather(buf, &ix, &x1);
+        gather(buf + 1, &ix, &x2);
+        x1 += (x2 - x1) * f;
+        memcpy(out + i, &x1, sizeof(x1));
+    }
+    linear_block_scalar(buf, size, index + i, frac + i, out + i, num - i);
+}
+
+static inline __attribute__((always_inline)) void
+cosine_block_body(MYFLT *buf, int size, const int *index, const MYFLT *frac, MYFLT *out, int num,
+                  interp_gather_func gather) {
+    int i;
+    interp_ivec ix, cix, mask;
+    interp_vec x1, x2, pos, c1, c2;
+    const interp_ivec zero = {0}, top = zero + (INTERP_COS_SIZE - 1);
+    for (i=0; i+INTERP_LANES<=num; i+=INTERP_LANES) {
+        memcpy(&pos, frac + i, sizeof(pos));
+        pos *= (MYFLT)INTERP_COS_SIZE;
+        cix = __builtin_convertvector(pos, interp_ivec);
+        mask = cix < zero;
+        cix &= ~mask;
+        mask = cix > top;
+        cix = (cix & ~mask) | (top & mask);
+        pos -= __builtin_convertvector(cix, interp_vec);
+        gather(INTERP_COS_TABLE, &cix, &c1);
+        gather(INTERP_COS_TABLE + 1, &cix, &c2);
+        memcpy(&ix, index + i, sizeof(ix));
+        gather(buf, &ix, &x1);
+        gather(buf + 1, &ix, &x2);
+        x1 += (x2 - x1) * (c1 + (c2 - c1) * pos);
+        memcpy(out + i, &x1, sizeof(x1));
+    }
+    cosine_block_scalar(buf, size, index + i, frac + i, out + i, num - i);
+}
+
+static inline __attribute__((always_inline)) void
+cubic_block_body(MYFLT *buf, int size, const int *index, const MYFLT *frac, MYFLT *out, int num,
+                 interp_gather_func gather) {
+    int i, k, edge;
+    interp_ivec ix;
+    interp_vec x0, x1, x2, x3, a0, a1, a2, a3, f;
+    for (i=0; i+INTERP_LANES<=num; i+=INTERP_LANES) {
+        memcpy(&ix, index + i, sizeof(ix));
+        /* The first and last points are extrapolated by the scalar version. */
+        edge = 0;
+        for (k=0; k<INTERP_LANES; k++)
+            edge |= ix[k] <= 0 || ix[k] >= (size-2);
+        if (edge) {
+            cubic_block_scalar(buf, size, index + i, frac + i, out + i, INTERP_LANES);
+            continue;
+        }
+        gather(buf - 1, &ix, &x0);
+        gather(buf, &ix, &x1);
+        gather(buf + 1, &ix, &x2);
+        gather(buf + 2, &ix, &x3);
+        memcpy(&f, frac + i, sizeof(f));
+        /* Same roundings as the scalar version, where 1.0 / 6.0 is a double. */
+        a3 = f * f; a3 -= 1;
+        a3 = __builtin_convertvector(__builtin_convertvector(a3, interp_dvec) * (1.0 / 6.0), interp_vec);
+        a2 = (f + 1) * (MYFLT)0.5; a0 = a2 - 1;
+        a1 = a3 * 3; a2 -= a1; a0 -= a3; a1 -= f;
+        a0 *= f; a1 *= f; a2 *= f; a3 *= f; a1 += 1;
+        x0 = a0*x0+a1*x1+a2*x2+a3*x3;
+        memcpy(out + i, &x0, sizeof(x0));
+    }
+    cubic_block_scalar(buf, size, index + i, frac + i, out + i, num - i);
+}
+
+#define INTERP_BLOCK_KERNELS(suffix, attr, gather) \
+attr static void nointerp_block_##suffix(MYFLT *b, int s, const int *ix, const MYFLT *f, MYFLT *o, int n) \
+    { nointerp_block_body(b, s, ix, f, o, n, gather); } \
+attr static void linear_block_##suffix(MYFLT *b, int s, const int *ix, const MYFLT *f, MYFLT *o, int n) \
+    { linear_block_body(b, s, ix, f, o, n, gather); } \
+attr static void cosine_block_##suffix(MYFLT *b, int s, const int *ix, const MYFLT *f, MYFLT *o, int n) \
+    { cosine_block_body(b, s, ix, f, o, n, gather); } \
+attr static void cubic_block_##suffix(MYFLT *b, int s, const int *ix, const MYFLT *f, MYFLT *o, int n) \
+    { cubic_block_body(b, s, ix, f, o, n, gather); }
+
+INTERP_BLOCK_KERNELS(vector, , interp_gather_vector)
+#ifdef INTERP_X86_SIMD
+INTERP_BLOCK_KERNELS(avx2, __attribute__((target("avx2"))), interp_gather_avx2)
+#endif
+#endif
+
+interp_block_func
+interp_get_block_func(int interp) {
+    if (interp < 1 || interp > 4)
+        interp = 2;
+    return interp_block_funcs[interp - 1];
+}
+
+void
+interp_init(void) {
+    int i;
+
+    for (i=0; i<=INTERP_COS_SIZE; i++)
+        INTERP_COS_TABLE[i] = (1.0 - cos(PI * i / INTERP_COS_SIZE)) * 0.5;
+
+#ifdef INTERP_VECTOR_EXT
+    interp_block_funcs[0] = nointerp_block_vector;
+    interp_block_funcs[1] = linear_block_vector;
+    interp_block_funcs[2] = cosine_block_vector;
+    interp_block_funcs[3] = cubic_block_vector;
+#ifdef INTERP_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        interp_block_funcs[0] = nointerp_block_avx2;
+        interp_block_funcs[1] = linear_block_avx2;
+        interp_block_funcs[2] = cosine_block_avx2;
+        interp_block_funcs[3] = cubic_block_avx2;
+    }
+#endif
+#endif
+}
@@ -29,6 +29,8 @@
 typedef struct {
     pyo_audio_HEAD
     PyObject *input;
+    Stream **streams; /* streams of the input objects, taken at creation */
+    int count;
     int modebuffer[2];
 } Mix;
 
@@ -84,15 +86,12 @@ Mix_compute_next_data_frame(Mix *self)
 {
     int i, j;
     MYFLT old;
-    PyObject *stream;
-    Py_ssize_t lsize = PyList_Size(self->input);
 
     MYFLT buffer[self->bufsize];
     memset(&buffer, 0, sizeof(buffer));
 
-    for (i=0; i<lsize; i++) {
-        stream = PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->input, i), "_getStream", NULL);
-        MYFLT *in = Stream_getData((Stream *)stream);
+    for (i=0; i<self->count; i++) {
+        MYFLT *in = Stream_getData(self->streams[i]);
         for (j=0; j<self->bufsize; j++) {
             old = buffer[j];
             buffer[j] = in[j] + old;
@@ -109,16 +108,24 @@ Mix_compute_next_data_frame(Mix *self)
 static int
 Mix_traverse(Mix *self, visitproc visit, void *arg)
 {
+    int i;
     pyo_VISIT
     Py_VISIT(self->input);
+    for (i=0; i<self->count; i++) {
+        Py_VISIT(self->streams[i]);
+    }
     return 0;
 }
 
 static int
 Mix_clear(Mix *self)
 {
+    int i;
     pyo_CLEAR
     Py_CLEAR(self->input);
+    for (i=0; i<self->count; i++) {
+        Py_CLEAR(self->streams[i]);
+    }
     return 0;
 }
 
@@ -127,6 +134,7 @@ Mix_dealloc(Mix* self)
 {
     pyo_DEALLOC
     Mix_clear(self);
+    free(self->streams);
     self->ob_type->tp_free((PyObject*)self);
 }
 
@@ -154,6 +162,13 @@ Mix_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Py_XDECREF(self->input);
     self->input = inputtmp;
 
+    /* The processing doesn't call Python, it can run without the GIL. */
+    self->count = PyList_Size(self->input);
+    self->streams = (Stream **)malloc((self->count > 0 ? self->count : 1) * sizeof(Stream *));
+    for (i=0; i<self->count; i++) {
+        self->streams[i] = (Stream *)PyObject_CallMethod(PyList_GET_ITEM(self->input, i), "_getStream", NULL);
+    }
+
     if (multmp) {
         PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
     }
@@ -192,7 +207,7 @@ static PyObject * Mix_inplace_div(Mix *self, PyObject *arg) { INPLACE_DIV };
 static PyMemberDef Mix_members[] = {
     {"server", T_OBJECT_EX, offsetof(Mix, server), 0, "Pyo server."},
     {"stream", T_OBJECT_EX, offsetof(Mix, stream), 0, "Stream object."},
-    {"input", T_OBJECT_EX, offsetof(Mix, input), 0, "List of input signals to mix."},
+    {"input", T_OBJECT_EX, offsetof(Mix, input), READONLY, "List of input signals to mix."},
     {"mul", T_OBJECT_EX, offsetof(Mix, mul), 0, "Mul factor."},
     {"add", T_OBJECT_EX, offsetof(Mix, add), 0, "Add factor."},
     {NULL}  /* Sentinel */
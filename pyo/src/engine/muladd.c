@@ -0,0 +1,145 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "pyomodule.h"
+#include <string.h>
+
+PyoMulAddFuncs pyo_muladd;
+
+/* Same values as the double comparisons of the scalar code, 0.00001f is
+** slightly below 0.00001. */
+#ifdef USE_DOUBLE
+#define MULADD_TINY(x) ((x) < 0.00001 && (x) > -0.00001)
+#else
+#define MULADD_TINY(x) ((x) <= (MYFLT)0.00001 && (x) >= (MYFLT)-0.00001)
+#endif
+
+/* Every kernel is the body below, specialized by the constant arguments:
+** mul and add are arrays if not NULL, numbers (mulv, addv) otherwise, div
+** divides by mul and sub subtracts add. */
+static inline void
+muladd_scalar_body(MYFLT *data, int start, int size, const MYFLT *mul, MYFLT mulv,
+                   const MYFLT *add, MYFLT addv, int div, int sub)
+{
+    int i;
+    MYFLT m, a;
+
+    for (i=start; i<size; i++) {
+        m = mul != NULL ? mul[i] : mulv;
+        a = add != NULL ? add[i] : addv;
+        if (div) {
+            if (MULADD_TINY(m))
+                m = 0.00001;
+            data[i] = sub ? data[i] / m - a : data[i] / m + a;
+        }
+        else
+            data[i] = sub ? m * data[i] - a : m * data[i] + a;
+    }
+}
+
+#if defined(__GNUC__)
+#define MULADD_VECTOR_EXT
+#define MULADD_LANES 8
+typedef MYFLT muladd_vec __attribute__((vector_size(MULADD_LANES * sizeof(MYFLT))));
+#ifdef USE_DOUBLE
+typedef long long muladd_ivec __attribute__((vector_size(MULADD_LANES * sizeof(MYFLT))));
+#else
+typedef int muladd_ivec __attribute__((vector_size(MULADD_LANES * sizeof(MYFLT))));
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#define MULADD_X86_SIMD
+#endif
+
+static inline __attribute__((always_inline)) void
+muladd_vector_body(MYFLT *data, int size, const MYFLT *mul, MYFLT mulv,
+                   const MYFLT *add, MYFLT addv, int div, int sub)
+{
+    int i;
+    muladd_vec x, m, a, zero = {0};
+    muladd_ivec tiny;
+    const muladd_vec small = zero + (MYFLT)0.00001;
+
+    m = zero + mulv;
+    a = zero + addv;
+    for (i=0; i+MULADD_LANES<=size; i+=MULADD_LANES) {
+        memcpy(&x, data + i, sizeof(muladd_vec));
+        if (mul != NULL)
+            memcpy(&m, mul + i, sizeof(muladd_vec));
+        if (add != NULL)
+            memcpy(&a, add + i, sizeof(muladd_vec));
+        if (div) {
+            /* Branchless version of the clamp. */
+#ifdef USE_DOUBLE
+            tiny = (m < small) & (m > -small);
+#else
+            tiny = (m <= small) & (m >= -small);
+#endif
+            m = (muladd_vec)(((muladd_ivec)m & ~tiny) | ((muladd_ivec)small & tiny));
+            x = sub ? x / m - a : x / m + a;
+        }
+        else
+            x = sub ? m * x - a : m * x + a;
+        memcpy(data + i, &x, sizeof(muladd_vec));
+    }
+    muladd_scalar_body(data, i, size, mul, mulv, add, addv, div, sub);
+}
+
+#define MULADD_BODY(d, n, m, mv, a, av, div, sub) muladd_vector_body(d, n, m, mv, a, av, div, sub)
+#else
+#define MULADD_BODY(d, n, m, mv, a, av, div, sub) muladd_scalar_body(d, 0, n, m, mv, a, av, div, sub)
+#endif
+
+#define MULADD_KERNELS(suffix, attr, BODY) \
+attr static void muladd_ii_##suffix(MYFLT *d, int n, MYFLT m, MYFLT a) { BODY(d, n, NULL, m, NULL, a, 0, 0); } \
+attr static void muladd_ai_##suffix(MYFLT *d, int n, const MYFLT *m, MYFLT a) { BODY(d, n, m, 0, NULL, a, 0, 0); } \
+attr static void muladd_ia_##suffix(MYFLT *d, int n, MYFLT m, const MYFLT *a) { BODY(d, n, NULL, m, a, 0, 0, 0); } \
+attr static void muladd_aa_##suffix(MYFLT *d, int n, const MYFLT *m, const MYFLT *a) { BODY(d, n, m, 0, a, 0, 0, 0); } \
+attr static void muladd_revai_##suffix(MYFLT *d, int n, const MYFLT *m, MYFLT a) { BODY(d, n, m, 0, NULL, a, 1, 0); } \
+attr static void muladd_revaa_##suffix(MYFLT *d, int n, const MYFLT *m, const MYFLT *a) { BODY(d, n, m, 0, a, 0, 1, 0); } \
+attr static void muladd_ireva_##suffix(MYFLT *d, int n, MYFLT m, const MYFLT *a) { BODY(d, n, NULL, m, a, 0, 0, 1); } \
+attr static void muladd_areva_##suffix(MYFLT *d, int n, const MYFLT *m, const MYFLT *a) { BODY(d, n, m, 0, a, 0, 0, 1); } \
+attr static void muladd_revareva_##suffix(MYFLT *d, int n, const MYFLT *m, const MYFLT *a) { BODY(d, n, m, 0, a, 0, 1, 1); } \
+static const PyoMulAddFuncs muladd_funcs_##suffix = { \
+    muladd_ii_##suffix, muladd_ai_##suffix, muladd_ia_##suffix, muladd_aa_##suffix, muladd_revai_##suffix, \
+    muladd_revaa_##suffix, muladd_ireva_##suffix, muladd_areva_##suffix, muladd_revareva_##suffix };
+
+#define MULADD_SCALAR_BODY(d, n, m, mv, a, av, div, sub) muladd_scalar_body(d, 0, n, m, mv, a, av, div, sub)
+
+MULADD_KERNELS(scalar, , MULADD_SCALAR_BODY)
+#ifdef MULADD_VECTOR_EXT
+MULADD_KERNELS(vector, , MULADD_BODY)
+#ifdef MULADD_X86_SIMD
+MULADD_KERNELS(avx, __attribute__((target("avx"))), MULADD_BODY)
+#endif
+#endif
+
+void
+PyoMulAdd_init(void)
+{
+    pyo_muladd = muladd_funcs_scalar;
+#ifdef MULADD_VECTOR_EXT
+    pyo_muladd = muladd_funcs_vector;
+#ifdef MULADD_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx"))
+        pyo_muladd = muladd_funcs_avx;
+#endif
+#endif
+}
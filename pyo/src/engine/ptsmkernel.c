@@ -0,0 +1,526 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+/******************************************************
+**  Gaussian force/potential kernels used by the
+**  particle trajectory sonification objects (PTSM).
+**
+**  The dataset is stored as a structure of arrays, one
+**  contiguous row per dimension, and processed in
+**  blocks of PTSM_BLOCK points. A first pass computes
+**  the squared distances and the weights of a block, a
+**  second pass accumulates the weighted offsets of each
+**  dimension. The SIMD kernels (AVX2+FMA, AVX-512F) use
+**  a polynomial exp approximation accurate to a few
+**  ulps and are selected at runtime.
+****************************************************** */
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ptsmkernel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PTSM_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/* Number of points processed per block, must be a multiple of 8. */
+#define PTSM_BLOCK 128
+
+/* exp(x) = 2^n * exp(r), x = n * ln2 + r, |r| <= ln2 / 2 */
+#define PTSM_LOG2E 1.44269504088896340736
+#define PTSM_LN2_HI 6.93147180369123816490e-01
+#define PTSM_LN2_LO 1.90821492927058770002e-10
+/* Below this value, exp(x) is flushed to zero. */
+#define PTSM_EXP_MIN -708.0
+
+static double
+ptsm_kernel_scalar(const double *soa, int stride, int dim, int start, int end,
+                   const double *pos, double scale, double *acc)
+{
+    int b, j, k, n;
+    double d, p, s, sum = 0.0;
+    const double *row;
+    double wbuf[PTSM_BLOCK];
+
+    for (b=start; b<end; b+=PTSM_BLOCK) {
+        n = (end - b) < PTSM_BLOCK ? (end - b) : PTSM_BLOCK;
+        for (j=0; j<n; j++)
+            wbuf[j] = 0.0;
+        for (k=0; k<dim; k++) {
+            row = soa + k * stride + b;
+            p = pos[k];
+            for (j=0; j<n; j++) {
+                d = row[j] - p;
+                wbuf[j] += d * d;
+            }
+        }
+        for (j=0; j<n; j++) {
+            wbuf[j] = exp(-scale * wbuf[j]);
+            sum += wbuf[j];
+        }
+        if (acc != NULL) {
+            for (k=0; k<dim; k++) {
+                row = soa + k * stride + b;
+                p = pos[k];
+                s = 0.0;
+                for (j=0; j<n; j++)
+                    s += (row[j] - p) * wbuf[j];
+                acc[k] += s;
+            }
+        }
+    }
+    return sum;
+}
+
+#ifdef PTSM_X86_SIMD
+
+__attribute__((target("avx2,fma")))
+static inline __m256d
+ptsm_exp_avx2(__m256d x)
+{
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0); /* 1.5 * 2^52 */
+    __m256d t, n, r, p, valid;
+    __m256i e;
+
+    valid = _mm256_cmp_pd(x, _mm256_set1_pd(PTSM_EXP_MIN), _CMP_GE_OQ);
+    x = _mm256_max_pd(x, _mm256_set1_pd(PTSM_EXP_MIN));
+    /* Rounds x * log2(e) to the nearest integer, kept in the low mantissa bits of t. */
+    t = _mm256_fmadd_pd(x, _mm256_set1_pd(PTSM_LOG2E), magic);
+    n = _mm256_sub_pd(t, magic);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(PTSM_LN2_HI), x);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(PTSM_LN2_LO), r);
+    p = _mm256_set1_pd(1.0 / 479001600.0);
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 39916800.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 3628800.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 362880.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 40320.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 5040.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 720.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 120.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 24.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 6.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(0.5));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0));
+    /* 2^n, the shift drops the magic number bits. */
+    e = _mm256_slli_epi64(_mm256_add_epi64(_mm256_castpd_si256(t), _mm256_set1_epi64x(1023)), 52);
+    p = _mm256_mul_pd(p, _mm256_castsi256_pd(e));
+    return _mm256_and_pd(p, valid);
+}
+
+__attribute__((target("avx2,fma")))
+static inline double
+ptsm_hsum_avx2(__m256d x)
+{
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+__attribute__((target("avx2,fma")))
+static double
+ptsm_kernel_avx2(const double *soa, int stride, int dim, int start, int end,
+                 const double *pos, double scale, double *acc)
+{
+    int b, j, k, n;
+    const double *row;
+    __m256d p, d, dsq, w, s, vsum, nscale;
+    __m256i mask;
+    double wbuf[PTSM_BLOCK] __attribute__((aligned(32)));
+    const __m256i lanes = _mm256_set_epi64x(3, 2, 1, 0);
+
+    vsum = _mm256_setzero_pd();
+    nscale = _mm256_set1_pd(-scale);
+    for (b=start; b<end; b+=PTSM_BLOCK) {
+        n = (end - b) < PTSM_BLOCK ? (end - b) : PTSM_BLOCK;
+        for (j=0; j<n; j+=4) {
+            dsq = _mm256_setzero_pd();
+            if ((n - j) >= 4) {
+                for (k=0; k<dim; k++) {
+                    d = _mm256_sub_pd(_mm256_loadu_pd(soa + k * stride + b + j), _mm256_set1_pd(pos[k]));
+                    dsq = _mm256_fmadd_pd(d, d, dsq);
+                }
+                w = ptsm_exp_avx2(_mm256_mul_pd(nscale, dsq));
+            }
+            else {
+                mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(n - j), lanes);
+                for (k=0; k<dim; k++) {
+                    d = _mm256_sub_pd(_mm256_maskload_pd(soa + k * stride + b + j, mask), _mm256_set1_pd(pos[k]));
+                    dsq = _mm256_fmadd_pd(d, d, dsq);
+                }
+                w = _mm256_and_pd(ptsm_exp_avx2(_mm256_mul_pd(nscale, dsq)), _mm256_castsi256_pd(mask));
+            }
+            _mm256_store_pd(wbuf + j, w);
+            vsum = _mm256_add_pd(vsum, w);
+        }
+        if (acc != NULL) {
+            for (k=0; k<dim; k++) {
+                row = soa + k * stride + b;
+                p = _mm256_set1_pd(pos[k]);
+                s = _mm256_setzero_pd();
+                for (j=0; j<=(n-4); j+=4) {
+                    d = _mm256_sub_pd(_mm256_loadu_pd(row + j), p);
+                    s = _mm256_fmadd_pd(d, _mm256_load_pd(wbuf + j), s);
+                }
+                if (j < n) {
+                    mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(n - j), lanes);
+                    d = _mm256_sub_pd(_mm256_maskload_pd(row + j, mask), p);
+                    s = _mm256_fmadd_pd(d, _mm256_load_pd(wbuf + j), s);
+                }
+                acc[k] += ptsm_hsum_avx2(s);
+            }
+        }
+    }
+    return ptsm_hsum_avx2(vsum);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512d
+ptsm_exp_avx512(__m512d x)
+{
+    __m512d n, r, p;
+
+    /* Anything below -1000 underflows to zero in scalef. */
+    x = _mm512_max_pd(x, _mm512_set1_pd(-1000.0));
+    n = _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(PTSM_LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    r = _mm512_fnmadd_pd(n, _mm512_set1_pd(PTSM_LN2_HI), x);
+    r = _mm512_fnmadd_pd(n, _mm512_set1_pd(PTSM_LN2_LO), r);
+    p = _mm512_set1_pd(1.0 / 479001600.0);
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 39916800.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 3628800.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 362880.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 40320.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 5040.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 720.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 120.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 24.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 6.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(0.5));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0));
+    return _mm512_scalef_pd(p, n);
+}
+
+__attribute__((target("avx512f")))
+static double
+ptsm_kernel_avx512(const double *soa, int stride, int dim, int start, int end,
+                   const double *pos, double scale, double *acc)
+{
+    int b, j, k, n;
+    const double *row;
+    __m512d p, d, dsq, s, w, vsum, nscale;
+    __mmask8 mask;
+    double wbuf[PTSM_BLOCK] __attribute__((aligned(64)));
+
+    vsum = _mm512_setzero_pd();
+    nscale = _mm512_set1_pd(-scale);
+    for (b=start; b<end; b+=PTSM_BLOCK) {
+        n = (end - b) < PTSM_BLOCK ? (end - b) : PTSM_BLOCK;
+        for (j=0; j<n; j+=8) {
+            mask = (n - j) >= 8 ? 0xFF : (__mmask8)((1 << (n - j)) - 1);
+            dsq = _mm512_setzero_pd();
+            for (k=0; k<dim; k++) {
+                d = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, soa + k * stride + b + j), _mm512_set1_pd(pos[k]));
+                dsq = _mm512_fmadd_pd(d, d, dsq);
+            }
+            w = _mm512_maskz_mov_pd(mask, ptsm_exp_avx512(_mm512_mul_pd(nscale, dsq)));
+            _mm512_store_pd(wbuf + j, w);
+            vsum = _mm512_add_pd(vsum, w);
+        }
+        if (acc != NULL) {
+            for (k=0; k<dim; k++) {
+                row = soa + k * stride + b;
+                p = _mm512_set1_pd(pos[k]);
+                s = _mm512_setzero_pd();
+                for (j=0; j<n; j+=8) {
+                    mask = (n - j) >= 8 ? 0xFF : (__mmask8)((1 << (n - j)) - 1);
+                    d = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, row + j), p);
+                    s = _mm512_fmadd_pd(d, _mm512_load_pd(wbuf + j), s);
+                }
+                acc[k] += _mm512_reduce_add_pd(s);
+            }
+        }
+    }
+    return _mm512_reduce_add_pd(vsum);
+}
+
+#endif
+
+int
+ptsm_kernel_available(int kernel)
+{
+    switch (kernel) {
+        case PTSM_KERNEL_AUTO:
+        case PTSM_KERNEL_SCALAR:
+            return 1;
+#ifdef PTSM_X86_SIMD
+        case PTSM_KERNEL_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case PTSM_KERNEL_AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return 0;
+    }
+}
+
+int
+ptsm_kernel_resolve(int kernel)
+{
+    if (kernel != PTSM_KERNEL_AUTO && ptsm_kernel_available(kernel))
+        return kernel;
+    if (ptsm_kernel_available(PTSM_KERNEL_AVX512))
+        return PTSM_KERNEL_AVX512;
+    if (ptsm_kernel_available(PTSM_KERNEL_AVX2))
+        return PTSM_KERNEL_AVX2;
+    return PTSM_KERNEL_SCALAR;
+}
+
+ptsm_kernel_func
+ptsm_get_kernel(int kernel)
+{
+    switch (ptsm_kernel_resolve(kernel)) {
+#ifdef PTSM_X86_SIMD
+        case PTSM_KERNEL_AVX512:
+            return ptsm_kernel_avx512;
+        case PTSM_KERNEL_AVX2:
+            return ptsm_kernel_avx2;
+#endif
+        default:
+            return ptsm_kernel_scalar;
+    }
+}
+
+const char *
+ptsm_kernel_name(int kernel)
+{
+    switch (kernel) {
+        case PTSM_KERNEL_SCALAR:
+            return "scalar";
+        case PTSM_KERNEL_AVX2:
+            return "avx2";
+        case PTSM_KERNEL_AVX512:
+            return "avx512";
+        default:
+            return "auto";
+    }
+}
+
+/* Number of points per block in the batch computation, about 64KB of data for 32 dimensions. */
+#define PTSM_BATCH_BLOCK 256
+
+void
+ptsm_batch_sum(ptsm_kernel_func kernel, const double *soa, int stride, int dim, int start, int end,
+               int nparticles, const double *pos, const char *active, double scale,
+               double *sums, double *acc)
+{
+    int b, m, bend;
+    double sum;
+
+    for (b=start; b<end; b+=PTSM_BATCH_BLOCK) {
+        bend = (end - b) < PTSM_BATCH_BLOCK ? end : (b + PTSM_BATCH_BLOCK);
+        for (m=0; m<nparticles; m++) {
+            if (active != NULL && !active[m])
+                continue;
+            sum = (*kernel)(soa, stride, dim, b, bend, pos + m * dim, scale, acc == NULL ? NULL : acc + m * dim);
+            if (sums != NULL)
+                sums[m] += sum;
+        }
+    }
+}
+
+void
+ptsm_to_soa(const double *rows, int npoints, int dim, double *soa, int stride)
+{
+    int j, k;
+    for (j=0; j<npoints; j++) {
+        for (k=0; k<dim; k++)
+            soa[k * stride + j] = rows[j * dim + k];
+    }
+}
+
+/******************************************************
+**  k-d tree spatial index. Nodes are split at the
+**  median of their widest dimension until they hold at
+**  most PTSM_LEAF_SIZE points. The dataset is reordered
+**  so that every node is a contiguous range of points,
+**  which lets the kernels run unchanged on the leaves.
+****************************************************** */
+#define PTSM_LEAF_SIZE 64
+#define PTSM_TREE_STACK 128
+
+static void
+ptsm_tree_select(const double *row, int *idx, int start, int end, int nth)
+{
+    int i, j, tmp;
+    double pivot;
+
+    end--;
+    while (end > start) {
+        pivot = row[idx[(start + end) / 2]];
+        i = start;
+        j = end;
+        while (i <= j) {
+            while (row[idx[i]] < pivot) i++;
+            while (row[idx[j]] > pivot) j--;
+            if (i <= j) {
+                tmp = idx[i]; idx[i] = idx[j]; idx[j] = tmp;
+                i++;
+                j--;
+            }
+        }
+        if (nth <= j)
+            end = j;
+        else if (nth >= i)
+            start = i;
+        else
+            break;
+    }
+}
+
+static int
+ptsm_tree_build(PtsmTree *tree, const double *soa, int stride, int *idx, int start, int end)
+{
+    int j, k, node, split = 0, mid, left, right;
+    double x, width, maxwidth = -1.0;
+    double *lo, *hi;
+
+    if (tree->nnodes == tree->size) {
+        tree->size *= 2;
+        tree->nodes = (PtsmNode *)realloc(tree->nodes, tree->size * sizeof(PtsmNode));
+        tree->bounds = (double *)realloc(tree->bounds, tree->size * 2 * tree->dim * sizeof(double));
+    }
+    node = tree->nnodes++;
+    tree->nodes[node].start = start;
+    tree->nodes[node].end = end;
+    tree->nodes[node].left = tree->nodes[node].right = -1;
+
+    lo = tree->bounds + node * 2 * tree->dim;
+    hi = lo + tree->dim;
+    for (k=0; k<tree->dim; k++) {
+        lo[k] = hi[k] = soa[k * stride + idx[start]];
+        for (j=start+1; j<end; j++) {
+            x = soa[k * stride + idx[j]];
+            if (x < lo[k])
+                lo[k] = x;
+            else if (x > hi[k])
+                hi[k] = x;
+        }
+        width = hi[k] - lo[k];
+        if (width > maxwidth) {
+            maxwidth = width;
+            split = k;
+        }
+    }
+
+    if ((end - start) <= PTSM_LEAF_SIZE || maxwidth <= 0.0)
+        return node;
+
+    mid = (start + end) / 2;
+    ptsm_tree_select(soa + split * stride, idx, start, end, mid);
+    left = ptsm_tree_build(tree, soa, stride, idx, start, mid);
+    right = ptsm_tree_build(tree, soa, stride, idx, mid, end);
+    tree->nodes[node].left = left;
+    tree->nodes[node].right = right;
+    return node;
+}
+
+PtsmTree *
+ptsm_tree_new(double *soa, int npoints, int dim, int stride)
+{
+    int j, k;
+    int *idx;
+    double *row;
+    PtsmTree *tree;
+
+    tree = (PtsmTree *)malloc(sizeof(PtsmTree));
+    tree->dim = dim;
+    tree->nnodes = 0;
+    tree->size = 2 * (npoints / PTSM_LEAF_SIZE) + 2;
+    tree->nodes = (PtsmNode *)malloc(tree->size * sizeof(PtsmNode));
+    tree->bounds = (double *)malloc(tree->size * 2 * dim * sizeof(double));
+
+    idx = (int *)malloc(npoints * sizeof(int));
+    for (j=0; j<npoints; j++)
+        idx[j] = j;
+    ptsm_tree_build(tree, soa, stride, idx, 0, npoints);
+
+    row = (double *)malloc(npoints * sizeof(double));
+    for (k=0; k<dim; k++) {
+        for (j=0; j<npoints; j++)
+            row[j] = soa[k * stride + idx[j]];
+        memcpy(soa + k * stride, row, npoints * sizeof(double));
+    }
+    free(row);
+    free(idx);
+
+    return tree;
+}
+
+void
+ptsm_tree_free(PtsmTree *tree)
+{
+    if (tree == NULL)
+        return;
+    free(tree->nodes);
+    free(tree->bounds);
+    free(tree);
+}
+
+double
+ptsm_tree_sum(const PtsmTree *tree, ptsm_kernel_func kernel, const double *soa, int stride,
+              const double *pos, double scale, double radius, double *acc)
+{
+    int k, node, top = 0, dim = tree->dim;
+    int stack[PTSM_TREE_STACK];
+    double d, dsq, rsq, sum = 0.0;
+    const double *lo, *hi;
+    const PtsmNode *n;
+
+    rsq = radius * radius;
+    stack[top++] = 0;
+    while (top > 0) {
+        node = stack[--top];
+        n = &tree->nodes[node];
+        /* Squared distance from pos to the bounding box of the node. */
+        lo = tree->bounds + node * 2 * dim;
+        hi = lo + dim;
+        dsq = 0.0;
+        for (k=0; k<dim; k++) {
+            if (pos[k] < lo[k])
+                d = lo[k] - pos[k];
+            else if (pos[k] > hi[k])
+                d = pos[k] - hi[k];
+            else
+                continue;
+            dsq += d * d;
+        }
+        if (dsq > rsq)
+            continue;
+        if (n->left < 0 || top > (PTSM_TREE_STACK - 2))
+            sum += (*kernel)(soa, stride, dim, n->start, n->end, pos, scale, acc);
+        else {
+            stack[top++] = n->right;
+            stack[top++] = n->left;
+        }
+    }
+    return sum;
+}
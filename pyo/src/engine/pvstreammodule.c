@@ -25,6 +25,7 @@
 #define __PV_STREAM_MODULE
 #include "pvstreammodule.h"
 #undef __PV_STREAM_MODULE
+#include "dspgraph.h"
 
 /************************/
 /* PVStream object */
@@ -49,21 +50,26 @@ PVStream_getOlaps(PVStream *self)
     return self->olaps;
 }
 
+/* The frames are written by the owner's processing function, reading
+** them is reading the owner's stream. */
 MYFLT **
 PVStream_getMagn(PVStream *self)
 {
+    PYO_GRAPH_READ(self->owner);
     return (MYFLT **)self->magn;
 }
 
 MYFLT **
 PVStream_getFreq(PVStream *self)
 {
+    PYO_GRAPH_READ(self->owner);
     return (MYFLT **)self->freq;
 }
 
 int *
 PVStream_getCount(PVStream *self)
 {
+    PYO_GRAPH_READ(self->owner);
     return (int *)self->count;
 }
 
@@ -97,6 +103,13 @@ PVStream_setCount(PVStream *self, int *data)
     self->count = data;
 }
 
+/* Borrowed, the owner keeps the PVStream alive, not the other way around. */
+void
+PVStream_setOwner(PVStream *self, PyObject *stream)
+{
+    self->owner = stream;
+}
+
 PyTypeObject PVStreamType = {
     PyObject_HEAD_INIT(NULL)
     0, /*ob_size*/
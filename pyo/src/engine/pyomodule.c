@@ -28,6 +28,7 @@
 #include "dummymodule.h"
 #include "tablemodule.h"
 #include "matrixmodule.h"
+#include "interpolation.h"
 
 #ifdef USE_PORTAUDIO
 #include "ad_portaudio.h"
@@ -1887,6 +1888,8 @@ static PyMethodDef pyo_functions[] = {
 {"secToSamps", (PyCFunction)secToSamps, METH_O, secToSamps_info},
 {"serverCreated", (PyCFunction)serverCreated, METH_NOARGS, serverCreated_info},
 {"serverBooted", (PyCFunction)serverBooted, METH_NOARGS, serverBooted_info},
+{"currentServer", (PyCFunction)Server_get_current, METH_NOARGS, "Returns the server receiving the new objects, or None."},
+{"offlineBatch", (PyCFunction)Server_offline_batch, METH_VARARGS, "Renders offline servers concurrently, used by the OfflineBatch object."},
 {"withPortaudio", (PyCFunction)with_portaudio, METH_NOARGS, "Returns True if pyo is built with portaudio support."},
 {"withPortmidi", (PyCFunction)with_portmidi, METH_NOARGS, "Returns True if pyo is built with portmidi support."},
 {"withJack", (PyCFunction)with_jack, METH_NOARGS, "Returns True if pyo is built with jack support."},
@@ -1915,6 +1918,9 @@ init_pyo64(void)
 
     m = Py_InitModule3(LIB_BASE_NAME, pyo_functions, "Python digital signal processing module.");
 
+    PyoMulAdd_init();
+    interp_init();
+
 #ifndef NO_MESSAGES
 #ifndef USE_DOUBLE
     printf("pyo version %s (uses single precision)\n", PYO_VERSION);
@@ -1953,6 +1959,7 @@ init_pyo64(void)
     module_add_object(m, "Mix_base", &MixType);
     module_add_object(m, "Sig_base", &SigType);
     module_add_object(m, "SigTo_base", &SigToType);
+    module_add_object(m, "SigQueue_base", &SigQueueType);
     module_add_object(m, "VarPort_base", &VarPortType);
     module_add_object(m, "InputFader_base", &InputFaderType);
     module_add_object(m, "Adsr_base", &AdsrType);
@@ -2045,6 +2052,8 @@ init_pyo64(void)
     module_add_object(m, "BrownNoise_base", &BrownNoiseType);
     module_add_object(m, "Biquad_base", &BiquadType);
     module_add_object(m, "Biquadx_base", &BiquadxType);
+    module_add_object(m, "BiquadBankMain_base", &BiquadBankMainType);
+    module_add_object(m, "BiquadBank_base", &BiquadBankType);
     module_add_object(m, "Biquada_base", &BiquadaType);
     module_add_object(m, "EQ_base", &EQType);
     module_add_object(m, "Tone_base", &ToneType);
@@ -2229,6 +2238,9 @@ init_pyo64(void)
     module_add_object(m, "Expr_base", &ExprType);
     module_add_object(m, "PadSynthTable_base", &PadSynthTableType);
     module_add_object(m, "FIFOPlayer_base", &FIFOPlayerType);
+    module_add_object(m, "FIFOPlay_base", &FIFOPlayType);
+    module_add_object(m, "ParticleTrajectory_base", &ParticleTrajectoryType);
+    module_add_object(m, "PTSMData_base", &PTSMDataType);
 
     PyModule_AddStringConstant(m, "PYO_VERSION", PYO_VERSION);
 #ifdef COMPILE_EXTERNALS
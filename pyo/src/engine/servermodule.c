@@ -25,6 +25,11 @@
 #include <time.h>
 #include <stdlib.h>
 #include <pthread.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "structmember.h"
 #include "sndfile.h"
@@ -84,21 +89,33 @@ static int serverID = 0;
 /* Function called by any new pyo object to get a pointer to the current server. */
 PyObject * PyServer_get_server() { return (PyObject *)my_server[serverID]; };
 
+/* Module function, lets OfflineBatch give the current server back after its rendering. */
+PyObject *
+Server_get_current(PyObject *self)
+{
+    if (my_server[serverID] == NULL)
+        Py_RETURN_NONE;
+    Py_INCREF(my_server[serverID]);
+    return (PyObject *)my_server[serverID];
+}
+
 /** Random generator and object seeds. **/
 /****************************************/
 
-#define num_rnd_objs 29
-
 int rnd_objs_count[num_rnd_objs] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
 int rnd_objs_mult[num_rnd_objs] = {1993,1997,1999,2003,2011,2017,2027,2029,2039,2053,2063,2069,
                                    2081,2083,2087,2089,2099,2111,2113,2129,2131,2137,2141,2143,
                                    2153,2161,2179,2203,2207};
 
-/* Linear congruential pseudo-random generator. */
+/* Linear congruential pseudo-random generator. A thread rendering a batch
+** server uses the generator of that server instead of the global one. */
 static unsigned int PYO_RAND_SEED = 1u;
+static PYO_THREAD_LOCAL unsigned int *pyo_rand_state = NULL;
 unsigned int pyorand() {
-    PYO_RAND_SEED = (PYO_RAND_SEED * 1664525 + 1013904223) % PYO_RAND_MAX;
-    return PYO_RAND_SEED;
+    unsigned int *state = pyo_rand_state != NULL ? pyo_rand_state : &PYO_RAND_SEED;
+    PYO_GRAPH_WRITE(state);
+    *state = (*state * 1664525 + 1013904223) % PYO_RAND_MAX;
+    return *state;
 }
 
 /** Logging levels. **/
@@ -182,27 +199,137 @@ offline_process_block(Server *arg)
 int Server_offline_init(Server *self) { return 0; };
 int Server_offline_deinit(Server *self) { return 0; };
 
+/* Called at the end of a rendering. */
+static void
+Server_warnDroppedParams(Server *self)
+{
+    if (self->paramDropped > 0) {
+        Server_warning(self, "%lu parameter events were dropped, their object had too many pending events.\n", self->paramDropped);
+        self->paramDropped = 0;
+    }
+}
+
+/* Without a duration, a record buffer without callback is rendered once. */
+static double
+Server_offline_getDuration(Server *self)
+{
+    if (self->recdur < 0 && self->recbuf != NULL && self->recbufCallback == NULL)
+        return self->recbufFrames / self->samplingRate;
+    return self->recdur;
+}
+
+/* Called by the rendering thread. Returns 0 if there is no callback to empty the buffer. */
+static int
+Server_flushRecordBuffer(Server *self)
+{
+    PyObject *result;
+    PyGILState_STATE s;
+
+    if (self->recbufCallback == NULL)
+        return 0;
+    s = PyGILState_Ensure();
+    result = PyObject_CallFunction(self->recbufCallback, "i", self->recbufPos);
+    if (result == NULL)
+        PyErr_Print();
+    else
+        Py_DECREF(result);
+    PyGILState_Release(s);
+    self->recbufPos = 0;
+    return 1;
+}
+
+/* Copies a buffer of interleaved output samples to the record buffer. */
+static void
+Server_writeRecordBuffer(Server *self, float *out)
+{
+    int i, n, count = self->bufferSize;
+    int nchnls = self->nchnls;
+    double *dst;
+
+    while (count > 0) {
+        if (self->recbufPos == self->recbufFrames && !Server_flushRecordBuffer(self)) {
+            self->recbufLost += count;
+            return;
+        }
+        n = self->recbufFrames - self->recbufPos;
+        if (n > count)
+            n = count;
+        if (self->recbufDouble) {
+            dst = (double *)self->recbuf + self->recbufPos * nchnls;
+            for (i=0; i<n*nchnls; i++) {
+                dst[i] = out[i];
+            }
+        }
+        else
+            memcpy((float *)self->recbuf + self->recbufPos * nchnls, out, n * nchnls * sizeof(float));
+        out += n * nchnls;
+        self->recbufPos += n;
+        count -= n;
+    }
+}
+
+/* Offline renders write to the record buffer if there is one, to recpath otherwise. */
+static void
+Server_offline_recstart(Server *self)
+{
+    if (self->recbuf != NULL) {
+        self->recbufFrames = (int)(self->recview.len / self->recview.itemsize / self->nchnls);
+        self->recbufPos = 0;
+        self->recbufLost = 0;
+        self->record = 2;
+    }
+    /* Without a file name, the result is only in the objects (ie. TableRec). */
+    else if (self->recpath != NULL && self->recpath[0] != '\0')
+        Server_start_rec_internal(self, self->recpath);
+}
+
+static void
+Server_offline_recstop(Server *self)
+{
+    if (self->record != 2) {
+        Server_stop_rec_internal(self);
+        return;
+    }
+    self->record = 0;
+    if (self->recbufPos > 0)
+        Server_flushRecordBuffer(self);
+    /* A duration taken from the buffer is rounded to blocks, the tail is expected to be lost. */
+    if (self->recbufLost > 0 && self->recdur >= 0)
+        Server_warning(self, "Offline rendering: %lu frames didn't fit in the record buffer.\n", self->recbufLost);
+}
+
+static void
+Server_offline_message(Server *self, double dur)
+{
+    if (self->recbuf != NULL)
+        Server_message(self,"Offline Server rendering to memory dur=%f\n", dur);
+    else
+        Server_message(self,"Offline Server rendering file %s dur=%f\n", self->recpath, dur);
+}
+
 void
 *Server_offline_thread(void *arg)
 {
     int numBlocks;
+    double dur;
     Server *self;
     self = (Server *)arg;
 
-    if (self->recdur < 0) {
+    dur = Server_offline_getDuration(self);
+    if (dur < 0) {
         Server_error(self,"Duration must be specified for Offline Server (see Server.recordOptions).");
     }
     else {
-        Server_message(self,"Offline Server rendering file %s dur=%f\n", self->recpath, self->recdur);
-        numBlocks = ceil(self->recdur * self->samplingRate/self->bufferSize);
+        Server_offline_message(self, dur);
+        numBlocks = ceil(dur * self->samplingRate/self->bufferSize);
         Server_debug(self,"Number of blocks: %i\n", numBlocks);
-        Server_start_rec_internal(self, self->recpath);
+        Server_offline_recstart(self);
         while (numBlocks-- > 0 && self->server_stopped == 0) {
             offline_process_block((Server *) self);
         }
         self->server_started = 0;
-        self->record = 0;
-        sf_close(self->recfile);
+        Server_offline_recstop(self);
+        Server_warnDroppedParams(self);
         Server_message(self,"Offline Server rendering finished.\n");
     }
     return NULL;
@@ -220,22 +347,23 @@ int
 Server_offline_start(Server *self)
 {
     int numBlocks;
+    double dur = Server_offline_getDuration(self);
 
-    if (self->recdur < 0) {
+    if (dur < 0) {
         Server_error(self,"Duration must be specified for Offline Server (see Server.recordOptions).");
         return -1;
     }
-    Server_message(self,"Offline Server rendering file %s dur=%f\n", self->recpath, self->recdur);
-    numBlocks = ceil(self->recdur * self->samplingRate/self->bufferSize);
+    Server_offline_message(self, dur);
+    numBlocks = ceil(dur * self->samplingRate/self->bufferSize);
     Server_debug(self,"Number of blocks: %i\n", numBlocks);
-    Server_start_rec_internal(self, self->recpath);
+    Server_offline_recstart(self);
     while (numBlocks-- > 0 && self->server_stopped == 0) {
         offline_process_block((Server *) self);
     }
     self->server_started = 0;
     self->server_stopped = 1;
-    self->record = 0;
-    sf_close(self->recfile);
+    Server_offline_recstop(self);
+    Server_warnDroppedParams(self);
     Server_message(self,"Offline Server rendering finished.\n");
     return 0;
 }
@@ -326,39 +454,549 @@ Server_embedded_stop(Server *self)
     return 0;
 }
 
+/** GIL-free processing. **/
+/***************************/
+
+/* The audio thread publishes rtBusy before reading rtStreams and the Python
+** side publishes rtStreams before reading rtBusy, both need a full barrier. */
+#if defined(__GNUC__)
+#define SERVER_LOAD(x) __atomic_load_n(&(x), __ATOMIC_SEQ_CST)
+#define SERVER_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_SEQ_CST)
+#define SERVER_EXCHANGE(x, v) __atomic_exchange_n(&(x), (v), __ATOMIC_SEQ_CST)
+#define SERVER_FETCH_ADD(x, v) __atomic_fetch_add(&(x), (v), __ATOMIC_SEQ_CST)
+#else
+#define SERVER_LOAD(x) (__sync_synchronize(), (x))
+#define SERVER_STORE(x, v) do { __sync_synchronize(); (x) = (v); __sync_synchronize(); } while (0)
+#define SERVER_EXCHANGE(x, v) __sync_lock_test_and_set(&(x), (v))
+#define SERVER_FETCH_ADD(x, v) __sync_fetch_and_add(&(x), (v))
+#endif
+
+static void
+Server_sleep(int usec)
+{
+#ifdef _WIN32
+    Sleep(usec / 1000 > 0 ? usec / 1000 : 1);
+#else
+    usleep(usec);
+#endif
+}
+
+/* Called with the GIL. Waits, without the GIL, until the audio thread is
+** done with the stream array it may have loaded before this call. */
+void
+Server_waitForCallback(Server *self)
+{
+    unsigned int epoch = SERVER_LOAD(self->rtEpoch);
+
+    if (SERVER_LOAD(self->rtBusy) == 0)
+        return;
+
+    Py_BEGIN_ALLOW_THREADS
+    while (SERVER_LOAD(self->rtBusy) && SERVER_LOAD(self->rtEpoch) == epoch)
+        Server_sleep(50);
+    Py_END_ALLOW_THREADS
+}
+
+/* A callback starting after the exchange sees the new value, the one that
+** may have loaded the old value is waited for. */
+void *
+Server_swapPointer(Server *self, void **ptr, void *value)
+{
+    void *old = SERVER_EXCHANGE(*ptr, value);
+
+    Server_waitForCallback(self);
+    return old;
+}
+
+static void
+Server_releaseStreams(PyoStreamArray *array)
+{
+    int i;
+
+    for (i=0; i<array->count; i++) {
+        Py_DECREF(array->streams[i]);
+    }
+    PyoGraph_free(array->graph);
+    free(array);
+}
+
+/* Called with the GIL after every change to self->streams. The array holds
+** a reference to each stream until the audio thread can no longer use it. */
+static void
+Server_publishStreams(Server *self, int enable)
+{
+    int i;
+    PyoStreamArray *array = NULL, *old;
+
+    if (enable) {
+        array = (PyoStreamArray *)malloc(sizeof(PyoStreamArray) + self->stream_count * sizeof(Stream *));
+        array->next = NULL;
+        array->count = self->stream_count;
+        for (i=0; i<self->stream_count; i++) {
+            array->streams[i] = (Stream *)PyList_GET_ITEM(self->streams, i);
+            Py_INCREF(array->streams[i]);
+            if (self->dspPool != NULL)
+                PyoGraph_initAccesses(array->streams[i]);
+        }
+        /* Everything the pool needs is allocated here, not by the audio thread. */
+        array->graph = NULL;
+        array->graphShort = 0;
+        if (self->dspPool != NULL)
+            array->graph = PyoGraphPool_newGraph(self->dspPool, array->streams, array->count);
+    }
+
+    old = SERVER_EXCHANGE(self->rtStreams, array);
+    if (old != NULL) {
+        /* Called from a stream of the run, the pool still walks the old array. */
+        if (self->dspRunning) {
+            old->next = self->dspRetired;
+            self->dspRetired = old;
+            return;
+        }
+        Server_waitForCallback(self);
+        Server_releaseStreams(old);
+    }
+}
+
+/* Deferred by the audio thread when the graph of the snapshot lacked room. */
+static void
+Server_growGraph(PyObject *obj, double value)
+{
+    Server *self = (Server *)obj;
+
+    if (self->rtStreams != NULL)
+        Server_publishStreams(self, 1);
+}
+
+static void
+Server_callStop(PyObject *obj, double value)
+{
+    PyObject *result = PyObject_CallMethod(obj, "stop", NULL);
+    if (result == NULL)
+        PyErr_Print();
+    else
+        Py_DECREF(result);
+}
+
+void
+Server_defer(Server *self, PyObject *obj, PyoDeferredFunc func, double value)
+{
+    unsigned int head;
+    PyoDeferredCall *call;
+
+    /* Made by a stream running in parallel, replayed in order after the buffer. */
+    if (PyoGraph_deferCall(obj, func, value))
+        return;
+
+    /* rtBusy is only set by the audio thread itself, during a GIL-free callback. */
+    if (self->rtBusy == 0) {
+        (*func)(obj, value);
+        return;
+    }
+
+    head = self->deferredHead;
+    if (head - SERVER_LOAD(self->deferredTail) >= PYO_DEFERRED_SIZE) {
+        self->deferredDropped++;
+        return;
+    }
+    call = &self->deferred[head & (PYO_DEFERRED_SIZE - 1)];
+    call->obj = obj;
+    call->func = func;
+    call->value = value;
+    SERVER_STORE(self->deferredHead, head + 1);
+}
+
+void
+Server_deferStop(Server *self, PyObject *obj)
+{
+    Server_defer(self, obj, Server_callStop, 0.0);
+}
+
+/* Called with the GIL. */
+static void
+Server_runDeferred(Server *self)
+{
+    unsigned int tail = self->deferredTail;
+    PyoDeferredCall call;
+
+    while (tail != SERVER_LOAD(self->deferredHead)) {
+        call = self->deferred[tail & (PYO_DEFERRED_SIZE - 1)];
+        tail++;
+        SERVER_STORE(self->deferredTail, tail);
+        if (call.obj != NULL) {
+            Py_INCREF(call.obj);
+            (*call.func)(call.obj, call.value);
+            Py_DECREF(call.obj);
+        }
+    }
+}
+
+/* Called with the GIL when obj is removed from the server. */
+static void
+Server_cancelDeferred(Server *self, PyObject *obj)
+{
+    int j;
+    unsigned int i, head;
+
+    for (j=0; j<self->dspCallCount; j++) {
+        if (self->dspCalls[j].obj == obj)
+            self->dspCalls[j].obj = NULL;
+    }
+    if (self->deferred == NULL)
+        return;
+    head = SERVER_LOAD(self->deferredHead);
+    for (i=self->deferredTail; i!=head; i++) {
+        if (self->deferred[i & (PYO_DEFERRED_SIZE - 1)].obj == obj)
+            self->deferred[i & (PYO_DEFERRED_SIZE - 1)].obj = NULL;
+    }
+}
+
+int
+Server_postParam(Server *self, PyObject *obj, PyoParamFunc func, double value, unsigned long time, long ramp)
+{
+    unsigned int head = self->paramHead;
+    PyoParamEvent *event;
+
+    if (head - SERVER_LOAD(self->paramTail) >= PYO_PARAM_SIZE)
+        return 0;
+    event = &self->params[head & (PYO_PARAM_SIZE - 1)];
+    event->obj = obj;
+    event->func = func;
+    event->value = value;
+    event->time = time;
+    event->ramp = ramp;
+    SERVER_STORE(self->paramHead, head + 1);
+    return 1;
+}
+
+/* Called by the audio thread, before the streams are processed. */
+static void
+Server_dispatchParams(Server *self)
+{
+    unsigned int tail = self->paramTail, head = SERVER_LOAD(self->paramHead);
+    PyoParamEvent *event;
+
+    while (tail != head) {
+        event = &self->params[tail & (PYO_PARAM_SIZE - 1)];
+        if (event->obj != NULL && !(*event->func)(event->obj, event->value, event->time, event->ramp))
+            self->paramDropped++;
+        tail++;
+    }
+    SERVER_STORE(self->paramTail, tail);
+}
+
+/* Called with the GIL when obj is removed from the server, before the
+** audio thread is waited for. */
+static void
+Server_cancelParams(Server *self, PyObject *obj)
+{
+    unsigned int i, head;
+
+    head = SERVER_LOAD(self->paramHead);
+    for (i=SERVER_LOAD(self->paramTail); i!=head; i++) {
+        if (self->params[i & (PYO_PARAM_SIZE - 1)].obj == obj)
+            self->params[i & (PYO_PARAM_SIZE - 1)].obj = NULL;
+    }
+}
+
+static void *
+Server_messageThread(void *arg)
+{
+    PyGILState_STATE s;
+    Server *self = (Server *)arg;
+
+    while (SERVER_LOAD(self->messageThreadRunning)) {
+        if (self->deferredTail != SERVER_LOAD(self->deferredHead)) {
+            s = PyGILState_Ensure();
+            Server_runDeferred(self);
+            PyGILState_Release(s);
+        }
+        else
+            Server_sleep(1000);
+    }
+    return NULL;
+}
+
+/* Called with the GIL, the audio backend must not be running yet. Without
+** the message thread, the audio thread runs the deferred calls itself. */
+static void
+Server_startGILFree(Server *self, int thread)
+{
+    if (self->deferred == NULL)
+        self->deferred = (PyoDeferredCall *)calloc(PYO_DEFERRED_SIZE, sizeof(PyoDeferredCall));
+    self->deferredHead = self->deferredTail = 0;
+    self->deferredDropped = 0;
+    Server_publishStreams(self, 1);
+    if (!thread) {
+        SERVER_STORE(self->deferCalls, 1);
+        return;
+    }
+    self->messageThreadRunning = 1;
+    if (pthread_create(&self->messageThread, NULL, Server_messageThread, self)) {
+        Server_error(self, "Unable to create the message thread, processing keeps the GIL.\n");
+        self->messageThreadRunning = 0;
+        Server_publishStreams(self, 0);
+        return;
+    }
+    SERVER_STORE(self->deferCalls, 1);
+}
+
+/* Called with the GIL. Callbacks still running after the backend is stopped go back to the GIL. */
+static void
+Server_stopGILFree(Server *self)
+{
+    if (self->deferCalls == 0)
+        return;
+    SERVER_STORE(self->deferCalls, 0);
+    if (self->dspPool == NULL)
+        Server_publishStreams(self, 0);
+    if (SERVER_LOAD(self->messageThreadRunning)) {
+        SERVER_STORE(self->messageThreadRunning, 0);
+        Py_BEGIN_ALLOW_THREADS
+        pthread_join(self->messageThread, NULL);
+        Py_END_ALLOW_THREADS
+    }
+    Server_runDeferred(self);
+    if (self->deferredDropped > 0)
+        Server_warning(self, "%lu deferred calls were dropped, the message queue was full.\n", self->deferredDropped);
+}
+
+/** Parallel processing. **/
+/***************************/
+
+/* Called with the GIL, the audio backend must not be running yet. */
+static void
+Server_startDSPThreads(Server *self)
+{
+    PyoGraphPool *pool;
+
+    if (self->dspThreads <= 1)
+        return;
+    if (self->dspCalls == NULL)
+        self->dspCalls = (PyoGraphCall *)malloc(PYO_DEFERRED_SIZE * sizeof(PyoGraphCall));
+    pool = PyoGraphPool_new(self->dspThreads);
+    if (pool == NULL) {
+        Server_error(self, "Unable to create the DSP threads, processing stays serial.\n");
+        return;
+    }
+    /* The new snapshot comes with the graph of the pool. */
+    SERVER_STORE(self->dspPool, pool);
+    Server_publishStreams(self, 1);
+}
+
+/* Called with the GIL. */
+static void
+Server_stopDSPThreads(Server *self)
+{
+    PyoGraphPool *pool = self->dspPool;
+
+    if (pool == NULL)
+        return;
+    SERVER_STORE(self->dspPool, NULL);
+    Server_waitForCallback(self);
+    if (self->deferCalls == 0)
+        Server_publishStreams(self, 0);
+    if (PyoGraphPool_getDroppedCalls(pool) > 0)
+        Server_warning(self, "%lu calls from parallel streams were dropped.\n", PyoGraphPool_getDroppedCalls(pool));
+    Py_BEGIN_ALLOW_THREADS
+    PyoGraphPool_free(pool);
+    Py_END_ALLOW_THREADS
+}
+
 /** Main Processing functions. **/
 /********************************/
 
+/* Takes the GIL and adds the wait to the telemetry of the callback. Streams
+** processed by the DSP threads can wait concurrently. */
+static PyGILState_STATE
+Server_ensureGIL(Server *server)
+{
+    double time;
+    unsigned long long wait;
+    PyGILState_STATE gil;
+
+    if (!server->telemetryOn)
+        return PyGILState_Ensure();
+    time = PyoProfile_getTime();
+    gil = PyGILState_Ensure();
+    wait = (unsigned long long)(PyoProfile_getTime() - time);
+#if defined(__GNUC__)
+    __atomic_add_fetch(&server->gilWait, wait, __ATOMIC_RELAXED);
+#else
+    __sync_add_and_fetch(&server->gilWait, wait);
+#endif
+    return gil;
+}
+
+static void
+Server_callStream(Server *server, Stream *stream, int profiling)
+{
+    PyoProfile *profile;
+    double time;
+
+    if (profiling && (profile = Stream_getProfile(stream)) != NULL) {
+        time = PyoProfile_getTime();
+        Stream_callFunction(stream);
+        PyoProfile_add(profile, PyoProfile_getTime() - time);
+    }
+    else
+        Stream_callFunction(stream);
+}
+
+/* Processes one stream, returns 1 if it was active. */
+static int
+Server_processStream(Server *server, Stream *stream)
+{
+    PyGILState_STATE gil;
+
+    if (Stream_getStreamActive(stream) != 1) {
+        if (Stream_getBufferCountWait(stream) != 0)
+            Stream_IncrementBufferCount(stream);
+        return 0;
+    }
+    if (server->rtBusy && Stream_getStreamNeedsGIL(stream)) {
+        gil = Server_ensureGIL(server);
+        Server_callStream(server, stream, server->profiling);
+        PyGILState_Release(gil);
+    }
+    else
+        Server_callStream(server, stream, server->profiling);
+    if (stream->views != NULL)
+        Stream_publishView(stream);
+    return 1;
+}
+
+/* Must come after the stream is mixed, stop() clears its buffer. */
+static void
+Server_checkDuration(Server *server, Stream *stream)
+{
+    if (Stream_getDuration(stream) != 0) {
+        if (Stream_IncrementDurationCount(stream))
+            Server_deferStop(server, stream->streamobject);
+    }
+}
+
+static void
+Server_mixStream(Server *server, Stream *stream, MYFLT *buffer)
+{
+    int j;
+    MYFLT *data;
+
+    if (Stream_getStreamToDac(stream) != 0) {
+        data = Stream_getData(stream);
+        buffer += Stream_getStreamChnl(stream) * server->bufferSize;
+        for (j=0; j < server->bufferSize; j++) {
+            buffer[j] += *data++;
+        }
+    }
+}
+
+/* Callbacks of the DSP pool, see dspgraph.h. */
+typedef struct {
+    Server *server;
+    MYFLT *buffer;
+} ServerDSPContext;
+
+static int
+Server_processStreamTask(void *ctx, Stream *stream)
+{
+    return Server_processStream(((ServerDSPContext *)ctx)->server, stream);
+}
+
+static void
+Server_mixStreamTask(void *ctx, Stream *stream)
+{
+    Server_mixStream(((ServerDSPContext *)ctx)->server, stream, ((ServerDSPContext *)ctx)->buffer);
+}
+
+static void
+Server_finishStreamTask(void *ctx, Stream *stream)
+{
+    Server_checkDuration(((ServerDSPContext *)ctx)->server, stream);
+}
+
 void
 Server_process_buffers(Server *server)
 {
     float *out = server->output_buffer;
     MYFLT buffer[server->nchnls][server->bufferSize];
-    int i, j, chnl;
+    int i, j, count, record;
     int nchnls = server->nchnls;
     MYFLT amp = server->amp;
     Stream *stream_tmp;
-    MYFLT *data;
-
+    PyoStreamArray *rtStreams = NULL;
+    PyoGraphPool *pool;
+    PyoGraphCall *call;
+    PyoStreamArray *retired;
+    ServerDSPContext context;
+    PyoGraphFuncs funcs = {Server_processStreamTask, Server_mixStreamTask, Server_finishStreamTask, NULL};
+    PyGILState_STATE s;
+    int parallel = 0;
+    int profiling = server->profiling;
+    int gilfree = SERVER_LOAD(server->deferCalls);
+    int telemetry = server->telemetryOn;
+    double start = 0.0, time;
+
+    if (profiling || telemetry)
+        start = PyoProfile_getTime();
+    server->gilWait = 0;
     memset(&buffer, 0, sizeof(buffer));
-    PyGILState_STATE s = PyGILState_Ensure();
-    for (i=0; i<server->stream_count; i++) {
-        stream_tmp = (Stream *)PyList_GET_ITEM(server->streams, i);
-        if (Stream_getStreamActive(stream_tmp) == 1) {
-            Stream_callFunction(stream_tmp);
-            if (Stream_getStreamToDac(stream_tmp) != 0) {
-                data = Stream_getData(stream_tmp);
-                chnl = Stream_getStreamChnl(stream_tmp);
-                for (j=0; j < server->bufferSize; j++) {
-                    buffer[chnl][j] += *data++;
-                }
-            }
-            if (Stream_getDuration(stream_tmp) != 0) {
-                Stream_IncrementDurationCount(stream_tmp);
+    if (gilfree) {
+        SERVER_STORE(server->rtBusy, 1);
+        rtStreams = SERVER_LOAD(server->rtStreams);
+        count = rtStreams != NULL ? rtStreams->count : 0;
+    }
+    else {
+        s = Server_ensureGIL(server);
+        count = server->stream_count;
+    }
+    if (server->paramTail != SERVER_LOAD(server->paramHead))
+        Server_dispatchParams(server);
+    pool = SERVER_LOAD(server->dspPool);
+    if (pool != NULL && (rtStreams = SERVER_LOAD(server->rtStreams)) != NULL) {
+        context.server = server;
+        context.buffer = &buffer[0][0];
+        funcs.ctx = &context;
+        if (rtStreams->graph != NULL) {
+            server->dspRunning = !gilfree;
+            parallel = PyoGraphPool_run(pool, rtStreams->graph, !gilfree, &funcs);
+            server->dspRunning = 0;
+        }
+        /* Processed serially until a snapshot with a larger graph is published. */
+        if (!parallel)
+            count = rtStreams->count;
+    }
+    if (parallel) {
+        while ((retired = server->dspRetired) != NULL) {
+            server->dspRetired = retired->next;
+            Server_releaseStreams(retired);
+        }
+        /* Python calls made by the streams, in the serial order. They may
+        ** change the streams list, the snapshot is not used after this. */
+        server->dspCallCount = PyoGraphPool_takeCalls(pool, server->dspCalls, PYO_DEFERRED_SIZE);
+        for (i=0; i<server->dspCallCount; i++) {
+            call = &server->dspCalls[i];
+            if (call->obj != NULL)
+                Server_defer(server, call->obj, call->func, call->value);
+        }
+        server->dspCallCount = 0;
+    }
+    else {
+        for (i=0; i<count; i++) {
+            if (rtStreams != NULL)
+                stream_tmp = rtStreams->streams[i];
+            else
+                stream_tmp = (Stream *)PyList_GET_ITEM(server->streams, i);
+            if (Server_processStream(server, stream_tmp)) {
+                Server_mixStream(server, stream_tmp, &buffer[0][0]);
+                Server_checkDuration(server, stream_tmp);
             }
         }
-        else if (Stream_getBufferCountWait(stream_tmp) != 0)
-            Stream_IncrementBufferCount(stream_tmp);
+        /* Last use of the snapshot, with the GIL the new one replaces it right away. */
+        if (pool != NULL && rtStreams != NULL && rtStreams->graph != NULL && !rtStreams->graphShort) {
+            rtStreams->graphShort = 1;
+            Server_defer(server, (PyObject *)server, Server_growGraph, 0.0);
+        }
     }
     if (server->withGUI == 1 && nchnls <= 8) {
         Server_process_gui(server);
@@ -367,7 +1005,12 @@ Server_process_buffers(Server *server)
         Server_process_time(server);
     }
     server->elapsedSamples += server->bufferSize;
-    PyGILState_Release(s);
+    if (gilfree) {
+        SERVER_STORE(server->rtEpoch, server->rtEpoch + 1);
+        SERVER_STORE(server->rtBusy, 0);
+    }
+    else
+        PyGILState_Release(s);
     if (amp != server->lastAmp) {
         server->timeCount = 0;
         server->stepVal = (amp - server->currentAmp) / server->timeStep;
@@ -383,9 +1026,60 @@ Server_process_buffers(Server *server)
             out[(i*server->nchnls)+j] = (float)buffer[j][i] * server->currentAmp;
         }
     }
-    if (server->record == 1)
-        sf_write_float(server->recfile, out, server->bufferSize * server->nchnls);
+    /* Server_stop_rec_internal waits for recBusy before freeing the writer. */
+    SERVER_STORE(server->recBusy, 1);
+    record = SERVER_LOAD(server->record);
+    if (record == 1)
+        SfWriter_writeFloat(server->recwriter, out, server->bufferSize);
+    else if (record == 2)
+        Server_writeRecordBuffer(server, out);
+    SERVER_STORE(server->recBusy, 0);
+
+    if (profiling || telemetry) {
+        time = PyoProfile_getTime();
+        if (telemetry)
+            PyoTelemetry_push(server->telemetry, start, time, server->bufferSize / server->samplingRate * 1e9,
+                              (double)server->gilWait);
+        time -= start;
+        if (profiling) {
+            PyoProfile_add(&server->callbackProfile, time);
+            if (time > server->bufferSize / server->samplingRate * 1e9)
+                server->overruns++;
+        }
+    }
+}
 
+static void
+Server_sendRms(PyObject *obj, double value)
+{
+    Server *server = (Server *)obj;
+
+    switch (server->nchnls) {
+        case 1:
+            PyObject_CallMethod((PyObject *)server->GUI, "setRms", "f", server->lastRms[0]);
+            break;
+        case 2:
+            PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ff", server->lastRms[0], server->lastRms[1]);
+            break;
+        case 3:
+            PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fff", server->lastRms[0], server->lastRms[1], server->lastRms[2]);
+            break;
+        case 4:
+            PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3]);
+            break;
+        case 5:
+            PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4]);
+            break;
+        case 6:
+            PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5]);
+            break;
+        case 7:
+            PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6]);
+            break;
+        case 8:
+            PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6], server->lastRms[7]);
+            break;
+    }
 }
 
 void
@@ -414,55 +1108,36 @@ Server_process_gui(Server *server)
         for (j=0; j<server->nchnls; j++) {
             server->lastRms[j] = (rms[j] + server->lastRms[j]) * 0.5;
         }
-        switch (server->nchnls) {
-            case 1:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "f", server->lastRms[0]);
-                break;
-            case 2:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ff", server->lastRms[0], server->lastRms[1]);
-                break;
-            case 3:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fff", server->lastRms[0], server->lastRms[1], server->lastRms[2]);
-                break;
-            case 4:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3]);
-                break;
-            case 5:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4]);
-                break;
-            case 6:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5]);
-                break;
-            case 7:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6]);
-                break;
-            case 8:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6], server->lastRms[7]);
-                break;
-        }
+        Server_defer(server, (PyObject *)server, Server_sendRms, 0.0);
         server->gcount = 0;
     }
 }
 
+static void
+Server_sendTime(PyObject *obj, double sampsToSecs)
+{
+    int hours, minutes, seconds, milliseconds;
+    Server *server = (Server *)obj;
+
+    seconds = (int)sampsToSecs;
+    milliseconds = (int)((sampsToSecs - seconds) * 1000);
+    minutes = seconds / 60;
+    hours = minutes / 60;
+    minutes = minutes % 60;
+    seconds = seconds % 60;
+    PyObject_CallMethod((PyObject *)server->TIME, "setTime", "iiii", hours, minutes, seconds, milliseconds);
+}
+
 void
 Server_process_time(Server *server)
 {
-    int hours, minutes, seconds, milliseconds;
     float sr = server->samplingRate;
-    double sampsToSecs;
 
     if (server->tcount <= server->timePass) {
         server->tcount++;
     }
     else {
-        sampsToSecs = (double)(server->elapsedSamples / sr);
-        seconds = (int)sampsToSecs;
-        milliseconds = (int)((sampsToSecs - seconds) * 1000);
-        minutes = seconds / 60;
-        hours = minutes / 60;
-        minutes = minutes % 60;
-        seconds = seconds % 60;
-        PyObject_CallMethod((PyObject *)server->TIME, "setTime", "iiii", hours, minutes, seconds, milliseconds);
+        Server_defer(server, (PyObject *)server, Server_sendTime, (double)(server->elapsedSamples / sr));
         server->tcount = 0;
     }
 }
@@ -480,6 +1155,7 @@ Server_shut_down(Server *self)
     if (self->server_started == 1) {
         Server_stop((Server *)self);
     }
+    Server_stopDSPThreads(self);
 
     for (i=0; i<num_rnd_objs; i++) {
         rnd_objs_count[i] = 0;
@@ -514,6 +1190,16 @@ Server_shut_down(Server *self)
     return Py_None;
 }
 
+static void
+Server_releaseRecordBuffer(Server *self)
+{
+    if (self->recbuf != NULL) {
+        self->recbuf = NULL;
+        PyBuffer_Release(&self->recview);
+    }
+    Py_CLEAR(self->recbufCallback);
+}
+
 static int
 Server_traverse(Server *self, visitproc visit, void *arg)
 {
@@ -522,6 +1208,7 @@ Server_traverse(Server *self, visitproc visit, void *arg)
     Py_VISIT(self->streams);
     Py_VISIT(self->jackAutoConnectInputPorts);
     Py_VISIT(self->jackAutoConnectOutputPorts);
+    Py_VISIT(self->recbufCallback);
     return 0;
 }
 
@@ -533,6 +1220,7 @@ Server_clear(Server *self)
     Py_CLEAR(self->streams);
     Py_CLEAR(self->jackAutoConnectInputPorts);
     Py_CLEAR(self->jackAutoConnectOutputPorts);
+    Server_releaseRecordBuffer(self);
     return 0;
 }
 
@@ -541,12 +1229,17 @@ Server_dealloc(Server* self)
 {
     if (self->server_booted == 1)
         Server_shut_down(self);
+    Server_stop_rec_internal(self);
     Server_clear(self);
     free(self->input_buffer);
     free(self->output_buffer);
     free(self->serverName);
     if (self->withGUI == 1)
         free(self->lastRms);
+    free(self->deferred);
+    free(self->params);
+    free(self->dspCalls);
+    PyoTelemetry_free(self->telemetry);
     my_server[self->thisServerID] = NULL;
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -617,8 +1310,48 @@ Server_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->recformat = 0;
     self->rectype = 0;
     self->recquality = 0.4;
+    self->recqueue = SFWRITER_DEFAULT_QUEUE;
+    self->recwriter = NULL;
+    self->recBusy = 0;
+    self->recOverruns = 0;
+    self->recbuf = NULL;
+    self->recbufDouble = 0;
+    self->recbufFrames = self->recbufPos = 0;
+    self->recbufLost = 0;
+    self->recbufCallback = NULL;
     self->startoffset = 0.0;
     self->globalSeed = 0;
+    self->randState = 1u;
+    self->batch = 0;
+    self->profiling = 0;
+    PyoProfile_reset(&self->callbackProfile);
+    self->overruns = 0;
+    self->telemetry = NULL;
+    self->telemetryOn = 0;
+    self->gilWait = 0;
+    self->gilFree = self->deferCalls = 0;
+    self->rtStreams = NULL;
+    self->rtBusy = 0;
+    self->rtEpoch = 0;
+    self->deferred = NULL;
+    self->deferredHead = self->deferredTail = 0;
+    self->deferredDropped = 0;
+    self->messageThreadRunning = 0;
+    /* Parameter events can be posted before the server is booted. */
+    self->params = (PyoParamEvent *)calloc(PYO_PARAM_SIZE, sizeof(PyoParamEvent));
+    if (self->params == NULL) {
+        free(self->serverName);
+        self->ob_type->tp_free((PyObject*)self);
+        return PyErr_NoMemory();
+    }
+    self->paramHead = self->paramTail = 0;
+    self->paramDropped = 0;
+    self->dspThreads = 1;
+    self->dspPool = NULL;
+    self->dspRunning = 0;
+    self->dspRetired = NULL;
+    self->dspCalls = NULL;
+    self->dspCallCount = 0;
     self->thisServerID = serverID;
     Py_XDECREF(my_server[serverID]);
     my_server[serverID] = (Server *)self;
@@ -952,12 +1685,25 @@ Server_setGlobalSeed(Server *self, PyObject *arg)
     return Py_None;
 }
 
+static PyObject *
+Server_setBatch(Server *self, PyObject *arg)
+{
+    if (arg != NULL && PyInt_Check(arg))
+        self->batch = PyInt_AsLong(arg) != 0;
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 int
 Server_generateSeed(Server *self, int oid)
 {
     unsigned int curseed, count, mult, ltime;
 
-    count = ++rnd_objs_count[oid];
+    if (self->batch)
+        count = ++self->rndObjsCount[oid];
+    else
+        count = ++rnd_objs_count[oid];
     mult = rnd_objs_mult[oid];
 
     if (self->globalSeed > 0) {
@@ -968,7 +1714,7 @@ Server_generateSeed(Server *self, int oid)
         curseed = (ltime * ltime + count * mult) % PYO_RAND_MAX;
     }
 
-    PYO_RAND_SEED = curseed;
+    PYO_RAND_SEED = self->randState = curseed;
 
     return 0;
 }
@@ -1061,6 +1807,251 @@ Server_setVerbosity(Server *self, PyObject *arg)
     return Py_None;
 }
 
+static PyObject *
+Server_setGILFree(Server *self, PyObject *arg)
+{
+    int state = PyObject_IsTrue(arg);
+
+    if (state == -1)
+        return NULL;
+
+    if (self->server_started == 1)
+        Server_warning(self, "GIL-free processing will be applied the next time the server is started.\n");
+    self->gilFree = state;
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_setDSPThreads(Server *self, PyObject *arg)
+{
+    if (arg != NULL && PyInt_Check(arg)) {
+        if (self->server_started == 1)
+            Server_warning(self, "The number of DSP threads will be applied the next time the server is started.\n");
+        self->dspThreads = PyInt_AsLong(arg);
+        if (self->dspThreads < 1)
+            self->dspThreads = 1;
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static void
+Server_clearProfile(Server *self)
+{
+    int i;
+    PyoProfile *profile;
+
+    for (i=0; i<self->stream_count; i++) {
+        profile = Stream_getProfile((Stream *)PyList_GET_ITEM(self->streams, i));
+        if (profile != NULL)
+            PyoProfile_reset(profile);
+    }
+    PyoProfile_reset(&self->callbackProfile);
+    self->overruns = 0;
+}
+
+static PyObject *
+Server_resetProfile(Server *self)
+{
+    Server_clearProfile(self);
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_setProfiling(Server *self, PyObject *arg)
+{
+    int i, state = PyObject_IsTrue(arg);
+
+    if (state == -1)
+        return NULL;
+
+    if (state && !self->profiling) {
+        for (i=0; i<self->stream_count; i++) {
+            Stream_setProfiling((Stream *)PyList_GET_ITEM(self->streams, i), 1);
+        }
+        Server_clearProfile(self);
+    }
+    self->profiling = state;
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+/* Snapshot of the profiling statistics, times are in microseconds. */
+static PyObject *
+Server_getProfile(Server *self)
+{
+    int i;
+    double deadline, mean;
+    Stream *stream_tmp;
+    PyoProfile *profile;
+    PyObject *streams, *callback, *dict, *item, *tmp;
+
+    deadline = self->bufferSize / self->samplingRate * 1e6;
+    profile = &self->callbackProfile;
+    mean = profile->count > 0 ? profile->sum / profile->count * 0.001 : 0.0;
+
+    streams = PyList_New(0);
+    for (i=0; i<self->stream_count; i++) {
+        stream_tmp = (Stream *)PyList_GET_ITEM(self->streams, i);
+        if (Stream_getProfile(stream_tmp) == NULL || Stream_getProfile(stream_tmp)->count == 0)
+            continue;
+        item = PyoProfile_toDict(Stream_getProfile(stream_tmp));
+        tmp = PyInt_FromLong(Stream_getStreamId(stream_tmp));
+        PyDict_SetItemString(item, "id", tmp);
+        Py_DECREF(tmp);
+        tmp = PyString_FromString(stream_tmp->streamobject->ob_type->tp_name);
+        PyDict_SetItemString(item, "object", tmp);
+        Py_DECREF(tmp);
+        PyList_Append(streams, item);
+        Py_DECREF(item);
+    }
+
+    callback = PyoProfile_toDict(profile);
+    dict = Py_BuildValue("{s:O,s:d,s:O,s:{s:d,s:d,s:d},s:k,s:O}",
+                         "enabled", self->profiling ? Py_True : Py_False,
+                         "deadline", deadline,
+                         "callback", callback,
+                         "load", "mean", mean / deadline,
+                                 "p99", PyoProfile_percentile(profile, 0.99) * 0.001 / deadline,
+                                 "max", profile->max * 0.001 / deadline,
+                         "overruns", self->overruns,
+                         "streams", streams);
+    Py_DECREF(callback);
+    Py_DECREF(streams);
+    return dict;
+}
+
+static PyObject *
+Server_setTelemetry(Server *self, PyObject *arg)
+{
+    int state = PyObject_IsTrue(arg);
+
+    if (state == -1)
+        return NULL;
+
+    if (state && self->telemetry == NULL) {
+        SERVER_STORE(self->telemetry, PyoTelemetry_new());
+        if (self->telemetry == NULL)
+            return PyErr_NoMemory();
+    }
+    SERVER_STORE(self->telemetryOn, state);
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_resetTelemetry(Server *self)
+{
+    if (self->telemetry != NULL)
+        PyoTelemetry_reset(self->telemetry);
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+void
+Server_xrun(Server *self)
+{
+    PyoTelemetry *telemetry = SERVER_LOAD(self->telemetry);
+
+    if (telemetry != NULL && SERVER_LOAD(self->telemetryOn))
+        PyoTelemetry_xrun(telemetry);
+}
+
+/* Snapshot of the telemetry counters and of the last records, times are in
+** microseconds, start times in seconds since the epoch. */
+static PyObject *
+Server_getTelemetry(Server *self, PyObject *arg)
+{
+    int i, n, num = 0;
+    unsigned long long cursor, head;
+    PyoTelemetryCounters c;
+    PyoTelemetryRecord *records;
+    PyObject *list, *item, *dict;
+
+    if (arg != NULL && PyNumber_Check(arg))
+        num = PyInt_AsLong(arg);
+    if (num < 0)
+        num = 0;
+    if (num > PYO_TELEMETRY_SIZE)
+        num = PYO_TELEMETRY_SIZE;
+
+    memset(&c, 0, sizeof(c));
+    list = PyList_New(0);
+    if (self->telemetry != NULL) {
+        PyoTelemetry_getCounters(self->telemetry, &c);
+        head = PyoTelemetry_getHead(self->telemetry);
+        cursor = head > (unsigned long long)num ? head - num : 0;
+        records = (PyoTelemetryRecord *)malloc((num > 0 ? num : 1) * sizeof(PyoTelemetryRecord));
+        n = PyoTelemetry_read(self->telemetry, &cursor, records, num);
+        for (i=0; i<n; i++) {
+            item = Py_BuildValue("{s:K,s:d,s:d,s:d,s:d,s:d,s:O,s:O,s:O}",
+                                 "index", records[i].index, "start", records[i].start,
+                                 "duration", records[i].duration * 0.001, "slack", records[i].slack * 0.001,
+                                 "interval", records[i].interval * 0.001, "gilwait", records[i].gilwait * 0.001,
+                                 "overrun", records[i].flags & PYO_TELEMETRY_OVERRUN ? Py_True : Py_False,
+                                 "xrun", records[i].flags & PYO_TELEMETRY_XRUN ? Py_True : Py_False,
+                                 "late", records[i].flags & PYO_TELEMETRY_LATE ? Py_True : Py_False);
+            PyList_Append(list, item);
+            Py_DECREF(item);
+        }
+        free(records);
+    }
+
+    dict = Py_BuildValue("{s:O,s:d,s:K,s:k,s:k,s:k,s:d,s:d,s:d,s:k,s:O}",
+                         "enabled", self->telemetryOn ? Py_True : Py_False,
+                         "deadline", self->bufferSize / self->samplingRate * 1e6,
+                         "callbacks", c.callbacks,
+                         "overruns", c.overruns,
+                         "xruns", c.xruns,
+                         "late", c.late,
+                         "max", c.maxDuration * 0.001,
+                         "minslack", c.minSlack * 0.001,
+                         "gilwait", c.gilwait * 0.001,
+                         "filelost", self->telemetry != NULL ? PyoTelemetry_getFileLost(self->telemetry) : 0UL,
+                         "records", list);
+    Py_DECREF(list);
+    return dict;
+}
+
+static PyObject *
+Server_setTelemetryFile(Server *self, PyObject *arg)
+{
+    int err = 0;
+    char *path;
+
+    if (arg == Py_None) {
+        if (self->telemetry != NULL) {
+            Py_BEGIN_ALLOW_THREADS
+            PyoTelemetry_closeFile(self->telemetry);
+            Py_END_ALLOW_THREADS
+        }
+    }
+    else if (PyString_Check(arg)) {
+        if (self->telemetry == NULL) {
+            SERVER_STORE(self->telemetry, PyoTelemetry_new());
+            if (self->telemetry == NULL)
+                return PyErr_NoMemory();
+        }
+        path = PyString_AsString(arg);
+        Py_BEGIN_ALLOW_THREADS
+        err = PyoTelemetry_openFile(self->telemetry, path);
+        Py_END_ALLOW_THREADS
+        if (err < 0)
+            Server_error(self, "Unable to open the telemetry file %s.\n", path);
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyObject *
 Server_setStartOffset(Server *self, PyObject *arg)
 {
@@ -1089,6 +2080,13 @@ Server_boot(Server *self, PyObject *arg)
     self->server_started = 0;
     self->stream_count = 0;
     self->elapsedSamples = 0;
+    self->randState = 1u;
+
+    /* The objects of a batch server are seeded the same way whatever was
+    ** created before, a batch boots several servers without shutting them down. */
+    for (i=0; i<num_rnd_objs; i++) {
+        self->rndObjsCount[i] = 0;
+    }
 
     int needNewBuffer = 0;
     if (arg != NULL && PyBool_Check(arg)) {
@@ -1197,6 +2195,10 @@ Server_start(Server *self)
     self->server_started = 1;
     self->timeStep = (int)(0.01 * self->samplingRate);
 
+    /* An offline render leaves its threads running, the count may have changed. */
+    Server_stopDSPThreads(self);
+    Server_startDSPThreads(self);
+
     if (self->audio_be_type != PyoOffline && self->audio_be_type != PyoOfflineNB && self->audio_be_type != PyoEmbedded) {
         switch (self->midi_be_type) {
             case PyoPortmidi:
@@ -1223,6 +2225,11 @@ Server_start(Server *self)
 
     self->amp = self->resetAmp;
 
+    if (self->gilFree && (self->audio_be_type == PyoPortaudio || self->audio_be_type == PyoCoreaudio ||
+                          self->audio_be_type == PyoJack)) {
+        Server_startGILFree(self, 1);
+    }
+
     switch (self->audio_be_type) {
         case PyoPortaudio:
             err = Server_pa_start(self);
@@ -1281,6 +2288,10 @@ Server_stop(Server *self)
             break;
     }
 
+    Server_stopGILFree(self);
+    Server_stopDSPThreads(self);
+    Server_warnDroppedParams(self);
+
     if (err < 0) {
         Server_error(self, "Error stopping server.\n");
     }
@@ -1299,12 +2310,173 @@ Server_stop(Server *self)
     return Py_None;
 }
 
+/** Offline batch rendering. **/
+/*******************************/
+
+/* Servers of a batch, taken in turn by the rendering threads. */
+typedef struct {
+    Server **servers;
+    int count;
+    int next;
+    unsigned long long frames;
+} ServerBatch;
+
+/* Computes numBlocks buffers of a batch server. The calls deferred by a
+** buffer are made by the rendering thread, with the GIL, right after it. */
+static unsigned long long
+Server_batch_blocks(Server *self, int numBlocks)
+{
+    unsigned long long frames = 0;
+    PyGILState_STATE s;
+
+    while (numBlocks-- > 0 && SERVER_LOAD(self->server_stopped) == 0) {
+        Server_process_buffers(self);
+        frames += self->bufferSize;
+        if (self->deferredTail != SERVER_LOAD(self->deferredHead)) {
+            s = PyGILState_Ensure();
+            Server_runDeferred(self);
+            PyGILState_Release(s);
+        }
+    }
+    return frames;
+}
+
+/* Renders a whole offline server on the calling thread. Returns the number of frames computed. */
+static unsigned long long
+Server_batch_render(Server *self)
+{
+    int numBlocks;
+    unsigned long long frames = 0;
+
+    pyo_rand_state = &self->randState;
+    if (self->startoffset > 0.0) {
+        numBlocks = ceil(self->startoffset * self->samplingRate/self->bufferSize);
+        self->lastAmp = 1.0; self->amp = 0.0;
+        frames += Server_batch_blocks(self, numBlocks);
+        self->startoffset = 0.0;
+    }
+    self->amp = self->resetAmp;
+    Server_offline_recstart(self);
+    numBlocks = ceil(Server_offline_getDuration(self) * self->samplingRate/self->bufferSize);
+    frames += Server_batch_blocks(self, numBlocks);
+    Server_offline_recstop(self);
+    Server_warnDroppedParams(self);
+    pyo_rand_state = NULL;
+    return frames;
+}
+
+static void *
+Server_batch_thread(void *arg)
+{
+    int i;
+    unsigned long long frames = 0;
+    ServerBatch *batch = (ServerBatch *)arg;
+    PyGILState_STATE s;
+
+    /* Keeps a thread state for the streams and the calls taking the GIL. */
+    s = PyGILState_Ensure();
+    Py_BEGIN_ALLOW_THREADS
+    while ((i = SERVER_FETCH_ADD(batch->next, 1)) < batch->count) {
+        frames += Server_batch_render(batch->servers[i]);
+    }
+    Py_END_ALLOW_THREADS
+    PyGILState_Release(s);
+    SERVER_FETCH_ADD(batch->frames, frames);
+    return NULL;
+}
+
+/* Renders booted offline servers concurrently on a pool of threads, the
+** calling thread included. Every server computes its streams without the
+** GIL and draws its random numbers from its own generator, seeded by the
+** last random object created on it. Returns (frames, seconds). */
+PyObject *
+Server_offline_batch(PyObject *self, PyObject *args)
+{
+    int i, num, threads, started;
+    double elapsed;
+    PyObject *list, *seq;
+    Server *server;
+    pthread_t *workers;
+    ServerBatch batch;
+
+    if (! PyArg_ParseTuple(args, "Oi", &list, &threads))
+        return NULL;
+
+    seq = PySequence_Fast(list, "offlineBatch: servers must be a list of Server objects.");
+    if (seq == NULL)
+        return NULL;
+    num = PySequence_Fast_GET_SIZE(seq);
+    for (i=0; i<num; i++) {
+        if (! PyObject_TypeCheck(PySequence_Fast_GET_ITEM(seq, i), &ServerType)) {
+            Py_DECREF(seq);
+            PyErr_SetString(PyExc_TypeError, "offlineBatch: servers must be a list of Server objects.");
+            return NULL;
+        }
+    }
+
+    PyEval_InitThreads();
+
+    batch.servers = (Server **)malloc((num > 0 ? num : 1) * sizeof(Server *));
+    batch.count = batch.next = 0;
+    batch.frames = 0;
+    for (i=0; i<num; i++) {
+        server = (Server *)PySequence_Fast_GET_ITEM(seq, i);
+        if (server->server_booted == 0 || server->server_started == 1) {
+            Server_error(server, "Batch rendering: the Server must be booted and not started.\n");
+            continue;
+        }
+        if (server->audio_be_type != PyoOffline && server->audio_be_type != PyoOfflineNB) {
+            Server_error(server, "Batch rendering: the Server must use an offline audio backend.\n");
+            continue;
+        }
+        if (Server_offline_getDuration(server) < 0) {
+            Server_error(server, "Duration must be specified for Offline Server (see Server.recordOptions).\n");
+            continue;
+        }
+        server->server_stopped = 0;
+        server->server_started = 1;
+        server->timeStep = (int)(0.01 * server->samplingRate);
+        Server_stopDSPThreads(server);
+        Server_startGILFree(server, 0);
+        batch.servers[batch.count++] = server;
+    }
+
+    if (threads > batch.count)
+        threads = batch.count;
+    workers = (pthread_t *)malloc((threads > 1 ? threads : 1) * sizeof(pthread_t));
+
+    elapsed = PyoProfile_getTime();
+    Py_BEGIN_ALLOW_THREADS
+    for (started=0; started<threads-1; started++) {
+        if (pthread_create(&workers[started], NULL, Server_batch_thread, &batch))
+            break;
+    }
+    Server_batch_thread(&batch);
+    for (i=0; i<started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    Py_END_ALLOW_THREADS
+    elapsed = (PyoProfile_getTime() - elapsed) * 1e-9;
+
+    for (i=0; i<batch.count; i++) {
+        server = batch.servers[i];
+        Server_stopGILFree(server);
+        server->server_started = 0;
+        server->server_stopped = 1;
+    }
+
+    free(workers);
+    free(batch.servers);
+    Py_DECREF(seq);
+    return Py_BuildValue("Kd", batch.frames, elapsed);
+}
+
 static PyObject *
 Server_recordOptions(Server *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"dur", "filename", "fileformat", "sampletype", "quality", NULL};
+    static char *kwlist[] = {"dur", "filename", "fileformat", "sampletype", "quality", "queuedur", NULL};
 
-    if (! PyArg_ParseTupleAndKeywords(args, kwds, "d|siid", kwlist, &self->recdur, &self->recpath, &self->recformat, &self->rectype, &self->recquality)) {
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "d|siidd", kwlist, &self->recdur, &self->recpath, &self->recformat, &self->rectype, &self->recquality, &self->recqueue)) {
         return PyInt_FromLong(-1);
     }
 
@@ -1312,6 +2484,55 @@ Server_recordOptions(Server *self, PyObject *args, PyObject *kwds)
     return Py_None;
 }
 
+static PyObject *
+Server_setRecordBuffer(Server *self, PyObject *args)
+{
+    char fmt = 'f';
+    PyObject *buffer, *callback = NULL;
+    Py_buffer view;
+
+    if (! PyArg_ParseTuple(args, "O|O", &buffer, &callback))
+        return NULL;
+
+    if (self->record == 2) {
+        Server_error(self, "The record buffer can't be changed during an offline rendering.\n");
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+    if (callback == Py_None)
+        callback = NULL;
+    if (callback != NULL && ! PyCallable_Check(callback)) {
+        PyErr_SetString(PyExc_TypeError, "setRecordBuffer: callback must be callable.");
+        return NULL;
+    }
+    if (buffer != Py_None) {
+        if (PyObject_GetBuffer(buffer, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE) != 0)
+            return NULL;
+        fmt = view.format == NULL ? 'B' : view.format[strlen(view.format)-1];
+        if ((fmt != 'd' && fmt != 'f') || (fmt == 'd' && view.itemsize != sizeof(double)) ||
+            (fmt == 'f' && view.itemsize != sizeof(float)) || view.ndim < 1 || view.ndim > 2 ||
+            (view.ndim == 2 && view.shape[1] != self->nchnls) || (view.ndim == 1 && view.shape[0] % self->nchnls != 0)) {
+            PyErr_Format(PyExc_TypeError, "setRecordBuffer: expected a writable array of float32 or float64 of shape (frames, %d) or (frames * %d,).",
+                         self->nchnls, self->nchnls);
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+    }
+
+    Server_releaseRecordBuffer(self);
+    if (buffer != Py_None) {
+        self->recview = view;
+        self->recbuf = (char *)view.buf;
+        self->recbufDouble = fmt == 'd';
+        self->recbufFrames = (int)(view.len / view.itemsize / self->nchnls);
+        Py_XINCREF(callback);
+        self->recbufCallback = callback;
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyObject *
 Server_start_rec(Server *self, PyObject *args, PyObject *kwds)
 {
@@ -1331,6 +2552,11 @@ Server_start_rec(Server *self, PyObject *args, PyObject *kwds)
 int
 Server_start_rec_internal(Server *self, char *filename)
 {
+    int capacity, offline;
+    SNDFILE *recfile;
+
+    Server_stop_rec_internal(self);
+
     /* Prepare sfinfo */
     self->recinfo.samplerate = (int)self->samplingRate;
     self->recinfo.channels = self->nchnls;
@@ -1394,40 +2620,74 @@ Server_start_rec_internal(Server *self, char *filename)
     /* Open the output file. */
     if (filename == NULL) {
         Server_debug(self, "recpath : %s\n", self->recpath);
-        if (! (self->recfile = sf_open(self->recpath, SFM_WRITE, &self->recinfo))) {
+        if (! (recfile = sf_open(self->recpath, SFM_WRITE, &self->recinfo))) {
             Server_error(self, "Not able to open output file %s.\n", self->recpath);
-            Server_debug(self, "%s\n", sf_strerror(self->recfile));
+            Server_debug(self, "%s\n", sf_strerror(recfile));
             return -1;
         }
     }
     else {
         Server_debug(self, "filename : %s\n", filename);
-        if (! (self->recfile = sf_open(filename, SFM_WRITE, &self->recinfo))) {
+        if (! (recfile = sf_open(filename, SFM_WRITE, &self->recinfo))) {
             Server_error(self, "Not able to open output file %s.\n", filename);
-            Server_debug(self, "%s\n", sf_strerror(self->recfile));
+            Server_debug(self, "%s\n", sf_strerror(recfile));
             return -1;
         }
     }
 
     /* Sets the encoding quality for FLAC and OGG compressed formats. */
     if (self->recformat == 5 || self->recformat == 7) {
-        sf_command(self->recfile, SFC_SET_VBR_ENCODING_QUALITY, &self->recquality, sizeof(double));
+        sf_command(recfile, SFC_SET_VBR_ENCODING_QUALITY, &self->recquality, sizeof(double));
     }
 
-    self->record = 1;
+    /* The file is written by a background thread. An offline server waits
+    ** for the disk, a real-time one drops the buffers that don't fit. */
+    offline = self->audio_be_type == PyoOffline || self->audio_be_type == PyoOfflineNB;
+    capacity = (int)(self->recqueue * self->samplingRate);
+    self->recwriter = SfWriter_new(recfile, self->nchnls, capacity, self->bufferSize, offline);
+    self->recOverruns = 0;
+    SERVER_STORE(self->record, 1);
+    return 0;
+}
+
+int
+Server_stop_rec_internal(Server *self)
+{
+    SfWriter *writer = self->recwriter;
+
+    if (writer == NULL)
+        return 0;
+    SERVER_STORE(self->record, 0);
+    while (SERVER_LOAD(self->recBusy))
+        Server_sleep(50);
+    self->recwriter = NULL;
+    SfWriter_close(writer);
+    self->recOverruns = SfWriter_getOverruns(writer);
+    SfWriter_free(writer);
+    if (self->recOverruns > 0)
+        Server_warning(self, "Recording: %lu buffers were dropped, the disk was too slow.\n", self->recOverruns);
     return 0;
 }
 
 static PyObject *
 Server_stop_rec(Server *self, PyObject *args)
 {
-    self->record = 0;
-    sf_close(self->recfile);
+    Py_BEGIN_ALLOW_THREADS
+    Server_stop_rec_internal(self);
+    Py_END_ALLOW_THREADS
 
     Py_INCREF(Py_None);
     return Py_None;
 }
 
+static PyObject *
+Server_getRecordOverruns(Server *self)
+{
+    if (self->recwriter != NULL)
+        return PyLong_FromUnsignedLong(SfWriter_getOverruns(self->recwriter));
+    return PyLong_FromUnsignedLong(self->recOverruns);
+}
+
 static PyObject *
 Server_addStream(Server *self, PyObject *args)
 {
@@ -1441,10 +2701,16 @@ Server_addStream(Server *self, PyObject *args)
         return PyInt_FromLong(-1);
     }
 
+    if (self->profiling)
+        Stream_setProfiling((Stream *)tmp, 1);
+
     PyList_Append(self->streams, tmp);
 
     self->stream_count++;
 
+    if (self->rtStreams != NULL)
+        Server_publishStreams(self, 1);
+
     Py_INCREF(Py_None);
     return Py_None;
 }
@@ -1463,8 +2729,16 @@ Server_removeStream(Server *self, int id)
                 sid = Stream_getStreamId(stream_tmp);
                 if (sid == id) {
                     Server_debug(self, "Removed stream id %d\n", id);
+                    Py_INCREF(stream_tmp);
                     PySequence_DelItem(self->streams, i);
                     self->stream_count--;
+                    /* A parallel run may still hold it in its array. */
+                    Stream_setStreamActive(stream_tmp, 0);
+                    Server_cancelParams(self, stream_tmp->streamobject);
+                    if (self->rtStreams != NULL)
+                        Server_publishStreams(self, 1);
+                    Server_cancelDeferred(self, stream_tmp->streamobject);
+                    Py_DECREF(stream_tmp);
                     break;
                 }
             }
@@ -1510,6 +2784,9 @@ Server_changeStreamPosition(Server *self, PyObject *args)
     PyList_Insert(self->streams, i, (PyObject *)cur_stream_tmp);
     self->stream_count++;
 
+    if (self->rtStreams != NULL)
+        Server_publishStreams(self, 1);
+
     Py_INCREF(Py_None);
     return Py_None;
 }
@@ -1733,6 +3010,12 @@ Server_getBufferSize(Server *self)
         return PyInt_FromLong(self->bufferSize * self->currentResampling);
 }
 
+static PyObject *
+Server_getElapsedSamples(Server *self)
+{
+    return PyLong_FromUnsignedLong(self->elapsedSamples);
+}
+
 static PyObject *
 Server_beginResamplingBlock(Server *self, PyObject *arg)
 {
@@ -1861,18 +3144,30 @@ static PyMethodDef Server_methods[] = {
     {"setJackAutoConnectInputPorts", (PyCFunction)Server_setJackAutoConnectInputPorts, METH_O, "Sets a list of ports to auto-connect inputs when using Jack."},
     {"setJackAutoConnectOutputPorts", (PyCFunction)Server_setJackAutoConnectOutputPorts, METH_O, "Sets a list of ports to auto-connect outputs when using Jack."},
     {"setGlobalSeed", (PyCFunction)Server_setGlobalSeed, METH_O, "Sets the server's global seed for random objects."},
+    {"setBatch", (PyCFunction)Server_setBatch, METH_O, "Marks a server of an OfflineBatch, its random objects count their seeds on their own."},
     {"setAmp", (PyCFunction)Server_setAmp, METH_O, "Sets the overall amplitude."},
     {"setAmpCallable", (PyCFunction)Server_setAmpCallable, METH_O, "Sets the Server's GUI callable object."},
     {"setTimeCallable", (PyCFunction)Server_setTimeCallable, METH_O, "Sets the Server's TIME callable object."},
     {"setVerbosity", (PyCFunction)Server_setVerbosity, METH_O, "Sets the verbosity."},
     {"setStartOffset", (PyCFunction)Server_setStartOffset, METH_O, "Sets starting time offset."},
+    {"setGILFree", (PyCFunction)Server_setGILFree, METH_O, "Runs the audio callback without holding the GIL."},
+    {"setDSPThreads", (PyCFunction)Server_setDSPThreads, METH_O, "Sets the number of threads processing the streams."},
+    {"setProfiling", (PyCFunction)Server_setProfiling, METH_O, "Turns on or off the DSP profiling."},
+    {"resetProfile", (PyCFunction)Server_resetProfile, METH_NOARGS, "Clears the DSP profiling statistics."},
+    {"getProfile", (PyCFunction)Server_getProfile, METH_NOARGS, "Returns a snapshot of the DSP profiling statistics."},
+    {"setTelemetry", (PyCFunction)Server_setTelemetry, METH_O, "Turns on or off the callback telemetry."},
+    {"resetTelemetry", (PyCFunction)Server_resetTelemetry, METH_NOARGS, "Clears the callback telemetry counters."},
+    {"getTelemetry", (PyCFunction)Server_getTelemetry, METH_O, "Returns the telemetry counters and the last records."},
+    {"setTelemetryFile", (PyCFunction)Server_setTelemetryFile, METH_O, "Writes the telemetry records to a file, None to stop."},
     {"boot", (PyCFunction)Server_boot, METH_O, "Setup and boot the server."},
     {"shutdown", (PyCFunction)Server_shut_down, METH_NOARGS, "Shut down the server."},
     {"start", (PyCFunction)Server_start, METH_NOARGS, "Starts the server's callback loop."},
     {"stop", (PyCFunction)Server_stop, METH_NOARGS, "Stops the server's callback loop."},
     {"recordOptions", (PyCFunction)Server_recordOptions, METH_VARARGS|METH_KEYWORDS, "Sets format settings for offline rendering and global recording."},
+    {"setRecordBuffer", (PyCFunction)Server_setRecordBuffer, METH_VARARGS, "Sets a buffer receiving the offline rendering instead of a file."},
     {"recstart", (PyCFunction)Server_start_rec, METH_VARARGS|METH_KEYWORDS, "Start automatic output recording."},
     {"recstop", (PyCFunction)Server_stop_rec, METH_NOARGS, "Stop automatic output recording."},
+    {"getRecordOverruns", (PyCFunction)Server_getRecordOverruns, METH_NOARGS, "Returns the number of buffers dropped by the recording."},
     {"addStream", (PyCFunction)Server_addStream, METH_VARARGS, "Adds an audio stream to the server. \
                                                                 This is for internal use and must never be called by the user."},
     {"removeStream", (PyCFunction)Server_removeStream, METH_VARARGS, "Adds an audio stream to the server. \
@@ -1892,6 +3187,7 @@ static PyMethodDef Server_methods[] = {
     {"getIchnls", (PyCFunction)Server_getIchnls, METH_NOARGS, "Returns the server's current number of input channels."},
     {"getGlobalSeed", (PyCFunction)Server_getGlobalSeed, METH_NOARGS, "Returns the server's global seed."},
     {"getBufferSize", (PyCFunction)Server_getBufferSize, METH_NOARGS, "Returns the server's buffer size."},
+    {"getElapsedSamples", (PyCFunction)Server_getElapsedSamples, METH_NOARGS, "Returns the number of samples computed since the server was booted."},
     {"getIsBooted", (PyCFunction)Server_getIsBooted, METH_NOARGS, "Returns 1 if the server is booted, otherwise returns 0."},
     {"getIsStarted", (PyCFunction)Server_getIsStarted, METH_NOARGS, "Returns 1 if the server is started, otherwise returns 0."},
     {"getMidiActive", (PyCFunction)Server_getMidiActive, METH_NOARGS, "Returns 1 if midi callback is active, otherwise returns 0."},
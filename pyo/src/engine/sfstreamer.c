@@ -0,0 +1,340 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "sfstreamer.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__GNUC__)
+#define STREAMER_LOAD(x) __atomic_load_n(&(x), __ATOMIC_SEQ_CST)
+#define STREAMER_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_SEQ_CST)
+#define STREAMER_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define STREAMER_LOAD(x) (__sync_synchronize(), (x))
+#define STREAMER_STORE(x, v) do { __sync_synchronize(); (x) = (v); __sync_synchronize(); } while (0)
+#define STREAMER_FENCE() __sync_synchronize()
+#endif
+
+/* Blocks kept behind the reading position and after a jump. */
+#define SFSTREAMER_BEHIND 1
+#define SFSTREAMER_NEXT 4
+/* Blocks loaded for one file before the I/O thread serves the others. */
+#define SFSTREAMER_LOADS_PER_PASS 2
+
+typedef struct {
+    sf_count_t block; /* -1 when empty */
+    unsigned int version; /* odd while the block is loading */
+    MYFLT *data;
+} SfStreamerSlot;
+
+struct SfStreamer {
+    SNDFILE *sf;
+    int chnls;
+    sf_count_t frames;
+    sf_count_t nblocks;
+    int blocking;
+    MYFLT *memory;
+    SfStreamerSlot slots[SFSTREAMER_BLOCKS];
+    /* Written by the reading side, read by the I/O thread. */
+    sf_count_t pos; /* -1 until the first prefetch */
+    int dir;
+    int span;
+    sf_count_t next;
+    int nextDir;
+    struct SfStreamer *link; /* list of the I/O thread */
+};
+
+static pthread_mutex_t streamers_mutex = PTHREAD_MUTEX_INITIALIZER;
+static SfStreamer *streamers = NULL;
+static int streamers_running = 0;
+
+static void
+SfStreamer_sleep(int usec)
+{
+#ifdef _WIN32
+    Sleep(usec / 1000 > 0 ? usec / 1000 : 1);
+#else
+    usleep(usec);
+#endif
+}
+
+/* Only the I/O thread, or the caller of a blocking streamer, loads blocks. */
+static void
+SfStreamer_load(SfStreamer *self, sf_count_t block)
+{
+    sf_count_t num, start = block * SFSTREAMER_BLOCK_SIZE;
+    SfStreamerSlot *slot = &self->slots[block % SFSTREAMER_BLOCKS];
+    unsigned int version = slot->version;
+
+    STREAMER_STORE(slot->version, version + 1);
+    STREAMER_STORE(slot->block, block);
+    num = self->frames - start;
+    if (num > SFSTREAMER_BLOCK_SIZE)
+        num = SFSTREAMER_BLOCK_SIZE;
+    sf_seek(self->sf, start, SEEK_SET);
+    num = SF_READ(self->sf, slot->data, num * self->chnls);
+    if (num < 0)
+        num = 0;
+    memset(slot->data + num, 0, (SFSTREAMER_BLOCK_SIZE * self->chnls - num) * sizeof(MYFLT));
+    STREAMER_STORE(slot->version, version + 2);
+}
+
+/* Copies count frames from offset in block, returns 0 if the block is not there. */
+static int
+SfStreamer_copy(SfStreamer *self, sf_count_t block, int offset, int count, MYFLT *buffer)
+{
+    SfStreamerSlot *slot = &self->slots[block % SFSTREAMER_BLOCKS];
+    unsigned int version = STREAMER_LOAD(slot->version);
+
+    if ((version & 1) || STREAMER_LOAD(slot->block) != block)
+        return 0;
+    memcpy(buffer, slot->data + offset * self->chnls, count * self->chnls * sizeof(MYFLT));
+    STREAMER_FENCE();
+    return STREAMER_LOAD(slot->version) == version;
+}
+
+int
+SfStreamer_read(SfStreamer *self, sf_count_t start, int count, MYFLT *buffer)
+{
+    int num, offset, missing = 0;
+    sf_count_t block;
+
+    if (self == NULL)
+        return count;
+    while (count > 0) {
+        if (start < 0 || start >= self->frames) {
+            num = count;
+            if (start < 0 && -start < num)
+                num = (int)-start;
+            memset(buffer, 0, num * self->chnls * sizeof(MYFLT));
+        }
+        else {
+            block = start / SFSTREAMER_BLOCK_SIZE;
+            offset = (int)(start - block * SFSTREAMER_BLOCK_SIZE);
+            num = SFSTREAMER_BLOCK_SIZE - offset;
+            if (num > count)
+                num = count;
+            if (!SfStreamer_copy(self, block, offset, num, buffer)) {
+                if (self->blocking) {
+                    SfStreamer_load(self, block);
+                    SfStreamer_copy(self, block, offset, num, buffer);
+                }
+                else {
+                    memset(buffer, 0, num * self->chnls * sizeof(MYFLT));
+                    missing += num;
+                }
+            }
+        }
+        start += num;
+        buffer += num * self->chnls;
+        count -= num;
+    }
+    return missing;
+}
+
+void
+SfStreamer_prefetch(SfStreamer *self, sf_count_t pos, int dir, int span, sf_count_t next, int nextDir)
+{
+    if (self == NULL || self->blocking)
+        return;
+    STREAMER_STORE(self->dir, dir);
+    STREAMER_STORE(self->span, span);
+    STREAMER_STORE(self->next, next);
+    STREAMER_STORE(self->nextDir, nextDir);
+    STREAMER_STORE(self->pos, pos);
+}
+
+/* Blocks wanted by the reading position, the most urgent first. */
+static int
+SfStreamer_wanted(SfStreamer *self, sf_count_t *blocks)
+{
+    int i, n = 0, ahead;
+    sf_count_t block, pos = STREAMER_LOAD(self->pos);
+    sf_count_t next = STREAMER_LOAD(self->next);
+    int dir = STREAMER_LOAD(self->dir) < 0 ? -1 : 1;
+    int nextDir = STREAMER_LOAD(self->nextDir) < 0 ? -1 : 1;
+
+    if (pos < 0)
+        return 0;
+    ahead = STREAMER_LOAD(self->span) * SFSTREAMER_AHEAD / SFSTREAMER_BLOCK_SIZE + 1;
+    if (ahead < 8)
+        ahead = 8;
+    else if (ahead > SFSTREAMER_BLOCKS - SFSTREAMER_BEHIND - SFSTREAMER_NEXT - 1)
+        ahead = SFSTREAMER_BLOCKS - SFSTREAMER_BEHIND - SFSTREAMER_NEXT - 1;
+
+    block = pos / SFSTREAMER_BLOCK_SIZE;
+    for (i=0; i<=ahead; i++)
+        blocks[n++] = block + i * dir;
+    for (i=1; i<=SFSTREAMER_BEHIND; i++)
+        blocks[n++] = block - i * dir;
+    if (next >= 0) {
+        block = next / SFSTREAMER_BLOCK_SIZE;
+        for (i=0; i<SFSTREAMER_NEXT; i++)
+            blocks[n++] = block + i * nextDir;
+    }
+    return n;
+}
+
+/* Returns the number of blocks loaded. */
+static int
+SfStreamer_service(SfStreamer *self)
+{
+    int i, n, loads = 0;
+    sf_count_t block, blocks[SFSTREAMER_BLOCKS * 2], want[SFSTREAMER_BLOCKS];
+
+    n = SfStreamer_wanted(self, blocks);
+    for (i=0; i<SFSTREAMER_BLOCKS; i++)
+        want[i] = -1;
+    /* A slot goes to the most urgent block mapped on it. */
+    for (i=0; i<n; i++) {
+        block = blocks[i];
+        if (block >= 0 && block < self->nblocks && want[block % SFSTREAMER_BLOCKS] == -1)
+            want[block % SFSTREAMER_BLOCKS] = block;
+    }
+    for (i=0; i<n && loads<SFSTREAMER_LOADS_PER_PASS; i++) {
+        block = blocks[i];
+        if (block < 0 || block >= self->nblocks || want[block % SFSTREAMER_BLOCKS] != block)
+            continue;
+        if (self->slots[block % SFSTREAMER_BLOCKS].block != block) {
+            SfStreamer_load(self, block);
+            loads++;
+        }
+    }
+    return loads;
+}
+
+static void *
+SfStreamer_thread(void *arg)
+{
+    int work;
+    SfStreamer *streamer;
+
+    for (;;) {
+        pthread_mutex_lock(&streamers_mutex);
+        if (streamers == NULL) {
+            streamers_running = 0;
+            pthread_mutex_unlock(&streamers_mutex);
+            break;
+        }
+        work = 0;
+        for (streamer=streamers; streamer!=NULL; streamer=streamer->link)
+            work += SfStreamer_service(streamer);
+        pthread_mutex_unlock(&streamers_mutex);
+        if (work == 0)
+            SfStreamer_sleep(2000);
+    }
+    return NULL;
+}
+
+SfStreamer *
+SfStreamer_open(const char *path, SF_INFO *info, int blocking)
+{
+    int i;
+    pthread_t thread;
+    SfStreamer *self;
+    SNDFILE *sf;
+
+    info->format = 0;
+    sf = sf_open(path, SFM_READ, info);
+    if (sf == NULL)
+        return NULL;
+
+    self = (SfStreamer *)calloc(1, sizeof(SfStreamer));
+    self->sf = sf;
+    self->chnls = info->channels;
+    self->frames = info->frames;
+    self->nblocks = (info->frames + SFSTREAMER_BLOCK_SIZE - 1) / SFSTREAMER_BLOCK_SIZE;
+    self->blocking = blocking;
+    self->memory = (MYFLT *)malloc(SFSTREAMER_BLOCKS * SFSTREAMER_BLOCK_SIZE * self->chnls * sizeof(MYFLT));
+    for (i=0; i<SFSTREAMER_BLOCKS; i++) {
+        self->slots[i].block = -1;
+        self->slots[i].version = 0;
+        self->slots[i].data = self->memory + i * SFSTREAMER_BLOCK_SIZE * self->chnls;
+    }
+    self->pos = self->next = -1;
+    self->dir = self->nextDir = 1;
+
+    if (blocking)
+        return self;
+
+    pthread_mutex_lock(&streamers_mutex);
+    self->link = streamers;
+    streamers = self;
+    if (!streamers_running) {
+        if (pthread_create(&thread, NULL, SfStreamer_thread, NULL) == 0) {
+            pthread_detach(thread);
+            streamers_running = 1;
+        }
+        else {
+            /* No I/O thread, read on demand. */
+            streamers = self->link;
+            self->blocking = 1;
+        }
+    }
+    pthread_mutex_unlock(&streamers_mutex);
+    return self;
+}
+
+void
+SfStreamer_close(SfStreamer *self)
+{
+    SfStreamer **p;
+
+    if (self == NULL)
+        return;
+    if (!self->blocking) {
+        /* The I/O thread holds the mutex while it uses the streamer. */
+        pthread_mutex_lock(&streamers_mutex);
+        for (p=&streamers; *p!=NULL; p=&(*p)->link) {
+            if (*p == self) {
+                *p = self->link;
+                break;
+            }
+        }
+        pthread_mutex_unlock(&streamers_mutex);
+    }
+    sf_close(self->sf);
+    free(self->memory);
+    free(self);
+}
+
+void
+SfStreamer_seek(SfStreamer *self, sf_count_t pos, int dir, int span, int timeout)
+{
+    sf_count_t block;
+    SfStreamerSlot *slot;
+
+    if (self->blocking || pos < 0 || pos >= self->frames)
+        return;
+    SfStreamer_prefetch(self, pos, dir, span, -1, dir);
+    block = pos / SFSTREAMER_BLOCK_SIZE;
+    slot = &self->slots[block % SFSTREAMER_BLOCKS];
+    while (timeout-- > 0) {
+        if (STREAMER_LOAD(slot->block) == block && (STREAMER_LOAD(slot->version) & 1) == 0)
+            break;
+        SfStreamer_sleep(1000);
+    }
+}
@@ -0,0 +1,206 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "sfwriter.h"
+#include <stdlib.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__GNUC__)
+#define WRITER_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define WRITER_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#else
+#define WRITER_LOAD(x) (__sync_synchronize(), (x))
+#define WRITER_STORE(x, v) do { __sync_synchronize(); (x) = (v); __sync_synchronize(); } while (0)
+#endif
+
+#define SFWRITER_CONVERT_SIZE 256
+
+struct SfWriter {
+    SNDFILE *sf;
+    int chnls;
+    int chunk; /* samples */
+    int blocking;
+    int threaded; /* 0 if the writer thread could not be started */
+    SPSCRing *ring;
+    MYFLT *scratch; /* used by the writer thread only */
+    pthread_t thread;
+    int closing;
+    unsigned long overruns;
+};
+
+static void
+SfWriter_sleep(int usec)
+{
+#ifdef _WIN32
+    Sleep(usec / 1000 > 0 ? usec / 1000 : 1);
+#else
+    usleep(usec);
+#endif
+}
+
+static void *
+SfWriter_thread(void *arg)
+{
+    int avail, closing;
+    SfWriter *self = (SfWriter *)arg;
+
+    for (;;) {
+        closing = WRITER_LOAD(self->closing);
+        avail = SPSCRing_readable(self->ring);
+        /* Frames are never split between two writes. */
+        avail -= avail % self->chnls;
+        if (avail >= self->chunk || (closing && avail > 0)) {
+            if (avail > self->chunk)
+                avail = self->chunk;
+            SPSCRing_read(self->ring, self->scratch, avail);
+            SF_WRITE(self->sf, self->scratch, avail);
+        }
+        else if (closing)
+            break;
+        else
+            SfWriter_sleep(2000);
+    }
+    return NULL;
+}
+
+SfWriter *
+SfWriter_new(SNDFILE *file, int chnls, int capacity, int chunk, int blocking)
+{
+    SfWriter *self;
+
+    if (chunk < 1)
+        chunk = 1;
+    /* A producer waiting for room must always leave a full chunk to write. */
+    if (capacity < chunk * 2)
+        capacity = chunk * 2;
+
+    self = (SfWriter *)calloc(1, sizeof(SfWriter));
+    self->sf = file;
+    self->chnls = chnls;
+    self->chunk = chunk * chnls;
+    self->blocking = blocking;
+    self->ring = SPSCRing_new(capacity * chnls);
+    self->scratch = (MYFLT *)malloc(self->chunk * sizeof(MYFLT));
+    self->closing = 0;
+    self->overruns = 0;
+    /* Without a writer thread, frames are written by the caller. */
+    self->threaded = pthread_create(&self->thread, NULL, SfWriter_thread, self) == 0;
+    return self;
+}
+
+/* Returns 1 when n samples can be pushed. */
+static int
+SfWriter_reserve(SfWriter *self, int n)
+{
+    if (SPSCRing_writable(self->ring) >= n)
+        return 1;
+    if (!self->blocking || n > SPSCRing_getSize(self->ring)) {
+        self->overruns++;
+        return 0;
+    }
+    while (SPSCRing_writable(self->ring) < n)
+        SfWriter_sleep(100);
+    return 1;
+}
+
+int
+SfWriter_write(SfWriter *self, const MYFLT *data, int frames)
+{
+    int n;
+
+    if (self == NULL || WRITER_LOAD(self->closing))
+        return 0;
+    n = frames * self->chnls;
+    if (!self->threaded) {
+        SF_WRITE(self->sf, (MYFLT *)data, n);
+        return 1;
+    }
+    if (!SfWriter_reserve(self, n))
+        return 0;
+    SPSCRing_write(self->ring, data, n);
+    return 1;
+}
+
+int
+SfWriter_writeFloat(SfWriter *self, const float *data, int frames)
+{
+#ifdef USE_DOUBLE
+    int i, n, num;
+    MYFLT convert[SFWRITER_CONVERT_SIZE];
+
+    if (self == NULL || WRITER_LOAD(self->closing))
+        return 0;
+    n = frames * self->chnls;
+    if (!self->threaded) {
+        sf_write_float(self->sf, data, n);
+        return 1;
+    }
+    if (!SfWriter_reserve(self, n))
+        return 0;
+    /* The writer thread only takes whole frames, pieces can be published. */
+    while (n > 0) {
+        num = n < SFWRITER_CONVERT_SIZE ? n : SFWRITER_CONVERT_SIZE;
+        for (i=0; i<num; i++)
+            convert[i] = (MYFLT)data[i];
+        SPSCRing_write(self->ring, convert, num);
+        data += num;
+        n -= num;
+    }
+    return 1;
+#else
+    return SfWriter_write(self, data, frames);
+#endif
+}
+
+void
+SfWriter_close(SfWriter *self)
+{
+    if (self == NULL || self->sf == NULL)
+        return;
+    WRITER_STORE(self->closing, 1);
+    if (self->threaded)
+        pthread_join(self->thread, NULL);
+    sf_close(self->sf);
+    self->sf = NULL;
+}
+
+void
+SfWriter_free(SfWriter *self)
+{
+    if (self == NULL)
+        return;
+    SfWriter_close(self);
+    SPSCRing_free(self->ring);
+    free(self->scratch);
+    free(self);
+}
+
+unsigned long
+SfWriter_getOverruns(SfWriter *self)
+{
+    if (self == NULL)
+        return 0;
+    return self->overruns;
+}
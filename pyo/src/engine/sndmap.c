@@ -0,0 +1,283 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "sndmap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#if !defined(MAP_ANON) && defined(MAP_ANONYMOUS)
+#define MAP_ANON MAP_ANONYMOUS
+#endif
+
+#define SNDMAP_CHUNK 65536 /* frames decoded at once */
+
+static unsigned int
+SndMap_le16(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static unsigned long
+SndMap_le32(const unsigned char *p)
+{
+    return (unsigned long)p[0] | ((unsigned long)p[1] << 8) | ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+}
+
+/* Returns the offset of the samples if path is a mono WAV file of MYFLT
+** floats, in the byte order of the machine, -1 otherwise. */
+static off_t
+SndMap_directOffset(const char *path)
+{
+    unsigned char header[12], chunk[8], fmt[26];
+    unsigned long size;
+    unsigned int tag = 0, chnls = 0, bits = 0;
+    unsigned int one = 1;
+    off_t offset = -1;
+    FILE *f;
+
+    if (*(unsigned char *)&one != 1)
+        return -1;
+    f = fopen(path, "rb");
+    if (f == NULL)
+        return -1;
+    if (fread(header, 1, 12, f) != 12 || memcmp(header, "RIFF", 4) || memcmp(header + 8, "WAVE", 4)) {
+        fclose(f);
+        return -1;
+    }
+    while (fread(chunk, 1, 8, f) == 8) {
+        size = SndMap_le32(chunk + 4);
+        if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+            memset(fmt, 0, sizeof(fmt));
+            if (fread(fmt, 1, size < sizeof(fmt) ? size : sizeof(fmt), f) < 16)
+                break;
+            tag = SndMap_le16(fmt);
+            chnls = SndMap_le16(fmt + 2);
+            bits = SndMap_le16(fmt + 14);
+            /* WAVE_FORMAT_EXTENSIBLE, the tag starts the subformat GUID. */
+            if (tag == 0xFFFE && size >= 26)
+                tag = SndMap_le16(fmt + 24);
+            size -= size < sizeof(fmt) ? size : sizeof(fmt);
+        }
+        else if (memcmp(chunk, "data", 4) == 0) {
+            if (tag == 3 && chnls == 1 && bits == sizeof(MYFLT) * 8)
+                offset = ftello(f);
+            break;
+        }
+        if (fseeko(f, (off_t)(size + (size & 1)), SEEK_CUR) != 0)
+            break;
+    }
+    fclose(f);
+    if (offset % sizeof(MYFLT) != 0)
+        return -1;
+    return offset;
+}
+
+/* Maps count samples, plus the guard point, starting at offset in fd. The
+** pages after the end of the file come from an anonymous mapping. */
+static MYFLT *
+SndMap_map(SndMap *map, int fd, off_t offset, sf_count_t count)
+{
+    size_t pagesize = (size_t)sysconf(_SC_PAGESIZE);
+    off_t aligned = offset - offset % pagesize;
+    size_t delta = (size_t)(offset - aligned);
+    size_t length = (delta + (count + 1) * sizeof(MYFLT) + pagesize - 1) / pagesize * pagesize;
+    size_t filelen;
+    struct stat st;
+    void *base;
+    MYFLT *data;
+
+    if (fstat(fd, &st) != 0 || st.st_size <= aligned)
+        return NULL;
+    filelen = (size_t)(st.st_size - aligned);
+    filelen = (filelen + pagesize - 1) / pagesize * pagesize;
+    if (filelen > length)
+        filelen = length;
+
+    base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (base == MAP_FAILED)
+        return NULL;
+    if (mmap(base, filelen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, aligned) == MAP_FAILED) {
+        munmap(base, length);
+        return NULL;
+    }
+    map->base = base;
+    map->length = length;
+    data = (MYFLT *)((char *)base + delta);
+    data[count] = data[0];
+    return data;
+}
+
+static MYFLT *
+SndMap_mapPath(SndMap *map, const char *path, off_t offset, sf_count_t count)
+{
+    MYFLT *data;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        return NULL;
+    /* The mapping keeps its own reference to the file. */
+    data = SndMap_map(map, fd, offset, count);
+    close(fd);
+    return data;
+}
+
+/* Decodes frames [start, stop) of channel chnl in the file sidecar. The
+** file is written under a temporary name, then renamed, another process
+** never sees a partial sidecar. */
+static int
+SndMap_decode(const char *path, int chnl, sf_count_t start, sf_count_t stop, const char *sidecar)
+{
+    int i, num, chnls;
+    sf_count_t frames, left = stop - start;
+    char tmppath[PATH_MAX];
+    MYFLT *buffer, *out;
+    SF_INFO info;
+    SNDFILE *sf;
+    FILE *f;
+
+    /* A sidecar path too long for the suffix is not decoded. */
+    if (snprintf(tmppath, PATH_MAX, "%s.%d.tmp", sidecar, (int)getpid()) >= PATH_MAX)
+        return -1;
+
+    info.format = 0;
+    sf = sf_open(path, SFM_READ, &info);
+    if (sf == NULL)
+        return -1;
+    chnls = info.channels;
+    if (chnl >= chnls || sf_seek(sf, start, SEEK_SET) < 0) {
+        sf_close(sf);
+        return -1;
+    }
+    f = fopen(tmppath, "wb");
+    if (f == NULL) {
+        sf_close(sf);
+        return -1;
+    }
+
+    buffer = (MYFLT *)malloc(SNDMAP_CHUNK * chnls * sizeof(MYFLT));
+    out = (MYFLT *)malloc(SNDMAP_CHUNK * sizeof(MYFLT));
+    while (left > 0) {
+        frames = left < SNDMAP_CHUNK ? left : SNDMAP_CHUNK;
+        num = (int)(SF_READ(sf, buffer, frames * chnls) / chnls);
+        if (num <= 0)
+            break;
+        for (i=0; i<num; i++)
+            out[i] = buffer[i * chnls + chnl];
+        if (fwrite(out, sizeof(MYFLT), num, f) != (size_t)num)
+            break;
+        left -= num;
+    }
+    free(buffer);
+    free(out);
+    sf_close(sf);
+
+    if (fclose(f) != 0 || left > 0 || rename(tmppath, sidecar) != 0) {
+        remove(tmppath);
+        return -1;
+    }
+    return 0;
+}
+
+/* FNV-1a. */
+static unsigned long long
+SndMap_hash(const char *str)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+
+    while (*str) {
+        hash ^= (unsigned char)*str++;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+MYFLT *
+SndMap_open(SndMap *map, const char *path, int chnl, sf_count_t start, sf_count_t stop,
+            const char *cachedir)
+{
+    char fullpath[PATH_MAX], key[PATH_MAX + 128], sidecar[PATH_MAX];
+    sf_count_t count = stop - start;
+    off_t offset;
+    struct stat st;
+
+    map->base = NULL;
+    map->length = 0;
+    if (count <= 0 || start < 0)
+        return NULL;
+
+    if (chnl == 0) {
+        offset = SndMap_directOffset(path);
+        if (offset >= 0)
+            return SndMap_mapPath(map, path, offset + start * sizeof(MYFLT), count);
+    }
+
+    if (cachedir == NULL || cachedir[0] == '\0')
+        return NULL;
+    if (realpath(path, fullpath) == NULL || stat(fullpath, &st) != 0)
+        return NULL;
+    snprintf(key, sizeof(key), "%s|%lld|%lld|%d|%lld|%lld|%d", fullpath, (long long)st.st_size,
+             (long long)st.st_mtime, chnl, (long long)start, (long long)stop, (int)sizeof(MYFLT));
+    snprintf(sidecar, PATH_MAX, "%s/pyo-%016llx.raw", cachedir, SndMap_hash(key));
+
+    if (stat(sidecar, &st) != 0 || st.st_size != (off_t)(count * sizeof(MYFLT))) {
+        if (SndMap_decode(path, chnl, start, stop, sidecar) != 0)
+            return NULL;
+    }
+    return SndMap_mapPath(map, sidecar, 0, count);
+}
+
+void
+SndMap_close(SndMap *map)
+{
+    if (map->base == NULL)
+        return;
+    munmap(map->base, map->length);
+    map->base = NULL;
+    map->length = 0;
+}
+
+#else
+
+/* No mapping on Windows, tables are read in memory. */
+MYFLT *
+SndMap_open(SndMap *map, const char *path, int chnl, sf_count_t start, sf_count_t stop,
+            const char *cachedir)
+{
+    map->base = NULL;
+    map->length = 0;
+    return NULL;
+}
+
+void
+SndMap_close(SndMap *map)
+{
+    map->base = NULL;
+}
+
+#endif
@@ -0,0 +1,129 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+#include "spscring.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* The producer publishes head after copying the samples (release) and the
+** consumer reads it before reading the samples (acquire), and vice versa
+** for tail. */
+#if defined(__GNUC__)
+#define SPSC_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define SPSC_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define SPSC_LOAD(x) (_ReadWriteBarrier(), *(volatile unsigned int *)&(x))
+#define SPSC_STORE(x, v) do { _ReadWriteBarrier(); *(volatile unsigned int *)&(x) = (v); } while (0)
+#else
+#define SPSC_LOAD(x) (__sync_synchronize(), *(volatile unsigned int *)&(x))
+#define SPSC_STORE(x, v) do { __sync_synchronize(); *(volatile unsigned int *)&(x) = (v); } while (0)
+#endif
+
+SPSCRing *
+SPSCRing_new(int capacity)
+{
+    unsigned int size = 1;
+    SPSCRing *ring;
+
+    while (size < (unsigned int)capacity && size < (1U << 30))
+        size <<= 1;
+
+    ring = (SPSCRing *)calloc(1, sizeof(SPSCRing));
+    ring->buffer = (MYFLT *)calloc(size, sizeof(MYFLT));
+    ring->size = size;
+    ring->mask = size - 1;
+    ring->head = ring->tail = 0;
+    return ring;
+}
+
+void
+SPSCRing_free(SPSCRing *ring)
+{
+    if (ring == NULL)
+        return;
+    free(ring->buffer);
+    free(ring);
+}
+
+int
+SPSCRing_getSize(SPSCRing *ring)
+{
+    return (int)ring->size;
+}
+
+int
+SPSCRing_readable(SPSCRing *ring)
+{
+    return (int)(SPSC_LOAD(ring->head) - ring->tail);
+}
+
+int
+SPSCRing_writable(SPSCRing *ring)
+{
+    return (int)(ring->size - (ring->head - SPSC_LOAD(ring->tail)));
+}
+
+int
+SPSCRing_write(SPSCRing *ring, const MYFLT *data, int n)
+{
+    unsigned int head, start, first;
+    int space = SPSCRing_writable(ring);
+
+    if (n > space)
+        n = space;
+    if (n <= 0)
+        return 0;
+
+    head = ring->head;
+    start = head & ring->mask;
+    first = ring->size - start;
+    if ((unsigned int)n <= first)
+        memcpy(ring->buffer + start, data, n * sizeof(MYFLT));
+    else {
+        memcpy(ring->buffer + start, data, first * sizeof(MYFLT));
+        memcpy(ring->buffer, data + first, (n - first) * sizeof(MYFLT));
+    }
+    SPSC_STORE(ring->head, head + n);
+    return n;
+}
+
+int
+SPSCRing_read(SPSCRing *ring, MYFLT *data, int n)
+{
+    unsigned int tail, start, first;
+    int avail = SPSCRing_readable(ring);
+
+    if (n > avail)
+        n = avail;
+    if (n <= 0)
+        return 0;
+
+    tail = ring->tail;
+    start = tail & ring->mask;
+    first = ring->size - start;
+    if ((unsigned int)n <= first)
+        memcpy(data, ring->buffer + start, n * sizeof(MYFLT));
+    else {
+        memcpy(data, ring->buffer + start, first * sizeof(MYFLT));
+        memcpy(data + first, ring->buffer, (n - first) * sizeof(MYFLT));
+    }
+    SPSC_STORE(ring->tail, tail + n);
+    return n;
+}
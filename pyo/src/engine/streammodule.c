@@ -19,15 +19,135 @@
  *************************************************************************/
 
 #include <Python.h>
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
 #include "structmember.h"
 #include "pyomodule.h"
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
 
 #define __STREAM_MODULE
 #include "streammodule.h"
 #undef __STREAM_MODULE
+#include "dspgraph.h"
+
+/* The audio thread publishes viewCount after copying a block (release) and
+** the readers load it before reading the rows (acquire). */
+#if defined(__GNUC__)
+#define STREAM_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define STREAM_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#else
+#define STREAM_LOAD(x) (__sync_synchronize(), (x))
+#define STREAM_STORE(x, v) do { __sync_synchronize(); (x) = (v); __sync_synchronize(); } while (0)
+#endif
 
 int stream_id = 1;
 
+/** Profiling statistics. **/
+/***************************/
+
+/* Monotonic time, in nanoseconds. */
+double
+PyoProfile_getTime()
+{
+#ifdef _WIN32
+    static double ns_per_tick = 0.0;
+    LARGE_INTEGER count;
+    if (ns_per_tick == 0.0) {
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency(&freq);
+        ns_per_tick = 1e9 / (double)freq.QuadPart;
+    }
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart * ns_per_tick;
+#elif defined(__APPLE__)
+    static double ns_per_tick = 0.0;
+    if (ns_per_tick == 0.0) {
+        mach_timebase_info_data_t info;
+        mach_timebase_info(&info);
+        ns_per_tick = (double)info.numer / (double)info.denom;
+    }
+    return (double)mach_absolute_time() * ns_per_tick;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+void
+PyoProfile_reset(PyoProfile *self)
+{
+    memset(self, 0, sizeof(PyoProfile));
+}
+
+void
+PyoProfile_add(PyoProfile *self, double time)
+{
+    int e, bin;
+    double m;
+
+    if (self->count == 0 || time < self->min)
+        self->min = time;
+    if (time > self->max)
+        self->max = time;
+    self->sum += time;
+    self->count++;
+
+    if (time < PYO_PROFILE_MIN_TIME)
+        bin = 0;
+    else {
+        /* time / MIN_TIME = m * 2^e, with 0.5 <= m < 1 */
+        m = frexp(time / PYO_PROFILE_MIN_TIME, &e);
+        bin = (e - 1) * PYO_PROFILE_BINS_PER_OCTAVE + (int)((m * 2.0 - 1.0) * PYO_PROFILE_BINS_PER_OCTAVE);
+        if (bin >= PYO_PROFILE_BINS)
+            bin = PYO_PROFILE_BINS - 1;
+    }
+    self->hist[bin]++;
+}
+
+/* Upper bound of the histogram bin holding the p percentile (0 < p <= 1),
+** clipped to the measured extremes. */
+double
+PyoProfile_percentile(PyoProfile *self, double p)
+{
+    int i;
+    unsigned long target, acc = 0;
+    double upper = self->max;
+
+    if (self->count == 0)
+        return 0.0;
+    target = (unsigned long)ceil(p * self->count);
+    for (i=0; i<PYO_PROFILE_BINS-1; i++) {
+        acc += self->hist[i];
+        if (acc >= target) {
+            upper = PYO_PROFILE_MIN_TIME * pow(2.0, (double)(i + 1) / PYO_PROFILE_BINS_PER_OCTAVE);
+            break;
+        }
+    }
+    if (upper > self->max)
+        upper = self->max;
+    if (upper < self->min)
+        upper = self->min;
+    return upper;
+}
+
+/* Returns a dictionary {count, min, mean, p99, max}, times in microseconds. */
+PyObject *
+PyoProfile_toDict(PyoProfile *self)
+{
+    double mean = self->count > 0 ? self->sum / self->count : 0.0;
+    return Py_BuildValue("{s:k,s:d,s:d,s:d,s:d}", "count", self->count, "min", self->min * 0.001,
+                         "mean", mean * 0.001, "p99", PyoProfile_percentile(self, 0.99) * 0.001,
+                         "max", self->max * 0.001);
+}
+
 int
 Stream_getNewStreamId()
 {
@@ -52,6 +172,11 @@ static void
 Stream_dealloc(Stream* self)
 {
     self->data = NULL;
+    free(self->views);
+    if (self->profile != NULL)
+        free(self->profile);
+    if (self->accesses != NULL)
+        free(self->accesses);
     Stream_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -80,6 +205,12 @@ Stream_getStreamToDac(Stream *self)
     return self->todac;
 }
 
+int
+Stream_getStreamNeedsGIL(Stream *self)
+{
+    return self->needsgil;
+}
+
 int
 Stream_getBufferCountWait(Stream *self)
 {
@@ -95,6 +226,7 @@ Stream_getDuration(Stream *self)
 MYFLT *
 Stream_getData(Stream *self)
 {
+    PYO_GRAPH_READ(self);
     return (MYFLT *)self->data;
 }
 
@@ -123,15 +255,137 @@ void Stream_IncrementBufferCount(Stream *self)
     }
 }
 
-void Stream_IncrementDurationCount(Stream *self)
+/* Returns 1 when the duration is over, the caller is responsible for stopping the object. */
+int Stream_IncrementDurationCount(Stream *self)
 {
     self->bufferCount++;
     if (self->bufferCount >= self->duration) {
-        PyObject_CallMethod((PyObject *)Stream_getStreamObject(self), "stop", NULL);
         self->duration = self->bufferCount = 0;
+        return 1;
+    }
+    return 0;
+}
+
+/* Statistics are allocated the first time profiling is turned on and kept
+** until the stream is deleted, the audio callback may still be reading them. */
+void
+Stream_setProfiling(Stream *self, int state)
+{
+    if (state && self->profile == NULL) {
+        self->profile = (PyoProfile *)malloc(sizeof(PyoProfile));
+        if (self->profile != NULL)
+            PyoProfile_reset(self->profile);
     }
 }
 
+PyoProfile *
+Stream_getProfile(Stream *self)
+{
+    return self->profile;
+}
+
+/** Buffer protocol. **/
+/**********************/
+
+int
+PyoBuffer_fillView(Py_buffer *view, PyObject *obj, MYFLT *data, int ndim, Py_ssize_t *shape,
+                   Py_ssize_t *strides, int readonly, int flags)
+{
+    int i, contiguous = 1;
+    Py_ssize_t len = 1, stride = sizeof(MYFLT);
+
+    for (i=ndim-1; i>=0; i--) {
+        if (shape[i] > 1 && strides[i] != stride)
+            contiguous = 0;
+        stride *= shape[i];
+        len *= shape[i];
+    }
+    if (readonly && (flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "Object is not writable.");
+        return -1;
+    }
+    if ((!contiguous && ((flags & PyBUF_STRIDES) != PyBUF_STRIDES || (flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS ||
+                         (flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS)) ||
+        (ndim > 1 && (flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS)) {
+        PyErr_SetString(PyExc_BufferError, "Object doesn't have the requested contiguity.");
+        return -1;
+    }
+
+    Py_INCREF(obj);
+    view->obj = obj;
+    view->buf = (void *)data;
+    view->len = len * sizeof(MYFLT);
+    view->readonly = readonly;
+    view->itemsize = sizeof(MYFLT);
+#ifdef USE_DOUBLE
+    view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? "d" : NULL;
+#else
+    view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? "f" : NULL;
+#endif
+    view->ndim = (flags & PyBUF_ND) == PyBUF_ND ? ndim : 1;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    return 0;
+}
+
+void
+Stream_publishView(Stream *self)
+{
+    unsigned long count = self->viewCount + 1;
+
+    memcpy(self->views + (count & 1) * self->bufsize, self->data, self->bufsize * sizeof(MYFLT));
+    STREAM_STORE(self->viewCount, count);
+}
+
+/* The view is a (2, bufsize) array holding the last two completed blocks. The
+** stream object is kept alive, and its stream, as long as the view exists. */
+static int
+Stream_getbuffer(Stream *self, Py_buffer *view, int flags)
+{
+    MYFLT *views;
+
+    if (self->views == NULL) {
+        self->viewShape[0] = 2;
+        self->viewShape[1] = self->bufsize;
+        self->viewStrides[0] = self->bufsize * sizeof(MYFLT);
+        self->viewStrides[1] = sizeof(MYFLT);
+        views = (MYFLT *)calloc(2 * self->bufsize, sizeof(MYFLT));
+        if (views == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        if (self->data != NULL)
+            memcpy(views, self->data, self->bufsize * sizeof(MYFLT));
+        STREAM_STORE(self->views, views);
+    }
+    if (PyoBuffer_fillView(view, (PyObject *)self, self->views, 2, self->viewShape, self->viewStrides, 1, flags) < 0)
+        return -1;
+    Py_XINCREF(self->streamobject);
+    return 0;
+}
+
+static void
+Stream_releasebuffer(Stream *self, Py_buffer *view)
+{
+    Py_XDECREF(self->streamobject);
+}
+
+static PyBufferProcs Stream_as_buffer = {
+    0, /*bf_getreadbuffer*/
+    0, /*bf_getwritebuffer*/
+    0, /*bf_getsegcount*/
+    0, /*bf_getcharbuffer*/
+    (getbufferproc)Stream_getbuffer, /*bf_getbuffer*/
+    (releasebufferproc)Stream_releasebuffer, /*bf_releasebuffer*/
+};
+
+static PyObject *
+Stream_getBlockCount(Stream *self) {
+    return PyLong_FromUnsignedLong(STREAM_LOAD(self->viewCount));
+}
+
 static PyObject *
 Stream_getValue(Stream *self) {
     return Py_BuildValue(TYPE_F, self->data[self->bufsize-1]);
@@ -178,6 +432,7 @@ Stream_isOutputting(Stream *self)
 static PyMethodDef Stream_methods[] = {
 {"getValue", (PyCFunction)Stream_getValue, METH_NOARGS, "Returns the first sample of the current buffer."},
 {"getId", (PyCFunction)Stream_getId, METH_NOARGS, "Returns the ID of assigned to this stream."},
+{"getBlockCount", (PyCFunction)Stream_getBlockCount, METH_NOARGS, "Returns the number of blocks copied to the buffer views."},
 {"getStreamObject", (PyCFunction)Stream_getStreamObject, METH_NOARGS, "Returns the object associated with this stream."},
 {"isPlaying", (PyCFunction)Stream_isPlaying, METH_NOARGS, "Returns True if the stream is playing, otherwise, returns False."},
 {"isOutputting", (PyCFunction)Stream_isOutputting, METH_NOARGS, "Returns True if the stream outputs to dac, otherwise, returns False."},
@@ -204,8 +459,8 @@ PyTypeObject StreamType = {
     0, /*tp_str*/
     0, /*tp_getattro*/
     0, /*tp_setattro*/
-    0, /*tp_as_buffer*/
-    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, /*tp_flags*/
+    &Stream_as_buffer, /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_NEWBUFFER, /*tp_flags*/
 "\n\
 Audio stream objects. For internal use only. \n\n\
 A Stream object must never be instantiated by the user. \n\n\
@@ -261,6 +516,7 @@ TriggerStream_dealloc(TriggerStream* self)
 MYFLT *
 TriggerStream_getData(TriggerStream *self)
 {
+    PYO_GRAPH_READ(self->owner);
     return (MYFLT *)self->data;
 }
 
@@ -270,6 +526,13 @@ TriggerStream_setData(TriggerStream *self, MYFLT *data)
     self->data = data;
 }
 
+/* Borrowed, the owner keeps the TriggerStream alive, not the other way around. */
+void
+TriggerStream_setOwner(TriggerStream *self, PyObject *stream)
+{
+    self->owner = stream;
+}
+
 PyTypeObject TriggerStreamType = {
     PyObject_HEAD_INIT(NULL)
     0, /*ob_size*/
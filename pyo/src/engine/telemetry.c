@@ -0,0 +1,292 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include "telemetry.h"
+#include "streammodule.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <sys/time.h>
+#endif
+
+#if defined(__GNUC__)
+#define TELEMETRY_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define TELEMETRY_STORE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#define TELEMETRY_EXCHANGE(x, v) __atomic_exchange_n(&(x), (v), __ATOMIC_ACQ_REL)
+#define TELEMETRY_FENCE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#else
+#define TELEMETRY_LOAD(x) (__sync_synchronize(), (x))
+#define TELEMETRY_STORE(x, v) do { __sync_synchronize(); (x) = (v); __sync_synchronize(); } while (0)
+#define TELEMETRY_EXCHANGE(x, v) __sync_lock_test_and_set(&(x), (v))
+#define TELEMETRY_FENCE() __sync_synchronize()
+#endif
+
+#define TELEMETRY_MASK (PYO_TELEMETRY_SIZE - 1)
+#define TELEMETRY_FILE_CHUNK 256 /* records per read of the file writer */
+
+struct PyoTelemetry {
+    PyoTelemetryRecord records[PYO_TELEMETRY_SIZE];
+    unsigned long long head; /* written by the audio thread only */
+    double clockOffset; /* seconds, epoch time - monotonic time */
+    double lastStart;
+    /* Counters are written by the audio thread only, readers may see a
+    ** callback half counted, never a torn value. */
+    PyoTelemetryCounters counters;
+    int resetRequest;
+    unsigned int pendingXruns;
+    /* File writer. */
+    FILE *file;
+    pthread_t thread;
+    int fileRunning;
+    unsigned long fileLost;
+};
+
+static void
+PyoTelemetry_sleep(int usec)
+{
+#ifdef _WIN32
+    Sleep(usec / 1000 > 0 ? usec / 1000 : 1);
+#else
+    usleep(usec);
+#endif
+}
+
+/* Seconds since the epoch. */
+static double
+PyoTelemetry_wallTime(void)
+{
+#ifdef _WIN32
+    FILETIME ft;
+    unsigned long long t;
+    GetSystemTimeAsFileTime(&ft);
+    t = ((unsigned long long)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+    /* 100 ns intervals since 1601. */
+    return t * 1e-7 - 11644473600.0;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+#endif
+}
+
+static void
+PyoTelemetry_clearCounters(PyoTelemetry *self)
+{
+    memset(&self->counters, 0, sizeof(PyoTelemetryCounters));
+}
+
+PyoTelemetry *
+PyoTelemetry_new(void)
+{
+    PyoTelemetry *self = (PyoTelemetry *)calloc(1, sizeof(PyoTelemetry));
+
+    if (self == NULL)
+        return NULL;
+    self->clockOffset = PyoTelemetry_wallTime() - PyoProfile_getTime() * 1e-9;
+    PyoTelemetry_clearCounters(self);
+    return self;
+}
+
+void
+PyoTelemetry_free(PyoTelemetry *self)
+{
+    if (self == NULL)
+        return;
+    PyoTelemetry_closeFile(self);
+    free(self);
+}
+
+void
+PyoTelemetry_push(PyoTelemetry *self, double start, double end, double deadline, double gilwait)
+{
+    PyoTelemetryRecord *rec;
+    PyoTelemetryCounters *c = &self->counters;
+    unsigned long long head = self->head;
+
+    if (TELEMETRY_EXCHANGE(self->resetRequest, 0))
+        PyoTelemetry_clearCounters(self);
+
+    rec = &self->records[head & TELEMETRY_MASK];
+    rec->index = head;
+    rec->start = start * 1e-9 + self->clockOffset;
+    rec->duration = end - start;
+    rec->slack = deadline - rec->duration;
+    rec->interval = head > 0 ? start - self->lastStart : 0.0;
+    rec->gilwait = gilwait;
+    rec->flags = 0;
+    if (rec->slack < 0.0) {
+        rec->flags |= PYO_TELEMETRY_OVERRUN;
+        c->overruns++;
+    }
+    if (TELEMETRY_EXCHANGE(self->pendingXruns, 0) > 0) {
+        rec->flags |= PYO_TELEMETRY_XRUN;
+        c->xruns++;
+    }
+    if (head > 0 && rec->interval > deadline * 2.0) {
+        rec->flags |= PYO_TELEMETRY_LATE;
+        c->late++;
+    }
+    if (c->callbacks == 0 || rec->duration > c->maxDuration)
+        c->maxDuration = rec->duration;
+    if (c->callbacks == 0 || rec->slack < c->minSlack)
+        c->minSlack = rec->slack;
+    c->gilwait += gilwait;
+    c->callbacks++;
+    self->lastStart = start;
+    TELEMETRY_STORE(self->head, head + 1);
+}
+
+void
+PyoTelemetry_xrun(PyoTelemetry *self)
+{
+#if defined(__GNUC__)
+    __atomic_add_fetch(&self->pendingXruns, 1, __ATOMIC_ACQ_REL);
+#else
+    __sync_add_and_fetch(&self->pendingXruns, 1);
+#endif
+}
+
+int
+PyoTelemetry_read(PyoTelemetry *self, unsigned long long *cursor, PyoTelemetryRecord *out, int max)
+{
+    int i, n, skip;
+    unsigned long long first, head = TELEMETRY_LOAD(self->head);
+
+    first = *cursor;
+    if (head - first > PYO_TELEMETRY_SIZE || first > head)
+        first = head > PYO_TELEMETRY_SIZE ? head - PYO_TELEMETRY_SIZE : 0;
+    n = (int)(head - first) < max ? (int)(head - first) : max;
+    for (i=0; i<n; i++)
+        out[i] = self->records[(first + i) & TELEMETRY_MASK];
+
+    /* The slots reused since the copy started may hold a newer record. */
+    TELEMETRY_FENCE();
+    head = TELEMETRY_LOAD(self->head);
+    skip = 0;
+    if (head >= PYO_TELEMETRY_SIZE && head - PYO_TELEMETRY_SIZE + 1 > first) {
+        skip = (int)(head - PYO_TELEMETRY_SIZE + 1 - first);
+        if (skip > n)
+            skip = n;
+        memmove(out, out + skip, (n - skip) * sizeof(PyoTelemetryRecord));
+    }
+    *cursor = first + n;
+    return n - skip;
+}
+
+unsigned long long
+PyoTelemetry_getHead(PyoTelemetry *self)
+{
+    return TELEMETRY_LOAD(self->head);
+}
+
+void
+PyoTelemetry_getCounters(PyoTelemetry *self, PyoTelemetryCounters *counters)
+{
+    TELEMETRY_FENCE();
+    *counters = self->counters;
+}
+
+void
+PyoTelemetry_reset(PyoTelemetry *self)
+{
+    TELEMETRY_STORE(self->resetRequest, 1);
+}
+
+/** File writer. **/
+
+static void
+PyoTelemetry_writeRecords(PyoTelemetry *self, unsigned long long *cursor, PyoTelemetryRecord *buf)
+{
+    int i, n;
+    unsigned long long expected;
+
+    for (;;) {
+        expected = *cursor;
+        n = PyoTelemetry_read(self, cursor, buf, TELEMETRY_FILE_CHUNK);
+        if (n > 0 && buf[0].index > expected)
+            self->fileLost += (unsigned long)(buf[0].index - expected);
+        for (i=0; i<n; i++) {
+            fprintf(self->file, "%llu,%.6f,%.3f,%.3f,%.3f,%.3f,%u\n", buf[i].index, buf[i].start,
+                    buf[i].duration * 0.001, buf[i].slack * 0.001, buf[i].interval * 0.001,
+                    buf[i].gilwait * 0.001, buf[i].flags);
+        }
+        if (n < TELEMETRY_FILE_CHUNK)
+            break;
+    }
+    fflush(self->file);
+}
+
+static void *
+PyoTelemetry_fileThread(void *arg)
+{
+    PyoTelemetry *self = (PyoTelemetry *)arg;
+    PyoTelemetryRecord *buf = (PyoTelemetryRecord *)malloc(TELEMETRY_FILE_CHUNK * sizeof(PyoTelemetryRecord));
+    unsigned long long cursor = PyoTelemetry_getHead(self);
+
+    while (TELEMETRY_LOAD(self->fileRunning)) {
+        PyoTelemetry_writeRecords(self, &cursor, buf);
+        PyoTelemetry_sleep(50000);
+    }
+    PyoTelemetry_writeRecords(self, &cursor, buf);
+    free(buf);
+    return NULL;
+}
+
+int
+PyoTelemetry_openFile(PyoTelemetry *self, const char *path)
+{
+    PyoTelemetry_closeFile(self);
+    self->file = fopen(path, "w");
+    if (self->file == NULL)
+        return -1;
+    /* Times in microseconds. */
+    fprintf(self->file, "index,start,duration,slack,interval,gilwait,flags\n");
+    self->fileLost = 0;
+    self->fileRunning = 1;
+    if (pthread_create(&self->thread, NULL, PyoTelemetry_fileThread, self)) {
+        self->fileRunning = 0;
+        fclose(self->file);
+        self->file = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+void
+PyoTelemetry_closeFile(PyoTelemetry *self)
+{
+    if (self->file == NULL)
+        return;
+    TELEMETRY_STORE(self->fileRunning, 0);
+    pthread_join(self->thread, NULL);
+    fclose(self->file);
+    self->file = NULL;
+}
+
+unsigned long
+PyoTelemetry_getFileLost(PyoTelemetry *self)
+{
+    return self->fileLost;
+}
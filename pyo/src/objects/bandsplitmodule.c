@@ -142,6 +142,7 @@ BandSplitter_filters_a(BandSplitter *self) {
 MYFLT *
 BandSplitter_getSamplesBuffer(BandSplitter *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -793,6 +794,7 @@ FourBandMain_filters(FourBandMain *self) {
 MYFLT *
 FourBandMain_getSamplesBuffer(FourBandMain *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -903,6 +903,9 @@ typedef struct {
     double increment;
     MYFLT *targets;
     MYFLT *times;
+    MYFLT *newTargets; /* points converted by setList, taken at the next reinit */
+    MYFLT *newTimes;
+    int newListsize;
     int which;
     int flag;
     int newlist;
@@ -911,26 +914,41 @@ typedef struct {
     int okToPause;
 } Linseg;
 
+/* Called with the GIL, the audio thread only reads the converted arrays. */
 static void
 Linseg_convert_pointslist(Linseg *self) {
     int i;
     PyObject *tup;
 
-    self->listsize = PyList_Size(self->pointslist);
-    self->targets = (MYFLT *)realloc(self->targets, self->listsize * sizeof(MYFLT));
-    self->times = (MYFLT *)realloc(self->times, self->listsize * sizeof(MYFLT));
-    for (i=0; i<self->listsize; i++) {
+    self->newListsize = PyList_Size(self->pointslist);
+    self->newTargets = (MYFLT *)realloc(self->newTargets, self->newListsize * sizeof(MYFLT));
+    self->newTimes = (MYFLT *)realloc(self->newTimes, self->newListsize * sizeof(MYFLT));
+    for (i=0; i<self->newListsize; i++) {
         tup = PyList_GET_ITEM(self->pointslist, i);
-        self->times[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 0));
-        self->targets[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 1));
+        self->newTimes[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 0));
+        self->newTargets[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 1));
     }
 }
 
+/* Swaps in the points converted by setList, the old arrays are reused by the next conversion. */
+static void
+Linseg_take_pointslist(Linseg *self) {
+    MYFLT *tmp;
+
+    tmp = self->targets;
+    self->targets = self->newTargets;
+    self->newTargets = tmp;
+    tmp = self->times;
+    self->times = self->newTimes;
+    self->newTimes = tmp;
+    self->listsize = self->newListsize;
+    self->newlist = 0;
+}
+
 static void
 Linseg_reinit(Linseg *self) {
     if (self->newlist == 1) {
-        Linseg_convert_pointslist((Linseg *)self);
-        self->newlist = 0;
+        Linseg_take_pointslist(self);
     }
     self->currentTime = 0.0;
     self->currentValue = self->targets[0];
@@ -1051,6 +1069,8 @@ Linseg_dealloc(Linseg* self)
     pyo_DEALLOC
     free(self->targets);
     free(self->times);
+    free(self->newTargets);
+    free(self->newTimes);
     Linseg_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -1086,6 +1106,7 @@ Linseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Py_XDECREF(self->pointslist);
     self->pointslist = pointslist;
     Linseg_convert_pointslist((Linseg *)self);
+    Linseg_take_pointslist(self);
 
     if (multmp) {
         PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
@@ -1158,9 +1179,15 @@ Linseg_setList(Linseg *self, PyObject *value)
         return PyInt_FromLong(-1);
     }
 
+    /* Once the audio thread is out of its buffer, it can't be taking the
+    ** points converted by a previous call anymore. */
+    self->newlist = 0;
+    Server_waitForCallback((Server *)self->server);
+
     Py_INCREF(value);
     Py_DECREF(self->pointslist);
     self->pointslist = value;
+    Linseg_convert_pointslist(self);
 
     self->newlist = 1;
 
@@ -1300,6 +1327,9 @@ typedef struct {
     double steps;
     MYFLT *targets;
     MYFLT *times;
+    MYFLT *newTargets; /* points converted by setList, taken at the next reinit */
+    MYFLT *newTimes;
+    int newListsize;
     int which;
     int flag;
     int newlist;
@@ -1312,26 +1342,41 @@ typedef struct {
     int okToPause;
 } Expseg;
 
+/* Called with the GIL, the audio thread only reads the converted arrays. */
 static void
 Expseg_convert_pointslist(Expseg *self) {
     int i;
     PyObject *tup;
 
-    self->listsize = PyList_Size(self->pointslist);
-    self->targets = (MYFLT *)realloc(self->targets, self->listsize * sizeof(MYFLT));
-    self->times = (MYFLT *)realloc(self->times, self->listsize * sizeof(MYFLT));
-    for (i=0; i<self->listsize; i++) {
+    self->newListsize = PyList_Size(self->pointslist);
+    self->newTargets = (MYFLT *)realloc(self->newTargets, self->newListsize * sizeof(MYFLT));
+    self->newTimes = (MYFLT *)realloc(self->newTimes, self->newListsize * sizeof(MYFLT));
+    for (i=0; i<self->newListsize; i++) {
         tup = PyList_GET_ITEM(self->pointslist, i);
-        self->times[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 0));
-        self->targets[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 1));
+        self->newTimes[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 0));
+        self->newTargets[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 1));
     }
 }
 
+/* Swaps in the points converted by setList, the old arrays are reused by the next conversion. */
+static void
+Expseg_take_pointslist(Expseg *self) {
+    MYFLT *tmp;
+
+    tmp = self->targets;
+    self->targets = self->newTargets;
+    self->newTargets = tmp;
+    tmp = self->times;
+    self->times = self->newTimes;
+    self->newTimes = tmp;
+    self->listsize = self->newListsize;
+    self->newlist = 0;
+}
+
 static void
 Expseg_reinit(Expseg *self) {
     if (self->newlist == 1) {
-        Expseg_convert_pointslist((Expseg *)self);
-        self->newlist = 0;
+        Expseg_take_pointslist(self);
     }
     self->currentTime = 0.0;
     self->currentValue = self->targets[0];
@@ -1467,6 +1512,8 @@ Expseg_dealloc(Expseg* self)
     pyo_DEALLOC
     free(self->targets);
     free(self->times);
+    free(self->newTargets);
+    free(self->newTimes);
     Expseg_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -1504,6 +1551,7 @@ Expseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Py_XDECREF(self->pointslist);
     self->pointslist = pointslist;
     Expseg_convert_pointslist((Expseg *)self);
+    Expseg_take_pointslist(self);
 
     if (multmp) {
         PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
@@ -1576,9 +1624,15 @@ Expseg_setList(Expseg *self, PyObject *value)
         return PyInt_FromLong(-1);
     }
 
+    /* Once the audio thread is out of its buffer, it can't be taking the
+    ** points converted by a previous call anymore. */
+    self->newlist = 0;
+    Server_waitForCallback((Server *)self->server);
+
     Py_INCREF(value);
     Py_DECREF(self->pointslist);
     self->pointslist = value;
+    Expseg_convert_pointslist(self);
 
     self->newlist = 1;
 
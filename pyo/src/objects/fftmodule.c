@@ -129,6 +129,7 @@ FFTMain_filters(FFTMain *self) {
 MYFLT *
 FFTMain_getSamplesBuffer(FFTMain *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -1582,6 +1583,7 @@ FrameDeltaMain_generate(FrameDeltaMain *self) {
 MYFLT *
 FrameDeltaMain_getSamplesBuffer(FrameDeltaMain *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -1639,6 +1641,7 @@ FrameDeltaMain_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, FrameDeltaMain_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
     self->mode_func_ptr = FrameDeltaMain_setProcMode;
 
     static char *kwlist[] = {"input", "frameSize", "overlaps", NULL};
@@ -1692,6 +1695,7 @@ FrameDeltaMain_setInput(FrameDeltaMain *self, PyObject *arg)
     Py_INCREF(tmp);
     Py_XDECREF(self->input);
     self->input = tmp;
+    PyoGraph_resetAccesses(self->stream);
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -2091,6 +2095,7 @@ FrameAccumMain_generate(FrameAccumMain *self) {
 MYFLT *
 FrameAccumMain_getSamplesBuffer(FrameAccumMain *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -2148,6 +2153,7 @@ FrameAccumMain_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, FrameAccumMain_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
     self->mode_func_ptr = FrameAccumMain_setProcMode;
 
     static char *kwlist[] = {"input", "framesize", "overlaps", NULL};
@@ -2201,6 +2207,7 @@ FrameAccumMain_setInput(FrameAccumMain *self, PyObject *arg)
     Py_INCREF(tmp);
     Py_XDECREF(self->input);
     self->input = tmp;
+    PyoGraph_resetAccesses(self->stream);
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -2646,6 +2653,7 @@ VectralMain_generate(VectralMain *self) {
 MYFLT *
 VectralMain_getSamplesBuffer(VectralMain *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -2723,6 +2731,7 @@ VectralMain_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, VectralMain_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
     self->mode_func_ptr = VectralMain_setProcMode;
 
     static char *kwlist[] = {"input", "frameSize", "overlaps", "up", "down", "damp", NULL};
@@ -2788,6 +2797,7 @@ VectralMain_setInput(VectralMain *self, PyObject *arg)
     Py_INCREF(tmp);
     Py_XDECREF(self->input);
     self->input = tmp;
+    PyoGraph_resetAccesses(self->stream);
 
     Py_INCREF(Py_None);
     return Py_None;
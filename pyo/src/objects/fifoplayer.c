@@ -6,14 +6,11 @@
 #include "streammodule.h"
 #include "servermodule.h"
 #include "dummymodule.h"
-
-#ifdef DEBUG
-    #include <time.h>
-    unsigned int GetTimeStamp() {
-        struct timeval tv;
-        gettimeofday(&tv, NULL);
-        return tv.tv_sec * (unsigned int)1000000 + tv.tv_usec;
-    }
+#include "spscring.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
 #endif
 
 /*****************************************************
@@ -23,423 +20,747 @@ for the proper operation of the object.
 typedef struct {
     /* Mandatory macro intializing common properties of PyoObjects */
     pyo_audio_HEAD
-    /* modebuffer keeps trace of the type of attributes that can
-    be float or PyoObject. Processing function is selected to
-    optimize operations. Need at least 2 slots for mul & add. */
-    int modebuffer[3];
-    /* Object's attributes. Attribute that can be float or PyoObject
-    must be defined as PyObject and must be coupled with a Stream
-    object (to hold the vector of samples of the audio signal). */
-    // we have none
-
-    PyObject *_queue; // a thread safe queue object (from Python's std-lib)
-    Py_buffer current_buffer; // The current buffer (already taken out of the queue)
-    int current_buffer_idx; // Track position in current_buffer
-    int data_idx; // Track position in data
-    MYFLT last_sample; // Value of the last sample to repeat it, if buffer runs empty
-    MYFLT *backup_data; // When changing data pointer, back it up to here
-    PyObject *python_str_get; // "get" string as Python object (we need it often)
-    PyObject *python_str_put;
-    int always_memcpy;
+    /* FIFOPlayer is the main object, it reads the ring and splits the
+    frames into one signal per channel. The FIFOPlay objects below, one
+    per channel, copy their signal to their own stream and apply mul and
+    add, as SfPlayer and SfPlay do. */
+    int chnls;
+    SPSCRing *ring; // lock-free ring of interleaved frames shared by the producer (put) and the audio thread
+    MYFLT *readBuffer; // interleaved frames read from the ring, bufsize * chnls
+    MYFLT *samplesBuffer; // one signal per channel, bufsize * chnls
+    MYFLT *last_samples; // Value of the last sample of each channel to repeat it, if buffer runs empty
+    int writing; // A put() is in progress, only one producer is allowed
+    /* Sample-rate conversion, done by the producer before writing to the ring. */
+    double srcRate; // rate of the last samples put, 0 if they were at the server rate
+    MYFLT *rsTable; // polyphase filter, (FIFO_RS_PHASES + 1) rows of FIFO_RS_TAPS coefficients
+    MYFLT *rsInput; // the last FIFO_RS_TAPS input frames followed by the new ones, interleaved
+    MYFLT *rsOutput; // converted frames, interleaved
+    int rsInputSize; // in frames
+    int rsOutputSize; // in frames
+    double rsPos; // position of the next output frame in rsInput, in input frames
     /* Floating-point values must always use the MYFLT macro which
     handles float vs double builds. */
 } FIFOPlayer;
 
 /**********************************************************************
-Processing functions. The last letter(s) of the name indicates the type
-of object assigned to PyObject attribute, in this case "db" attribute.
-"i" is for floating-point value and "a" is for audio signal.
+Interleaving kernels. The number of channels is given as a constant to
+the inlined body for the common layouts, so the compiler unrolls the
+channel loop and vectorizes the strided accesses with shuffles (SSE,
+AVX, NEON), the other layouts use the generic loop.
 **********************************************************************/
+static inline void
+fifoplayer_deinterleave_body(const MYFLT * restrict in, MYFLT * restrict out, int chnls, int frames, int stride)
+{
+    int i, j;
+    for (i=0; i<frames; i++) {
+        for (j=0; j<chnls; j++)
+            out[j * stride + i] = in[i * chnls + j];
+    }
+}
+
+static inline void
+fifoplayer_interleave_body(const MYFLT * restrict in, MYFLT * restrict out, int chnls, int frames)
+{
+    int i, j;
+    for (i=0; i<frames; i++) {
+        for (j=0; j<chnls; j++)
+            out[i * chnls + j] = in[j * frames + i];
+    }
+}
+
+/* Splits frames interleaved frames into chnls signals, stride samples apart. */
 static void
-FIFOPlayer_process_i(FIFOPlayer *self) {
-    int total;              // number of samples in the self->current_buffer
-    int available;          // number of samples not yet processed
-    int needed = self->bufsize - self->data_idx; // number of items needed
-    #ifdef DEBUG
-        unsigned int t_start = GetTimeStamp(), t_delta;
-    #endif
-
-    // Do we have a current_buffer?
-    if (self->current_buffer.obj != NULL) {
-        assert(self->current_buffer.itemsize == sizeof(MYFLT));
-        total = (int)self->current_buffer.len / (int)self->current_buffer.itemsize;
-        available = total - self->current_buffer_idx;
-
-        #ifdef DEBUG
-            printf("--> Current_buffer: total=%i available=%i needed=%i.\n", total, available, needed);
-        #endif
-
-        // First, we let self->stream->data point to the chunk of mem that Pyo
-        // allocated for us in the first place.
-        if (self->backup_data != NULL) {
-            self->stream->data = self->backup_data;
-            self->backup_data = NULL;
+fifoplayer_deinterleave(const MYFLT *in, MYFLT *out, int chnls, int frames, int stride)
+{
+    switch (chnls) {
+        case 2: fifoplayer_deinterleave_body(in, out, 2, frames, stride); break;
+        case 4: fifoplayer_deinterleave_body(in, out, 4, frames, stride); break;
+        case 8: fifoplayer_deinterleave_body(in, out, 8, frames, stride); break;
+        default: fifoplayer_deinterleave_body(in, out, chnls, frames, stride); break;
+    }
+}
+
+/* Merges chnls consecutive signals of frames samples into interleaved frames. */
+static void
+fifoplayer_interleave(const MYFLT *in, MYFLT *out, int chnls, int frames)
+{
+    switch (chnls) {
+        case 2: fifoplayer_interleave_body(in, out, 2, frames); break;
+        case 4: fifoplayer_interleave_body(in, out, 4, frames); break;
+        case 8: fifoplayer_interleave_body(in, out, 8, frames); break;
+        default: fifoplayer_interleave_body(in, out, chnls, frames); break;
+    }
+}
+
+/**********************************************************************
+Sample-rate conversion. The filter is a windowed-sinc lowpass designed
+with gen_lp_impulse (the upsamp and downsamp filter), oversampled by
+FIFO_RS_PHASES and split in phases of FIFO_RS_TAPS coefficients. An
+output frame at a fractional input position interpolates linearly
+between the two nearest phases. The cutoff is FIFO_RS_CUTOFF times the
+lowest of the two nyquist frequencies. The conversion adds a latency of
+FIFO_RS_TAPS / 2 input frames.
+**********************************************************************/
+#define FIFO_RS_TAPS 64
+#define FIFO_RS_PHASES 128
+#define FIFO_RS_CUTOFF 0.9
+
+static void
+fifoplayer_resampler_design(FIFOPlayer *self)
+{
+    int i, j, center = FIFO_RS_TAPS * FIFO_RS_PHASES / 2;
+    MYFLT cutoff = FIFO_RS_CUTOFF;
+    MYFLT *proto;
+
+    if (self->srcRate > self->sr)
+        cutoff *= self->sr / self->srcRate;
+
+    // The extra point is the zero reached by the last phase.
+    proto = (MYFLT *)calloc(FIFO_RS_TAPS * FIFO_RS_PHASES + 1, sizeof(MYFLT));
+    gen_lp_impulse(proto, FIFO_RS_TAPS * FIFO_RS_PHASES, PI * cutoff / FIFO_RS_PHASES);
+
+    if (self->rsTable == NULL)
+        self->rsTable = (MYFLT *)malloc((FIFO_RS_PHASES + 1) * FIFO_RS_TAPS * sizeof(MYFLT));
+    // The prototype has a unity gain, each phase gets 1 / FIFO_RS_PHASES of it.
+    for (i=0; i<=FIFO_RS_PHASES; i++) {
+        for (j=0; j<FIFO_RS_TAPS; j++)
+            self->rsTable[i * FIFO_RS_TAPS + j] = proto[center + i - (j - FIFO_RS_TAPS / 2 + 1) * FIFO_RS_PHASES] * FIFO_RS_PHASES;
+    }
+    free(proto);
+}
+
+/* Converts frames interleaved frames at rate srcRate to the server rate.
+** Returns the number of frames in self->rsOutput. Called by the producer,
+** without the GIL. */
+static int
+FIFOPlayer_resample(FIFOPlayer *self, MYFLT *samples, int frames, double srcRate)
+{
+    int j, k, base, phase, count = 0, size, chnls = self->chnls;
+    MYFLT frac, val;
+    MYFLT *row, *in, coeffs[FIFO_RS_TAPS];
+    double step = srcRate / self->sr;
+
+    if (srcRate != self->srcRate) {
+        // Starting from silence, the history is kept if only the rate changes.
+        if (self->srcRate == 0.0 || self->rsInput == NULL) {
+            self->rsInputSize = 0;
+            self->rsPos = FIFO_RS_TAPS / 2 - 1;
         }
+        self->srcRate = srcRate;
+        fifoplayer_resampler_design(self);
+    }
+
+    size = FIFO_RS_TAPS + frames;
+    if (size > self->rsInputSize) {
+        self->rsInput = (MYFLT *)realloc(self->rsInput, size * chnls * sizeof(MYFLT));
+        if (self->rsInputSize == 0)
+            memset(self->rsInput, 0, FIFO_RS_TAPS * chnls * sizeof(MYFLT));
+        self->rsInputSize = size;
+    }
+    memcpy(self->rsInput + FIFO_RS_TAPS * chnls, samples, frames * chnls * sizeof(MYFLT));
 
-        if (available == 0) {
-            // Clean-up if we are finished with the self->current_buffer
-
-            #ifdef DEBUG
-                unsigned int t_start_clean = GetTimeStamp(), t_delta_clean;
-            #endif
-
-            // PyBuffer_Release will also DECREF the object we got from the
-            // self->_queue. We didn't store a reference to that object, but
-            // the Py_Buffer->obj stores a reference and calling
-            // PyBuffer_Release will Py_DECREF it.
-            // Doc: http://docs.python.org/3.3/c-api/buffer.html
-            PyBuffer_Release(&(self->current_buffer));
-            self->current_buffer_idx = 0;
-            total = 0;
-            available = 0;
-            // Note, don't (re)set self->data_idx here!! It's value is needed.
-
-            #ifdef DEBUG
-                t_delta_clean = GetTimeStamp() - t_start_clean;
-                printf( "   * Clean up: PyBuffer_Release(). Now total=%i available=%i needed=%i (%u µs)\n",
-                        total, available, needed, t_delta_clean);
-            #endif
-
-        } else if (self->always_memcpy == 0 && available >= self->bufsize && needed == self->bufsize) {
-            // self->data buffer is empty and we have enough samples available
-            // in the current_buffer so we can basically just let the
-            // self->data pointer point into the right position in the
-            // current_buffer.
-
-            #ifdef DEBUG
-                unsigned int t_start_pointer = GetTimeStamp(), t_delta_pointer;
-            #endif
-
-            // But first, we store the current self->data into
-            // self->backup_data for later reuse.
-            if (self->backup_data == NULL) {
-                self->backup_data = self->data;
-            }
-            // Copy-free pointer reassignment. You may consider this a hack.
-            // For some reason self->data does not work, because the Server uses
-            // self->stream->data. So we have to change the self->stream->data pointer.
-            self->stream->data = (MYFLT*)(self->current_buffer.buf) + self->current_buffer_idx;
-
-            // Update some counters and last_sample
-            self->current_buffer_idx += self->bufsize;
-            available -= self->bufsize;
-            needed -= self->bufsize;
-            self->last_sample = self->data[self->bufsize-1];
-
-            #ifdef DEBUG
-                t_delta_pointer = GetTimeStamp() - t_start_pointer;
-                printf( "   * Let self->data point to <%u>: total=%i available=%i needed=%i (%u µs)\n",
-                        (unsigned int)self->stream->data, total, available, needed, t_delta_pointer);
-            #endif
-
-        } else {
-            // Fall back to memcpy!
-
-            #ifdef DEBUG
-                unsigned int t_start_memcpy = GetTimeStamp(), t_delta_memcpy;
-            #endif
-
-            // Copy what is available but not more than what is needed.
-            // memcpy operates on bytes!
-            int n = (available < needed) ? available : needed;
-            memcpy( self->data + self->data_idx, /* dest (pointer has right type) */
-                    (MYFLT*)(self->current_buffer.buf) + self->current_buffer_idx, /* source */
-                    n * sizeof(MYFLT));
-
-            self->current_buffer_idx += n;
-            self->data_idx += n;
-            available -= n;
-            needed -= n;
-            self->last_sample = self->data[self->data_idx-1];
-
-            #ifdef DEBUG
-                t_delta_memcpy = GetTimeStamp() - t_start_memcpy;
-                printf( "   * memcpy (%lu bytes (%i MYFLTs) to data_idx=%i): total=%i available=%i needed=%i (%u µs)\n",
-                        n * sizeof(MYFLT), n, self->data_idx, total, available, needed, t_delta_memcpy);
-            #endif
+    size = (int)(frames / step) + 2;
+    if (size > self->rsOutputSize) {
+        self->rsOutput = (MYFLT *)realloc(self->rsOutput, size * chnls * sizeof(MYFLT));
+        self->rsOutputSize = size;
+    }
+
+    while (((int)self->rsPos + FIFO_RS_TAPS / 2) < (FIFO_RS_TAPS + frames) && count < self->rsOutputSize) {
+        base = (int)self->rsPos;
+        frac = (MYFLT)((self->rsPos - base) * FIFO_RS_PHASES);
+        phase = (int)frac;
+        frac -= phase;
+        row = self->rsTable + phase * FIFO_RS_TAPS;
+        for (j=0; j<FIFO_RS_TAPS; j++)
+            coeffs[j] = row[j] + (row[j + FIFO_RS_TAPS] - row[j]) * frac;
+        in = self->rsInput + (base - FIFO_RS_TAPS / 2 + 1) * chnls;
+        for (k=0; k<chnls; k++) {
+            val = 0.0;
+            for (j=0; j<FIFO_RS_TAPS; j++)
+                val += in[j * chnls + k] * coeffs[j];
+            self->rsOutput[count * chnls + k] = val;
         }
+        count++;
+        self->rsPos += step;
+    }
 
-        #ifdef DEBUG
-            // available should not be negative!
-            assert(available >= 0);
-            // if there is more available, it should have been used up and needed == 0 !
-            if (available > 0) { assert(needed == 0); }
-        #endif
-
-    } // end: if (self->current_buffer.obj != NULL)
-
-
-    if (needed > 0 && self->current_buffer.obj == NULL) {
-        // We have to get the next buffer from the queue (in non-blocking style)
-        // because more samples are needed to be put into self->data ...
-
-        #ifdef DEBUG
-            unsigned int t_start_get = GetTimeStamp(), t_delta_get;
-        #endif
-
-        PyObject *ret = PyObject_CallMethodObjArgs( self->_queue,
-                                                    self->python_str_get,
-                                                    Py_False, /*non-blocking*/
-                                                    NULL ); // NULL as last arg to flag the end
-        if (ret) {
-            // Python Buffer structure, so we don't need numpy's include files
-            if (PyObject_GetBuffer(ret, &(self->current_buffer), PyBUF_CONTIG_RO ) != 0) {
-                printf("ERROR: FIFOPlayer: Could not get C-continuous buffer from _queue.\n");
-                PyErr_Print();
-                exit(-3);
-            }
-
-            if (PyErr_Occurred()) {
-                // Exporter may raise an err if it does not support PyBUF_CONTIG_RO
-                printf("ERROR: FIFOPlayer exception during PyObject_GetBuffer...\n");
-                PyErr_Print();
-                exit(-1);
-            }
-
-            // The buffer's ndim (number of dimensions) must be equal to one
-            if (self->current_buffer.ndim != 1) {
-                printf("ERROR: FIFOPlayer: Given buffer has to be one-dimensional for audio!\n");
-                exit(-4);
-            }
-
-            // Alright, we got a new self->current_buffer, so in a few lines
-            // down we recursively call FIFOPlayer_process_i and we don't need
-            // to update any of the vars, as they will be updated right after
-            // the beginning of FIFOPlayer_process_i!
+    // Keeps the last FIFO_RS_TAPS input frames for the next call.
+    memmove(self->rsInput, self->rsInput + frames * chnls, FIFO_RS_TAPS * chnls * sizeof(MYFLT));
+    self->rsPos -= frames;
 
+    return count;
+}
+
+/* Returns the frames converted to the server rate, if srcRate is given and
+** is not the server rate, or samples, and updates *frames. */
+static MYFLT *
+FIFOPlayer_toServerRate(FIFOPlayer *self, MYFLT *samples, int *frames, double srcRate)
+{
+    if (srcRate <= 0.0 || srcRate == self->sr) {
+        self->srcRate = 0.0;
+        return samples;
+    }
+    *frames = FIFOPlayer_resample(self, samples, *frames, srcRate);
+    return self->rsOutput;
+}
+
+/**********************************************************************
+Processing function. Never calls into Python, never blocks: takes the
+frames that are in the ring, every channel gets the same number of
+samples so they stay aligned.
+**********************************************************************/
+static void
+FIFOPlayer_process_i(FIFOPlayer *self) {
+    int i, j, n;
+    MYFLT *out;
+
+    if (self->chnls == 1)
+        n = SPSCRing_read(self->ring, self->samplesBuffer, self->bufsize);
+    else {
+        n = SPSCRing_read(self->ring, self->readBuffer, self->bufsize * self->chnls) / self->chnls;
+        fifoplayer_deinterleave(self->readBuffer, self->samplesBuffer, self->chnls, n, self->bufsize);
+    }
+
+    // The ring ran empty, so we resort to play the last sample (constant output; no sound!)
+    for (j=0; j<self->chnls; j++) {
+        out = self->samplesBuffer + j * self->bufsize;
+        if (n > 0)
+            self->last_samples[j] = out[n-1];
+        for (i=n; i<self->bufsize; i++) {
+            out[i] = self->last_samples[j];
         }
+    }
+}
+
+static void
+FIFOPlayer_setProcMode(FIFOPlayer *self)
+{
+    self->proc_func_ptr = FIFOPlayer_process_i;
+}
+
+static void
+FIFOPlayer_compute_next_data_frame(FIFOPlayer *self)
+{
+    (*self->proc_func_ptr)(self);
+}
+
+static int
+FIFOPlayer_traverse(FIFOPlayer *self, visitproc visit, void *arg)
+{
+    pyo_VISIT
+    return 0;
+}
+
+static int
+FIFOPlayer_clear(FIFOPlayer *self)
+{
+    pyo_CLEAR
+    return 0;
+}
 
-        #ifdef DEBUG
-            t_delta_get = GetTimeStamp() - t_start_get;
-            if (self->current_buffer.obj != NULL) {
-                printf( "   * Getting new Py_Buffer from queue: itemsize=%u, len=%u, ndim=%u (%u µs)\n",
-                        (unsigned int)self->current_buffer.itemsize,
-                        (unsigned int)(self->current_buffer.len/self->current_buffer.itemsize),
-                        (unsigned int)self->current_buffer.ndim,
-                        t_delta_get );
-            }
-        #endif
-    } // enf of getting next buffer from queue
+static void
+FIFOPlayer_dealloc(FIFOPlayer* self)
+{
+    pyo_DEALLOC
+    FIFOPlayer_clear(self);
+    SPSCRing_free(self->ring);
+    free(self->readBuffer);
+    free(self->samplesBuffer);
+    free(self->last_samples);
+    free(self->rsTable);
+    free(self->rsInput);
+    free(self->rsOutput);
+    self->ob_type->tp_free((PyObject*)self);
+}
 
+static PyObject *
+FIFOPlayer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i, size = 32768, chnls = 1;
+    FIFOPlayer *self;
+    self = (FIFOPlayer *)type->tp_alloc(type, 0);
 
-    if (needed > 0) {
-        if (self->current_buffer.obj == NULL) {
-            // The queue was empty, so we resort to play the last sample (constant output; no sound!)
+    INIT_OBJECT_COMMON
+    Stream_setFunctionPtr(self->stream, FIFOPlayer_compute_next_data_frame);
+    self->mode_func_ptr = FIFOPlayer_setProcMode;
 
-            #ifdef DEBUG
-                unsigned int t_start_const = GetTimeStamp(), t_delta_const;
-            #endif
+    static char *kwlist[] = {"size", "chnls", NULL};
 
-            int i;
-            for (i = self->data_idx; i < self->bufsize; i++) {
-                self->data[i] = self->last_sample;
-            }
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "|ii", kwlist, &size, &chnls))
+        Py_RETURN_NONE;
 
-            #ifdef DEBUG
-                t_delta_const = GetTimeStamp() - t_start_const;
-                if (self->data_idx > 0 ) {
-                    // Don't print this on empty (idle) loop
-                    printf("   * Buffer empty. Const filling with last sample=%f (%u µs)\n", (double)self->last_sample, t_delta_const);
-                }
-            #endif
+    if (chnls < 1)
+        chnls = 1;
+    if (size < self->bufsize)
+        size = self->bufsize;
+    self->chnls = chnls;
+    // size is in frames, the ring holds the interleaved samples.
+    self->ring = SPSCRing_new(size * chnls);
+    self->readBuffer = (MYFLT *)calloc(self->bufsize * chnls, sizeof(MYFLT));
+    self->samplesBuffer = (MYFLT *)calloc(self->bufsize * chnls, sizeof(MYFLT));
+    self->last_samples = (MYFLT *)calloc(chnls, sizeof(MYFLT));
+    self->writing = 0;
+    self->srcRate = 0.0;
+    self->rsTable = self->rsInput = self->rsOutput = NULL;
+    self->rsInputSize = self->rsOutputSize = 0;
 
-            self->data_idx = 0;
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+
+    (*self->mode_func_ptr)(self);
+
+    return (PyObject *)self;
+}
+
+MYFLT *
+FIFOPlayer_getSamplesBuffer(FIFOPlayer *self)
+{
+    PYO_GRAPH_READ(self->stream);
+    return (MYFLT *)self->samplesBuffer;
+}
 
-        } else {
-            // recursive call to FIFOPlayer_process_i
+static PyObject * FIFOPlayer_getServer(FIFOPlayer *self) { GET_SERVER };
+static PyObject * FIFOPlayer_getStream(FIFOPlayer *self) { GET_STREAM };
 
-            #ifdef DEBUG
-                printf("--> Recursive call to FIFOPlayer_process_i to fill %i remaining samples...\n", needed);
-            #endif
+static PyObject * FIFOPlayer_play(FIFOPlayer *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * FIFOPlayer_out(FIFOPlayer *self, PyObject *args, PyObject *kwds) { OUT };
+static PyObject * FIFOPlayer_stop(FIFOPlayer *self) { STOP };
+
+/**********************************************************************
+FIFOPlayer_getSamples gets a C-contiguous float32 or float64 buffer from
+arg and returns a pointer to its samples as interleaved MYFLT frames, or
+NULL with an exception set. The buffer holds interleaved frames in C
+order (a 1-D or a (frames, chnls) array), or, if planar is true, one row
+per channel (a (chnls, frames) array). The layout is never guessed from
+the shape, a square array would be ambiguous. The samples are converted
+in a malloc'ed array (returned in *converted, to be freed) if the element
+type does not match MYFLT or if the buffer is planar. The number of
+frames is returned in *frames. The view must be released by the caller
+on success.
+**********************************************************************/
+static MYFLT *
+FIFOPlayer_getSamples(FIFOPlayer *self, PyObject *arg, Py_buffer *view, MYFLT **converted, int *frames, int planar,
+                      const char *name)
+{
+    int i, total;
+    char fmt;
+    MYFLT *samples, *tmp;
 
-            // self->data_idx will be used to determine where to continue.
-            FIFOPlayer_process_i(self);
+    *converted = NULL;
 
+    // Does the given arg support the buffer protocol at all?
+    if (!PyObject_CheckBuffer(arg)) {
+        PyErr_Format(PyExc_TypeError, "FIFOPlayer.%s: Object with buffer protocol expected (e.g. numpy.array, ...)", name);
+        return NULL;
+    }
+    if (PyObject_GetBuffer(arg, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+        return NULL;
+
+    // float32 and float64 are accepted, the one not matching MYFLT is converted.
+    fmt = view->format == NULL ? 'B' : view->format[strlen(view->format)-1];
+    if ((fmt != 'f' || view->itemsize != sizeof(float)) && (fmt != 'd' || view->itemsize != sizeof(double))) {
+        PyErr_Format(PyExc_TypeError, "FIFOPlayer.%s: float32 or float64 elements expected.", name);
+        PyBuffer_Release(view);
+        return NULL;
+    }
+
+    total = (int)(view->len / view->itemsize);
+    if (self->chnls == 1)
+        planar = 0;
+    if (planar && (view->ndim != 2 || view->shape[0] != self->chnls)) {
+        PyErr_Format(PyExc_ValueError, "FIFOPlayer.%s: planar=True expects a (%d, frames) array.", name, self->chnls);
+        PyBuffer_Release(view);
+        return NULL;
+    }
+    if (!planar && ((view->ndim == 2 && view->shape[1] != self->chnls) || (total % self->chnls) != 0)) {
+        PyErr_Format(PyExc_ValueError, "FIFOPlayer.%s: whole frames of %d interleaved channels expected, "
+                     "use planar=True for a (%d, frames) array.", name, self->chnls, self->chnls);
+        PyBuffer_Release(view);
+        return NULL;
+    }
+    *frames = total / self->chnls;
+
+    if (view->itemsize == sizeof(MYFLT))
+        samples = (MYFLT *)view->buf;
+    else {
+        samples = *converted = (MYFLT *)malloc(total * sizeof(MYFLT));
+        for (i=0; i<total; i++) {
+            if (fmt == 'f')
+                samples[i] = (MYFLT)((float *)view->buf)[i];
+            else
+                samples[i] = (MYFLT)((double *)view->buf)[i];
         }
-    } else {
-        // The self->data buffer has been filled. Nothing more needed.
-
-        #ifdef DEBUG
-            t_delta = GetTimeStamp() - t_start;
-            if (self->data_idx > 0) {
-                // Don't print this on empty (idle) loop, so we check data_idx
-                printf("==> Finished. The self->data buffer has been filled (%u µs).\n\n", t_delta);
-            }
-            // should not be negative!
-            assert(needed >= 0);
-        #endif
-
-        self->data_idx = 0; // reset for next call
     }
+
+    if (planar) {
+        tmp = (MYFLT *)malloc(total * sizeof(MYFLT));
+        fifoplayer_interleave(samples, tmp, self->chnls, *frames);
+        if (*converted != NULL)
+            free(*converted);
+        samples = *converted = tmp;
+    }
+    return samples;
 }
 
 /**********************************************************************
-End of processing function definitions.
+FIFOPlayer_writeRing copies frames interleaved frames into the ring,
+waiting while the ring is full if block is true, until *waited reaches
+timeout (in seconds, negative means as long as the server runs, nothing
+would make room otherwise). Only whole frames are written, so the
+channels stay aligned. Must be called without the GIL.
+Returns the number of frames written.
 **********************************************************************/
+static int
+FIFOPlayer_writeRing(FIFOPlayer *self, MYFLT *samples, int frames, int block, double timeout, double *waited)
+{
+    int n, written = 0, total = frames * self->chnls;
+
+    for (;;) {
+        n = SPSCRing_writable(self->ring);
+        n -= n % self->chnls;
+        if (n > total - written)
+            n = total - written;
+        written += SPSCRing_write(self->ring, samples + written, n);
+        if (written == total || !block || (timeout >= 0.0 && *waited >= timeout))
+            break;
+        if (timeout < 0.0 && !((Server *)self->server)->server_started)
+            break;
+        // The ring is full, give the audio thread some time to consume.
+#ifdef _WIN32
+        Sleep(1);
+#else
+        usleep(1000);
+#endif
+        *waited += 0.001;
+    }
+    return written / self->chnls;
+}
 
 /**********************************************************************
-Post-Processing functions. These are functions where are applied "mul"
-and "add" attributes. Macros are defined in pyomodule.h. Just keep them
-and change the object's name.
+put copies the samples into the ring. If the ring is full, it waits
+(without holding the GIL) for the audio thread to make room, unless
+block is False or the timeout (in seconds, negative means as long as
+the server runs) expires. planar tells if x holds one row per channel,
+see getSamples. If sr, the rate of the samples, is given and differs
+from the server rate, the samples are converted first. Returns the
+number of frames actually written, at the server rate. The converted frames that
+do not fit in the ring are lost.
 **********************************************************************/
-static void FIFOPlayer_postprocessing_ii(FIFOPlayer *self) { POST_PROCESSING_II };
-static void FIFOPlayer_postprocessing_ai(FIFOPlayer *self) { POST_PROCESSING_AI };
-static void FIFOPlayer_postprocessing_ia(FIFOPlayer *self) { POST_PROCESSING_IA };
-static void FIFOPlayer_postprocessing_aa(FIFOPlayer *self) { POST_PROCESSING_AA };
-static void FIFOPlayer_postprocessing_ireva(FIFOPlayer *self) { POST_PROCESSING_IREVA };
-static void FIFOPlayer_postprocessing_areva(FIFOPlayer *self) { POST_PROCESSING_AREVA };
-static void FIFOPlayer_postprocessing_revai(FIFOPlayer *self) { POST_PROCESSING_REVAI };
-static void FIFOPlayer_postprocessing_revaa(FIFOPlayer *self) { POST_PROCESSING_REVAA };
-static void FIFOPlayer_postprocessing_revareva(FIFOPlayer *self) { POST_PROCESSING_REVAREVA };
+static PyObject *
+FIFOPlayer_put(FIFOPlayer *self, PyObject *args, PyObject *kwds)
+{
+    int total, written = 0, block = 1, planar = 0;
+    double timeout = -1.0, waited = 0.0, sr = 0.0;
+    MYFLT *samples, *converted = NULL;
+    PyObject *arg;
+    Py_buffer view;
+
+    static char *kwlist[] = {"x", "block", "timeout", "sr", "planar", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|iddi", kwlist, &arg, &block, &timeout, &sr, &planar))
+        return NULL;
+
+    if (self->writing) {
+        PyErr_SetString(PyExc_RuntimeError, "FIFOPlayer.put: only one thread can put samples at a time.");
+        return NULL;
+    }
+    samples = FIFOPlayer_getSamples(self, arg, &view, &converted, &total, planar, "put");
+    if (samples == NULL)
+        return NULL;
+
+    self->writing = 1;
+    Py_BEGIN_ALLOW_THREADS
+    samples = FIFOPlayer_toServerRate(self, samples, &total, sr);
+    written = FIFOPlayer_writeRing(self, samples, total, block, timeout, &waited);
+    Py_END_ALLOW_THREADS
+    self->writing = 0;
+
+    if (converted != NULL)
+        free(converted);
+    PyBuffer_Release(&view);
+
+    return PyInt_FromLong(written);
+}
 
 /**********************************************************************
-setProcMode is called everytime a new value is assigned to one of the
-object's attributes. Here are specified pointers to processing and
-post-processing functions according to attribute types.
+write copies a batch of buffers into the ring, in order, with a single
+release of the GIL. x is either one buffer or a sequence of buffers,
+each laid out as for put. block, timeout, sr and planar are the same as
+for put, the timeout applies to the whole batch. Returns the total number of
+frames written, the writing stops at the first buffer that does not fit
+entirely.
 **********************************************************************/
-static void
-FIFOPlayer_setProcMode(FIFOPlayer *self)
+static PyObject *
+FIFOPlayer_write(FIFOPlayer *self, PyObject *args, PyObject *kwds)
 {
-    // FIFOPlayer only defines process_i
-    self->proc_func_ptr = FIFOPlayer_process_i;
+    int i, num, count = 0, frames, total, written = 0, block = 1, planar = 0;
+    double timeout = -1.0, waited = 0.0, sr = 0.0;
+    int *sizes = NULL;
+    MYFLT *buffer;
+    MYFLT **samples = NULL, **converted = NULL;
+    PyObject *arg, *seq = NULL;
+    Py_buffer *views = NULL;
+
+    static char *kwlist[] = {"x", "block", "timeout", "sr", "planar", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|iddi", kwlist, &arg, &block, &timeout, &sr, &planar))
+        return NULL;
+
+    if (self->writing) {
+        PyErr_SetString(PyExc_RuntimeError, "FIFOPlayer.write: only one thread can put samples at a time.");
+        return NULL;
+    }
+
+    if (PyObject_CheckBuffer(arg))
+        num = 1;
+    else {
+        seq = PySequence_Fast(arg, "FIFOPlayer.write: Object with buffer protocol or sequence of them expected.");
+        if (seq == NULL)
+            return NULL;
+        num = (int)PySequence_Fast_GET_SIZE(seq);
+    }
+
+    views = (Py_buffer *)malloc(num * sizeof(Py_buffer));
+    samples = (MYFLT **)malloc(num * sizeof(MYFLT *));
+    converted = (MYFLT **)malloc(num * sizeof(MYFLT *));
+    sizes = (int *)malloc(num * sizeof(int));
+
+    // Get every buffer first, the GIL is needed for that.
+    for (count=0; count<num; count++) {
+        samples[count] = FIFOPlayer_getSamples(self, seq == NULL ? arg : PySequence_Fast_GET_ITEM(seq, count),
+                                               &views[count], &converted[count], &sizes[count], planar, "write");
+        if (samples[count] == NULL)
+            break;
+    }
+
+    if (count == num) {
+        self->writing = 1;
+        Py_BEGIN_ALLOW_THREADS
+        for (i=0; i<num; i++) {
+            frames = sizes[i];
+            buffer = FIFOPlayer_toServerRate(self, samples[i], &frames, sr);
+            total = FIFOPlayer_writeRing(self, buffer, frames, block, timeout, &waited);
+            written += total;
+            if (total < frames)
+                break;
+        }
+        Py_END_ALLOW_THREADS
+        self->writing = 0;
+    }
+
+    for (i=0; i<count; i++) {
+        if (converted[i] != NULL)
+            free(converted[i]);
+        PyBuffer_Release(&views[i]);
+    }
+    free(views);
+    free(samples);
+    free(converted);
+    free(sizes);
+    Py_XDECREF(seq);
+
+    if (count < num)
+        return NULL;
+
+    return PyInt_FromLong(written);
+}
+
+/* Producer side queries, in frames, the ring is read without locking. */
+static PyObject *
+FIFOPlayer_getFillLevel(FIFOPlayer *self)
+{
+    return PyInt_FromLong((SPSCRing_getSize(self->ring) - SPSCRing_writable(self->ring)) / self->chnls);
+}
+
+static PyObject *
+FIFOPlayer_getCapacity(FIFOPlayer *self)
+{
+    return PyInt_FromLong(SPSCRing_getSize(self->ring) / self->chnls);
+}
+
+static PyMemberDef FIFOPlayer_members[] = {
+{"server", T_OBJECT_EX, offsetof(FIFOPlayer, server), 0, "Pyo server."},
+{"stream", T_OBJECT_EX, offsetof(FIFOPlayer, stream), 0, "Stream object."},
+{NULL}  /* Sentinel */
+};
+
+static PyMethodDef FIFOPlayer_methods[] = {
+{"getServer", (PyCFunction)FIFOPlayer_getServer, METH_NOARGS, "Returns server object."},
+{"_getStream", (PyCFunction)FIFOPlayer_getStream, METH_NOARGS, "Returns stream object."},
+{"play", (PyCFunction)FIFOPlayer_play, METH_VARARGS|METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+{"out", (PyCFunction)FIFOPlayer_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
+{"stop", (PyCFunction)FIFOPlayer_stop, METH_NOARGS, "Stops computing."},
+{"put", (PyCFunction)FIFOPlayer_put, METH_VARARGS|METH_KEYWORDS, "Put a numpy array into the FIFO buffer."},
+{"write", (PyCFunction)FIFOPlayer_write, METH_VARARGS|METH_KEYWORDS, "Put a batch of arrays into the FIFO buffer."},
+{"getFillLevel", (PyCFunction)FIFOPlayer_getFillLevel, METH_NOARGS, "Returns the number of frames waiting in the FIFO buffer."},
+{"getCapacity", (PyCFunction)FIFOPlayer_getCapacity, METH_NOARGS, "Returns the size of the FIFO buffer in frames."},
+{NULL}  /* Sentinel */
+};
+
+PyTypeObject FIFOPlayerType = {
+PyObject_HEAD_INIT(NULL)
+0,                                              /*ob_size*/
+"_pyo.FIFOPlayer_base",                         /*tp_name*/
+sizeof(FIFOPlayer),                             /*tp_basicsize*/
+0,                                              /*tp_itemsize*/
+(destructor)FIFOPlayer_dealloc,                 /*tp_dealloc*/
+0,                                              /*tp_print*/
+0,                                              /*tp_getattr*/
+0,                                              /*tp_setattr*/
+0,                                              /*tp_compare*/
+0,                                              /*tp_repr*/
+0,                                              /*tp_as_number*/
+0,                                              /*tp_as_sequence*/
+0,                                              /*tp_as_mapping*/
+0,                                              /*tp_hash */
+0,                                              /*tp_call*/
+0,                                              /*tp_str*/
+0,                                              /*tp_getattro*/
+0,                                              /*tp_setattro*/
+0,                                              /*tp_as_buffer*/
+Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_CHECKTYPES, /*tp_flags*/
+"FIFOPlayer C-implementation. Plays audio data as raw samples from numpy arrays.\n"
+"Other objects that support the Python buffer protocol, are valid, too, as long as the element type matches.\n"
+"For pyo", /* tp_doc */
+(traverseproc)FIFOPlayer_traverse,              /* tp_traverse */
+(inquiry)FIFOPlayer_clear,                      /* tp_clear */
+0,                                              /* tp_richcompare */
+0,                                              /* tp_weaklistoffset */
+0,                                              /* tp_iter */
+0,                                              /* tp_iternext */
+FIFOPlayer_methods,                             /* tp_methods */
+FIFOPlayer_members,                             /* tp_members */
+0,                                              /* tp_getset */
+0,                                              /* tp_base */
+0,                                              /* tp_dict */
+0,                                              /* tp_descr_get */
+0,                                              /* tp_descr_set */
+0,                                              /* tp_dictoffset */
+0,                                              /* tp_init */
+0,                                              /* tp_alloc */
+FIFOPlayer_new,                                 /* tp_new */
+};
+
+/************************************************************************************************/
+/* FIFOPlay streamer object per channel */
+/************************************************************************************************/
+typedef struct {
+    pyo_audio_HEAD
+    FIFOPlayer *mainPlayer;
+    int modebuffer[2];
+    int chnl;
+} FIFOPlay;
+
+static void FIFOPlay_postprocessing_ii(FIFOPlay *self) { POST_PROCESSING_II };
+static void FIFOPlay_postprocessing_ai(FIFOPlay *self) { POST_PROCESSING_AI };
+static void FIFOPlay_postprocessing_ia(FIFOPlay *self) { POST_PROCESSING_IA };
+static void FIFOPlay_postprocessing_aa(FIFOPlay *self) { POST_PROCESSING_AA };
+static void FIFOPlay_postprocessing_ireva(FIFOPlay *self) { POST_PROCESSING_IREVA };
+static void FIFOPlay_postprocessing_areva(FIFOPlay *self) { POST_PROCESSING_AREVA };
+static void FIFOPlay_postprocessing_revai(FIFOPlay *self) { POST_PROCESSING_REVAI };
+static void FIFOPlay_postprocessing_revaa(FIFOPlay *self) { POST_PROCESSING_REVAA };
+static void FIFOPlay_postprocessing_revareva(FIFOPlay *self) { POST_PROCESSING_REVAREVA };
 
+static void
+FIFOPlay_setProcMode(FIFOPlay *self)
+{
     int muladdmode;
-    /* "muladdmode" swith statement should be left as is. */
     muladdmode = self->modebuffer[0] + self->modebuffer[1] * 10;
 
     switch (muladdmode) {
         case 0:
-            self->muladd_func_ptr = FIFOPlayer_postprocessing_ii;
+            self->muladd_func_ptr = FIFOPlay_postprocessing_ii;
             break;
         case 1:
-            self->muladd_func_ptr = FIFOPlayer_postprocessing_ai;
+            self->muladd_func_ptr = FIFOPlay_postprocessing_ai;
             break;
         case 2:
-            self->muladd_func_ptr = FIFOPlayer_postprocessing_revai;
+            self->muladd_func_ptr = FIFOPlay_postprocessing_revai;
             break;
         case 10:
-            self->muladd_func_ptr = FIFOPlayer_postprocessing_ia;
+            self->muladd_func_ptr = FIFOPlay_postprocessing_ia;
             break;
         case 11:
-            self->muladd_func_ptr = FIFOPlayer_postprocessing_aa;
+            self->muladd_func_ptr = FIFOPlay_postprocessing_aa;
             break;
         case 12:
-            self->muladd_func_ptr = FIFOPlayer_postprocessing_revaa;
+            self->muladd_func_ptr = FIFOPlay_postprocessing_revaa;
             break;
         case 20:
-            self->muladd_func_ptr = FIFOPlayer_postprocessing_ireva;
+            self->muladd_func_ptr = FIFOPlay_postprocessing_ireva;
             break;
         case 21:
-            self->muladd_func_ptr = FIFOPlayer_postprocessing_areva;
+            self->muladd_func_ptr = FIFOPlay_postprocessing_areva;
             break;
         case 22:
-            self->muladd_func_ptr = FIFOPlayer_postprocessing_revareva;
+            self->muladd_func_ptr = FIFOPlay_postprocessing_revareva;
             break;
     }
 }
 
-/**********************************************************************
-"compute_next_data_frame" is the function called by the server on each
-processing loop. Processing functions are executed first and then, the
-post-processing function is called.
-**********************************************************************/
 static void
-FIFOPlayer_compute_next_data_frame(FIFOPlayer *self)
+FIFOPlay_compute_next_data_frame(FIFOPlay *self)
 {
-    (*self->proc_func_ptr)(self);
+    int i;
+    MYFLT *tmp;
+    int offset = self->chnl * self->bufsize;
+    tmp = FIFOPlayer_getSamplesBuffer((FIFOPlayer *)self->mainPlayer);
+    for (i=0; i<self->bufsize; i++) {
+        self->data[i] = tmp[i + offset];
+    }
     (*self->muladd_func_ptr)(self);
 }
 
-/**********************************************************************
-Garbage-collector. Every PyObject and Stream objects must be added to
-"traverse" and "clear" functions to allow the interpreter to clean memory
-when ref count drop to zero. These functions must be registered as
-"tp_traverse" and "tp_clear" in the object's PyTypeObject structure below.
-Py_TPFLAGS_HAVE_GC flag must be added to the class flags (tp_flags).
-**********************************************************************/
 static int
-FIFOPlayer_traverse(FIFOPlayer *self, visitproc visit, void *arg)
+FIFOPlay_traverse(FIFOPlay *self, visitproc visit, void *arg)
 {
     pyo_VISIT
-    Py_VISIT(self->python_str_put);
-    Py_VISIT(self->python_str_get);
-    Py_VISIT(self->_queue);
+    Py_VISIT(self->mainPlayer);
     return 0;
 }
 
 static int
-FIFOPlayer_clear(FIFOPlayer *self)
+FIFOPlay_clear(FIFOPlay *self)
 {
     pyo_CLEAR
-    Py_CLEAR(self->python_str_get);
-    Py_CLEAR(self->python_str_put);
-    Py_CLEAR(self->_queue);
+    Py_CLEAR(self->mainPlayer);
     return 0;
 }
 
-/**********************************************************************
-Deallocation function, registered as "tp_dealloc". Here must be freed
-every malloc'ed and realloc'ed variables of the object.
-**********************************************************************/
 static void
-FIFOPlayer_dealloc(FIFOPlayer* self)
+FIFOPlay_dealloc(FIFOPlay* self)
 {
     pyo_DEALLOC
-    FIFOPlayer_clear(self);
-    // in FIFOPlayer_new, we increased Py_False and Py_True (the global objects)
-    // to pass them to _queue.get(False) and _queue.put(...,True) instead
-    // of INCREFing and DECREFing them after each call.
-    Py_DECREF(Py_False);
-    Py_DECREF(Py_True);
+    FIFOPlay_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
 
-/**********************************************************************
-Function called at the object creation, registered as "tp_new".
-**********************************************************************/
 static PyObject *
-FIFOPlayer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+FIFOPlay_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
     int i;
-    PyObject *multmp=NULL, *addtmp=NULL, *always_memcpy=NULL;
-
-    /* Object's allocation */
-    FIFOPlayer *self;
-    self = (FIFOPlayer *)type->tp_alloc(type, 0);
+    PyObject *maintmp=NULL, *multmp=NULL, *addtmp=NULL;
+    FIFOPlay *self;
+    self = (FIFOPlay *)type->tp_alloc(type, 0);
 
-    /* Initialization of object's attributes */
+    self->chnl = 0;
     self->modebuffer[0] = 0;
     self->modebuffer[1] = 0;
-    self->modebuffer[2] = 0; // so setProcMode will set self->proc_func_ptr to FIFOPlayer_process_i
 
-    /* Initialization of common properties of PyoObject */
     INIT_OBJECT_COMMON
+    Stream_setFunctionPtr(self->stream, FIFOPlay_compute_next_data_frame);
+    self->mode_func_ptr = FIFOPlay_setProcMode;
 
-    /* Assign the stream's pointer to the object's processing callback. */
-    /* The stream struct is what is registered in the server. */
-    Stream_setFunctionPtr(self->stream, FIFOPlayer_compute_next_data_frame);
-    /* Assign setProcMode to the common mode_func_ptr pointer */
-    self->mode_func_ptr = FIFOPlayer_setProcMode;
+    static char *kwlist[] = {"mainPlayer", "chnl", "mul", "add", NULL};
 
-    /* Object's keyword list. These are arguments to the object's creation */
-    static char *kwlist[] = { "mul", "add", "copy_free", NULL};
-
-    /* Argument parsing. If there is float values in the type list ("|OO"),
-    a macro must be given to handle float vs double argument. See pyomodule.h
-    for the list of macros already available. */
-    if (! PyArg_ParseTupleAndKeywords(args, kwds, "|OOO", kwlist, &multmp, &addtmp, &always_memcpy))
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|iOO", kwlist, &maintmp, &self->chnl, &multmp, &addtmp))
         Py_RETURN_NONE;
 
-    self->backup_data = NULL;
-    self->current_buffer_idx = 0;
-    self->data_idx = 0;
-    self->last_sample = (MYFLT)0.0;
-    self->python_str_get = PyString_FromString("get");
-    self->python_str_put = PyString_FromString("put");
-    self->always_memcpy = !PyObject_IsTrue(always_memcpy);
-    // these two are used globally to pass as an argument,
-    Py_INCREF(Py_False);
-    Py_INCREF(Py_True);
+    Py_XDECREF(self->mainPlayer);
+    Py_INCREF(maintmp);
+    self->mainPlayer = (FIFOPlayer *)maintmp;
+
+    if (self->chnl < 0 || self->chnl >= self->mainPlayer->chnls)
+        self->chnl = 0;
 
     if (multmp) {
         PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
@@ -449,115 +770,59 @@ FIFOPlayer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
         PyObject_CallMethod((PyObject *)self, "setAdd", "O", addtmp);
     }
 
-    /* Add the object's stream struct to the server registry */
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
-    /* Call setProcMode to be sure pointers are correctly assigned */
     (*self->mode_func_ptr)(self);
 
     return (PyObject *)self;
 }
 
-/**********************************************************************
-Functions common to almost all PyoObjects. The macros are defined in
-pyomodule.h. Sometime the "out" function is removed to prevent sending
-non-normalized signal (like the fft analysis of FFT object) to the soundcard.
-Object dependant initializations can be added before PLAY, OUT and STOP macros.
-**********************************************************************/
-static PyObject * FIFOPlayer_getServer(FIFOPlayer *self) { GET_SERVER };
-static PyObject * FIFOPlayer_getStream(FIFOPlayer *self) { GET_STREAM };
-static PyObject * FIFOPlayer_setMul(FIFOPlayer *self, PyObject *arg) { SET_MUL };
-static PyObject * FIFOPlayer_setAdd(FIFOPlayer *self, PyObject *arg) { SET_ADD };
-static PyObject * FIFOPlayer_setSub(FIFOPlayer *self, PyObject *arg) { SET_SUB };
-static PyObject * FIFOPlayer_setDiv(FIFOPlayer *self, PyObject *arg) { SET_DIV };
-
-static PyObject * FIFOPlayer_play(FIFOPlayer *self, PyObject *args, PyObject *kwds) { PLAY };
-static PyObject * FIFOPlayer_out(FIFOPlayer *self, PyObject *args, PyObject *kwds) { OUT };
-static PyObject * FIFOPlayer_stop(FIFOPlayer *self) { STOP };
-
-static PyObject * FIFOPlayer_multiply(FIFOPlayer *self, PyObject *arg) { MULTIPLY };
-static PyObject * FIFOPlayer_inplace_multiply(FIFOPlayer *self, PyObject *arg) { INPLACE_MULTIPLY };
-static PyObject * FIFOPlayer_add(FIFOPlayer *self, PyObject *arg) { ADD };
-static PyObject * FIFOPlayer_inplace_add(FIFOPlayer *self, PyObject *arg) { INPLACE_ADD };
-static PyObject * FIFOPlayer_sub(FIFOPlayer *self, PyObject *arg) { SUB };
-static PyObject * FIFOPlayer_inplace_sub(FIFOPlayer *self, PyObject *arg) { INPLACE_SUB };
-static PyObject * FIFOPlayer_div(FIFOPlayer *self, PyObject *arg) { DIV };
-static PyObject * FIFOPlayer_inplace_div(FIFOPlayer *self, PyObject *arg) { INPLACE_DIV };
-
-static PyObject *
-FIFOPlayer_put(FIFOPlayer *self, PyObject *arg)
-{
-    if (arg == NULL) {
-        Py_INCREF(Py_None);
-        return Py_None;
-    }
-
-    // Does the given arg support the buffer protocol at all?
-    if (!PyObject_CheckBuffer(arg)) {
-        PyErr_SetString(PyExc_TypeError, "FIFOPlayer.put: Object with buffer protocol expected (e.g. str, numpy.array, ...)");
-        return NULL;
-    }
-
-    // we pass True as second arg, so it will block until the queue has a free slot...
-    PyObject* ret;
-    Py_INCREF(Py_True);
-    ret = PyObject_CallMethodObjArgs(self->_queue, self->python_str_put, arg, Py_True, NULL); // NULL as last arg to flag the end
-    Py_DECREF(Py_True);
-    if (!ret) {
-        // todo: raise err or what? I dunno. queue.put(arg,True) should not fail
-        PyErr_SetString(PyExc_TypeError, "FIFOPlayer.put: Object with buffer protocol expected (e.g. str, numpy.array, ...)");
-        return NULL;
-    }
-    Py_DECREF(ret);
-
-    Py_INCREF(Py_None);
-    return Py_None;
-}
-
-/**********************************************************************
-Object's members descriptors. Here should appear the server and stream
-refs and also every PyObjects declared in the object's struct.
-Registered as "tp_members".
-**********************************************************************/
-static PyMemberDef FIFOPlayer_members[] = {
-{"server", T_OBJECT_EX, offsetof(FIFOPlayer, server), 0, "Pyo server."},
-{"stream", T_OBJECT_EX, offsetof(FIFOPlayer, stream), 0, "Stream object."},
-{"mul", T_OBJECT_EX, offsetof(FIFOPlayer, mul), 0, "Mul factor."},
-{"add", T_OBJECT_EX, offsetof(FIFOPlayer, add), 0, "Add factor."},
-{"_queue", T_OBJECT_EX, offsetof(FIFOPlayer, _queue), 0, "The Python Queue (from stdlib) for this channel."},
+static PyObject * FIFOPlay_getServer(FIFOPlay* self) { GET_SERVER };
+static PyObject * FIFOPlay_getStream(FIFOPlay* self) { GET_STREAM };
+static PyObject * FIFOPlay_setMul(FIFOPlay *self, PyObject *arg) { SET_MUL };
+static PyObject * FIFOPlay_setAdd(FIFOPlay *self, PyObject *arg) { SET_ADD };
+static PyObject * FIFOPlay_setSub(FIFOPlay *self, PyObject *arg) { SET_SUB };
+static PyObject * FIFOPlay_setDiv(FIFOPlay *self, PyObject *arg) { SET_DIV };
+
+static PyObject * FIFOPlay_play(FIFOPlay *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * FIFOPlay_out(FIFOPlay *self, PyObject *args, PyObject *kwds) { OUT };
+static PyObject * FIFOPlay_stop(FIFOPlay *self) { STOP };
+
+static PyObject * FIFOPlay_multiply(FIFOPlay *self, PyObject *arg) { MULTIPLY };
+static PyObject * FIFOPlay_inplace_multiply(FIFOPlay *self, PyObject *arg) { INPLACE_MULTIPLY };
+static PyObject * FIFOPlay_add(FIFOPlay *self, PyObject *arg) { ADD };
+static PyObject * FIFOPlay_inplace_add(FIFOPlay *self, PyObject *arg) { INPLACE_ADD };
+static PyObject * FIFOPlay_sub(FIFOPlay *self, PyObject *arg) { SUB };
+static PyObject * FIFOPlay_inplace_sub(FIFOPlay *self, PyObject *arg) { INPLACE_SUB };
+static PyObject * FIFOPlay_div(FIFOPlay *self, PyObject *arg) { DIV };
+static PyObject * FIFOPlay_inplace_div(FIFOPlay *self, PyObject *arg) { INPLACE_DIV };
+
+static PyMemberDef FIFOPlay_members[] = {
+{"server", T_OBJECT_EX, offsetof(FIFOPlay, server), 0, "Pyo server."},
+{"stream", T_OBJECT_EX, offsetof(FIFOPlay, stream), 0, "Stream object."},
+{"mul", T_OBJECT_EX, offsetof(FIFOPlay, mul), 0, "Mul factor."},
+{"add", T_OBJECT_EX, offsetof(FIFOPlay, add), 0, "Add factor."},
 {NULL}  /* Sentinel */
 };
 
-/**********************************************************************
-Object's method descriptors. Here should appear every methods needed to
-be exposed to the python interpreter, casted to PyCFunction.
-Registered as "tp_methods".
-**********************************************************************/
-static PyMethodDef FIFOPlayer_methods[] = {
-{"getServer", (PyCFunction)FIFOPlayer_getServer, METH_NOARGS, "Returns server object."},
-{"_getStream", (PyCFunction)FIFOPlayer_getStream, METH_NOARGS, "Returns stream object."},
-{"play", (PyCFunction)FIFOPlayer_play, METH_VARARGS|METH_KEYWORDS, "Starts dbuting without sending sound to soundcard."},
-{"out", (PyCFunction)FIFOPlayer_out, METH_VARARGS|METH_KEYWORDS, "Starts dbuting and sends sound to soundcard channel speficied by argument."},
-{"stop", (PyCFunction)FIFOPlayer_stop, METH_NOARGS, "Stops dbuting."},
-{"setMul", (PyCFunction)FIFOPlayer_setMul, METH_O, "Sets oscillator mul factor."},
-{"setAdd", (PyCFunction)FIFOPlayer_setAdd, METH_O, "Sets oscillator add factor."},
-{"setSub", (PyCFunction)FIFOPlayer_setSub, METH_O, "Sets inverse add factor."},
-{"setDiv", (PyCFunction)FIFOPlayer_setDiv, METH_O, "Sets inverse mul factor."},
-{"put", (PyCFunction)FIFOPlayer_put, METH_O, "Put a numpy array into the FIFO buffer."},
+static PyMethodDef FIFOPlay_methods[] = {
+{"getServer", (PyCFunction)FIFOPlay_getServer, METH_NOARGS, "Returns server object."},
+{"_getStream", (PyCFunction)FIFOPlay_getStream, METH_NOARGS, "Returns stream object."},
+{"play", (PyCFunction)FIFOPlay_play, METH_VARARGS|METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+{"out", (PyCFunction)FIFOPlay_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
+{"stop", (PyCFunction)FIFOPlay_stop, METH_NOARGS, "Stops computing."},
+{"setMul", (PyCFunction)FIFOPlay_setMul, METH_O, "Sets FIFOPlay mul factor."},
+{"setAdd", (PyCFunction)FIFOPlay_setAdd, METH_O, "Sets FIFOPlay add factor."},
+{"setSub", (PyCFunction)FIFOPlay_setSub, METH_O, "Sets inverse add factor."},
+{"setDiv", (PyCFunction)FIFOPlay_setDiv, METH_O, "Sets inverse mul factor."},
 {NULL}  /* Sentinel */
 };
 
-/**********************************************************************
-Number protocol struct. This allow to override the behaviour of mathematical
-operations on the object. At the moment of the writing, only +, -, * and /,
-and the corresponding "inplace" operations (a *= 1) are implemented. More
-to comme in the future. Registered as "tp_as_number".
-**********************************************************************/
-static PyNumberMethods FIFOPlayer_as_number = {
-(binaryfunc)FIFOPlayer_add,                           /*nb_add*/
-(binaryfunc)FIFOPlayer_sub,                           /*nb_subtract*/
-(binaryfunc)FIFOPlayer_multiply,                      /*nb_multiply*/
-(binaryfunc)FIFOPlayer_div,                           /*nb_divide*/
+static PyNumberMethods FIFOPlay_as_number = {
+(binaryfunc)FIFOPlay_add,                       /*nb_add*/
+(binaryfunc)FIFOPlay_sub,                       /*nb_subtract*/
+(binaryfunc)FIFOPlay_multiply,                  /*nb_multiply*/
+(binaryfunc)FIFOPlay_div,                       /*nb_divide*/
 0,                                              /*nb_remainder*/
 0,                                              /*nb_divmod*/
 0,                                              /*nb_power*/
@@ -577,10 +842,10 @@ static PyNumberMethods FIFOPlayer_as_number = {
 0,                                              /*nb_float*/
 0,                                              /*nb_oct*/
 0,                                              /*nb_hex*/
-(binaryfunc)FIFOPlayer_inplace_add,                   /*inplace_add*/
-(binaryfunc)FIFOPlayer_inplace_sub,                   /*inplace_subtract*/
-(binaryfunc)FIFOPlayer_inplace_multiply,              /*inplace_multiply*/
-(binaryfunc)FIFOPlayer_inplace_div,                   /*inplace_divide*/
+(binaryfunc)FIFOPlay_inplace_add,               /*inplace_add*/
+(binaryfunc)FIFOPlay_inplace_sub,               /*inplace_subtract*/
+(binaryfunc)FIFOPlay_inplace_multiply,          /*inplace_multiply*/
+(binaryfunc)FIFOPlay_inplace_div,               /*inplace_divide*/
 0,                                              /*inplace_remainder*/
 0,                                              /*inplace_power*/
 0,                                              /*inplace_lshift*/
@@ -595,31 +860,19 @@ static PyNumberMethods FIFOPlayer_as_number = {
 0,                                              /* nb_index */
 };
 
-/**************************************************************
-Object's type declaration. The type's name should be "XXXType",
-where XXX is replaced by the name of the object.
-Fields in PyTypeObject that are not used should be 0.
-**************************************************************/
-PyTypeObject FIFOPlayerType = {
+PyTypeObject FIFOPlayType = {
 PyObject_HEAD_INIT(NULL)
 0,                                              /*ob_size*/
-/* How the object will be exposed to the
-python interpreter. The name of the C component
-of a PyoObject should be "XXX_base", where XXX
-is replaced by the name of the object. These
-objects are actually never directly created
-by the user. They are used inside the object's
-Python class to handle multi-channel expansion.*/
-"_pyo.FIFOPlayer_base",                      /*tp_name*/
-sizeof(FIFOPlayer),                                  /*tp_basicsize*/
+"_pyo.FIFOPlay_base",                           /*tp_name*/
+sizeof(FIFOPlay),                               /*tp_basicsize*/
 0,                                              /*tp_itemsize*/
-(destructor)FIFOPlayer_dealloc,                       /*tp_dealloc*/
+(destructor)FIFOPlay_dealloc,                   /*tp_dealloc*/
 0,                                              /*tp_print*/
 0,                                              /*tp_getattr*/
 0,                                              /*tp_setattr*/
-0,                                              /*tp_dbare*/
+0,                                              /*tp_compare*/
 0,                                              /*tp_repr*/
-&FIFOPlayer_as_number,                          /*tp_as_number*/
+&FIFOPlay_as_number,                            /*tp_as_number*/
 0,                                              /*tp_as_sequence*/
 0,                                              /*tp_as_mapping*/
 0,                                              /*tp_hash */
@@ -629,17 +882,15 @@ sizeof(FIFOPlayer),                                  /*tp_basicsize*/
 0,                                              /*tp_setattro*/
 0,                                              /*tp_as_buffer*/
 Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_CHECKTYPES, /*tp_flags*/
-"FIFOPlayer C-implementation. Plays audio data as raw samples from numpy arrays.\n"
-"Other objects that support the Python buffer protocol, are valid, too, as long as the element type matches.\n"
-"For pyo", /* tp_doc */
-(traverseproc)FIFOPlayer_traverse,                    /* tp_traverse */
-(inquiry)FIFOPlayer_clear,                            /* tp_clear */
-0,                                              /* tp_richdbare */
+"FIFOPlay objects. Reads a channel from a FIFOPlayer.",  /* tp_doc */
+(traverseproc)FIFOPlay_traverse,                /* tp_traverse */
+(inquiry)FIFOPlay_clear,                        /* tp_clear */
+0,                                              /* tp_richcompare */
 0,                                              /* tp_weaklistoffset */
 0,                                              /* tp_iter */
 0,                                              /* tp_iternext */
-FIFOPlayer_methods,                                   /* tp_methods */
-FIFOPlayer_members,                                   /* tp_members */
+FIFOPlay_methods,                               /* tp_methods */
+FIFOPlay_members,                               /* tp_members */
 0,                                              /* tp_getset */
 0,                                              /* tp_base */
 0,                                              /* tp_dict */
@@ -648,5 +899,5 @@ FIFOPlayer_members,                                   /* tp_members */
 0,                                              /* tp_dictoffset */
 0,                                              /* tp_init */
 0,                                              /* tp_alloc */
-FIFOPlayer_new,                                       /* tp_new */
+FIFOPlay_new,                                   /* tp_new */
 };
@@ -24,6 +24,8 @@
 #include "pyomodule.h"
 #include "streammodule.h"
 #include "servermodule.h"
+#include "ctlramp.h"
+#include "biquadbank.h"
 #include "dummymodule.h"
 
 static MYFLT HALF_COS_ARRAY[513] = {1.0, 0.99998110153278696, 0.99992440684545181, 0.99982991808087995, 0.99969763881045715, 0.99952757403393411, 0.99931973017923825, 0.99907411510222999, 0.99879073808640628, 0.99846960984254973, 0.99811074250832332, 0.99771414964781235, 0.99727984625101107, 0.99680784873325645, 0.99629817493460782, 0.99575084411917214, 0.99516587697437664, 0.99454329561018584, 0.99388312355826691, 0.9931853857710996, 0.99245010862103322, 0.99167731989928998, 0.99086704881491472, 0.99001932599367026, 0.98913418347688054, 0.98821165472021921, 0.9872517745924454, 0.98625457937408512, 0.98522010675606064, 0.98414839583826585, 0.98303948712808786, 0.98189342253887657, 0.98071024538836005, 0.97949000039700762, 0.97823273368633901, 0.9769384927771817, 0.97560732658787452, 0.97423928543241856, 0.97283442101857576, 0.97139278644591409, 0.96991443620380113, 0.96839942616934394, 0.96684781360527761, 0.96525965715780015, 0.96363501685435693, 0.96197395410137099, 0.96027653168192206, 0.95854281375337425, 0.95677286584495025, 0.95496675485525528, 0.95312454904974775, 0.95124631805815985, 0.94933213287186513, 0.94738206584119555, 0.94539619067270686, 0.9433745824263926, 0.94131731751284708, 0.9392244736903772, 0.93709613006206383, 0.9349323670727715, 0.93273326650610799, 0.93049891148133324, 0.92822938645021758, 0.92592477719384991, 0.92358517081939495, 0.92121065575680161, 0.91880132175545981, 0.91635725988080907, 0.91387856251089561, 0.91136532333288145, 0.90881763733950294, 0.9062356008254806, 0.90361931138387919, 0.90096886790241915, 0.89828437055973898, 0.89556592082160869, 0.89281362143709486, 0.89002757643467667, 0.88720789111831455, 0.8843546720634694, 0.88146802711307481, 0.87854806537346075, 0.87559489721022943, 0.8726086342440843, 0.86958938934661101, 0.86653727663601088, 0.86345241147278784, 0.86033491045538835, 0.85718489141579368, 0.85400247341506719, 0.8507877767388532, 0.84754092289283123, 0.8442620345981231, 0.84095123578665476, 0.8376086515964718, 0.83423440836700968, 0.83082863363431847, 0.82739145612624232, 0.82392300575755428, 0.82042341362504534, 0.81689281200256991, 0.81333133433604599, 0.80973911523841147, 0.80611629048453592, 0.80246299700608914, 0.79877937288636502, 0.7950655573550629, 0.79132169078302494, 0.78754791467693042, 0.78374437167394739, 0.77991120553634141, 0.77604856114604148, 0.77215658449916424, 0.76823542270049605, 0.76428522395793219, 0.7603061375768756, 0.75629831395459302, 0.75226190457453135, 0.74819706200059122, 0.7441039398713607, 0.73998269289430851, 0.73583347683993672, 0.73165644853589207, 0.72745176586103977, 0.72321958773949491, 0.71896007413461649, 0.71467338604296105, 0.71035968548819706, 0.70601913551498185, 0.70165190018279788, 0.69725814455975277, 0.69283803471633953, 0.68839173771916018, 0.68391942162461061, 0.6794212554725293, 0.67489740927980701, 0.67034805403396192, 0.66577336168667567, 0.66117350514729512, 0.65654865827629605, 0.65189899587871258, 0.64722469369752944, 0.6425259284070397, 0.63780287760616672, 0.63305571981175202, 0.62828463445180749, 0.62348980185873359, 0.61867140326250347, 0.61382962078381298, 0.60896463742719675, 0.60407663707411186, 0.59916580447598711, 0.59423232524724023, 0.58927638585826192, 0.58429817362836856, 0.57929787671872113, 0.57427568412521424, 0.56923178567133192, 0.56416637200097319, 0.55907963457124654, 0.55397176564523298, 0.5488429582847193, 0.5436934063429012, 0.53852330445705543, 0.53333284804118442, 0.52812223327862839, 0.52289165711465235, 0.51764131724900009, 0.51237141212842374, 0.50708214093918114, 0.50177370359950879, 0.49644630075206486, 0.49110013375634509, 0.48573540468107329, 0.48035231629656205, 0.47495107206705045, 0.46953187614301212, 0.46409493335344021, 0.45864044919810504, 0.45316862983978612, 0.44767968209648135, 0.44217381343358825, 0.43665123195606403, 0.43111214640055828, 0.42555676612752463, 0.41998530111330729, 0.41439796194220363, 0.40879495979850627, 0.40317650645851943, 0.39754281428255606, 0.3918940962069094, 0.38623056573580644, 0.38055243693333718, 0.3748599244153632, 0.36915324334140731, 0.36343260940651945, 0.35769823883312568, 0.35195034836285416, 0.34618915524834432, 0.34041487724503472, 0.33462773260293199, 0.32882794005836308, 0.32301571882570607, 0.31719128858910622, 0.31135486949417079, 0.30550668213964982, 0.29964694756909749, 0.29377588726251663, 0.28789372312798917, 0.28200067749328667, 0.27609697309746906, 0.27018283308246382, 0.26425848098463345, 0.25832414072632598, 0.25238003660741054, 0.24642639329680122, 0.24046343582396335, 0.23449138957040974, 0.22851048026118126, 0.22252093395631445, 0.21652297704229864, 0.21051683622351761, 0.20450273851368242, 0.19848091122724945, 0.19245158197082995, 0.18641497863458675, 0.1803713293836198, 0.17432086264934399, 0.16826380712085329, 0.16220039173627876, 0.15613084567413366, 0.1500553983446527, 0.14397427938112045, 0.13788771863119115, 0.13179594614820278, 0.12569919218247999, 0.11959768717263308, 0.11349166173684638, 0.10738134666416307, 0.10126697290576155, 0.095148771566225324, 0.089026973894809708, 0.082901811276699419, 0.076773515224264705, 0.070642317368309157, 0.064508449449316344, 0.058372143308689985, 0.052233630879990445, 0.046093144180169916, 0.039950915300801082, 0.033807176399306589, 0.027662159690182372, 0.021516097436222258, 0.01536922193973846, 0.0092217655337806046, 0.0030739605733557966, -0.0030739605733554522, -0.0092217655337804832, -0.015369221939738116, -0.021516097436222133, -0.027662159690182025, -0.033807176399306464, -0.039950915300800735, -0.046093144180169791, -0.052233630879990098, -0.05837214330868986, -0.064508449449316232, -0.07064231736830906, -0.076773515224264371, -0.082901811276699308, -0.089026973894809375, -0.095148771566225213, -0.10126697290576121, -0.10738134666416296, -0.11349166173684605, -0.11959768717263299, -0.12569919218247966, -0.13179594614820267, -0.13788771863119104, -0.14397427938112034, -0.15005539834465259, -0.15613084567413354, -0.16220039173627843, -0.16826380712085318, -0.17432086264934366, -0.18037132938361969, -0.18641497863458642, -0.19245158197082984, -0.19848091122724912, -0.20450273851368231, -0.21051683622351727, -0.21652297704229853, -0.22252093395631434, -0.22851048026118118, -0.23449138957040966, -0.24046343582396323, -0.24642639329680088, -0.25238003660741043, -0.25832414072632565, -0.26425848098463334, -0.27018283308246349, -0.27609697309746895, -0.28200067749328633, -0.28789372312798905, -0.2937758872625163, -0.29964694756909738, -0.30550668213964971, -0.31135486949417068, -0.31719128858910589, -0.32301571882570601, -0.32882794005836274, -0.33462773260293188, -0.34041487724503444, -0.3461891552483442, -0.35195034836285388, -0.35769823883312557, -0.36343260940651911, -0.3691532433414072, -0.37485992441536287, -0.38055243693333707, -0.38623056573580633, -0.39189409620690935, -0.39754281428255578, -0.40317650645851938, -0.408794959798506, -0.41439796194220352, -0.41998530111330723, -0.42555676612752458, -0.43111214640055795, -0.43665123195606392, -0.44217381343358819, -0.44767968209648107, -0.45316862983978584, -0.45864044919810493, -0.46409493335344015, -0.46953187614301223, -0.47495107206704995, -0.48035231629656183, -0.4857354046810729, -0.49110013375634509, -0.4964463007520647, -0.50177370359950857, -0.5070821409391808, -0.51237141212842352, -0.51764131724899998, -0.52289165711465191, -0.52812223327862795, -0.53333284804118419, -0.53852330445705532, -0.5436934063429012, -0.54884295828471885, -0.55397176564523276, -0.55907963457124621, -0.56416637200097308, -0.5692317856713317, -0.57427568412521401, -0.57929787671872079, -0.58429817362836844, -0.5892763858582617, -0.5942323252472399, -0.59916580447598666, -0.60407663707411174, -0.60896463742719653, -0.61382962078381298, -0.61867140326250303, -0.62348980185873337, -0.62828463445180716, -0.6330557198117519, -0.6378028776061665, -0.64252592840703937, -0.64722469369752911, -0.65189899587871247, -0.65654865827629583, -0.66117350514729478, -0.66577336168667522, -0.67034805403396169, -0.67489740927980679, -0.6794212554725293, -0.68391942162461028, -0.68839173771915996, -0.6928380347163392, -0.69725814455975266, -0.70165190018279777, -0.70601913551498163, -0.71035968548819683, -0.71467338604296105, -0.71896007413461638, -0.72321958773949468, -0.72745176586103955, -0.73165644853589207, -0.73583347683993661, -0.73998269289430874, -0.74410393987136036, -0.74819706200059111, -0.75226190457453113, -0.75629831395459302, -0.76030613757687548, -0.76428522395793208, -0.76823542270049594, -0.77215658449916424, -0.77604856114604126, -0.77991120553634119, -0.78374437167394717, -0.78754791467693031, -0.79132169078302472, -0.7950655573550629, -0.79877937288636469, -0.80246299700608903, -0.80611629048453581, -0.80973911523841147, -0.81333133433604599, -0.8168928120025698, -0.82042341362504512, -0.82392300575755417, -0.82739145612624221, -0.83082863363431825, -0.83423440836700946, -0.8376086515964718, -0.84095123578665465, -0.8442620345981231, -0.84754092289283089, -0.85078777673885309, -0.85400247341506696, -0.85718489141579368, -0.86033491045538824, -0.86345241147278773, -0.86653727663601066, -0.86958938934661101, -0.87260863424408419, -0.87559489721022921, -0.87854806537346053, -0.88146802711307481, -0.88435467206346929, -0.88720789111831455, -0.89002757643467667, -0.89281362143709475, -0.89556592082160857, -0.89828437055973898, -0.90096886790241903, -0.90361931138387908, -0.90623560082548038, -0.90881763733950294, -0.91136532333288134, -0.9138785625108955, -0.91635725988080885, -0.91880132175545981, -0.92121065575680139, -0.92358517081939495, -0.9259247771938498, -0.92822938645021758, -0.93049891148133312, -0.93273326650610799, -0.9349323670727715, -0.93709613006206383, -0.93922447369037709, -0.94131731751284708, -0.9433745824263926, -0.94539619067270697, -0.94738206584119544, -0.94933213287186502, -0.95124631805815973, -0.95312454904974775, -0.95496675485525517, -0.95677286584495025, -0.95854281375337413, -0.96027653168192206, -0.96197395410137099, -0.96363501685435693, -0.96525965715780004, -0.9668478136052775, -0.96839942616934394, -0.96991443620380113, -0.97139278644591398, -0.97283442101857565, -0.97423928543241844, -0.97560732658787452, -0.9769384927771817, -0.9782327336863389, -0.97949000039700751, -0.98071024538836005, -0.98189342253887657, -0.98303948712808775, -0.98414839583826574, -0.98522010675606064, -0.98625457937408501, -0.9872517745924454, -0.98821165472021921, -0.98913418347688054, -0.99001932599367015, -0.99086704881491472, -0.99167731989928998, -0.99245010862103311, -0.99318538577109949, -0.99388312355826691, -0.99454329561018584, -0.99516587697437653, -0.99575084411917214, -0.99629817493460782, -0.99680784873325645, -0.99727984625101107, -0.99771414964781235, -0.99811074250832332, -0.99846960984254973, -0.99879073808640628, -0.99907411510222999, -0.99931973017923825, -0.99952757403393411, -0.99969763881045715, -0.99982991808087995, -0.99992440684545181, -0.99998110153278685, -1.0, -1.0};
@@ -58,6 +60,7 @@ typedef struct {
     MYFLT a0;
     MYFLT a1;
     MYFLT a2;
+    CtlRamp ramp;
 } Biquad;
 
 static void
@@ -219,6 +222,60 @@ Biquad_filters_aa(Biquad *self) {
     }
 }
 
+/* Coefficients computed every ramp.period samples and interpolated, see ctlramp.h. */
+static void
+Biquad_filters_ctl(Biquad *self) {
+    MYFLT val, fr = 0.0, q = 0.0, target[CTLRAMP_MAX_COEFFS];
+    int i, j, len;
+    MYFLT *c = self->ramp.coeffs;
+    MYFLT *inc = self->ramp.incs;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    MYFLT *frs = NULL, *qs = NULL;
+
+    if (self->init == 1) {
+        self->x1 = self->x2 = self->y1 = self->y2 = in[0];
+        self->init = 0;
+    }
+
+    if (self->modebuffer[2] == 0)
+        fr = PyFloat_AS_DOUBLE(self->freq);
+    else
+        frs = Stream_getData((Stream *)self->freq_stream);
+    if (self->modebuffer[3] == 0)
+        q = PyFloat_AS_DOUBLE(self->q);
+    else
+        qs = Stream_getData((Stream *)self->q_stream);
+
+    for (i=0; i<self->bufsize; i+=len) {
+        len = CtlRamp_segment(&self->ramp, i, self->bufsize);
+        if (frs != NULL)
+            fr = frs[i+len-1];
+        if (qs != NULL)
+            q = qs[i+len-1];
+        if (CtlRamp_begin(&self->ramp, fr, q, 0.0)) {
+            Biquad_compute_variables(self, fr, q);
+            target[0] = self->b0 * self->a0;
+            target[1] = self->b1 * self->a0;
+            target[2] = self->b2 * self->a0;
+            target[3] = self->a1 * self->a0;
+            target[4] = self->a2 * self->a0;
+            CtlRamp_setTarget(&self->ramp, target, len);
+        }
+        for (j=i; j<i+len; j++) {
+            c[0] += inc[0];
+            c[1] += inc[1];
+            c[2] += inc[2];
+            c[3] += inc[3];
+            c[4] += inc[4];
+            val = c[0] * in[j] + c[1] * self->x1 + c[2] * self->x2 - c[3] * self->y1 - c[4] * self->y2;
+            self->x2 = self->x1;
+            self->x1 = in[j];
+            self->y2 = self->y1;
+            self->data[j] = self->y1 = val;
+        }
+    }
+}
+
 static void Biquad_postprocessing_ii(Biquad *self) { POST_PROCESSING_II };
 static void Biquad_postprocessing_ai(Biquad *self) { POST_PROCESSING_AI };
 static void Biquad_postprocessing_ia(Biquad *self) { POST_PROCESSING_IA };
@@ -269,6 +326,13 @@ Biquad_setProcMode(Biquad *self)
             self->proc_func_ptr = Biquad_filters_aa;
             break;
     }
+    if (self->ramp.period > 0 && procmode != 0) {
+        self->proc_func_ptr = Biquad_filters_ctl;
+    }
+    else {
+        self->ramp.ready = 0;
+    }
+
 	switch (muladdmode) {
         case 0:
             self->muladd_func_ptr = Biquad_postprocessing_ii;
@@ -365,6 +429,7 @@ Biquad_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     Stream_setFunctionPtr(self->stream, Biquad_compute_next_data_frame);
     self->mode_func_ptr = Biquad_setProcMode;
+    CtlRamp_init(&self->ramp, 5);
 
     static char *kwlist[] = {"input", "freq", "q", "type", "mul", "add", NULL};
 
@@ -489,12 +554,29 @@ Biquad_setType(Biquad *self, PyObject *arg)
 		self->filtertype = PyInt_AsLong(arg);
 	}
 
+    /* Same parameters, other coefficients. */
+    self->ramp.ready = 0;
+
     (*self->mode_func_ptr)(self);
 
 	Py_INCREF(Py_None);
 	return Py_None;
 }
 
+static PyObject *
+Biquad_setCtlPeriod(Biquad *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+    if (PyNumber_Check(arg)) {
+        CtlRamp_setPeriod(&self->ramp, PyInt_AsLong(arg));
+        (*self->mode_func_ptr)(self);
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyMemberDef Biquad_members[] = {
     {"server", T_OBJECT_EX, offsetof(Biquad, server), 0, "Pyo server."},
     {"stream", T_OBJECT_EX, offsetof(Biquad, stream), 0, "Stream object."},
@@ -513,6 +595,7 @@ static PyMethodDef Biquad_methods[] = {
     {"out", (PyCFunction)Biquad_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
     {"stop", (PyCFunction)Biquad_stop, METH_NOARGS, "Stops computing."},
 	{"setFreq", (PyCFunction)Biquad_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
+	{"setCtlPeriod", (PyCFunction)Biquad_setCtlPeriod, METH_O, "Sets the number of samples between two coefficient computations."},
     {"setQ", (PyCFunction)Biquad_setQ, METH_O, "Sets filter Q factor."},
     {"setType", (PyCFunction)Biquad_setType, METH_O, "Sets filter type factor."},
 	{"setMul", (PyCFunction)Biquad_setMul, METH_O, "Sets oscillator mul factor."},
@@ -636,6 +719,7 @@ typedef struct {
     MYFLT a0;
     MYFLT a1;
     MYFLT a2;
+    CtlRamp ramp;
 } Biquadx;
 
 static void
@@ -835,6 +919,66 @@ Biquadx_filters_aa(Biquadx *self) {
     }
 }
 
+/* Coefficients computed every ramp.period samples and interpolated, see ctlramp.h. */
+static void
+Biquadx_filters_ctl(Biquadx *self) {
+    MYFLT vin, vout = 0.0, fr = 0.0, q = 0.0, target[CTLRAMP_MAX_COEFFS];
+    int i, j, len, k;
+    MYFLT *c = self->ramp.coeffs;
+    MYFLT *inc = self->ramp.incs;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    MYFLT *frs = NULL, *qs = NULL;
+
+    if (self->init == 1) {
+        for (i=0; i<self->stages; i++) {
+            self->x1[i] = self->x2[i] = self->y1[i] = self->y2[i] = in[0];
+        }
+        self->init = 0;
+    }
+
+    if (self->modebuffer[2] == 0)
+        fr = PyFloat_AS_DOUBLE(self->freq);
+    else
+        frs = Stream_getData((Stream *)self->freq_stream);
+    if (self->modebuffer[3] == 0)
+        q = PyFloat_AS_DOUBLE(self->q);
+    else
+        qs = Stream_getData((Stream *)self->q_stream);
+
+    for (i=0; i<self->bufsize; i+=len) {
+        len = CtlRamp_segment(&self->ramp, i, self->bufsize);
+        if (frs != NULL)
+            fr = frs[i+len-1];
+        if (qs != NULL)
+            q = qs[i+len-1];
+        if (CtlRamp_begin(&self->ramp, fr, q, 0.0)) {
+            Biquadx_compute_variables(self, fr, q);
+            target[0] = self->b0 * self->a0;
+            target[1] = self->b1 * self->a0;
+            target[2] = self->b2 * self->a0;
+            target[3] = self->a1 * self->a0;
+            target[4] = self->a2 * self->a0;
+            CtlRamp_setTarget(&self->ramp, target, len);
+        }
+        for (j=i; j<i+len; j++) {
+            c[0] += inc[0];
+            c[1] += inc[1];
+            c[2] += inc[2];
+            c[3] += inc[3];
+            c[4] += inc[4];
+            vin = in[j];
+            for (k=0; k<self->stages; k++) {
+                vout = c[0] * vin + c[1] * self->x1[k] + c[2] * self->x2[k] - c[3] * self->y1[k] - c[4] * self->y2[k];
+                self->x2[k] = self->x1[k];
+                self->x1[k] = vin;
+                self->y2[k] = self->y1[k];
+                self->y1[k] = vin = vout;
+            }
+            self->data[j] = vout;
+        }
+    }
+}
+
 static void Biquadx_postprocessing_ii(Biquadx *self) { POST_PROCESSING_II };
 static void Biquadx_postprocessing_ai(Biquadx *self) { POST_PROCESSING_AI };
 static void Biquadx_postprocessing_ia(Biquadx *self) { POST_PROCESSING_IA };
@@ -885,6 +1029,13 @@ Biquadx_setProcMode(Biquadx *self)
             self->proc_func_ptr = Biquadx_filters_aa;
             break;
     }
+    if (self->ramp.period > 0 && procmode != 0) {
+        self->proc_func_ptr = Biquadx_filters_ctl;
+    }
+    else {
+        self->ramp.ready = 0;
+    }
+
 	switch (muladdmode) {
         case 0:
             self->muladd_func_ptr = Biquadx_postprocessing_ii;
@@ -985,6 +1136,7 @@ Biquadx_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     Stream_setFunctionPtr(self->stream, Biquadx_compute_next_data_frame);
     self->mode_func_ptr = Biquadx_setProcMode;
+    CtlRamp_init(&self->ramp, 5);
 
     static char *kwlist[] = {"input", "freq", "q", "type", "stages", "mul", "add", NULL};
 
@@ -1111,6 +1263,9 @@ Biquadx_setType(Biquadx *self, PyObject *arg)
 		self->filtertype = PyInt_AsLong(arg);
 	}
 
+    /* Same parameters, other coefficients. */
+    self->ramp.ready = 0;
+
     (*self->mode_func_ptr)(self);
 
 	Py_INCREF(Py_None);
@@ -1133,6 +1288,20 @@ Biquadx_setStages(Biquadx *self, PyObject *arg)
 	return Py_None;
 }
 
+static PyObject *
+Biquadx_setCtlPeriod(Biquadx *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+    if (PyNumber_Check(arg)) {
+        CtlRamp_setPeriod(&self->ramp, PyInt_AsLong(arg));
+        (*self->mode_func_ptr)(self);
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyMemberDef Biquadx_members[] = {
     {"server", T_OBJECT_EX, offsetof(Biquadx, server), 0, "Pyo server."},
     {"stream", T_OBJECT_EX, offsetof(Biquadx, stream), 0, "Stream object."},
@@ -1151,6 +1320,7 @@ static PyMethodDef Biquadx_methods[] = {
     {"out", (PyCFunction)Biquadx_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
     {"stop", (PyCFunction)Biquadx_stop, METH_NOARGS, "Stops computing."},
 	{"setFreq", (PyCFunction)Biquadx_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
+	{"setCtlPeriod", (PyCFunction)Biquadx_setCtlPeriod, METH_O, "Sets the number of samples between two coefficient computations."},
     {"setQ", (PyCFunction)Biquadx_setQ, METH_O, "Sets filter Q factor."},
     {"setType", (PyCFunction)Biquadx_setType, METH_O, "Sets filter type factor."},
     {"setStages", (PyCFunction)Biquadx_setStages, METH_O, "Sets the number of filtering stages."},
@@ -1203,46 +1373,841 @@ static PyNumberMethods Biquadx_as_number = {
     0,                                              /* nb_index */
 };
 
-PyTypeObject BiquadxType = {
+PyTypeObject BiquadxType = {
+    PyObject_HEAD_INIT(NULL)
+    0,                                              /*ob_size*/
+    "_pyo.Biquadx_base",                                   /*tp_name*/
+    sizeof(Biquadx),                                 /*tp_basicsize*/
+    0,                                              /*tp_itemsize*/
+    (destructor)Biquadx_dealloc,                     /*tp_dealloc*/
+    0,                                              /*tp_print*/
+    0,                                              /*tp_getattr*/
+    0,                                              /*tp_setattr*/
+    0,                                              /*tp_compare*/
+    0,                                              /*tp_repr*/
+    &Biquadx_as_number,                              /*tp_as_number*/
+    0,                                              /*tp_as_sequence*/
+    0,                                              /*tp_as_mapping*/
+    0,                                              /*tp_hash */
+    0,                                              /*tp_call*/
+    0,                                              /*tp_str*/
+    0,                                              /*tp_getattro*/
+    0,                                              /*tp_setattro*/
+    0,                                              /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_CHECKTYPES, /*tp_flags*/
+    "Biquadx objects. Generates a biquadratic filter.",           /* tp_doc */
+    (traverseproc)Biquadx_traverse,                  /* tp_traverse */
+    (inquiry)Biquadx_clear,                          /* tp_clear */
+    0,                                              /* tp_richcompare */
+    0,                                              /* tp_weaklistoffset */
+    0,                                              /* tp_iter */
+    0,                                              /* tp_iternext */
+    Biquadx_methods,                                 /* tp_methods */
+    Biquadx_members,                                 /* tp_members */
+    0,                                              /* tp_getset */
+    0,                                              /* tp_base */
+    0,                                              /* tp_dict */
+    0,                                              /* tp_descr_get */
+    0,                                              /* tp_descr_set */
+    0,                                              /* tp_dictoffset */
+    0,                          /* tp_init */
+    0,                                              /* tp_alloc */
+    Biquadx_new,                                     /* tp_new */
+};
+
+/*** Bank of biquad filters processed in parallel ***/
+typedef struct {
+    pyo_audio_HEAD
+    PyObject *input; /* list of PyoObjects, one per filter */
+    PyObject *input_streams; /* the lists read by the audio thread, published with Server_swapPointer */
+    PyObject *freq; /* list of floats and PyoObjects */
+    PyObject *freq_streams; /* Stream of every PyoObject in freq, the floats as they are */
+    PyObject *q;
+    PyObject *q_streams;
+    int *types;
+    int count; /* filters */
+    int groups;
+    int init;
+    int ready;
+    int kernel;
+    bqbank_kernel_func kernel_func;
+    MYFLT nyquist;
+    MYFLT twoPiOverSr;
+    BqBankGroup *bank;
+    MYFLT *params; /* freq, q and type of the last coefficients, per filter */
+    MYFLT *targets; /* last coefficients, per filter */
+    MYFLT *frames; /* interleaved inputs of one group */
+    MYFLT *buffer_streams; /* interleaved outputs, one block of bufsize frames per group */
+} BiquadBankMain;
+
+/* Same formulas as the Biquad coefficients, normalized by a0. */
+static void
+BiquadBankMain_compute_coeffs(BiquadBankMain *self, MYFLT freq, MYFLT q, int type, MYFLT *coeffs)
+{
+    MYFLT w0, c, alpha, a0, b0, b1, b2, a1, a2;
+
+    if (freq <= 1)
+        freq = 1;
+    else if (freq >= self->nyquist)
+        freq = self->nyquist;
+    if (q < 0.1)
+        q = 0.1;
+
+    w0 = freq * self->twoPiOverSr;
+    c = MYCOS(w0);
+    alpha = MYSIN(w0) / (2 * q);
+    a0 = 1.0 / (1 + alpha);
+    a1 = -2 * c;
+    a2 = 1 - alpha;
+
+    switch (type) {
+        case 1: /* highpass */
+            b0 = b2 = (1 + c) / 2;
+            b1 = -(1 + c);
+            break;
+        case 2: /* bandpass */
+            b0 = alpha;
+            b1 = 0;
+            b2 = -alpha;
+            break;
+        case 3: /* bandstop */
+            b0 = b2 = 1;
+            b1 = -2 * c;
+            break;
+        case 4: /* allpass */
+            b0 = 1 - alpha;
+            b1 = -2 * c;
+            b2 = 1 + alpha;
+            break;
+        default: /* lowpass */
+            b0 = b2 = (1 - c) / 2;
+            b1 = 1 - c;
+            break;
+    }
+
+    coeffs[0] = b0 * a0;
+    coeffs[1] = b1 * a0;
+    coeffs[2] = b2 * a0;
+    coeffs[3] = a1 * a0;
+    coeffs[4] = a2 * a0;
+}
+
+/* Coefficients reached at the end of the buffer, computed from the parameters
+** of the last sample and only for the filters whose parameters changed. The
+** kernels ramp linearly toward them. */
+static void
+BiquadBankMain_update_coeffs(BiquadBankMain *self)
+{
+    int i, j, k;
+    MYFLT fr, q, target[5];
+    MYFLT *params, *last;
+    PyObject *stream, *freqs = self->freq_streams, *qs = self->q_streams;
+    BqBankGroup *group;
+
+    for (i=0; i<self->count; i++) {
+        group = &self->bank[i / BQBANK_LANES];
+        k = i % BQBANK_LANES;
+        params = self->params + i * 3;
+        last = self->targets + i * 5;
+
+        stream = PyList_GET_ITEM(freqs, i);
+        if (PyFloat_Check(stream))
+            fr = PyFloat_AS_DOUBLE(stream);
+        else
+            fr = Stream_getData((Stream *)stream)[self->bufsize-1];
+        stream = PyList_GET_ITEM(qs, i);
+        if (PyFloat_Check(stream))
+            q = PyFloat_AS_DOUBLE(stream);
+        else
+            q = Stream_getData((Stream *)stream)[self->bufsize-1];
+
+        if (self->ready && fr == params[0] && q == params[1] && self->types[i] == params[2]) {
+            for (j=0; j<5; j++) {
+                group->coeffs[j][k] = last[j];
+                group->incs[j][k] = 0.0;
+            }
+            continue;
+        }
+
+        BiquadBankMain_compute_coeffs(self, fr, q, self->types[i], target);
+        /* A new type jumps, the coefficients between two types are meaningless. */
+        if (self->ready && self->types[i] == params[2]) {
+            for (j=0; j<5; j++) {
+                group->coeffs[j][k] = last[j];
+                group->incs[j][k] = (target[j] - last[j]) / self->bufsize;
+            }
+        }
+        else {
+            for (j=0; j<5; j++) {
+                group->coeffs[j][k] = target[j];
+                group->incs[j][k] = 0.0;
+            }
+        }
+        for (j=0; j<5; j++)
+            last[j] = target[j];
+        params[0] = fr;
+        params[1] = q;
+        params[2] = self->types[i];
+    }
+    self->ready = 1;
+}
+
+static void
+BiquadBankMain_filters(BiquadBankMain *self) {
+    int i, j, k, lanes, shared;
+    MYFLT *in;
+    PyObject *stream, *inputs = self->input_streams;
+    BqBankGroup *group;
+
+    BiquadBankMain_update_coeffs(self);
+
+    for (i=0; i<self->groups; i++) {
+        group = &self->bank[i];
+        lanes = self->count - i * BQBANK_LANES;
+        if (lanes > BQBANK_LANES)
+            lanes = BQBANK_LANES;
+
+        /* A group filtering a single signal reads it directly. */
+        stream = PyList_GET_ITEM(inputs, i * BQBANK_LANES);
+        shared = 1;
+        for (k=1; k<lanes; k++) {
+            if (PyList_GET_ITEM(inputs, i * BQBANK_LANES + k) != stream)
+                shared = 0;
+        }
+
+        for (k=0; k<lanes; k++) {
+            in = Stream_getData((Stream *)PyList_GET_ITEM(inputs, i * BQBANK_LANES + k));
+            if (self->init == 1)
+                group->x1[k] = group->x2[k] = group->y1[k] = group->y2[k] = in[0];
+            if (shared == 0) {
+                for (j=0; j<self->bufsize; j++)
+                    self->frames[j * BQBANK_LANES + k] = in[j];
+            }
+        }
+
+        if (shared)
+            in = Stream_getData((Stream *)stream);
+        else
+            in = self->frames;
+        (*self->kernel_func)(group, in, shared, self->buffer_streams + i * self->bufsize * BQBANK_LANES, self->bufsize);
+    }
+    self->init = 0;
+}
+
+MYFLT *
+BiquadBankMain_getSamplesBuffer(BiquadBankMain *self)
+{
+    PYO_GRAPH_READ(self->stream);
+    return (MYFLT *)self->buffer_streams;
+}
+
+static void
+BiquadBankMain_setProcMode(BiquadBankMain *self)
+{
+    self->proc_func_ptr = BiquadBankMain_filters;
+}
+
+static void
+BiquadBankMain_compute_next_data_frame(BiquadBankMain *self)
+{
+    (*self->proc_func_ptr)(self);
+}
+
+static int
+BiquadBankMain_traverse(BiquadBankMain *self, visitproc visit, void *arg)
+{
+    pyo_VISIT
+    Py_VISIT(self->input);
+    Py_VISIT(self->input_streams);
+    Py_VISIT(self->freq);
+    Py_VISIT(self->freq_streams);
+    Py_VISIT(self->q);
+    Py_VISIT(self->q_streams);
+    return 0;
+}
+
+static int
+BiquadBankMain_clear(BiquadBankMain *self)
+{
+    pyo_CLEAR
+    Py_CLEAR(self->input);
+    Py_CLEAR(self->input_streams);
+    Py_CLEAR(self->freq);
+    Py_CLEAR(self->freq_streams);
+    Py_CLEAR(self->q);
+    Py_CLEAR(self->q_streams);
+    return 0;
+}
+
+static void
+BiquadBankMain_dealloc(BiquadBankMain* self)
+{
+    pyo_DEALLOC
+    free(self->types);
+    free(self->bank);
+    free(self->params);
+    free(self->targets);
+    free(self->frames);
+    free(self->buffer_streams);
+    BiquadBankMain_clear(self);
+    self->ob_type->tp_free((PyObject*)self);
+}
+
+/* Returns a new list of count items, the streams of the PyoObjects and the
+** numbers, which are converted to floats in place. */
+static PyObject *
+BiquadBankMain_getStreams(BiquadBankMain *self, PyObject *list, const char *name)
+{
+    int i;
+    PyObject *item, *streams;
+
+    if (! PyList_Check(list) || PyList_Size(list) != self->count) {
+        PyErr_Format(PyExc_TypeError, "BiquadBank: %s must be a list of %d values.", name, self->count);
+        return NULL;
+    }
+
+    streams = PyList_New(self->count);
+    for (i=0; i<self->count; i++) {
+        item = PyList_GET_ITEM(list, i);
+        if (PyNumber_Check(item)) {
+            PyList_SetItem(list, i, PyNumber_Float(item));
+            item = PyList_GET_ITEM(list, i);
+            Py_INCREF(item);
+            PyList_SET_ITEM(streams, i, item);
+        }
+        else if (PyObject_HasAttrString(item, "_getStream")) {
+            PyList_SET_ITEM(streams, i, PyObject_CallMethod(item, "_getStream", NULL));
+        }
+        else {
+            Py_DECREF(streams);
+            PyErr_Format(PyExc_TypeError, "BiquadBank: %s items must be numbers or PyoObjects.", name);
+            return NULL;
+        }
+    }
+    return streams;
+}
+
+static PyObject *
+BiquadBankMain_setInput(BiquadBankMain *self, PyObject *arg)
+{
+    int i;
+    PyObject *tmp, *streamstmp;
+
+    ASSERT_ARG_NOT_NULL
+
+    tmp = PySequence_List(arg);
+    if (tmp == NULL)
+        return NULL;
+    streamstmp = BiquadBankMain_getStreams(self, tmp, "input");
+    if (streamstmp == NULL) {
+        Py_DECREF(tmp);
+        return NULL;
+    }
+    for (i=0; i<self->count; i++) {
+        if (PyFloat_Check(PyList_GET_ITEM(streamstmp, i))) {
+            Py_DECREF(tmp);
+            Py_DECREF(streamstmp);
+            PyErr_SetString(PyExc_TypeError, "BiquadBank: input items must be PyoObjects.");
+            return NULL;
+        }
+    }
+
+    Py_XDECREF(self->input);
+    self->input = tmp;
+    streamstmp = (PyObject *)Server_swapPointer((Server *)self->server, (void **)&self->input_streams, streamstmp);
+    Py_XDECREF(streamstmp);
+    PyoGraph_resetAccesses(self->stream);
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+static PyObject *
+BiquadBankMain_setFreq(BiquadBankMain *self, PyObject *arg)
+{
+    PyObject *tmp, *streamstmp;
+
+    ASSERT_ARG_NOT_NULL
+
+    tmp = PySequence_List(arg);
+    if (tmp == NULL)
+        return NULL;
+    streamstmp = BiquadBankMain_getStreams(self, tmp, "freq");
+    if (streamstmp == NULL) {
+        Py_DECREF(tmp);
+        return NULL;
+    }
+
+    Py_XDECREF(self->freq);
+    self->freq = tmp;
+    streamstmp = (PyObject *)Server_swapPointer((Server *)self->server, (void **)&self->freq_streams, streamstmp);
+    Py_XDECREF(streamstmp);
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+static PyObject *
+BiquadBankMain_setQ(BiquadBankMain *self, PyObject *arg)
+{
+    PyObject *tmp, *streamstmp;
+
+    ASSERT_ARG_NOT_NULL
+
+    tmp = PySequence_List(arg);
+    if (tmp == NULL)
+        return NULL;
+    streamstmp = BiquadBankMain_getStreams(self, tmp, "q");
+    if (streamstmp == NULL) {
+        Py_DECREF(tmp);
+        return NULL;
+    }
+
+    Py_XDECREF(self->q);
+    self->q = tmp;
+    streamstmp = (PyObject *)Server_swapPointer((Server *)self->server, (void **)&self->q_streams, streamstmp);
+    Py_XDECREF(streamstmp);
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+static PyObject *
+BiquadBankMain_setType(BiquadBankMain *self, PyObject *arg)
+{
+    int i;
+
+    ASSERT_ARG_NOT_NULL
+
+    if (! PyList_Check(arg) || PyList_Size(arg) != self->count) {
+        PyErr_Format(PyExc_TypeError, "BiquadBank: type must be a list of %d values.", self->count);
+        return NULL;
+    }
+
+    for (i=0; i<self->count; i++) {
+        self->types[i] = PyInt_AsLong(PyList_GET_ITEM(arg, i));
+    }
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+static PyObject *
+BiquadBankMain_setKernel(BiquadBankMain *self, PyObject *arg)
+{
+    int kernel;
+
+    ASSERT_ARG_NOT_NULL
+
+    kernel = PyInt_AsLong(arg);
+    if (kernel == -1 && PyErr_Occurred())
+        return NULL;
+    if (!bqbank_kernel_available(kernel)) {
+        PyErr_Format(PyExc_ValueError, "BiquadBank: kernel '%s' is not supported by this cpu.", bqbank_kernel_name(kernel));
+        return NULL;
+    }
+    self->kernel = bqbank_kernel_resolve(kernel);
+    self->kernel_func = bqbank_get_kernel(self->kernel);
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+static PyObject * BiquadBankMain_getKernel(BiquadBankMain *self) { return PyString_FromString(bqbank_kernel_name(self->kernel)); }
+
+static PyObject *
+BiquadBankMain_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i;
+    PyObject *inputtmp, *freqtmp, *qtmp, *typetmp, *ret;
+    BiquadBankMain *self;
+    self = (BiquadBankMain *)type->tp_alloc(type, 0);
+
+    self->init = 1;
+    self->ready = 0;
+
+    INIT_OBJECT_COMMON
+    Stream_setFunctionPtr(self->stream, BiquadBankMain_compute_next_data_frame);
+    self->mode_func_ptr = BiquadBankMain_setProcMode;
+
+    self->nyquist = (MYFLT)self->sr * 0.49;
+    self->twoPiOverSr = TWOPI / (MYFLT)self->sr;
+    self->kernel = bqbank_kernel_resolve(BQBANK_KERNEL_AUTO);
+    self->kernel_func = bqbank_get_kernel(self->kernel);
+
+    static char *kwlist[] = {"input", "freq", "q", "type", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "O!O!O!O!", kwlist, &PyList_Type, &inputtmp, &PyList_Type, &freqtmp,
+                                      &PyList_Type, &qtmp, &PyList_Type, &typetmp))
+        Py_RETURN_NONE;
+
+    self->count = PyList_Size(inputtmp);
+    if (self->count < 1) {
+        PyErr_SetString(PyExc_TypeError, "BiquadBank: at least one filter is needed.");
+        Py_RETURN_NONE;
+    }
+    self->groups = (self->count + BQBANK_LANES - 1) / BQBANK_LANES;
+
+    self->types = (int *)calloc(self->count, sizeof(int));
+    self->bank = (BqBankGroup *)calloc(self->groups, sizeof(BqBankGroup));
+    self->params = (MYFLT *)calloc(self->count * 3, sizeof(MYFLT));
+    self->targets = (MYFLT *)calloc(self->count * 5, sizeof(MYFLT));
+    /* The unused lanes of the last group stay at 0. */
+    self->frames = (MYFLT *)calloc(self->bufsize * BQBANK_LANES, sizeof(MYFLT));
+    self->buffer_streams = (MYFLT *)calloc(self->groups * self->bufsize * BQBANK_LANES, sizeof(MYFLT));
+
+    ret = PyObject_CallMethod((PyObject *)self, "setInput", "O", inputtmp);
+    if (ret == NULL)
+        Py_RETURN_NONE;
+    Py_DECREF(ret);
+    ret = PyObject_CallMethod((PyObject *)self, "setFreq", "O", freqtmp);
+    if (ret == NULL)
+        Py_RETURN_NONE;
+    Py_DECREF(ret);
+    ret = PyObject_CallMethod((PyObject *)self, "setQ", "O", qtmp);
+    if (ret == NULL)
+        Py_RETURN_NONE;
+    Py_DECREF(ret);
+    ret = PyObject_CallMethod((PyObject *)self, "setType", "O", typetmp);
+    if (ret == NULL)
+        Py_RETURN_NONE;
+    Py_DECREF(ret);
+
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+
+    (*self->mode_func_ptr)(self);
+
+    return (PyObject *)self;
+}
+
+static PyObject * BiquadBankMain_getServer(BiquadBankMain* self) { GET_SERVER };
+static PyObject * BiquadBankMain_getStream(BiquadBankMain* self) { GET_STREAM };
+
+static PyObject * BiquadBankMain_play(BiquadBankMain *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * BiquadBankMain_stop(BiquadBankMain *self) { STOP };
+
+static PyMemberDef BiquadBankMain_members[] = {
+    {"server", T_OBJECT_EX, offsetof(BiquadBankMain, server), 0, "Pyo server."},
+    {"stream", T_OBJECT_EX, offsetof(BiquadBankMain, stream), 0, "Stream object."},
+    {"input", T_OBJECT_EX, offsetof(BiquadBankMain, input), 0, "Input sound objects."},
+    {"freq", T_OBJECT_EX, offsetof(BiquadBankMain, freq), 0, "Cutoff or center frequencies."},
+    {"q", T_OBJECT_EX, offsetof(BiquadBankMain, q), 0, "Q factors."},
+    {NULL}  /* Sentinel */
+};
+
+static PyMethodDef BiquadBankMain_methods[] = {
+    {"getServer", (PyCFunction)BiquadBankMain_getServer, METH_NOARGS, "Returns server object."},
+    {"_getStream", (PyCFunction)BiquadBankMain_getStream, METH_NOARGS, "Returns stream object."},
+    {"play", (PyCFunction)BiquadBankMain_play, METH_VARARGS|METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+    {"stop", (PyCFunction)BiquadBankMain_stop, METH_NOARGS, "Stops computing."},
+    {"setInput", (PyCFunction)BiquadBankMain_setInput, METH_O, "Sets the input of every filter."},
+    {"setFreq", (PyCFunction)BiquadBankMain_setFreq, METH_O, "Sets the frequency of every filter."},
+    {"setQ", (PyCFunction)BiquadBankMain_setQ, METH_O, "Sets the Q of every filter."},
+    {"setType", (PyCFunction)BiquadBankMain_setType, METH_O, "Sets the type of every filter."},
+    {"setKernel", (PyCFunction)BiquadBankMain_setKernel, METH_O, "Sets the computation kernel (0 = auto, 1 = scalar, 2 = vector, 3 = avx)."},
+    {"getKernel", (PyCFunction)BiquadBankMain_getKernel, METH_NOARGS, "Returns the name of the computation kernel."},
+    {NULL}  /* Sentinel */
+};
+
+PyTypeObject BiquadBankMainType = {
+    PyObject_HEAD_INIT(NULL)
+    0,                                              /*ob_size*/
+    "_pyo.BiquadBankMain_base",                                   /*tp_name*/
+    sizeof(BiquadBankMain),                                 /*tp_basicsize*/
+    0,                                              /*tp_itemsize*/
+    (destructor)BiquadBankMain_dealloc,                     /*tp_dealloc*/
+    0,                                              /*tp_print*/
+    0,                                              /*tp_getattr*/
+    0,                                              /*tp_setattr*/
+    0,                                              /*tp_compare*/
+    0,                                              /*tp_repr*/
+    0,                              /*tp_as_number*/
+    0,                                              /*tp_as_sequence*/
+    0,                                              /*tp_as_mapping*/
+    0,                                              /*tp_hash */
+    0,                                              /*tp_call*/
+    0,                                              /*tp_str*/
+    0,                                              /*tp_getattro*/
+    0,                                              /*tp_setattro*/
+    0,                                              /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_CHECKTYPES, /*tp_flags*/
+    "BiquadBankMain objects. Bank of biquadratic filters processed in parallel.",           /* tp_doc */
+    (traverseproc)BiquadBankMain_traverse,                  /* tp_traverse */
+    (inquiry)BiquadBankMain_clear,                          /* tp_clear */
+    0,                                              /* tp_richcompare */
+    0,                                              /* tp_weaklistoffset */
+    0,                                              /* tp_iter */
+    0,                                              /* tp_iternext */
+    BiquadBankMain_methods,                                 /* tp_methods */
+    BiquadBankMain_members,                                 /* tp_members */
+    0,                                              /* tp_getset */
+    0,                                              /* tp_base */
+    0,                                              /* tp_dict */
+    0,                                              /* tp_descr_get */
+    0,                                              /* tp_descr_set */
+    0,                                              /* tp_dictoffset */
+    0,                          /* tp_init */
+    0,                                              /* tp_alloc */
+    BiquadBankMain_new,                                     /* tp_new */
+};
+
+/************************************************************************************************/
+/* BiquadBank streamer object */
+/************************************************************************************************/
+typedef struct {
+    pyo_audio_HEAD
+    BiquadBankMain *mainBank;
+    int modebuffer[2];
+    int chnl;
+} BiquadBank;
+
+static void BiquadBank_postprocessing_ii(BiquadBank *self) { POST_PROCESSING_II };
+static void BiquadBank_postprocessing_ai(BiquadBank *self) { POST_PROCESSING_AI };
+static void BiquadBank_postprocessing_ia(BiquadBank *self) { POST_PROCESSING_IA };
+static void BiquadBank_postprocessing_aa(BiquadBank *self) { POST_PROCESSING_AA };
+static void BiquadBank_postprocessing_ireva(BiquadBank *self) { POST_PROCESSING_IREVA };
+static void BiquadBank_postprocessing_areva(BiquadBank *self) { POST_PROCESSING_AREVA };
+static void BiquadBank_postprocessing_revai(BiquadBank *self) { POST_PROCESSING_REVAI };
+static void BiquadBank_postprocessing_revaa(BiquadBank *self) { POST_PROCESSING_REVAA };
+static void BiquadBank_postprocessing_revareva(BiquadBank *self) { POST_PROCESSING_REVAREVA };
+
+static void
+BiquadBank_setProcMode(BiquadBank *self)
+{
+    int muladdmode;
+    muladdmode = self->modebuffer[0] + self->modebuffer[1] * 10;
+
+	switch (muladdmode) {
+        case 0:
+            self->muladd_func_ptr = BiquadBank_postprocessing_ii;
+            break;
+        case 1:
+            self->muladd_func_ptr = BiquadBank_postprocessing_ai;
+            break;
+        case 2:
+            self->muladd_func_ptr = BiquadBank_postprocessing_revai;
+            break;
+        case 10:
+            self->muladd_func_ptr = BiquadBank_postprocessing_ia;
+            break;
+        case 11:
+            self->muladd_func_ptr = BiquadBank_postprocessing_aa;
+            break;
+        case 12:
+            self->muladd_func_ptr = BiquadBank_postprocessing_revaa;
+            break;
+        case 20:
+            self->muladd_func_ptr = BiquadBank_postprocessing_ireva;
+            break;
+        case 21:
+            self->muladd_func_ptr = BiquadBank_postprocessing_areva;
+            break;
+        case 22:
+            self->muladd_func_ptr = BiquadBank_postprocessing_revareva;
+            break;
+    }
+}
+
+static void
+BiquadBank_compute_next_data_frame(BiquadBank *self)
+{
+    int i;
+    MYFLT *tmp;
+    int offset = (self->chnl / BQBANK_LANES) * self->bufsize * BQBANK_LANES + self->chnl % BQBANK_LANES;
+    tmp = BiquadBankMain_getSamplesBuffer((BiquadBankMain *)self->mainBank);
+    for (i=0; i<self->bufsize; i++) {
+        self->data[i] = tmp[i * BQBANK_LANES + offset];
+    }
+    (*self->muladd_func_ptr)(self);
+}
+
+static int
+BiquadBank_traverse(BiquadBank *self, visitproc visit, void *arg)
+{
+    pyo_VISIT
+    Py_VISIT(self->mainBank);
+    return 0;
+}
+
+static int
+BiquadBank_clear(BiquadBank *self)
+{
+    pyo_CLEAR
+    Py_CLEAR(self->mainBank);
+    return 0;
+}
+
+static void
+BiquadBank_dealloc(BiquadBank* self)
+{
+    pyo_DEALLOC
+    BiquadBank_clear(self);
+    self->ob_type->tp_free((PyObject*)self);
+}
+
+static PyObject *
+BiquadBank_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i;
+    PyObject *maintmp=NULL, *multmp=NULL, *addtmp=NULL;
+    BiquadBank *self;
+    self = (BiquadBank *)type->tp_alloc(type, 0);
+
+    self->chnl = 0;
+	self->modebuffer[0] = 0;
+	self->modebuffer[1] = 0;
+
+    INIT_OBJECT_COMMON
+    Stream_setFunctionPtr(self->stream, BiquadBank_compute_next_data_frame);
+    self->mode_func_ptr = BiquadBank_setProcMode;
+
+    static char *kwlist[] = {"mainBank", "chnl", "mul", "add", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|iOO", kwlist, &maintmp, &self->chnl, &multmp, &addtmp))
+        Py_RETURN_NONE;
+
+    Py_XDECREF(self->mainBank);
+    Py_INCREF(maintmp);
+    self->mainBank = (BiquadBankMain *)maintmp;
+
+    if (multmp) {
+        PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
+    }
+
+    if (addtmp) {
+        PyObject_CallMethod((PyObject *)self, "setAdd", "O", addtmp);
+    }
+
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+
+    (*self->mode_func_ptr)(self);
+
+    return (PyObject *)self;
+}
+
+static PyObject * BiquadBank_getServer(BiquadBank* self) { GET_SERVER };
+static PyObject * BiquadBank_getStream(BiquadBank* self) { GET_STREAM };
+static PyObject * BiquadBank_setMul(BiquadBank *self, PyObject *arg) { SET_MUL };
+static PyObject * BiquadBank_setAdd(BiquadBank *self, PyObject *arg) { SET_ADD };
+static PyObject * BiquadBank_setSub(BiquadBank *self, PyObject *arg) { SET_SUB };
+static PyObject * BiquadBank_setDiv(BiquadBank *self, PyObject *arg) { SET_DIV };
+
+static PyObject * BiquadBank_play(BiquadBank *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * BiquadBank_out(BiquadBank *self, PyObject *args, PyObject *kwds) { OUT };
+static PyObject * BiquadBank_stop(BiquadBank *self) { STOP };
+
+static PyObject * BiquadBank_multiply(BiquadBank *self, PyObject *arg) { MULTIPLY };
+static PyObject * BiquadBank_inplace_multiply(BiquadBank *self, PyObject *arg) { INPLACE_MULTIPLY };
+static PyObject * BiquadBank_add(BiquadBank *self, PyObject *arg) { ADD };
+static PyObject * BiquadBank_inplace_add(BiquadBank *self, PyObject *arg) { INPLACE_ADD };
+static PyObject * BiquadBank_sub(BiquadBank *self, PyObject *arg) { SUB };
+static PyObject * BiquadBank_inplace_sub(BiquadBank *self, PyObject *arg) { INPLACE_SUB };
+static PyObject * BiquadBank_div(BiquadBank *self, PyObject *arg) { DIV };
+static PyObject * BiquadBank_inplace_div(BiquadBank *self, PyObject *arg) { INPLACE_DIV };
+
+static PyMemberDef BiquadBank_members[] = {
+    {"server", T_OBJECT_EX, offsetof(BiquadBank, server), 0, "Pyo server."},
+    {"stream", T_OBJECT_EX, offsetof(BiquadBank, stream), 0, "Stream object."},
+    {"mul", T_OBJECT_EX, offsetof(BiquadBank, mul), 0, "Mul factor."},
+    {"add", T_OBJECT_EX, offsetof(BiquadBank, add), 0, "Add factor."},
+    {NULL}  /* Sentinel */
+};
+
+static PyMethodDef BiquadBank_methods[] = {
+    {"getServer", (PyCFunction)BiquadBank_getServer, METH_NOARGS, "Returns server object."},
+    {"_getStream", (PyCFunction)BiquadBank_getStream, METH_NOARGS, "Returns stream object."},
+    {"play", (PyCFunction)BiquadBank_play, METH_VARARGS|METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+    {"out", (PyCFunction)BiquadBank_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
+    {"stop", (PyCFunction)BiquadBank_stop, METH_NOARGS, "Stops computing."},
+    {"setMul", (PyCFunction)BiquadBank_setMul, METH_O, "Sets BiquadBank mul factor."},
+    {"setAdd", (PyCFunction)BiquadBank_setAdd, METH_O, "Sets BiquadBank add factor."},
+    {"setSub", (PyCFunction)BiquadBank_setSub, METH_O, "Sets inverse add factor."},
+    {"setDiv", (PyCFunction)BiquadBank_setDiv, METH_O, "Sets inverse mul factor."},
+    {NULL}  /* Sentinel */
+};
+
+static PyNumberMethods BiquadBank_as_number = {
+    (binaryfunc)BiquadBank_add,                      /*nb_add*/
+    (binaryfunc)BiquadBank_sub,                 /*nb_subtract*/
+    (binaryfunc)BiquadBank_multiply,                 /*nb_multiply*/
+    (binaryfunc)BiquadBank_div,                   /*nb_divide*/
+    0,                /*nb_remainder*/
+    0,                   /*nb_divmod*/
+    0,                   /*nb_power*/
+    0,                  /*nb_neg*/
+    0,                /*nb_pos*/
+    0,                  /*(unaryfunc)array_abs,*/
+    0,                    /*nb_nonzero*/
+    0,                    /*nb_invert*/
+    0,               /*nb_lshift*/
+    0,              /*nb_rshift*/
+    0,              /*nb_and*/
+    0,              /*nb_xor*/
+    0,               /*nb_or*/
+    0,                                          /*nb_coerce*/
+    0,                       /*nb_int*/
+    0,                      /*nb_long*/
+    0,                     /*nb_float*/
+    0,                       /*nb_oct*/
+    0,                       /*nb_hex*/
+    (binaryfunc)BiquadBank_inplace_add,              /*inplace_add*/
+    (binaryfunc)BiquadBank_inplace_sub,         /*inplace_subtract*/
+    (binaryfunc)BiquadBank_inplace_multiply,         /*inplace_multiply*/
+    (binaryfunc)BiquadBank_inplace_div,           /*inplace_divide*/
+    0,        /*inplace_remainder*/
+    0,           /*inplace_power*/
+    0,       /*inplace_lshift*/
+    0,      /*inplace_rshift*/
+    0,      /*inplace_and*/
+    0,      /*inplace_xor*/
+    0,       /*inplace_or*/
+    0,             /*nb_floor_divide*/
+    0,              /*nb_true_divide*/
+    0,     /*nb_inplace_floor_divide*/
+    0,      /*nb_inplace_true_divide*/
+    0,                     /* nb_index */
+};
+
+PyTypeObject BiquadBankType = {
     PyObject_HEAD_INIT(NULL)
-    0,                                              /*ob_size*/
-    "_pyo.Biquadx_base",                                   /*tp_name*/
-    sizeof(Biquadx),                                 /*tp_basicsize*/
-    0,                                              /*tp_itemsize*/
-    (destructor)Biquadx_dealloc,                     /*tp_dealloc*/
-    0,                                              /*tp_print*/
-    0,                                              /*tp_getattr*/
-    0,                                              /*tp_setattr*/
-    0,                                              /*tp_compare*/
-    0,                                              /*tp_repr*/
-    &Biquadx_as_number,                              /*tp_as_number*/
-    0,                                              /*tp_as_sequence*/
-    0,                                              /*tp_as_mapping*/
-    0,                                              /*tp_hash */
-    0,                                              /*tp_call*/
-    0,                                              /*tp_str*/
-    0,                                              /*tp_getattro*/
-    0,                                              /*tp_setattro*/
-    0,                                              /*tp_as_buffer*/
-    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_CHECKTYPES, /*tp_flags*/
-    "Biquadx objects. Generates a biquadratic filter.",           /* tp_doc */
-    (traverseproc)Biquadx_traverse,                  /* tp_traverse */
-    (inquiry)Biquadx_clear,                          /* tp_clear */
-    0,                                              /* tp_richcompare */
-    0,                                              /* tp_weaklistoffset */
-    0,                                              /* tp_iter */
-    0,                                              /* tp_iternext */
-    Biquadx_methods,                                 /* tp_methods */
-    Biquadx_members,                                 /* tp_members */
-    0,                                              /* tp_getset */
-    0,                                              /* tp_base */
-    0,                                              /* tp_dict */
-    0,                                              /* tp_descr_get */
-    0,                                              /* tp_descr_set */
-    0,                                              /* tp_dictoffset */
-    0,                          /* tp_init */
-    0,                                              /* tp_alloc */
-    Biquadx_new,                                     /* tp_new */
+    0,                         /*ob_size*/
+    "_pyo.BiquadBank_base",         /*tp_name*/
+    sizeof(BiquadBank),         /*tp_basicsize*/
+    0,                         /*tp_itemsize*/
+    (destructor)BiquadBank_dealloc, /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    &BiquadBank_as_number,             /*tp_as_number*/
+    0,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    0,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_CHECKTYPES,  /*tp_flags*/
+    "BiquadBank objects. Reads one filter output from a BiquadBankMain object.",           /* tp_doc */
+    (traverseproc)BiquadBank_traverse,   /* tp_traverse */
+    (inquiry)BiquadBank_clear,           /* tp_clear */
+    0,		               /* tp_richcompare */
+    0,		               /* tp_weaklistoffset */
+    0,		               /* tp_iter */
+    0,		               /* tp_iternext */
+    BiquadBank_methods,             /* tp_methods */
+    BiquadBank_members,             /* tp_members */
+    0,                      /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,      /* tp_init */
+    0,                         /* tp_alloc */
+    BiquadBank_new,                 /* tp_new */
 };
 
 /*** Biquad filter with direct coefficient control ***/
@@ -1690,6 +2655,7 @@ typedef struct {
     MYFLT a0;
     MYFLT a1;
     MYFLT a2;
+    CtlRamp ramp;
 } EQ;
 
 static void
@@ -1945,6 +2911,66 @@ EQ_filters_aaa(EQ *self) {
     }
 }
 
+/* Coefficients computed every ramp.period samples and interpolated, see ctlramp.h. */
+static void
+EQ_filters_ctl(EQ *self) {
+    MYFLT val, fr = 0.0, q = 0.0, boost = 0.0, target[CTLRAMP_MAX_COEFFS];
+    int i, j, len;
+    MYFLT *c = self->ramp.coeffs;
+    MYFLT *inc = self->ramp.incs;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    MYFLT *frs = NULL, *qs = NULL, *boosts = NULL;
+
+    if (self->init == 1) {
+        self->x1 = self->x2 = self->y1 = self->y2 = in[0];
+        self->init = 0;
+    }
+
+    if (self->modebuffer[2] == 0)
+        fr = PyFloat_AS_DOUBLE(self->freq);
+    else
+        frs = Stream_getData((Stream *)self->freq_stream);
+    if (self->modebuffer[3] == 0)
+        q = PyFloat_AS_DOUBLE(self->q);
+    else
+        qs = Stream_getData((Stream *)self->q_stream);
+    if (self->modebuffer[4] == 0)
+        boost = PyFloat_AS_DOUBLE(self->boost);
+    else
+        boosts = Stream_getData((Stream *)self->boost_stream);
+
+    for (i=0; i<self->bufsize; i+=len) {
+        len = CtlRamp_segment(&self->ramp, i, self->bufsize);
+        if (frs != NULL)
+            fr = frs[i+len-1];
+        if (qs != NULL)
+            q = qs[i+len-1];
+        if (boosts != NULL)
+            boost = boosts[i+len-1];
+        if (CtlRamp_begin(&self->ramp, fr, q, boost)) {
+            EQ_compute_variables(self, fr, q, boost);
+            target[0] = self->b0 * self->a0;
+            target[1] = self->b1 * self->a0;
+            target[2] = self->b2 * self->a0;
+            target[3] = self->a1 * self->a0;
+            target[4] = self->a2 * self->a0;
+            CtlRamp_setTarget(&self->ramp, target, len);
+        }
+        for (j=i; j<i+len; j++) {
+            c[0] += inc[0];
+            c[1] += inc[1];
+            c[2] += inc[2];
+            c[3] += inc[3];
+            c[4] += inc[4];
+            val = c[0] * in[j] + c[1] * self->x1 + c[2] * self->x2 - c[3] * self->y1 - c[4] * self->y2;
+            self->x2 = self->x1;
+            self->x1 = in[j];
+            self->y2 = self->y1;
+            self->data[j] = self->y1 = val;
+        }
+    }
+}
+
 static void EQ_postprocessing_ii(EQ *self) { POST_PROCESSING_II };
 static void EQ_postprocessing_ai(EQ *self) { POST_PROCESSING_AI };
 static void EQ_postprocessing_ia(EQ *self) { POST_PROCESSING_IA };
@@ -2001,6 +3027,13 @@ EQ_setProcMode(EQ *self)
             self->proc_func_ptr = EQ_filters_aaa;
             break;
     }
+    if (self->ramp.period > 0 && procmode != 0) {
+        self->proc_func_ptr = EQ_filters_ctl;
+    }
+    else {
+        self->ramp.ready = 0;
+    }
+
 	switch (muladdmode) {
         case 0:
             self->muladd_func_ptr = EQ_postprocessing_ii;
@@ -2103,6 +3136,7 @@ EQ_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     Stream_setFunctionPtr(self->stream, EQ_compute_next_data_frame);
     self->mode_func_ptr = EQ_setProcMode;
+    CtlRamp_init(&self->ramp, 5);
 
     static char *kwlist[] = {"input", "freq", "q", "boost", "type", "mul", "add", NULL};
 
@@ -2262,12 +3296,29 @@ EQ_setType(EQ *self, PyObject *arg)
 		self->filtertype = PyInt_AsLong(arg);
 	}
 
+    /* Same parameters, other coefficients. */
+    self->ramp.ready = 0;
+
     (*self->mode_func_ptr)(self);
 
 	Py_INCREF(Py_None);
 	return Py_None;
 }
 
+static PyObject *
+EQ_setCtlPeriod(EQ *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+    if (PyNumber_Check(arg)) {
+        CtlRamp_setPeriod(&self->ramp, PyInt_AsLong(arg));
+        (*self->mode_func_ptr)(self);
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyMemberDef EQ_members[] = {
 {"server", T_OBJECT_EX, offsetof(EQ, server), 0, "Pyo server."},
 {"stream", T_OBJECT_EX, offsetof(EQ, stream), 0, "Stream object."},
@@ -2287,6 +3338,7 @@ static PyMethodDef EQ_methods[] = {
 {"out", (PyCFunction)EQ_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
 {"stop", (PyCFunction)EQ_stop, METH_NOARGS, "Stops computing."},
 {"setFreq", (PyCFunction)EQ_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
+{"setCtlPeriod", (PyCFunction)EQ_setCtlPeriod, METH_O, "Sets the number of samples between two coefficient computations."},
 {"setQ", (PyCFunction)EQ_setQ, METH_O, "Sets filter Q factor."},
 {"setBoost", (PyCFunction)EQ_setBoost, METH_O, "Sets filter boost factor."},
 {"setType", (PyCFunction)EQ_setType, METH_O, "Sets filter type factor."},
@@ -6962,6 +8014,7 @@ typedef struct {
     MYFLT y4;
     // variables
     MYFLT w;
+    CtlRamp ramp;
 } SVF;
 
 static void
@@ -7340,6 +8393,77 @@ SVF_filters_aaa(SVF *self) {
     }
 }
 
+/* Coefficients computed every ramp.period samples and interpolated, see ctlramp.h. */
+static void
+SVF_filters_ctl(SVF *self) {
+    MYFLT val, fr = 0.0, q = 0.0, type = 0.0, low, high, band, lowgain, highgain, bandgain, target[CTLRAMP_MAX_COEFFS];
+    int i, j, len;
+    MYFLT *c = self->ramp.coeffs;
+    MYFLT *inc = self->ramp.incs;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    MYFLT *frs = NULL, *qs = NULL, *tps = NULL;
+
+    if (self->modebuffer[2] == 0)
+        fr = PyFloat_AS_DOUBLE(self->freq);
+    else
+        frs = Stream_getData((Stream *)self->freq_stream);
+    if (self->modebuffer[3] == 0)
+        q = PyFloat_AS_DOUBLE(self->q);
+    else
+        qs = Stream_getData((Stream *)self->q_stream);
+    if (self->modebuffer[4] == 0)
+        type = PyFloat_AS_DOUBLE(self->type);
+    else
+        tps = Stream_getData((Stream *)self->type_stream);
+
+    lowgain = highgain = bandgain = 0.0;
+    for (i=0; i<self->bufsize; i+=len) {
+        len = CtlRamp_segment(&self->ramp, i, self->bufsize);
+        if (frs != NULL)
+            fr = frs[i+len-1];
+        if (qs != NULL)
+            q = qs[i+len-1];
+        if (CtlRamp_begin(&self->ramp, fr, q, 0.0)) {
+            if (fr < 0.1)
+                fr = 0.1;
+            else if (fr > self->srOverSix)
+                fr = self->srOverSix;
+            if (q < 0.5)
+                q = 0.5;
+            target[0] = 2.0 * MYSIN(fr * self->piOverSr);
+            target[1] = 1.0 / q;
+            CtlRamp_setTarget(&self->ramp, target, len);
+        }
+        for (j=i; j<i+len; j++) {
+            c[0] += inc[0];
+            c[1] += inc[1];
+            if (tps != NULL || j == 0) {
+                if (tps != NULL)
+                    type = tps[j];
+                if (type < 0.0)
+                    type = 0.0;
+                else if (type > 1.0)
+                    type = 1.0;
+                lowgain = (type <= 0.5) ? (0.5 - type) : 0.0;
+                highgain = (type >= 0.5) ? (type - 0.5) : 0.0;
+                bandgain = (type <= 0.5) ? type : (1.0 - type);
+            }
+            low = self->y2 + c[0] * self->y1;
+            high = in[j] - low - c[1] * self->y1;
+            band = c[0] * high + self->y1;
+            self->y1 = band;
+            self->y2 = low;
+            val = low * lowgain + high * highgain + band * bandgain;
+            low = self->y4 + c[0] * self->y3;
+            high = val - low - c[1] * self->y3;
+            band = c[0] * high + self->y3;
+            self->y3 = band;
+            self->y4 = low;
+            self->data[j] = low * lowgain + high * highgain + band * bandgain;
+        }
+    }
+}
+
 static void SVF_postprocessing_ii(SVF *self) { POST_PROCESSING_II };
 static void SVF_postprocessing_ai(SVF *self) { POST_PROCESSING_AI };
 static void SVF_postprocessing_ia(SVF *self) { POST_PROCESSING_IA };
@@ -7383,6 +8507,13 @@ SVF_setProcMode(SVF *self)
             self->proc_func_ptr = SVF_filters_aaa;
             break;
     }
+    if (self->ramp.period > 0 && procmode != 0) {
+        self->proc_func_ptr = SVF_filters_ctl;
+    }
+    else {
+        self->ramp.ready = 0;
+    }
+
 	switch (muladdmode) {
         case 0:
             self->muladd_func_ptr = SVF_postprocessing_ii;
@@ -7485,6 +8616,7 @@ SVF_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     Stream_setFunctionPtr(self->stream, SVF_compute_next_data_frame);
     self->mode_func_ptr = SVF_setProcMode;
+    CtlRamp_init(&self->ramp, 2);
 
     static char *kwlist[] = {"input", "freq", "q", "type", "mul", "add", NULL};
 
@@ -7633,6 +8765,20 @@ SVF_setType(SVF *self, PyObject *arg)
 	return Py_None;
 }
 
+static PyObject *
+SVF_setCtlPeriod(SVF *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+    if (PyNumber_Check(arg)) {
+        CtlRamp_setPeriod(&self->ramp, PyInt_AsLong(arg));
+        (*self->mode_func_ptr)(self);
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyMemberDef SVF_members[] = {
     {"server", T_OBJECT_EX, offsetof(SVF, server), 0, "Pyo server."},
     {"stream", T_OBJECT_EX, offsetof(SVF, stream), 0, "Stream object."},
@@ -7652,6 +8798,7 @@ static PyMethodDef SVF_methods[] = {
     {"out", (PyCFunction)SVF_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
     {"stop", (PyCFunction)SVF_stop, METH_NOARGS, "Stops computing."},
 	{"setFreq", (PyCFunction)SVF_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
+	{"setCtlPeriod", (PyCFunction)SVF_setCtlPeriod, METH_O, "Sets the number of samples between two coefficient computations."},
     {"setQ", (PyCFunction)SVF_setQ, METH_O, "Sets filter Q factor."},
     {"setType", (PyCFunction)SVF_setType, METH_O, "Sets filter type factor."},
 	{"setMul", (PyCFunction)SVF_setMul, METH_O, "Sets mul factor."},
@@ -9145,6 +10292,7 @@ typedef struct {
     MYFLT a2;
     MYFLT b1;
     MYFLT b2;
+    CtlRamp ramp;
 } ButLP;
 
 static void
@@ -9207,6 +10355,53 @@ ButLP_filters_a(ButLP *self) {
     }
 }
 
+/* Coefficients computed every ramp.period samples and interpolated, see ctlramp.h. */
+static void
+ButLP_filters_ctl(ButLP *self) {
+    MYFLT val, cf, cf2, fr = 0.0, target[CTLRAMP_MAX_COEFFS];
+    int i, j, len;
+    MYFLT *c = self->ramp.coeffs;
+    MYFLT *inc = self->ramp.incs;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    MYFLT *frs = NULL;
+
+    if (self->modebuffer[2] == 0)
+        fr = PyFloat_AS_DOUBLE(self->freq);
+    else
+        frs = Stream_getData((Stream *)self->freq_stream);
+
+    for (i=0; i<self->bufsize; i+=len) {
+        len = CtlRamp_segment(&self->ramp, i, self->bufsize);
+        if (frs != NULL)
+            fr = frs[i+len-1];
+        if (CtlRamp_begin(&self->ramp, fr, 0.0, 0.0)) {
+            if (fr < 0.1)
+                fr = 0.1;
+            else if (fr >= self->nyquist)
+                fr = self->nyquist;
+            cf = 1.0 / MYTAN(self->piOnSr * fr);
+            cf2 = cf * cf;
+            target[0] = target[2] = 1.0 / (1.0 + self->sqrt2 * cf + cf2);
+            target[1] = 2.0 * target[0];
+            target[3] = target[1] * (1.0 - cf2);
+            target[4] = target[0] * (1.0 - self->sqrt2 * cf + cf2);
+            CtlRamp_setTarget(&self->ramp, target, len);
+        }
+        for (j=i; j<i+len; j++) {
+            c[0] += inc[0];
+            c[1] += inc[1];
+            c[2] += inc[2];
+            c[3] += inc[3];
+            c[4] += inc[4];
+            val = c[0] * in[j] + c[1] * self->x1 + c[2] * self->x2 - c[3] * self->y1 - c[4] * self->y2;
+            self->x2 = self->x1;
+            self->x1 = in[j];
+            self->y2 = self->y1;
+            self->data[j] = self->y1 = val;
+        }
+    }
+}
+
 static void ButLP_postprocessing_ii(ButLP *self) { POST_PROCESSING_II };
 static void ButLP_postprocessing_ai(ButLP *self) { POST_PROCESSING_AI };
 static void ButLP_postprocessing_ia(ButLP *self) { POST_PROCESSING_IA };
@@ -9232,6 +10427,13 @@ ButLP_setProcMode(ButLP *self)
             self->proc_func_ptr = ButLP_filters_a;
             break;
     }
+    if (self->ramp.period > 0 && procmode != 0) {
+        self->proc_func_ptr = ButLP_filters_ctl;
+    }
+    else {
+        self->ramp.ready = 0;
+    }
+
 	switch (muladdmode) {
         case 0:
             self->muladd_func_ptr = ButLP_postprocessing_ii;
@@ -9323,6 +10525,7 @@ ButLP_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     Stream_setFunctionPtr(self->stream, ButLP_compute_next_data_frame);
     self->mode_func_ptr = ButLP_setProcMode;
+    CtlRamp_init(&self->ramp, 5);
 
     static char *kwlist[] = {"input", "freq", "mul", "add", NULL};
 
@@ -9401,6 +10604,20 @@ ButLP_setFreq(ButLP *self, PyObject *arg)
 	return Py_None;
 }
 
+static PyObject *
+ButLP_setCtlPeriod(ButLP *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+    if (PyNumber_Check(arg)) {
+        CtlRamp_setPeriod(&self->ramp, PyInt_AsLong(arg));
+        (*self->mode_func_ptr)(self);
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyMemberDef ButLP_members[] = {
 {"server", T_OBJECT_EX, offsetof(ButLP, server), 0, "Pyo server."},
 {"stream", T_OBJECT_EX, offsetof(ButLP, stream), 0, "Stream object."},
@@ -9418,6 +10635,7 @@ static PyMethodDef ButLP_methods[] = {
 {"out", (PyCFunction)ButLP_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
 {"stop", (PyCFunction)ButLP_stop, METH_NOARGS, "Stops computing."},
 {"setFreq", (PyCFunction)ButLP_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
+{"setCtlPeriod", (PyCFunction)ButLP_setCtlPeriod, METH_O, "Sets the number of samples between two coefficient computations."},
 {"setMul", (PyCFunction)ButLP_setMul, METH_O, "Sets oscillator mul factor."},
 {"setAdd", (PyCFunction)ButLP_setAdd, METH_O, "Sets oscillator add factor."},
 {"setSub", (PyCFunction)ButLP_setSub, METH_O, "Sets inverse add factor."},
@@ -9534,6 +10752,7 @@ typedef struct {
     MYFLT a2;
     MYFLT b1;
     MYFLT b2;
+    CtlRamp ramp;
 } ButHP;
 
 static void
@@ -9596,6 +10815,53 @@ ButHP_filters_a(ButHP *self) {
     }
 }
 
+/* Coefficients computed every ramp.period samples and interpolated, see ctlramp.h. */
+static void
+ButHP_filters_ctl(ButHP *self) {
+    MYFLT val, cf, cf2, fr = 0.0, target[CTLRAMP_MAX_COEFFS];
+    int i, j, len;
+    MYFLT *c = self->ramp.coeffs;
+    MYFLT *inc = self->ramp.incs;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    MYFLT *frs = NULL;
+
+    if (self->modebuffer[2] == 0)
+        fr = PyFloat_AS_DOUBLE(self->freq);
+    else
+        frs = Stream_getData((Stream *)self->freq_stream);
+
+    for (i=0; i<self->bufsize; i+=len) {
+        len = CtlRamp_segment(&self->ramp, i, self->bufsize);
+        if (frs != NULL)
+            fr = frs[i+len-1];
+        if (CtlRamp_begin(&self->ramp, fr, 0.0, 0.0)) {
+            if (fr < 0.1)
+                fr = 0.1;
+            else if (fr >= self->nyquist)
+                fr = self->nyquist;
+            cf = MYTAN(self->piOnSr * fr);
+            cf2 = cf * cf;
+            target[0] = target[2] = 1.0 / (1.0 + self->sqrt2 * cf + cf2);
+            target[1] = -2.0 * target[0];
+            target[3] = 2.0 * target[0] * (cf2 - 1.0);
+            target[4] = target[0] * (1.0 - self->sqrt2 * cf + cf2);
+            CtlRamp_setTarget(&self->ramp, target, len);
+        }
+        for (j=i; j<i+len; j++) {
+            c[0] += inc[0];
+            c[1] += inc[1];
+            c[2] += inc[2];
+            c[3] += inc[3];
+            c[4] += inc[4];
+            val = c[0] * in[j] + c[1] * self->x1 + c[2] * self->x2 - c[3] * self->y1 - c[4] * self->y2;
+            self->x2 = self->x1;
+            self->x1 = in[j];
+            self->y2 = self->y1;
+            self->data[j] = self->y1 = val;
+        }
+    }
+}
+
 static void ButHP_postprocessing_ii(ButHP *self) { POST_PROCESSING_II };
 static void ButHP_postprocessing_ai(ButHP *self) { POST_PROCESSING_AI };
 static void ButHP_postprocessing_ia(ButHP *self) { POST_PROCESSING_IA };
@@ -9621,6 +10887,13 @@ ButHP_setProcMode(ButHP *self)
             self->proc_func_ptr = ButHP_filters_a;
             break;
     }
+    if (self->ramp.period > 0 && procmode != 0) {
+        self->proc_func_ptr = ButHP_filters_ctl;
+    }
+    else {
+        self->ramp.ready = 0;
+    }
+
 	switch (muladdmode) {
         case 0:
             self->muladd_func_ptr = ButHP_postprocessing_ii;
@@ -9712,6 +10985,7 @@ ButHP_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     Stream_setFunctionPtr(self->stream, ButHP_compute_next_data_frame);
     self->mode_func_ptr = ButHP_setProcMode;
+    CtlRamp_init(&self->ramp, 5);
 
     static char *kwlist[] = {"input", "freq", "mul", "add", NULL};
 
@@ -9790,6 +11064,20 @@ ButHP_setFreq(ButHP *self, PyObject *arg)
 	return Py_None;
 }
 
+static PyObject *
+ButHP_setCtlPeriod(ButHP *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+    if (PyNumber_Check(arg)) {
+        CtlRamp_setPeriod(&self->ramp, PyInt_AsLong(arg));
+        (*self->mode_func_ptr)(self);
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyMemberDef ButHP_members[] = {
 {"server", T_OBJECT_EX, offsetof(ButHP, server), 0, "Pyo server."},
 {"stream", T_OBJECT_EX, offsetof(ButHP, stream), 0, "Stream object."},
@@ -9807,6 +11095,7 @@ static PyMethodDef ButHP_methods[] = {
 {"out", (PyCFunction)ButHP_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
 {"stop", (PyCFunction)ButHP_stop, METH_NOARGS, "Stops computing."},
 {"setFreq", (PyCFunction)ButHP_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
+{"setCtlPeriod", (PyCFunction)ButHP_setCtlPeriod, METH_O, "Sets the number of samples between two coefficient computations."},
 {"setMul", (PyCFunction)ButHP_setMul, METH_O, "Sets oscillator mul factor."},
 {"setAdd", (PyCFunction)ButHP_setAdd, METH_O, "Sets oscillator add factor."},
 {"setSub", (PyCFunction)ButHP_setSub, METH_O, "Sets inverse add factor."},
@@ -9924,6 +11213,7 @@ typedef struct {
     MYFLT a2;
     MYFLT b1;
     MYFLT b2;
+    CtlRamp ramp;
 } ButBP;
 
 static void
@@ -10041,6 +11331,57 @@ ButBP_filters_aa(ButBP *self) {
     }
 }
 
+/* Coefficients computed every ramp.period samples and interpolated, see ctlramp.h. */
+static void
+ButBP_filters_ctl(ButBP *self) {
+    MYFLT val, fr = 0.0, q = 0.0, target[CTLRAMP_MAX_COEFFS];
+    int i, j, len;
+    MYFLT *c = self->ramp.coeffs;
+    MYFLT *inc = self->ramp.incs;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    MYFLT *frs = NULL, *qs = NULL;
+
+    if (self->modebuffer[2] == 0)
+        fr = PyFloat_AS_DOUBLE(self->freq);
+    else
+        frs = Stream_getData((Stream *)self->freq_stream);
+    if (self->modebuffer[3] == 0)
+        q = PyFloat_AS_DOUBLE(self->q);
+    else
+        qs = Stream_getData((Stream *)self->q_stream);
+
+    for (i=0; i<self->bufsize; i+=len) {
+        len = CtlRamp_segment(&self->ramp, i, self->bufsize);
+        if (frs != NULL)
+            fr = frs[i+len-1];
+        if (qs != NULL)
+            q = qs[i+len-1];
+        if (CtlRamp_begin(&self->ramp, fr, q, 0.0)) {
+            ButBP_compute_coeffs(self, fr, q);
+            self->last_freq = fr;
+            self->last_q = q;
+            target[0] = self->a0;
+            target[1] = 0.0;
+            target[2] = self->a2;
+            target[3] = self->b1;
+            target[4] = self->b2;
+            CtlRamp_setTarget(&self->ramp, target, len);
+        }
+        for (j=i; j<i+len; j++) {
+            c[0] += inc[0];
+            c[1] += inc[1];
+            c[2] += inc[2];
+            c[3] += inc[3];
+            c[4] += inc[4];
+            val = c[0] * in[j] + c[1] * self->x1 + c[2] * self->x2 - c[3] * self->y1 - c[4] * self->y2;
+            self->x2 = self->x1;
+            self->x1 = in[j];
+            self->y2 = self->y1;
+            self->data[j] = self->y1 = val;
+        }
+    }
+}
+
 static void ButBP_postprocessing_ii(ButBP *self) { POST_PROCESSING_II };
 static void ButBP_postprocessing_ai(ButBP *self) { POST_PROCESSING_AI };
 static void ButBP_postprocessing_ia(ButBP *self) { POST_PROCESSING_IA };
@@ -10072,6 +11413,13 @@ ButBP_setProcMode(ButBP *self)
             self->proc_func_ptr = ButBP_filters_aa;
             break;
     }
+    if (self->ramp.period > 0 && procmode != 0) {
+        self->proc_func_ptr = ButBP_filters_ctl;
+    }
+    else {
+        self->ramp.ready = 0;
+    }
+
 	switch (muladdmode) {
         case 0:
             self->muladd_func_ptr = ButBP_postprocessing_ii;
@@ -10169,6 +11517,7 @@ ButBP_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     Stream_setFunctionPtr(self->stream, ButBP_compute_next_data_frame);
     self->mode_func_ptr = ButBP_setProcMode;
+    CtlRamp_init(&self->ramp, 5);
 
     static char *kwlist[] = {"input", "freq", "q", "mul", "add", NULL};
 
@@ -10282,6 +11631,20 @@ ButBP_setQ(ButBP *self, PyObject *arg)
 	return Py_None;
 }
 
+static PyObject *
+ButBP_setCtlPeriod(ButBP *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+    if (PyNumber_Check(arg)) {
+        CtlRamp_setPeriod(&self->ramp, PyInt_AsLong(arg));
+        (*self->mode_func_ptr)(self);
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyMemberDef ButBP_members[] = {
     {"server", T_OBJECT_EX, offsetof(ButBP, server), 0, "Pyo server."},
     {"stream", T_OBJECT_EX, offsetof(ButBP, stream), 0, "Stream object."},
@@ -10300,6 +11663,7 @@ static PyMethodDef ButBP_methods[] = {
     {"out", (PyCFunction)ButBP_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
     {"stop", (PyCFunction)ButBP_stop, METH_NOARGS, "Stops computing."},
 	{"setFreq", (PyCFunction)ButBP_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
+	{"setCtlPeriod", (PyCFunction)ButBP_setCtlPeriod, METH_O, "Sets the number of samples between two coefficient computations."},
     {"setQ", (PyCFunction)ButBP_setQ, METH_O, "Sets filter Q factor."},
 	{"setMul", (PyCFunction)ButBP_setMul, METH_O, "Sets oscillator mul factor."},
 	{"setAdd", (PyCFunction)ButBP_setAdd, METH_O, "Sets oscillator add factor."},
@@ -10419,6 +11783,7 @@ typedef struct {
     MYFLT a2;
     MYFLT b1;
     MYFLT b2;
+    CtlRamp ramp;
 } ButBR;
 
 static void
@@ -10535,6 +11900,57 @@ ButBR_filters_aa(ButBR *self) {
     }
 }
 
+/* Coefficients computed every ramp.period samples and interpolated, see ctlramp.h. */
+static void
+ButBR_filters_ctl(ButBR *self) {
+    MYFLT val, fr = 0.0, q = 0.0, target[CTLRAMP_MAX_COEFFS];
+    int i, j, len;
+    MYFLT *c = self->ramp.coeffs;
+    MYFLT *inc = self->ramp.incs;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    MYFLT *frs = NULL, *qs = NULL;
+
+    if (self->modebuffer[2] == 0)
+        fr = PyFloat_AS_DOUBLE(self->freq);
+    else
+        frs = Stream_getData((Stream *)self->freq_stream);
+    if (self->modebuffer[3] == 0)
+        q = PyFloat_AS_DOUBLE(self->q);
+    else
+        qs = Stream_getData((Stream *)self->q_stream);
+
+    for (i=0; i<self->bufsize; i+=len) {
+        len = CtlRamp_segment(&self->ramp, i, self->bufsize);
+        if (frs != NULL)
+            fr = frs[i+len-1];
+        if (qs != NULL)
+            q = qs[i+len-1];
+        if (CtlRamp_begin(&self->ramp, fr, q, 0.0)) {
+            ButBR_compute_coeffs(self, fr, q);
+            self->last_freq = fr;
+            self->last_q = q;
+            target[0] = self->a0;
+            target[1] = self->a1;
+            target[2] = self->a2;
+            target[3] = self->b1;
+            target[4] = self->b2;
+            CtlRamp_setTarget(&self->ramp, target, len);
+        }
+        for (j=i; j<i+len; j++) {
+            c[0] += inc[0];
+            c[1] += inc[1];
+            c[2] += inc[2];
+            c[3] += inc[3];
+            c[4] += inc[4];
+            val = c[0] * in[j] + c[1] * self->x1 + c[2] * self->x2 - c[3] * self->y1 - c[4] * self->y2;
+            self->x2 = self->x1;
+            self->x1 = in[j];
+            self->y2 = self->y1;
+            self->data[j] = self->y1 = val;
+        }
+    }
+}
+
 static void ButBR_postprocessing_ii(ButBR *self) { POST_PROCESSING_II };
 static void ButBR_postprocessing_ai(ButBR *self) { POST_PROCESSING_AI };
 static void ButBR_postprocessing_ia(ButBR *self) { POST_PROCESSING_IA };
@@ -10566,6 +11982,13 @@ ButBR_setProcMode(ButBR *self)
             self->proc_func_ptr = ButBR_filters_aa;
             break;
     }
+    if (self->ramp.period > 0 && procmode != 0) {
+        self->proc_func_ptr = ButBR_filters_ctl;
+    }
+    else {
+        self->ramp.ready = 0;
+    }
+
 	switch (muladdmode) {
         case 0:
             self->muladd_func_ptr = ButBR_postprocessing_ii;
@@ -10663,6 +12086,7 @@ ButBR_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     Stream_setFunctionPtr(self->stream, ButBR_compute_next_data_frame);
     self->mode_func_ptr = ButBR_setProcMode;
+    CtlRamp_init(&self->ramp, 5);
 
     static char *kwlist[] = {"input", "freq", "q", "mul", "add", NULL};
 
@@ -10776,6 +12200,20 @@ ButBR_setQ(ButBR *self, PyObject *arg)
 	return Py_None;
 }
 
+static PyObject *
+ButBR_setCtlPeriod(ButBR *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+    if (PyNumber_Check(arg)) {
+        CtlRamp_setPeriod(&self->ramp, PyInt_AsLong(arg));
+        (*self->mode_func_ptr)(self);
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyMemberDef ButBR_members[] = {
     {"server", T_OBJECT_EX, offsetof(ButBR, server), 0, "Pyo server."},
     {"stream", T_OBJECT_EX, offsetof(ButBR, stream), 0, "Stream object."},
@@ -10794,6 +12232,7 @@ static PyMethodDef ButBR_methods[] = {
     {"out", (PyCFunction)ButBR_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
     {"stop", (PyCFunction)ButBR_stop, METH_NOARGS, "Stops computing."},
 	{"setFreq", (PyCFunction)ButBR_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
+	{"setCtlPeriod", (PyCFunction)ButBR_setCtlPeriod, METH_O, "Sets the number of samples between two coefficient computations."},
     {"setQ", (PyCFunction)ButBR_setQ, METH_O, "Sets filter Q factor."},
 	{"setMul", (PyCFunction)ButBR_setMul, METH_O, "Sets oscillator mul factor."},
 	{"setAdd", (PyCFunction)ButBR_setAdd, METH_O, "Sets oscillator add factor."},
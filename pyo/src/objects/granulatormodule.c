@@ -899,6 +899,7 @@ Granulator_setTable(Granulator *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -1112,7 +1113,7 @@ typedef struct {
     long maxfadepoint[2];
     MYFLT *fader;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
-    MYFLT (*interp_func_ptr)(MYFLT *, int, MYFLT, int);
+    interp_block_func interp_func_ptr;
     int modebuffer[6];
     int autosmooth;
     MYFLT lastpitch;
@@ -1121,6 +1122,11 @@ typedef struct {
     MYFLT y2;
     // variables
     MYFLT c1;
+    // scratch buffers of the block interpolation, two voices
+    int *interpIndex;
+    MYFLT *interpFrac;
+    MYFLT *interpAmps;
+    MYFLT *voiceBuffer;
 
 } Looper;
 
@@ -1267,11 +1273,38 @@ Looper_get_amp(Looper *self, MYFLT pos) {
     return self->fader[ipart] + (self->fader[ipart+1] - self->fader[ipart]) * (pos - ipart);
 }
 
+/* Reads the positions recorded for both voices with the block interpolation
+** function and sums them, weighted by their amplitudes. The positions of
+** voice j are stored at offset j * bufsize. */
+static void
+Looper_read_voices(Looper *self, MYFLT *tablelist, int size, int *index, MYFLT *frac, MYFLT *amps, int *used) {
+    int i;
+    MYFLT *tmp = self->voiceBuffer;
+
+    if (used[0])
+        (*self->interp_func_ptr)(tablelist, size, index, frac, self->data, self->bufsize);
+    if (used[1])
+        (*self->interp_func_ptr)(tablelist, size, index + self->bufsize, frac + self->bufsize, tmp, self->bufsize);
+
+    for (i=0; i<self->bufsize; i++) {
+        if (used[0] && used[1])
+            self->data[i] = self->data[i] * amps[i] + tmp[i] * amps[i+self->bufsize];
+        else if (used[0])
+            self->data[i] = self->data[i] * amps[i];
+        else if (used[1])
+            self->data[i] = tmp[i] * amps[i+self->bufsize];
+        else
+            self->data[i] = 0.0;
+    }
+}
+
 static void
 Looper_transform_i(Looper *self) {
     MYFLT fpart, amp, fr;
     double pit;
-    int i, j, ipart;
+    int i, j, used[2] = {0, 0};
+    int *index = self->interpIndex;
+    MYFLT *frac = self->interpFrac, *amps = self->interpAmps;
 
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
@@ -1292,7 +1325,10 @@ Looper_transform_i(Looper *self) {
     }
 
     for (i=0; i<self->bufsize; i++) {
-        self->data[i] = 0.0;
+        for (j=0; j<2; j++) {
+            index[i+j*self->bufsize] = 0;
+            frac[i+j*self->bufsize] = amps[i+j*self->bufsize] = 0.0;
+        }
         for (j=0; j<2; j++) {
             if (self->active[j] == 1) {
                 switch (self->mode[j]) {
@@ -1308,16 +1344,17 @@ Looper_transform_i(Looper *self) {
                             }
                             else
                                 amp = 1.0;
-                            ipart = (int)self->pointerPos[j];
-                            fpart = self->pointerPos[j] - ipart;
-                            self->data[i] += (*self->interp_func_ptr)(tablelist, ipart, fpart, size) * amp;
+                            index[i+j*self->bufsize] = (int)self->pointerPos[j];
+                            frac[i+j*self->bufsize] = self->pointerPos[j] - index[i+j*self->bufsize];
+                            amps[i+j*self->bufsize] = amp;
+                            used[j] = 1;
                         }
                         self->pointerPos[j] += pit;
                         if (self->pointerPos[j] < 0.0)
                             self->pointerPos[j] = 0.0;
                         else if (self->pointerPos[j] >= self->loopend[j]) {
                             self->active[j] = 0;
-                            PyObject_CallMethod((PyObject *)self, "stop", NULL);
+                            Server_deferStop((Server *)self->server, (PyObject *)self);
                         }
                         break;
                     case 1:
@@ -1332,9 +1369,10 @@ Looper_transform_i(Looper *self) {
                             }
                             else
                                 amp = 1.0;
-                            ipart = (int)self->pointerPos[j];
-                            fpart = self->pointerPos[j] - ipart;
-                            self->data[i] += (*self->interp_func_ptr)(tablelist, ipart, fpart, size) * amp;
+                            index[i+j*self->bufsize] = (int)self->pointerPos[j];
+                            frac[i+j*self->bufsize] = self->pointerPos[j] - index[i+j*self->bufsize];
+                            amps[i+j*self->bufsize] = amp;
+                            used[j] = 1;
                         }
                         self->pointerPos[j] += pit;
                         if (self->pointerPos[j] < 0.0)
@@ -1356,9 +1394,10 @@ Looper_transform_i(Looper *self) {
                             }
                             else
                                 amp = 1.0;
-                            ipart = (int)self->pointerPos[j];
-                            fpart = self->pointerPos[j] - ipart;
-                            self->data[i] += (*self->interp_func_ptr)(tablelist, ipart, fpart, size) * amp;
+                            index[i+j*self->bufsize] = (int)self->pointerPos[j];
+                            frac[i+j*self->bufsize] = self->pointerPos[j] - index[i+j*self->bufsize];
+                            amps[i+j*self->bufsize] = amp;
+                            used[j] = 1;
                         }
                         self->pointerPos[j] -= pit;
                         if (self->pointerPos[j] >= size)
@@ -1381,9 +1420,10 @@ Looper_transform_i(Looper *self) {
                                 }
                                 else
                                     amp = 1.0;
-                                ipart = (int)self->pointerPos[j];
-                                fpart = self->pointerPos[j] - ipart;
-                                self->data[i] += (*self->interp_func_ptr)(tablelist, ipart, fpart, size) * amp;
+                                index[i+j*self->bufsize] = (int)self->pointerPos[j];
+                                frac[i+j*self->bufsize] = self->pointerPos[j] - index[i+j*self->bufsize];
+                                amps[i+j*self->bufsize] = amp;
+                                used[j] = 1;
                             }
                             self->pointerPos[j] += pit;
                             if (self->pointerPos[j] < 0.0)
@@ -1405,9 +1445,10 @@ Looper_transform_i(Looper *self) {
                                 }
                                 else
                                     amp = 1.0;
-                                ipart = (int)self->pointerPos[j];
-                                fpart = self->pointerPos[j] - ipart;
-                                self->data[i] += (*self->interp_func_ptr)(tablelist, ipart, fpart, size) * amp;
+                                index[i+j*self->bufsize] = (int)self->pointerPos[j];
+                                frac[i+j*self->bufsize] = self->pointerPos[j] - index[i+j*self->bufsize];
+                                amps[i+j*self->bufsize] = amp;
+                                used[j] = 1;
                             }
                             self->pointerPos[j] -= pit;
                             if (self->pointerPos[j] >= size)
@@ -1422,6 +1463,7 @@ Looper_transform_i(Looper *self) {
             }
         }
     }
+    Looper_read_voices(self, tablelist, size, index, frac, amps, used);
 
     /* Automatic smoothering of low transposition */
     if (self->autosmooth == 1 && pitval < 1.0) {
@@ -1444,7 +1486,9 @@ static void
 Looper_transform_a(Looper *self) {
     MYFLT fpart, amp, fr, pitval;
     double pit, srFactor;
-    int i, j, ipart;
+    int i, j, used[2] = {0, 0};
+    int *index = self->interpIndex;
+    MYFLT *frac = self->interpFrac, *amps = self->interpAmps;
 
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
@@ -1463,7 +1507,10 @@ Looper_transform_a(Looper *self) {
     }
 
     for (i=0; i<self->bufsize; i++) {
-        self->data[i] = 0.0;
+        for (j=0; j<2; j++) {
+            index[i+j*self->bufsize] = 0;
+            frac[i+j*self->bufsize] = amps[i+j*self->bufsize] = 0.0;
+        }
         pitval = pitch[i];
         if (pitval < 0.0)
             pitval = 0.0;
@@ -1483,16 +1530,17 @@ Looper_transform_a(Looper *self) {
                             }
                             else
                                 amp = 1.0;
-                            ipart = (int)self->pointerPos[j];
-                            fpart = self->pointerPos[j] - ipart;
-                            self->data[i] += (*self->interp_func_ptr)(tablelist, ipart, fpart, size) * amp;
+                            index[i+j*self->bufsize] = (int)self->pointerPos[j];
+                            frac[i+j*self->bufsize] = self->pointerPos[j] - index[i+j*self->bufsize];
+                            amps[i+j*self->bufsize] = amp;
+                            used[j] = 1;
                         }
                         self->pointerPos[j] += pit;
                         if (self->pointerPos[j] < 0.0)
                             self->pointerPos[j] = 0.0;
                         else if (self->pointerPos[j] >= self->loopend[j]) {
                             self->active[j] = 0;
-                            PyObject_CallMethod((PyObject *)self, "stop", NULL);
+                            Server_deferStop((Server *)self->server, (PyObject *)self);
                         }
                         break;
                     case 1:
@@ -1507,9 +1555,10 @@ Looper_transform_a(Looper *self) {
                             }
                             else
                                 amp = 1.0;
-                            ipart = (int)self->pointerPos[j];
-                            fpart = self->pointerPos[j] - ipart;
-                            self->data[i] += (*self->interp_func_ptr)(tablelist, ipart, fpart, size) * amp;
+                            index[i+j*self->bufsize] = (int)self->pointerPos[j];
+                            frac[i+j*self->bufsize] = self->pointerPos[j] - index[i+j*self->bufsize];
+                            amps[i+j*self->bufsize] = amp;
+                            used[j] = 1;
                         }
                         self->pointerPos[j] += pit;
                         if (self->pointerPos[j] < 0.0)
@@ -1531,9 +1580,10 @@ Looper_transform_a(Looper *self) {
                             }
                             else
                                 amp = 1.0;
-                            ipart = (int)self->pointerPos[j];
-                            fpart = self->pointerPos[j] - ipart;
-                            self->data[i] += (*self->interp_func_ptr)(tablelist, ipart, fpart, size) * amp;
+                            index[i+j*self->bufsize] = (int)self->pointerPos[j];
+                            frac[i+j*self->bufsize] = self->pointerPos[j] - index[i+j*self->bufsize];
+                            amps[i+j*self->bufsize] = amp;
+                            used[j] = 1;
                         }
                         self->pointerPos[j] -= pit;
                         if (self->pointerPos[j] >= size)
@@ -1556,9 +1606,10 @@ Looper_transform_a(Looper *self) {
                                 }
                                 else
                                     amp = 1.0;
-                                ipart = (int)self->pointerPos[j];
-                                fpart = self->pointerPos[j] - ipart;
-                                self->data[i] += (*self->interp_func_ptr)(tablelist, ipart, fpart, size) * amp;
+                                index[i+j*self->bufsize] = (int)self->pointerPos[j];
+                                frac[i+j*self->bufsize] = self->pointerPos[j] - index[i+j*self->bufsize];
+                                amps[i+j*self->bufsize] = amp;
+                                used[j] = 1;
                             }
                             self->pointerPos[j] += pit;
                             if (self->pointerPos[j] < 0.0)
@@ -1580,9 +1631,10 @@ Looper_transform_a(Looper *self) {
                                 }
                                 else
                                     amp = 1.0;
-                                ipart = (int)self->pointerPos[j];
-                                fpart = self->pointerPos[j] - ipart;
-                                self->data[i] += (*self->interp_func_ptr)(tablelist, ipart, fpart, size) * amp;
+                                index[i+j*self->bufsize] = (int)self->pointerPos[j];
+                                frac[i+j*self->bufsize] = self->pointerPos[j] - index[i+j*self->bufsize];
+                                amps[i+j*self->bufsize] = amp;
+                                used[j] = 1;
                             }
                             self->pointerPos[j] -= pit;
                             if (self->pointerPos[j] >= size)
@@ -1597,6 +1649,7 @@ Looper_transform_a(Looper *self) {
             }
         }
     }
+    Looper_read_voices(self, tablelist, size, index, frac, amps, used);
 
     /* Automatic smoothering of low transposition */
     if (self->autosmooth == 1) {
@@ -1720,6 +1773,10 @@ Looper_dealloc(Looper* self)
 {
     pyo_DEALLOC
     free(self->trigsBuffer);
+    free(self->interpIndex);
+    free(self->interpFrac);
+    free(self->interpAmps);
+    free(self->voiceBuffer);
     Looper_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -1757,6 +1814,11 @@ Looper_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Stream_setFunctionPtr(self->stream, Looper_compute_next_data_frame);
     self->mode_func_ptr = Looper_setProcMode;
 
+    self->interpIndex = (int *)realloc(self->interpIndex, 2 * self->bufsize * sizeof(int));
+    self->interpFrac = (MYFLT *)realloc(self->interpFrac, 2 * self->bufsize * sizeof(MYFLT));
+    self->interpAmps = (MYFLT *)realloc(self->interpAmps, 2 * self->bufsize * sizeof(MYFLT));
+    self->voiceBuffer = (MYFLT *)realloc(self->voiceBuffer, self->bufsize * sizeof(MYFLT));
+
     static char *kwlist[] = {"table", "pitch", "start", "dur", "xfade", "mode", "xfadeshape", "startfromloop", "interp", "autosmooth", "mul", "add", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|OOOOiiiiiOO", kwlist, &tabletmp, &pitchtmp, &starttmp, &durtmp, &xfadetmp, &self->tmpmode, &self->xfadeshape, &self->startfromloop, &self->interp, &self->autosmooth, &multmp, &addtmp))
@@ -1805,13 +1867,14 @@ Looper_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
     if (self->tmpmode >= 0 && self->tmpmode < 4)
         self->mode[0] = self->mode[1] = self->tmpmode;
     else
         self->mode[0] = self->mode[1] = self->tmpmode = 1;
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     return (PyObject *)self;
 }
@@ -1972,6 +2035,7 @@ Looper_setTable(Looper *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -2037,7 +2101,7 @@ Looper_setInterp(Looper *self, PyObject *arg)
 		self->interp = PyInt_AsLong(PyNumber_Int(arg));
     }
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -2760,6 +2824,7 @@ Granule_setTable(Granule *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -3517,6 +3582,7 @@ MainParticle_dealloc(MainParticle* self)
 MYFLT *
 MainParticle_getSamplesBuffer(MainParticle *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -3829,6 +3895,7 @@ MainParticle_setTable(MainParticle *self, PyObject *arg)
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
     self->srScale = TableStream_getSamplingRate(self->table) / self->sr;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
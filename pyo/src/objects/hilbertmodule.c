@@ -88,6 +88,7 @@ HilbertMain_filters(HilbertMain *self) {
 MYFLT *
 HilbertMain_getSamplesBuffer(HilbertMain *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -65,6 +65,7 @@ MatrixStream_getInterpPointFromPos(MatrixStream *self, MYFLT x, MYFLT y)
     MYFLT xpos, ypos, xfpart, yfpart, x1, x2, x3, x4;
     int xipart, yipart;
 
+    PYO_GRAPH_READ(self);
     xpos = x * self->width;
     if (xpos < 0)
         xpos += self->width;
@@ -100,6 +101,7 @@ MatrixStream_getInterpPointFromPos(MatrixStream *self, MYFLT x, MYFLT y)
 MYFLT
 MatrixStream_getPointFromPos(MatrixStream *self, long x, long y)
 {
+    PYO_GRAPH_READ(self);
     return self->data[y][x];
 }
 
@@ -109,6 +111,55 @@ MatrixStream_setData(MatrixStream *self, MYFLT **data)
     self->data = data;
 }
 
+static void
+MatrixStream_setOwner(MatrixStream *self, PyObject *owner)
+{
+    self->owner = owner;
+}
+
+/* A (height, width) view of the points, the guard points are skipped with the strides. */
+static int
+MatrixStream_getbuffer(MatrixStream *self, Py_buffer *view, int flags)
+{
+    self->viewShape[0] = self->height;
+    self->viewShape[1] = self->width;
+    self->viewStrides[0] = (self->width + 1) * sizeof(MYFLT);
+    self->viewStrides[1] = sizeof(MYFLT);
+    if (PyoBuffer_fillView(view, (PyObject *)self, self->data[0], 2, self->viewShape, self->viewStrides, 0, flags) < 0)
+        return -1;
+    self->exports++;
+    Py_XINCREF(self->owner);
+    return 0;
+}
+
+static void
+MatrixStream_releasebuffer(MatrixStream *self, Py_buffer *view)
+{
+    self->exports--;
+    Py_XDECREF(self->owner);
+}
+
+/* Returns -1, with a BufferError, if the matrix is exported. Called before
+** the data is resized or replaced. */
+static int
+MatrixStream_checkExports(MatrixStream *self)
+{
+    if (self->exports > 0) {
+        PyErr_SetString(PyExc_BufferError, "The matrix can't be resized or replaced while a buffer view of it exists.");
+        return -1;
+    }
+    return 0;
+}
+
+static PyBufferProcs MatrixStream_as_buffer = {
+    0, /*bf_getreadbuffer*/
+    0, /*bf_getwritebuffer*/
+    0, /*bf_getsegcount*/
+    0, /*bf_getcharbuffer*/
+    (getbufferproc)MatrixStream_getbuffer, /*bf_getbuffer*/
+    (releasebufferproc)MatrixStream_releasebuffer, /*bf_releasebuffer*/
+};
+
 void
 MatrixStream_setWidth(MatrixStream *self, int size)
 {
@@ -141,8 +192,8 @@ sizeof(MatrixStream), /*tp_basicsize*/
 0, /*tp_str*/
 0, /*tp_getattro*/
 0, /*tp_setattro*/
-0, /*tp_as_buffer*/
-Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, /*tp_flags*/
+&MatrixStream_as_buffer, /*tp_as_buffer*/
+Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_NEWBUFFER, /*tp_flags*/
 "MatrixStream objects. For internal use only. Must never be instantiated by the user.", /* tp_doc */
 0, /* tp_traverse */
 0, /* tp_clear */
@@ -179,11 +230,12 @@ NewMatrix_clip(MYFLT val, MYFLT min, MYFLT max) {
     else return val;
 }
 
-static PyObject *
+static void
 NewMatrix_recordChunkAllRow(NewMatrix *self, MYFLT *data, long datasize)
 {
     long i;
 
+    PYO_GRAPH_WRITE(self->matrixstream);
     for (i=0; i<datasize; i++) {
         self->data[self->y_pointer][self->x_pointer++] = data[i];
         if (self->x_pointer >= self->width) {
@@ -193,8 +245,6 @@ NewMatrix_recordChunkAllRow(NewMatrix *self, MYFLT *data, long datasize)
                 self->y_pointer = 0;
         }
     }
-    Py_INCREF(Py_None);
-    return Py_None;
 }
 
 static int
@@ -214,10 +264,7 @@ NewMatrix_clear(NewMatrix *self)
 static void
 NewMatrix_dealloc(NewMatrix* self)
 {
-    int i;
-    for (i=0; i<(self->height+1); i++) {
-        free(self->data[i]);
-    }
+    free(self->data[0]);
     free(self->data);
     NewMatrix_clear(self);
     self->ob_type->tp_free((PyObject*)self);
@@ -226,7 +273,7 @@ NewMatrix_dealloc(NewMatrix* self)
 static PyObject *
 NewMatrix_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    int i, j;
+    int i;
     PyObject *inittmp=NULL;
     NewMatrix *self;
 
@@ -237,22 +284,19 @@ NewMatrix_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->x_pointer = self->y_pointer = 0;
 
     MAKE_NEW_MATRIXSTREAM(self->matrixstream, &MatrixStreamType, NULL);
+    MatrixStream_setOwner(self->matrixstream, (PyObject *)self);
 
     static char *kwlist[] = {"width", "height", "init", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "ii|O", kwlist, &self->width, &self->height, &inittmp))
         Py_RETURN_NONE;
 
+    /* A single block, the buffer views need a constant stride between the rows. */
     self->data = (MYFLT **)realloc(self->data, (self->height + 1) * sizeof(MYFLT *));
+    self->data[0] = (MYFLT *)calloc((self->height + 1) * (self->width + 1), sizeof(MYFLT));
 
-    for (i=0; i<(self->height+1); i++) {
-        self->data[i] = (MYFLT *)malloc((self->width + 1) * sizeof(MYFLT));
-    }
-
-    for(i=0; i<(self->height+1); i++) {
-        for (j=0; j<(self->width+1); j++) {
-            self->data[i][j] = 0.0;
-        }
+    for (i=1; i<(self->height+1); i++) {
+        self->data[i] = self->data[0] + i * (self->width + 1);
     }
 
     MatrixStream_setWidth(self->matrixstream, self->width);
@@ -608,6 +652,7 @@ MatrixRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
     int width = NewMatrix_getWidth((NewMatrix *)self->matrix);
     int height = NewMatrix_getHeight((NewMatrix *)self->matrix);
@@ -812,6 +857,7 @@ MatrixRecLoop_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
     return (PyObject *)self;
 }
@@ -1000,6 +1046,7 @@ MatrixMorph_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, MatrixMorph_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
 
     static char *kwlist[] = {"input", "matrix", "sources", NULL};
 
@@ -391,9 +391,11 @@ typedef struct {
     double currentTime;
     double duration;
     int *seq;
+    int *newSeq; /* sequence converted by setSeq, taken at the end of the current one */
     int count;
     MYFLT *buffer_streams;
     int seqsize;
+    int newSeqsize;
     int poly;
     int flag;
     int tap;
@@ -401,16 +403,16 @@ typedef struct {
     int newseq;
 } Seqer;
 
+/* Swaps in the sequence converted by setSeq, the old array is reused by the next conversion. */
 static void
 Seqer_reset(Seqer *self)
 {
-    int i;
+    int *tmp;
 
-    self->seqsize = PyList_Size(self->tmp);
-    self->seq = (int *)realloc(self->seq, self->seqsize * sizeof(int));
-    for (i=0; i<self->seqsize; i++) {
-        self->seq[i] = PyInt_AS_LONG(PyNumber_Int(PyList_GET_ITEM(self->tmp, i)));
-    }
+    tmp = self->seq;
+    self->seq = self->newSeq;
+    self->newSeq = tmp;
+    self->seqsize = self->newSeqsize;
     self->newseq = 0;
 }
 
@@ -492,6 +494,7 @@ Seqer_generate_a(Seqer *self) {
 MYFLT *
 Seqer_getSamplesBuffer(Seqer *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -540,6 +543,8 @@ Seqer_dealloc(Seqer* self)
 {
     pyo_DEALLOC
     free(self->buffer_streams);
+    free(self->seq);
+    free(self->newSeq);
     Seqer_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -636,17 +641,30 @@ Seqer_setTime(Seqer *self, PyObject *arg)
 static PyObject *
 Seqer_setSeq(Seqer *self, PyObject *arg)
 {
-	PyObject *tmp;
+    int i;
+	PyObject *tmp, *num;
 
     ASSERT_ARG_NOT_NULL
 
 	int isList = PyList_Check(arg);
 
 	if (isList == 1) {
+        /* Once the audio thread is out of its buffer, it can't be taking the
+        ** sequence converted by a previous call anymore. */
+        self->newseq = 0;
+        Server_waitForCallback((Server *)self->server);
+
         tmp = arg;
         Py_INCREF(tmp);
         Py_XDECREF(self->tmp);
         self->tmp = tmp;
+        self->newSeqsize = PyList_Size(self->tmp);
+        self->newSeq = (int *)realloc(self->newSeq, self->newSeqsize * sizeof(int));
+        for (i=0; i<self->newSeqsize; i++) {
+            num = PyNumber_Int(PyList_GET_ITEM(self->tmp, i));
+            self->newSeq[i] = PyInt_AS_LONG(num);
+            Py_DECREF(num);
+        }
         self->newseq = 1;
     }
 
@@ -1034,6 +1052,7 @@ Clouder_generate_a(Clouder *self) {
 MYFLT *
 Clouder_getSamplesBuffer(Clouder *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -2094,30 +2113,35 @@ Beater_generate_a(Beater *self) {
 MYFLT *
 Beater_getSamplesBuffer(Beater *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
 MYFLT *
 Beater_getTapBuffer(Beater *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->tap_buffer_streams;
 }
 
 MYFLT *
 Beater_getAmpBuffer(Beater *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->amp_buffer_streams;
 }
 
 MYFLT *
 Beater_getDurBuffer(Beater *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->dur_buffer_streams;
 }
 
 MYFLT *
 Beater_getEndBuffer(Beater *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->end_buffer_streams;
 }
 
@@ -3825,30 +3849,35 @@ TrigBurster_generate_i(TrigBurster *self) {
 MYFLT *
 TrigBurster_getSamplesBuffer(TrigBurster *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
 MYFLT *
 TrigBurster_getTapBuffer(TrigBurster *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->tap_buffer_streams;
 }
 
 MYFLT *
 TrigBurster_getAmpBuffer(TrigBurster *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->amp_buffer_streams;
 }
 
 MYFLT *
 TrigBurster_getDurBuffer(TrigBurster *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->dur_buffer_streams;
 }
 
 MYFLT *
 TrigBurster_getEndBuffer(TrigBurster *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->end_buffer_streams;
 }
 
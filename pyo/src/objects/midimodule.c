@@ -36,6 +36,17 @@ typedef struct {
 static void
 CtlScan_setProcMode(CtlScan *self) {}
 
+static void
+CtlScan_callFunction(PyObject *obj, double value)
+{
+    PyObject *tup;
+    CtlScan *self = (CtlScan *)obj;
+
+    tup = PyTuple_New(1);
+    PyTuple_SetItem(tup, 0, PyInt_FromLong((long)value));
+    PyObject_Call((PyObject *)self->callable, tup, NULL);
+}
+
 static void
 CtlScan_compute_next_data_frame(CtlScan *self)
 {
@@ -46,7 +57,6 @@ CtlScan_compute_next_data_frame(CtlScan *self)
     count = Server_getMidiEventCount((Server *)self->server);
 
     if (count > 0) {
-        PyObject *tup;
         for (i=count-1; i>=0; i--) {
             int status = PyoMidi_MessageStatus(buffer[i].message);	// Temp note event holders
             int number = PyoMidi_MessageData1(buffer[i].message);
@@ -55,9 +65,7 @@ CtlScan_compute_next_data_frame(CtlScan *self)
             if ((status & 0xF0) == 0xB0) {
                 if (number != self->ctlnumber) {
                     self->ctlnumber = number;
-                    tup = PyTuple_New(1);
-                    PyTuple_SetItem(tup, 0, PyInt_FromLong(self->ctlnumber));
-                    PyObject_Call((PyObject *)self->callable, tup, NULL);
+                    Server_defer((Server *)self->server, (PyObject *)self, CtlScan_callFunction, self->ctlnumber);
                 }
                 if (self->toprint == 1)
                     printf("ctl number : %i, ctl value : %i, midi channel : %i\n", self->ctlnumber, value, status - 0xB0 + 1);
@@ -234,6 +242,19 @@ typedef struct {
 static void
 CtlScan2_setProcMode(CtlScan2 *self) {}
 
+/* value is ctlnumber * 256 + midichnl. */
+static void
+CtlScan2_callFunction(PyObject *obj, double value)
+{
+    PyObject *tup;
+    CtlScan2 *self = (CtlScan2 *)obj;
+
+    tup = PyTuple_New(2);
+    PyTuple_SetItem(tup, 0, PyInt_FromLong((long)value / 256));
+    PyTuple_SetItem(tup, 1, PyInt_FromLong((long)value % 256));
+    PyObject_Call((PyObject *)self->callable, tup, NULL);
+}
+
 static void
 CtlScan2_compute_next_data_frame(CtlScan2 *self)
 {
@@ -244,7 +265,6 @@ CtlScan2_compute_next_data_frame(CtlScan2 *self)
     count = Server_getMidiEventCount((Server *)self->server);
 
     if (count > 0) {
-        PyObject *tup;
         for (i=count-1; i>=0; i--) {
             int status = PyoMidi_MessageStatus(buffer[i].message);	// Temp note event holders
             int number = PyoMidi_MessageData1(buffer[i].message);
@@ -255,10 +275,8 @@ CtlScan2_compute_next_data_frame(CtlScan2 *self)
                 if (number != self->ctlnumber || midichnl != self->midichnl) {
                     self->ctlnumber = number;
                     self->midichnl = midichnl;
-                    tup = PyTuple_New(2);
-                    PyTuple_SetItem(tup, 0, PyInt_FromLong(self->ctlnumber));
-                    PyTuple_SetItem(tup, 1, PyInt_FromLong(self->midichnl));
-                    PyObject_Call((PyObject *)self->callable, tup, NULL);
+                    Server_defer((Server *)self->server, (PyObject *)self, CtlScan2_callFunction,
+                                 self->ctlnumber * 256 + self->midichnl);
                 }
                 if (self->toprint == 1)
                     printf("ctl number : %i, ctl value : %i, midi channel : %i\n", self->ctlnumber, value, midichnl);
@@ -2043,6 +2061,7 @@ MidiNote_dealloc(MidiNote* self)
 static MYFLT *
 MidiNote_get_trigger_buffer(MidiNote *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return self->trigger_streams;
 }
 
@@ -2094,6 +2113,7 @@ MidiNote_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
 MYFLT MidiNote_getValue(MidiNote *self, int voice, int which)
 {
+    PYO_GRAPH_READ(self->stream);
     MYFLT val = -1.0;
     int midival = self->notebuf[voice*2+which];
     if (which == 0 && midival != -1) {
@@ -3632,6 +3652,21 @@ typedef struct {
 static void
 RawMidi_setProcMode(RawMidi *self) {}
 
+/* value is status * 65536 + data1 * 256 + data2. */
+static void
+RawMidi_callFunction(PyObject *obj, double value)
+{
+    PyObject *tup;
+    long msg = (long)value;
+    RawMidi *self = (RawMidi *)obj;
+
+    tup = PyTuple_New(3);
+    PyTuple_SetItem(tup, 0, PyInt_FromLong((msg >> 16) & 0xFF));
+    PyTuple_SetItem(tup, 1, PyInt_FromLong((msg >> 8) & 0xFF));
+    PyTuple_SetItem(tup, 2, PyInt_FromLong(msg & 0xFF));
+    PyObject_Call((PyObject *)self->callable, tup, NULL);
+}
+
 static void
 RawMidi_compute_next_data_frame(RawMidi *self)
 {
@@ -3642,16 +3677,12 @@ RawMidi_compute_next_data_frame(RawMidi *self)
     count = Server_getMidiEventCount((Server *)self->server);
 
     if (count > 0) {
-        PyObject *tup;
         for (i=count-1; i>=0; i--) {
             status = PyoMidi_MessageStatus(buffer[i].message);	// Temp note event holders
             data1 = PyoMidi_MessageData1(buffer[i].message);
             data2 = PyoMidi_MessageData2(buffer[i].message);
-            tup = PyTuple_New(3);
-            PyTuple_SetItem(tup, 0, PyInt_FromLong(status));
-            PyTuple_SetItem(tup, 1, PyInt_FromLong(data1));
-            PyTuple_SetItem(tup, 2, PyInt_FromLong(data2));
-            PyObject_Call((PyObject *)self->callable, tup, NULL);
+            Server_defer((Server *)self->server, (PyObject *)self, RawMidi_callFunction,
+                         (status & 0xFF) * 65536 + (data1 & 0xFF) * 256 + (data2 & 0xFF));
         }
     }
 }
@@ -35,23 +35,25 @@ typedef struct {
 static void
 Noise_generate(Noise *self) {
     int i;
+    FUSED_MULADD_INIT
 
     for (i=0; i<self->bufsize; i++) {
-        self->data[i] = RANDOM_UNIFORM * 1.98 - 0.99;
+        self->data[i] = FUSED_MULADD(RANDOM_UNIFORM * 1.98 - 0.99);
     }
 }
 
 static void
 Noise_generate_cheap(Noise *self) {
     int i;
+    FUSED_MULADD_INIT
 
     for (i=0; i<self->bufsize; i++) {
         self->seed = (self->seed * 15625 + 1) & 0xFFFF;
-        self->data[i] = (self->seed - 0x8000) * 3.0517578125e-05;
+        self->data[i] = FUSED_MULADD((self->seed - 0x8000) * 3.0517578125e-05);
     }
 }
 
-static void Noise_postprocessing_ii(Noise *self) { POST_PROCESSING_II };
+static void Noise_postprocessing_ii(Noise *self) { POST_PROCESSING_FUSED };
 static void Noise_postprocessing_ai(Noise *self) { POST_PROCESSING_AI };
 static void Noise_postprocessing_ia(Noise *self) { POST_PROCESSING_IA };
 static void Noise_postprocessing_aa(Noise *self) { POST_PROCESSING_AA };
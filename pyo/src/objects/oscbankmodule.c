@@ -553,6 +553,7 @@ OscBank_setTable(OscBank *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -76,6 +76,7 @@ static void
 Sine_readframes_ii(Sine *self) {
     MYFLT inc, fr, ph, pos, fpart;
     int i, ipart;
+    FUSED_MULADD_INIT
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     ph = PyFloat_AS_DOUBLE(self->phase) * 512;
@@ -88,7 +89,7 @@ Sine_readframes_ii(Sine *self) {
             pos -= 512;
         ipart = (int)pos;
         fpart = pos - ipart;
-        self->data[i] = SINE_ARRAY[ipart] * (1.0 - fpart) + SINE_ARRAY[ipart+1] * fpart;
+        self->data[i] = FUSED_MULADD(SINE_ARRAY[ipart] * (1.0 - fpart) + SINE_ARRAY[ipart+1] * fpart);
         self->pointerPos += inc;
     }
 }
@@ -97,6 +98,7 @@ static void
 Sine_readframes_ai(Sine *self) {
     MYFLT inc, ph, pos, fpart, fac;
     int i, ipart;
+    FUSED_MULADD_INIT
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     ph = PyFloat_AS_DOUBLE(self->phase) * 512;
@@ -110,7 +112,7 @@ Sine_readframes_ai(Sine *self) {
             pos -= 512;
         ipart = (int)pos;
         fpart = pos - ipart;
-        self->data[i] = SINE_ARRAY[ipart] * (1.0 - fpart) + SINE_ARRAY[ipart+1] * fpart;
+        self->data[i] = FUSED_MULADD(SINE_ARRAY[ipart] * (1.0 - fpart) + SINE_ARRAY[ipart+1] * fpart);
         self->pointerPos += inc;
     }
 }
@@ -119,6 +121,7 @@ static void
 Sine_readframes_ia(Sine *self) {
     MYFLT inc, fr, pos, fpart;
     int i, ipart;
+    FUSED_MULADD_INIT
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *ph = Stream_getData((Stream *)self->phase_stream);
@@ -131,7 +134,7 @@ Sine_readframes_ia(Sine *self) {
             pos -= 512;
         ipart = (int)pos;
         fpart = pos - ipart;
-        self->data[i] = SINE_ARRAY[ipart] * (1.0 - fpart) + SINE_ARRAY[ipart+1] * fpart;
+        self->data[i] = FUSED_MULADD(SINE_ARRAY[ipart] * (1.0 - fpart) + SINE_ARRAY[ipart+1] * fpart);
         self->pointerPos += inc;
     }
 }
@@ -140,6 +143,7 @@ static void
 Sine_readframes_aa(Sine *self) {
     MYFLT inc, pos, fpart, fac;
     int i, ipart;
+    FUSED_MULADD_INIT
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     MYFLT *ph = Stream_getData((Stream *)self->phase_stream);
@@ -153,12 +157,12 @@ Sine_readframes_aa(Sine *self) {
             pos -= 512;
         ipart = (int)pos;
         fpart = pos - ipart;
-        self->data[i] = SINE_ARRAY[ipart] * (1.0 - fpart) + SINE_ARRAY[ipart+1] * fpart;
+        self->data[i] = FUSED_MULADD(SINE_ARRAY[ipart] * (1.0 - fpart) + SINE_ARRAY[ipart+1] * fpart);
         self->pointerPos += inc;
     }
 }
 
-static void Sine_postprocessing_ii(Sine *self) { POST_PROCESSING_II };
+static void Sine_postprocessing_ii(Sine *self) { POST_PROCESSING_FUSED };
 static void Sine_postprocessing_ai(Sine *self) { POST_PROCESSING_AI };
 static void Sine_postprocessing_ia(Sine *self) { POST_PROCESSING_IA };
 static void Sine_postprocessing_aa(Sine *self) { POST_PROCESSING_AA };
@@ -1503,14 +1507,18 @@ typedef struct {
     int modebuffer[4];
     double pointerPos;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
-    MYFLT (*interp_func_ptr)(MYFLT *, int, MYFLT, int);
+    interp_block_func interp_func_ptr;
+    int *interpIndex; /* scratch buffers of the block interpolation */
+    MYFLT *interpFrac;
 } Osc;
 
 static void
 Osc_readframes_ii(Osc *self) {
-    MYFLT fr, ph, fpart;
+    MYFLT fr, ph;
     double inc, pos;
-    int i, ipart;
+    int i;
+    int *ipart = self->interpIndex;
+    MYFLT *fpart = self->interpFrac;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
 
@@ -1525,17 +1533,19 @@ Osc_readframes_ii(Osc *self) {
         pos = self->pointerPos + ph;
         if (pos >= size)
             pos -= size;
-        ipart = (int)pos;
-        fpart = pos - ipart;
-        self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+        ipart[i] = (int)pos;
+        fpart[i] = pos - ipart[i];
     }
+    (*self->interp_func_ptr)(tablelist, size, ipart, fpart, self->data, self->bufsize);
 }
 
 static void
 Osc_readframes_ai(Osc *self) {
-    MYFLT ph, fpart, sizeOnSr;
+    MYFLT ph, sizeOnSr;
     double inc, pos;
-    int i, ipart;
+    int i;
+    int *ipart = self->interpIndex;
+    MYFLT *fpart = self->interpFrac;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
 
@@ -1551,17 +1561,19 @@ Osc_readframes_ai(Osc *self) {
         pos = self->pointerPos + ph;
         if (pos >= size)
             pos -= size;
-        ipart = (int)pos;
-        fpart = pos - ipart;
-        self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+        ipart[i] = (int)pos;
+        fpart[i] = pos - ipart[i];
     }
+    (*self->interp_func_ptr)(tablelist, size, ipart, fpart, self->data, self->bufsize);
 }
 
 static void
 Osc_readframes_ia(Osc *self) {
-    MYFLT fr, pha, fpart;
+    MYFLT fr, pha;
     double inc, pos;
-    int i, ipart;
+    int i;
+    int *ipart = self->interpIndex;
+    MYFLT *fpart = self->interpFrac;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
 
@@ -1576,17 +1588,19 @@ Osc_readframes_ia(Osc *self) {
         pos = self->pointerPos + pha;
         if (pos >= size)
             pos -= size;
-        ipart = (int)pos;
-        fpart = pos - ipart;
-        self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+        ipart[i] = (int)pos;
+        fpart[i] = pos - ipart[i];
     }
+    (*self->interp_func_ptr)(tablelist, size, ipart, fpart, self->data, self->bufsize);
 }
 
 static void
 Osc_readframes_aa(Osc *self) {
-    MYFLT pha, fpart, sizeOnSr;
+    MYFLT pha, sizeOnSr;
     double inc, pos;
-    int i, ipart;
+    int i;
+    int *ipart = self->interpIndex;
+    MYFLT *fpart = self->interpFrac;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
 
@@ -1602,10 +1616,10 @@ Osc_readframes_aa(Osc *self) {
         pos = self->pointerPos + pha;
         if (pos >= size)
             pos -= size;
-        ipart = (int)pos;
-        fpart = pos - ipart;
-        self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+        ipart[i] = (int)pos;
+        fpart[i] = pos - ipart[i];
     }
+    (*self->interp_func_ptr)(tablelist, size, ipart, fpart, self->data, self->bufsize);
 }
 
 static void Osc_postprocessing_ii(Osc *self) { POST_PROCESSING_II };
@@ -1705,6 +1719,8 @@ static void
 Osc_dealloc(Osc* self)
 {
     pyo_DEALLOC
+    free(self->interpIndex);
+    free(self->interpFrac);
     Osc_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -1730,6 +1746,9 @@ Osc_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Stream_setFunctionPtr(self->stream, Osc_compute_next_data_frame);
     self->mode_func_ptr = Osc_setProcMode;
 
+    self->interpIndex = (int *)realloc(self->interpIndex, self->bufsize * sizeof(int));
+    self->interpFrac = (MYFLT *)realloc(self->interpFrac, self->bufsize * sizeof(MYFLT));
+
     static char *kwlist[] = {"table", "freq", "phase", "interp", "mul", "add", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|OOiOO", kwlist, &tabletmp, &freqtmp, &phasetmp, &self->interp, &multmp, &addtmp))
@@ -1762,7 +1781,7 @@ Osc_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     (*self->mode_func_ptr)(self);
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     return (PyObject *)self;
 }
@@ -1804,6 +1823,7 @@ Osc_setTable(Osc *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -1882,7 +1902,7 @@ Osc_setInterp(Osc *self, PyObject *arg)
 		self->interp = PyInt_AsLong(PyNumber_Int(arg));
     }
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -2322,6 +2342,7 @@ OscLoop_setTable(OscLoop *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -2842,6 +2863,7 @@ OscTrig_setTable(OscTrig *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -3096,6 +3118,7 @@ Phasor_readframes_ii(Phasor *self) {
     MYFLT fr, ph;
     double inc, pos;
     int i;
+    FUSED_MULADD_INIT
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     ph = _clip(PyFloat_AS_DOUBLE(self->phase));
@@ -3105,7 +3128,7 @@ Phasor_readframes_ii(Phasor *self) {
         pos = self->pointerPos + ph;
         if (pos > 1)
             pos -= 1.0;
-        self->data[i] = pos;
+        self->data[i] = FUSED_MULADD(pos);
 
         self->pointerPos += inc;
         if (self->pointerPos < 0)
@@ -3120,6 +3143,7 @@ Phasor_readframes_ai(Phasor *self) {
     MYFLT ph, oneOnSr;
     double inc, pos;
     int i;
+    FUSED_MULADD_INIT
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     ph = _clip(PyFloat_AS_DOUBLE(self->phase));
@@ -3129,7 +3153,7 @@ Phasor_readframes_ai(Phasor *self) {
         pos = self->pointerPos + ph;
         if (pos > 1)
             pos -= 1.0;
-        self->data[i] = pos;
+        self->data[i] = FUSED_MULADD(pos);
 
         inc = fr[i] * oneOnSr;
         self->pointerPos += inc;
@@ -3145,6 +3169,7 @@ Phasor_readframes_ia(Phasor *self) {
     MYFLT fr, pha;
     double inc, pos;
     int i;
+    FUSED_MULADD_INIT
 
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *ph = Stream_getData((Stream *)self->phase_stream);
@@ -3157,7 +3182,7 @@ Phasor_readframes_ia(Phasor *self) {
         pos = self->pointerPos + pha;
         if (pos > 1)
             pos -= 1.0;
-        self->data[i] = pos;
+        self->data[i] = FUSED_MULADD(pos);
 
         self->pointerPos += inc;
         if (self->pointerPos < 0)
@@ -3172,6 +3197,7 @@ Phasor_readframes_aa(Phasor *self) {
     MYFLT pha, oneOnSr;
     double inc, pos;
     int i;
+    FUSED_MULADD_INIT
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     MYFLT *ph = Stream_getData((Stream *)self->phase_stream);
@@ -3184,7 +3210,7 @@ Phasor_readframes_aa(Phasor *self) {
         pos = self->pointerPos + pha;
         if (pos > 1)
             pos -= 1.0;
-        self->data[i] = pos;
+        self->data[i] = FUSED_MULADD(pos);
 
         inc = fr[i] * oneOnSr;
         self->pointerPos += inc;
@@ -3195,7 +3221,7 @@ Phasor_readframes_aa(Phasor *self) {
     }
 }
 
-static void Phasor_postprocessing_ii(Phasor *self) { POST_PROCESSING_II };
+static void Phasor_postprocessing_ii(Phasor *self) { POST_PROCESSING_FUSED };
 static void Phasor_postprocessing_ai(Phasor *self) { POST_PROCESSING_AI };
 static void Phasor_postprocessing_ia(Phasor *self) { POST_PROCESSING_IA };
 static void Phasor_postprocessing_aa(Phasor *self) { POST_PROCESSING_AA };
@@ -3551,13 +3577,16 @@ typedef struct {
     PyObject *index;
     Stream *index_stream;
     int modebuffer[2];
+    int *interpIndex; /* scratch buffers of the block interpolation */
+    MYFLT *interpFrac;
 } Pointer;
 
 static void
 Pointer_readframes_a(Pointer *self) {
-    MYFLT fpart;
+    MYFLT *fpart = self->interpFrac;
     double ph;
-    int i, ipart;
+    int i;
+    int *ipart = self->interpIndex;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
 
@@ -3565,10 +3594,10 @@ Pointer_readframes_a(Pointer *self) {
 
     for (i=0; i<self->bufsize; i++) {
         ph = Osc_clip(pha[i] * size, size);
-        ipart = (int)ph;
-        fpart = ph - ipart;
-        self->data[i] = tablelist[ipart] + (tablelist[ipart+1] - tablelist[ipart]) * fpart;
+        ipart[i] = (int)ph;
+        fpart[i] = ph - ipart[i];
     }
+    (*interp_get_block_func(2))(tablelist, size, ipart, fpart, self->data, self->bufsize);
 }
 
 static void Pointer_postprocessing_ii(Pointer *self) { POST_PROCESSING_II };
@@ -3651,6 +3680,8 @@ static void
 Pointer_dealloc(Pointer* self)
 {
     pyo_DEALLOC
+    free(self->interpIndex);
+    free(self->interpFrac);
     Pointer_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -3670,6 +3701,9 @@ Pointer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Stream_setFunctionPtr(self->stream, Pointer_compute_next_data_frame);
     self->mode_func_ptr = Pointer_setProcMode;
 
+    self->interpIndex = (int *)realloc(self->interpIndex, self->bufsize * sizeof(int));
+    self->interpFrac = (MYFLT *)realloc(self->interpFrac, self->bufsize * sizeof(MYFLT));
+
     static char *kwlist[] = {"table", "index", "mul", "add", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "OO|OO", kwlist, &tabletmp, &indextmp, &multmp, &addtmp))
@@ -3736,6 +3770,7 @@ Pointer_setTable(Pointer *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -3892,34 +3927,37 @@ typedef struct {
     MYFLT y2;
     MYFLT c;
     MYFLT lastPh;
-    MYFLT (*interp_func_ptr)(MYFLT *, int, MYFLT, int);
+    interp_block_func interp_func_ptr;
+    int *interpIndex; /* scratch buffers of the block interpolation */
+    MYFLT *interpFrac;
 } Pointer2;
 
 static void
 Pointer2_readframes_a(Pointer2 *self) {
-    MYFLT fpart, phdiff, b, fr;
+    MYFLT phdiff, b, fr;
+    MYFLT *fpart = self->interpFrac;
     double ph;
-    int i, ipart;
+    int i;
+    int *ipart = self->interpIndex;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
     double tableSr = TableStream_getSamplingRate(self->table);
 
     MYFLT *pha = Stream_getData((Stream *)self->index_stream);
 
+    for (i=0; i<self->bufsize; i++) {
+        ph = Osc_clip(pha[i] * size, size);
+        ipart[i] = (int)ph;
+        fpart[i] = ph - ipart[i];
+    }
+    (*self->interp_func_ptr)(tablelist, size, ipart, fpart, self->data, self->bufsize);
+
     if (!self->autosmooth) {
-        for (i=0; i<self->bufsize; i++) {
-            ph = Osc_clip(pha[i] * size, size);
-            ipart = (int)ph;
-            fpart = ph - ipart;
-            self->y1 = self->y2 = self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
-        }
+        self->y1 = self->y2 = self->data[self->bufsize-1];
     }
     else {
         for (i=0; i<self->bufsize; i++) {
             ph = Osc_clip(pha[i] * size, size);
-            ipart = (int)ph;
-            fpart = ph - ipart;
-            self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
             phdiff = MYFABS(ph - self->lastPh);
             self->lastPh = ph;
             if (phdiff < 1) {
@@ -4015,6 +4053,8 @@ static void
 Pointer2_dealloc(Pointer2* self)
 {
     pyo_DEALLOC
+    free(self->interpIndex);
+    free(self->interpFrac);
     Pointer2_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -4037,6 +4077,9 @@ Pointer2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Stream_setFunctionPtr(self->stream, Pointer2_compute_next_data_frame);
     self->mode_func_ptr = Pointer2_setProcMode;
 
+    self->interpIndex = (int *)realloc(self->interpIndex, self->bufsize * sizeof(int));
+    self->interpFrac = (MYFLT *)realloc(self->interpFrac, self->bufsize * sizeof(MYFLT));
+
     static char *kwlist[] = {"table", "index", "interp", "autosmooth", "mul", "add", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "OO|iiOO", kwlist, &tabletmp, &indextmp, &self->interp, &self->autosmooth, &multmp, &addtmp))
@@ -4063,7 +4106,7 @@ Pointer2_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     (*self->mode_func_ptr)(self);
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     return (PyObject *)self;
 }
@@ -4105,6 +4148,7 @@ Pointer2_setTable(Pointer2 *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -4147,7 +4191,7 @@ Pointer2_setInterp(Pointer2 *self, PyObject *arg)
 		self->interp = PyInt_AsLong(PyNumber_Int(arg));
     }
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -4475,6 +4519,7 @@ TableIndex_setTable(TableIndex *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -4819,6 +4864,7 @@ Lookup_setTable(Lookup *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -5561,6 +5607,7 @@ Pulsar_setTable(Pulsar *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -5824,13 +5871,17 @@ typedef struct {
     TriggerStream *trig_stream;
     int init;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
-    MYFLT (*interp_func_ptr)(MYFLT *, int, MYFLT, int);
+    interp_block_func interp_func_ptr;
+    int *interpIndex; /* scratch buffers of the block interpolation */
+    MYFLT *interpFrac;
 } TableRead;
 
 static void
 TableRead_readframes_i(TableRead *self) {
-    MYFLT fr, inc, fpart;
-    int i, ipart;
+    MYFLT fr, inc;
+    int i, num = 0;
+    int *ipart = self->interpIndex;
+    MYFLT *fpart = self->interpFrac;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
 
@@ -5838,7 +5889,7 @@ TableRead_readframes_i(TableRead *self) {
     inc = fr * size / self->sr;
 
     if (self->go == 0)
-        PyObject_CallMethod((PyObject *)self, "stop", NULL);
+        Server_deferStop((Server *)self->server, (PyObject *)self);
 
     for (i=0; i<self->bufsize; i++) {
         self->trigsBuffer[i] = 0.0;
@@ -5857,21 +5908,25 @@ TableRead_readframes_i(TableRead *self) {
                 self->go = 0;
         }
         if (self->go == 1) {
-            ipart = (int)self->pointerPos;
-            fpart = self->pointerPos - ipart;
-            self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+            ipart[i] = (int)self->pointerPos;
+            fpart[i] = self->pointerPos - ipart[i];
+            num = i + 1;
         }
         else
             self->data[i] = 0.0;
 
         self->pointerPos += inc;
     }
+    /* go never comes back to 1 inside a buffer. */
+    (*self->interp_func_ptr)(tablelist, size, ipart, fpart, self->data, num);
 }
 
 static void
 TableRead_readframes_a(TableRead *self) {
-    MYFLT inc, fpart, sizeOnSr;
-    int i, ipart;
+    MYFLT inc, sizeOnSr;
+    int i, num = 0;
+    int *ipart = self->interpIndex;
+    MYFLT *fpart = self->interpFrac;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
 
@@ -5880,7 +5935,7 @@ TableRead_readframes_a(TableRead *self) {
     sizeOnSr = size / self->sr;
 
     if (self->go == 0)
-        PyObject_CallMethod((PyObject *)self, "stop", NULL);
+        Server_deferStop((Server *)self->server, (PyObject *)self);
 
     for (i=0; i<self->bufsize; i++) {
         self->trigsBuffer[i] = 0.0;
@@ -5899,9 +5954,9 @@ TableRead_readframes_a(TableRead *self) {
                 self->go = 0;
         }
         if (self->go == 1) {
-            ipart = (int)self->pointerPos;
-            fpart = self->pointerPos - ipart;
-            self->data[i] = (*self->interp_func_ptr)(tablelist, ipart, fpart, size);
+            ipart[i] = (int)self->pointerPos;
+            fpart[i] = self->pointerPos - ipart[i];
+            num = i + 1;
         }
         else
             self->data[i] = 0.0;
@@ -5909,6 +5964,8 @@ TableRead_readframes_a(TableRead *self) {
         inc = fr[i] * sizeOnSr;
         self->pointerPos += inc;
     }
+    /* go never comes back to 1 inside a buffer. */
+    (*self->interp_func_ptr)(tablelist, size, ipart, fpart, self->data, num);
 }
 
 static void TableRead_postprocessing_ii(TableRead *self) { POST_PROCESSING_II };
@@ -6000,6 +6057,8 @@ static void
 TableRead_dealloc(TableRead* self)
 {
     pyo_DEALLOC
+    free(self->interpIndex);
+    free(self->interpFrac);
     free(self->trigsBuffer);
     TableRead_clear(self);
     self->ob_type->tp_free((PyObject*)self);
@@ -6027,6 +6086,9 @@ TableRead_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Stream_setFunctionPtr(self->stream, TableRead_compute_next_data_frame);
     self->mode_func_ptr = TableRead_setProcMode;
 
+    self->interpIndex = (int *)realloc(self->interpIndex, self->bufsize * sizeof(int));
+    self->interpFrac = (MYFLT *)realloc(self->interpFrac, self->bufsize * sizeof(MYFLT));
+
     static char *kwlist[] = {"table", "freq", "loop", "interp", "mul", "add", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|OiiOO", kwlist, &tabletmp, &freqtmp, &self->loop, &self->interp, &multmp, &addtmp))
@@ -6064,10 +6126,11 @@ TableRead_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
     (*self->mode_func_ptr)(self);
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     self->init = 1;
 
@@ -6129,6 +6192,7 @@ TableRead_setTable(TableRead *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -6187,7 +6251,7 @@ TableRead_setInterp(TableRead *self, PyObject *arg)
 		self->interp = PyInt_AsLong(PyNumber_Int(arg));
     }
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -8355,6 +8419,7 @@ Rossler_setChaos(Rossler *self, PyObject *arg)
 MYFLT *
 Rossler_getAltBuffer(Rossler *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->altBuffer;
 }
 
@@ -9130,6 +9195,7 @@ Lorenz_setChaos(Lorenz *self, PyObject *arg)
 MYFLT *
 Lorenz_getAltBuffer(Lorenz *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->altBuffer;
 }
 
@@ -9913,6 +9979,7 @@ ChenLee_setChaos(ChenLee *self, PyObject *arg)
 MYFLT *
 ChenLee_getAltBuffer(ChenLee *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->altBuffer;
 }
 
@@ -12358,7 +12425,7 @@ TableScale_readframes_ii(TableScale *self) {
     MYFLT mul, add;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
-    MYFLT *outlist = TableStream_getData(self->outtable);
+    MYFLT *outlist = TableStream_getWritableData(self->outtable);
     int osize = TableStream_getSize(self->outtable);
 
     mul = PyFloat_AS_DOUBLE(self->mul);
@@ -12376,7 +12443,7 @@ TableScale_readframes_ai(TableScale *self) {
     MYFLT add;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
-    MYFLT *outlist = TableStream_getData(self->outtable);
+    MYFLT *outlist = TableStream_getWritableData(self->outtable);
     int osize = TableStream_getSize(self->outtable);
 
     MYFLT *mul = Stream_getData((Stream *)self->mul_stream);
@@ -12394,7 +12461,7 @@ TableScale_readframes_ia(TableScale *self) {
     MYFLT mul;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
-    MYFLT *outlist = TableStream_getData(self->outtable);
+    MYFLT *outlist = TableStream_getWritableData(self->outtable);
     int osize = TableStream_getSize(self->outtable);
 
     mul = PyFloat_AS_DOUBLE(self->mul);
@@ -12411,7 +12478,7 @@ TableScale_readframes_aa(TableScale *self) {
     int i, num;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
-    MYFLT *outlist = TableStream_getData(self->outtable);
+    MYFLT *outlist = TableStream_getWritableData(self->outtable);
     int osize = TableStream_getSize(self->outtable);
 
     MYFLT *mul = Stream_getData((Stream *)self->mul_stream);
@@ -12563,6 +12630,7 @@ TableScale_setTable(TableScale *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -52,6 +52,7 @@ int OscReceiver_handler(const char *path, const char *types, lo_arg **argv, int
 MYFLT OscReceiver_getValue(OscReceiver *self, PyObject *path)
 {
     PyObject *tmp;
+    PYO_GRAPH_READ(self->stream);
     tmp = PyDict_GetItem(self->dict, path);
     return PyFloat_AsDouble(tmp);
 }
@@ -99,6 +100,7 @@ OscReceiver_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, OscReceiver_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
 
     static char *kwlist[] = {"port", "address", NULL};
 
@@ -364,6 +366,7 @@ OscReceive_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->factor = 1. / (0.01 * self->sr);
 
     Stream_setFunctionPtr(self->stream, OscReceive_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
     self->mode_func_ptr = OscReceive_setProcMode;
 
     static char *kwlist[] = {"input", "address", "mul", "add", NULL};
@@ -611,6 +614,7 @@ OscSend_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, OscSend_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
 
     static char *kwlist[] = {"input", "port", "address", "host", NULL};
 
@@ -847,6 +851,7 @@ OscDataSend_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, OscDataSend_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
 
     static char *kwlist[] = {"types", "port", "address", "host", NULL};
 
@@ -1101,6 +1106,7 @@ OscDataReceive_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, OscDataReceive_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
 
     static char *kwlist[] = {"port", "address", "callable", NULL};
 
@@ -1254,6 +1260,7 @@ PyObject *
 OscListReceiver_getValue(OscListReceiver *self, PyObject *path)
 {
     PyObject *tmp;
+    PYO_GRAPH_READ(self->stream);
     tmp = PyDict_GetItem(self->dict, path);
     return tmp;
 }
@@ -1303,6 +1310,7 @@ OscListReceiver_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, OscListReceiver_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
 
     static char *kwlist[] = {"port", "address", "num", NULL};
 
@@ -1586,6 +1594,7 @@ OscListReceive_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->factor = 1. / (0.01 * self->sr);
 
     Stream_setFunctionPtr(self->stream, OscListReceive_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
     self->mode_func_ptr = OscListReceive_setProcMode;
 
     static char *kwlist[] = {"input", "address", "order", "mul", "add", NULL};
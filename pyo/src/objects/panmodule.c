@@ -190,6 +190,7 @@ Panner_splitter_aa(Panner *self) {
 MYFLT *
 Panner_getSamplesBuffer(Panner *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -851,6 +852,7 @@ SPanner_splitter_a(SPanner *self) {
 MYFLT *
 SPanner_getSamplesBuffer(SPanner *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -1418,6 +1420,7 @@ Switcher_splitter_a(Switcher *self) {
 MYFLT *
 Switcher_getSamplesBuffer(Switcher *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -2259,6 +2262,7 @@ Mixer_generate(Mixer *self) {
 MYFLT *
 Mixer_getSamplesBuffer(Mixer *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 
@@ -2329,6 +2333,7 @@ Mixer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Mixer_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
     self->mode_func_ptr = Mixer_setProcMode;
 
     static char *kwlist[] = {"outs", "time", NULL};
@@ -2984,6 +2989,7 @@ Selector_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Selector_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
     self->mode_func_ptr = Selector_setProcMode;
 
     static char *kwlist[] = {"inputs", "voice", "mul", "add", NULL};
@@ -3050,6 +3056,7 @@ Selector_setInputs(Selector *self, PyObject *arg)
     Py_INCREF(tmp);
 	Py_XDECREF(self->inputs);
     self->inputs = tmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
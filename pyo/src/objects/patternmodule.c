@@ -37,11 +37,30 @@ typedef struct {
     int init;
 } Pattern;
 
+static void
+Pattern_callFunction(PyObject *obj, double value) {
+    PyObject *tuple, *result;
+    Pattern *self = (Pattern *)obj;
+
+    if (self->arg == Py_None)
+        tuple = PyTuple_New(0);
+    else {
+        tuple = PyTuple_New(1);
+        Py_INCREF(self->arg);
+        PyTuple_SET_ITEM(tuple, 0, self->arg);
+    }
+    result = PyObject_Call((PyObject *)self->callable, tuple, NULL);
+    Py_DECREF(tuple);
+    if (result == NULL)
+        PyErr_Print();
+    else
+        Py_DECREF(result);
+}
+
 static void
 Pattern_generate_i(Pattern *self) {
     int i;
     MYFLT tm;
-    PyObject *tuple, *result;
 
     tm = PyFloat_AS_DOUBLE(self->time);
 
@@ -53,21 +72,7 @@ Pattern_generate_i(Pattern *self) {
     for (i=0; i<self->bufsize; i++) {
         if (self->currentTime >= tm) {
             self->currentTime = 0.0;
-            if (self->arg == Py_None) {
-                result = PyObject_Call((PyObject *)self->callable, PyTuple_New(0), NULL);
-                if (result == NULL) {
-                    PyErr_Print();
-                    return;
-                }
-            } else {
-                tuple = PyTuple_New(1);
-                PyTuple_SET_ITEM(tuple, 0, self->arg);
-                result = PyObject_Call((PyObject *)self->callable, tuple, NULL);
-                if (result == NULL) {
-                    PyErr_Print();
-                    return;
-                }
-            }
+            Server_defer((Server *)self->server, (PyObject *)self, Pattern_callFunction, 0.0);
         }
         self->currentTime += self->sampleToSec;
     }
@@ -76,7 +81,6 @@ Pattern_generate_i(Pattern *self) {
 static void
 Pattern_generate_a(Pattern *self) {
     int i;
-    PyObject *tuple, *result;
 
     MYFLT *tm = Stream_getData((Stream *)self->time_stream);
 
@@ -88,21 +92,7 @@ Pattern_generate_a(Pattern *self) {
     for (i=0; i<self->bufsize; i++) {
         if (self->currentTime >= tm[i]) {
             self->currentTime = 0.0;
-            if (self->arg == Py_None) {
-                result = PyObject_Call((PyObject *)self->callable, PyTuple_New(0), NULL);
-                if (result == NULL) {
-                    PyErr_Print();
-                    return;
-                }
-            } else {
-                tuple = PyTuple_New(1);
-                PyTuple_SET_ITEM(tuple, 0, self->arg);
-                result = PyObject_Call((PyObject *)self->callable, tuple, NULL);
-                if (result == NULL) {
-                    PyErr_Print();
-                    return;
-                }
-            }
+            Server_defer((Server *)self->server, (PyObject *)self, Pattern_callFunction, 0.0);
         }
         self->currentTime += self->sampleToSec;
     }
@@ -509,23 +499,36 @@ typedef struct {
     double currentTime;
 } CallAfter;
 
+static void
+CallAfter_callFunction(PyObject *obj, double value) {
+    PyObject *tuple, *result;
+    CallAfter *self = (CallAfter *)obj;
+
+    if (self->arg == Py_None)
+        tuple = PyTuple_New(0);
+    else {
+        tuple = PyTuple_New(1);
+        Py_INCREF(self->arg);
+        PyTuple_SET_ITEM(tuple, 0, self->arg);
+    }
+    result = PyObject_Call(self->callable, tuple, NULL);
+    Py_DECREF(tuple);
+    if (result == NULL)
+        PyErr_Print();
+    else
+        Py_DECREF(result);
+}
+
 static void
 CallAfter_generate(CallAfter *self) {
     int i;
-    PyObject *tuple, *result;
 
     for (i=0; i<self->bufsize; i++) {
         if (self->currentTime >= self->time) {
-            if (self->arg == Py_None)
-                tuple = PyTuple_New(0);
-            else {
-                tuple = PyTuple_New(1);
-                PyTuple_SET_ITEM(tuple, 0, self->arg);
-            }
-            result = PyObject_Call(self->callable, tuple, NULL);
-            if (result == NULL)
-                PyErr_Print();
-            PyObject_CallMethod((PyObject *)self, "stop", NULL);
+            /* Deactivates the stream now, the call to stop() may be deferred. */
+            Stream_setStreamActive(self->stream, 0);
+            Server_defer((Server *)self->server, (PyObject *)self, CallAfter_callFunction, 0.0);
+            Server_deferStop((Server *)self->server, (PyObject *)self);
             break;
         }
         self->currentTime += self->sampleToSec;
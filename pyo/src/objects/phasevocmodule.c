@@ -238,6 +238,7 @@ PVAnal_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     if (!isPowerOfTwo(self->size)) {
         k = 1;
@@ -661,6 +662,7 @@ PVSynth_setInput(PVSynth *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -1141,6 +1143,7 @@ PVAddSynth_setInput(PVAddSynth *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -1583,6 +1586,7 @@ PVTranspose_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -1618,6 +1622,7 @@ PVTranspose_setInput(PVTranspose *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -2102,6 +2107,7 @@ PVVerb_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -2137,6 +2143,7 @@ PVVerb_setInput(PVVerb *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -2586,6 +2593,7 @@ PVGate_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -2621,6 +2629,7 @@ PVGate_setInput(PVGate *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -2984,6 +2993,7 @@ PVCross_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -3019,6 +3029,7 @@ PVCross_setInput(PVCross *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -3042,6 +3053,7 @@ PVCross_setInput2(PVCross *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input2_stream);
     self->input2_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -3317,6 +3329,7 @@ PVMult_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -3352,6 +3365,7 @@ PVMult_setInput(PVMult *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -3375,6 +3389,7 @@ PVMult_setInput2(PVMult *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input2_stream);
     self->input2_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -3684,6 +3699,7 @@ PVMorph_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -3719,6 +3735,7 @@ PVMorph_setInput(PVMorph *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -3742,6 +3759,7 @@ PVMorph_setInput2(PVMorph *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input2_stream);
     self->input2_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -4113,6 +4131,7 @@ PVFilter_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -4148,6 +4167,7 @@ PVFilter_setInput(PVFilter *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -4201,6 +4221,7 @@ PVFilter_setTable(PVFilter *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -4588,6 +4609,7 @@ PVDelay_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -4624,6 +4646,7 @@ PVDelay_setInput(PVDelay *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -5044,6 +5067,7 @@ PVBuffer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -5083,6 +5107,7 @@ PVBuffer_setInput(PVBuffer *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -5439,6 +5464,7 @@ PVShift_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -5474,6 +5500,7 @@ PVShift_setInput(PVShift *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -5915,6 +5942,7 @@ PVAmpMod_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -5955,6 +5983,7 @@ PVAmpMod_setInput(PVAmpMod *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -6518,6 +6547,7 @@ PVFreqMod_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -6558,6 +6588,7 @@ PVFreqMod_setInput(PVFreqMod *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -7049,6 +7080,7 @@ PVBufLoops_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -7091,6 +7123,7 @@ PVBufLoops_setInput(PVBufLoops *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -7465,6 +7498,7 @@ PVBufTabLoops_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -7507,6 +7541,7 @@ PVBufTabLoops_setInput(PVBufTabLoops *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -7781,6 +7816,7 @@ PVMix_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
 
     MAKE_NEW_PV_STREAM(self->pv_stream, &PVStreamType, NULL);
+    PVStream_setOwner(self->pv_stream, (PyObject *)self->stream);
 
     self->count = (int *)realloc(self->count, self->bufsize * sizeof(int));
 
@@ -7816,6 +7852,7 @@ PVMix_setInput(PVMix *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input_stream);
     self->input_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -7839,6 +7876,7 @@ PVMix_setInput2(PVMix *self, PyObject *arg)
     Py_INCREF(input_streamtmp);
     Py_XDECREF(self->input2_stream);
     self->input2_stream = (PVStream *)input_streamtmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -0,0 +1,1333 @@
+/**************************************************************************
+ * Copyright 2009-2015 Olivier Belanger                                   *
+ *                                                                        *
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *
+ *                                                                        *
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with pyo.  If not, see <http://www.gnu.org/licenses/>.   *
+ *************************************************************************/
+
+#include <Python.h>
+#include "structmember.h"
+#include <math.h>
+#include <string.h>
+#include <pthread.h>
+#include "pyomodule.h"
+#include "streammodule.h"
+#include "servermodule.h"
+#include "dummymodule.h"
+#include "ptsmkernel.h"
+
+/* Smallest sigma accepted, avoids a division by zero in the force term. */
+#define PTSM_MIN_SIGMA 1.0e-9
+/* Number of seeds a mode finding thread takes at once. */
+#define PTSM_MODE_CHUNK 16
+
+/*****************************************************
+Reads a 2-D (rows x dims) or 1-D (dims) array of floats
+from an object supporting the buffer protocol (float32
+or float64 items, C-contiguous) or from a list of lists
+(or list) of floats. The returned array is malloc'ed and
+owned by the caller. Returns NULL and sets an exception
+on failure, `name` is used as prefix of the message.
+*****************************************************/
+static double *
+PTSM_readArray(PyObject *arg, int ndim, int *rows, int *cols, const char *name)
+{
+    int i, j, r, c;
+    double *out = NULL;
+    PyObject *row;
+
+    if (PyObject_CheckBuffer(arg)) {
+        Py_buffer view;
+        char fmt;
+        if (PyObject_GetBuffer(arg, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+            return NULL;
+        fmt = view.format == NULL ? 'B' : view.format[strlen(view.format)-1];
+        if (view.ndim != ndim || (fmt != 'd' && fmt != 'f') ||
+            (fmt == 'd' && view.itemsize != sizeof(double)) || (fmt == 'f' && view.itemsize != sizeof(float))) {
+            PyErr_Format(PyExc_TypeError, "%s: expected a %d-dimensional array of float32 or float64.", name, ndim);
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        r = ndim == 2 ? (int)view.shape[0] : 1;
+        c = (int)view.shape[ndim-1];
+        out = (double *)malloc(r * c * sizeof(double));
+        if (fmt == 'd') {
+            for (i=0; i<r*c; i++)
+                out[i] = ((double *)view.buf)[i];
+        }
+        else {
+            for (i=0; i<r*c; i++)
+                out[i] = (double)((float *)view.buf)[i];
+        }
+        PyBuffer_Release(&view);
+    }
+    else if (PyList_Check(arg) || PyTuple_Check(arg)) {
+        if (ndim == 1) {
+            r = 1;
+            c = PySequence_Size(arg);
+            out = (double *)malloc(c * sizeof(double));
+            for (j=0; j<c; j++)
+                out[j] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(arg, j));
+        }
+        else {
+            r = PySequence_Size(arg);
+            for (i=0; i<r; i++) {
+                row = PySequence_Fast_GET_ITEM(arg, i);
+                if (!PyList_Check(row) && !PyTuple_Check(row)) {
+                    PyErr_Format(PyExc_TypeError, "%s: every row of the data must be a list of floats.", name);
+                    return NULL;
+                }
+            }
+            c = r > 0 ? PySequence_Size(PySequence_Fast_GET_ITEM(arg, 0)) : 0;
+            out = (double *)malloc(r * c * sizeof(double));
+            for (i=0; i<r; i++) {
+                row = PySequence_Fast_GET_ITEM(arg, i);
+                if (PySequence_Size(row) != c) {
+                    PyErr_Format(PyExc_ValueError, "%s: all rows of the data must have the same length.", name);
+                    free(out);
+                    return NULL;
+                }
+                for (j=0; j<c; j++)
+                    out[i*c+j] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(row, j));
+            }
+        }
+        if (PyErr_Occurred()) {
+            free(out);
+            return NULL;
+        }
+    }
+    else {
+        PyErr_Format(PyExc_TypeError, "%s: expected an object with buffer protocol (numpy.array) or a list of floats.", name);
+        return NULL;
+    }
+
+    if (r <= 0 || c <= 0) {
+        PyErr_Format(PyExc_ValueError, "%s: empty array given.", name);
+        free(out);
+        return NULL;
+    }
+
+    *rows = r;
+    *cols = c;
+    return out;
+}
+
+/* Dataset and particle state of a ParticleTrajectory, replaced as a whole. */
+typedef struct {
+    int npoints; /* number of data points (rows) */
+    int dim; /* number of dimensions (columns) */
+    double *soa; /* dataset, one row of npoints values per dimension */
+    double *position;
+    double *velocity;
+    double *force;
+} PTSMParticle;
+
+static void
+PTSMParticle_free(PTSMParticle *particle)
+{
+    if (particle == NULL)
+        return;
+    free(particle->soa);
+    free(particle->position);
+    free(particle->velocity);
+    free(particle->force);
+    free(particle);
+}
+
+/* ParticleTrajectory object */
+typedef struct {
+    pyo_audio_HEAD
+    PyObject *sigma;
+    Stream *sigma_stream;
+    PyObject *r;
+    Stream *r_stream;
+    double mass;
+    double dt;
+    PTSMParticle *particle; /* NULL until setData, published with Server_swapPointer */
+    ptsm_kernel_func kernel;
+    int modebuffer[4];
+} ParticleTrajectory;
+
+static void
+ParticleTrajectory_generate(ParticleTrajectory *self) {
+    int i, k, npoints, dim;
+    double sigma = PTSM_MIN_SIGMA, sigma2, res = 0.0, dt, dt_over_m, vsq;
+    double *position, *velocity, *force;
+    MYFLT *sg = NULL, *rs = NULL;
+    PTSMParticle *particle = self->particle;
+
+    if (particle == NULL) {
+        for (i=0; i<self->bufsize; i++)
+            self->data[i] = 0.0;
+        return;
+    }
+
+    if (self->modebuffer[2] == 0)
+        sigma = PyFloat_AS_DOUBLE(self->sigma);
+    else
+        sg = Stream_getData((Stream *)self->sigma_stream);
+    if (self->modebuffer[3] == 0)
+        res = PyFloat_AS_DOUBLE(self->r);
+    else
+        rs = Stream_getData((Stream *)self->r_stream);
+
+    npoints = particle->npoints;
+    dim = particle->dim;
+    position = particle->position;
+    velocity = particle->velocity;
+    force = particle->force;
+    dt = self->dt;
+
+    for (i=0; i<self->bufsize; i++) {
+        if (sg != NULL)
+            sigma = sg[i];
+        if (rs != NULL)
+            res = rs[i];
+        if (sigma < PTSM_MIN_SIGMA)
+            sigma = PTSM_MIN_SIGMA;
+        sigma2 = sigma * sigma;
+        /* m = mass / sigma2, division by sigma for sigma-independent pitch. */
+        dt_over_m = dt * sigma2 / self->mass;
+
+        /* force = sum((x - pos) * exp(-|x - pos|^2 / sigma2)) / sigma2 */
+        for (k=0; k<dim; k++)
+            force[k] = 0.0;
+        (*self->kernel)(particle->soa, npoints, dim, 0, npoints, position, 1.0 / sigma2, force);
+
+        /* Numerical integration => update position and velocity. */
+        vsq = 0.0;
+        for (k=0; k<dim; k++) {
+            velocity[k] = res * velocity[k] + force[k] / sigma2 * dt_over_m;
+            position[k] += dt * velocity[k];
+            vsq += velocity[k] * velocity[k];
+        }
+        self->data[i] = (MYFLT)vsq;
+    }
+}
+
+static void ParticleTrajectory_postprocessing_ii(ParticleTrajectory *self) { POST_PROCESSING_II };
+static void ParticleTrajectory_postprocessing_ai(ParticleTrajectory *self) { POST_PROCESSING_AI };
+static void ParticleTrajectory_postprocessing_ia(ParticleTrajectory *self) { POST_PROCESSING_IA };
+static void ParticleTrajectory_postprocessing_aa(ParticleTrajectory *self) { POST_PROCESSING_AA };
+static void ParticleTrajectory_postprocessing_ireva(ParticleTrajectory *self) { POST_PROCESSING_IREVA };
+static void ParticleTrajectory_postprocessing_areva(ParticleTrajectory *self) { POST_PROCESSING_AREVA };
+static void ParticleTrajectory_postprocessing_revai(ParticleTrajectory *self) { POST_PROCESSING_REVAI };
+static void ParticleTrajectory_postprocessing_revaa(ParticleTrajectory *self) { POST_PROCESSING_REVAA };
+static void ParticleTrajectory_postprocessing_revareva(ParticleTrajectory *self) { POST_PROCESSING_REVAREVA };
+
+static void
+ParticleTrajectory_setProcMode(ParticleTrajectory *self)
+{
+    int muladdmode;
+    muladdmode = self->modebuffer[0] + self->modebuffer[1] * 10;
+
+    /* sigma and r modes are handled inside the generate function. */
+    self->proc_func_ptr = ParticleTrajectory_generate;
+
+	switch (muladdmode) {
+        case 0:
+            self->muladd_func_ptr = ParticleTrajectory_postprocessing_ii;
+            break;
+        case 1:
+            self->muladd_func_ptr = ParticleTrajectory_postprocessing_ai;
+            break;
+        case 2:
+            self->muladd_func_ptr = ParticleTrajectory_postprocessing_revai;
+            break;
+        case 10:
+            self->muladd_func_ptr = ParticleTrajectory_postprocessing_ia;
+            break;
+        case 11:
+            self->muladd_func_ptr = ParticleTrajectory_postprocessing_aa;
+            break;
+        case 12:
+            self->muladd_func_ptr = ParticleTrajectory_postprocessing_revaa;
+            break;
+        case 20:
+            self->muladd_func_ptr = ParticleTrajectory_postprocessing_ireva;
+            break;
+        case 21:
+            self->muladd_func_ptr = ParticleTrajectory_postprocessing_areva;
+            break;
+        case 22:
+            self->muladd_func_ptr = ParticleTrajectory_postprocessing_revareva;
+            break;
+    }
+}
+
+static void
+ParticleTrajectory_compute_next_data_frame(ParticleTrajectory *self)
+{
+    (*self->proc_func_ptr)(self);
+    (*self->muladd_func_ptr)(self);
+}
+
+static int
+ParticleTrajectory_traverse(ParticleTrajectory *self, visitproc visit, void *arg)
+{
+    pyo_VISIT
+    Py_VISIT(self->sigma);
+    Py_VISIT(self->sigma_stream);
+    Py_VISIT(self->r);
+    Py_VISIT(self->r_stream);
+    return 0;
+}
+
+static int
+ParticleTrajectory_clear(ParticleTrajectory *self)
+{
+    pyo_CLEAR
+    Py_CLEAR(self->sigma);
+    Py_CLEAR(self->sigma_stream);
+    Py_CLEAR(self->r);
+    Py_CLEAR(self->r_stream);
+    return 0;
+}
+
+static void
+ParticleTrajectory_dealloc(ParticleTrajectory* self)
+{
+    pyo_DEALLOC
+    PTSMParticle_free(self->particle);
+    ParticleTrajectory_clear(self);
+    self->ob_type->tp_free((PyObject*)self);
+}
+
+static PyObject *
+ParticleTrajectory_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i;
+    PyObject *datatmp=NULL, *sigmatmp=NULL, *rtmp=NULL, *multmp=NULL, *addtmp=NULL;
+    ParticleTrajectory *self;
+    self = (ParticleTrajectory *)type->tp_alloc(type, 0);
+
+    self->sigma = PyFloat_FromDouble(0.25);
+    self->r = PyFloat_FromDouble(0.99);
+    self->mass = 1.0;
+    self->dt = 0.01;
+    self->kernel = ptsm_get_kernel(PTSM_KERNEL_AUTO);
+	self->modebuffer[0] = 0;
+	self->modebuffer[1] = 0;
+	self->modebuffer[2] = 0;
+	self->modebuffer[3] = 0;
+
+    INIT_OBJECT_COMMON
+    Stream_setFunctionPtr(self->stream, ParticleTrajectory_compute_next_data_frame);
+    self->mode_func_ptr = ParticleTrajectory_setProcMode;
+
+    static char *kwlist[] = {"data", "sigma", "mass", "r", "dt", "mul", "add", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|OdOdOO", kwlist, &datatmp, &sigmatmp, &self->mass, &rtmp, &self->dt, &multmp, &addtmp))
+        Py_RETURN_NONE;
+
+    if (self->mass <= 0.0)
+        self->mass = 1.0;
+
+    if (datatmp) {
+        if (PyObject_CallMethod((PyObject *)self, "setData", "O", datatmp) == NULL) {
+            Py_DECREF(self);
+            return NULL;
+        }
+    }
+
+    if (sigmatmp) {
+        PyObject_CallMethod((PyObject *)self, "setSigma", "O", sigmatmp);
+    }
+
+    if (rtmp) {
+        PyObject_CallMethod((PyObject *)self, "setR", "O", rtmp);
+    }
+
+    if (multmp) {
+        PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
+    }
+
+    if (addtmp) {
+        PyObject_CallMethod((PyObject *)self, "setAdd", "O", addtmp);
+    }
+
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+
+    (*self->mode_func_ptr)(self);
+
+    return (PyObject *)self;
+}
+
+static PyObject * ParticleTrajectory_getServer(ParticleTrajectory* self) { GET_SERVER };
+static PyObject * ParticleTrajectory_getStream(ParticleTrajectory* self) { GET_STREAM };
+static PyObject * ParticleTrajectory_setMul(ParticleTrajectory *self, PyObject *arg) { SET_MUL };
+static PyObject * ParticleTrajectory_setAdd(ParticleTrajectory *self, PyObject *arg) { SET_ADD };
+static PyObject * ParticleTrajectory_setSub(ParticleTrajectory *self, PyObject *arg) { SET_SUB };
+static PyObject * ParticleTrajectory_setDiv(ParticleTrajectory *self, PyObject *arg) { SET_DIV };
+
+static PyObject * ParticleTrajectory_play(ParticleTrajectory *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * ParticleTrajectory_out(ParticleTrajectory *self, PyObject *args, PyObject *kwds) { OUT };
+static PyObject * ParticleTrajectory_stop(ParticleTrajectory *self) { STOP };
+
+static PyObject * ParticleTrajectory_multiply(ParticleTrajectory *self, PyObject *arg) { MULTIPLY };
+static PyObject * ParticleTrajectory_inplace_multiply(ParticleTrajectory *self, PyObject *arg) { INPLACE_MULTIPLY };
+static PyObject * ParticleTrajectory_add(ParticleTrajectory *self, PyObject *arg) { ADD };
+static PyObject * ParticleTrajectory_inplace_add(ParticleTrajectory *self, PyObject *arg) { INPLACE_ADD };
+static PyObject * ParticleTrajectory_sub(ParticleTrajectory *self, PyObject *arg) { SUB };
+static PyObject * ParticleTrajectory_inplace_sub(ParticleTrajectory *self, PyObject *arg) { INPLACE_SUB };
+static PyObject * ParticleTrajectory_div(ParticleTrajectory *self, PyObject *arg) { DIV };
+static PyObject * ParticleTrajectory_inplace_div(ParticleTrajectory *self, PyObject *arg) { INPLACE_DIV };
+
+static PyObject *
+ParticleTrajectory_setData(ParticleTrajectory *self, PyObject *arg)
+{
+    int k, npoints, dim;
+    double *points;
+    PTSMParticle *particle, *old = self->particle;
+
+    ASSERT_ARG_NOT_NULL
+
+    points = PTSM_readArray(arg, 2, &npoints, &dim, "ParticleTrajectory");
+    if (points == NULL)
+        return NULL;
+
+    particle = (PTSMParticle *)malloc(sizeof(PTSMParticle));
+    particle->npoints = npoints;
+    particle->dim = dim;
+    particle->soa = (double *)malloc(npoints * dim * sizeof(double));
+    particle->position = (double *)malloc(dim * sizeof(double));
+    particle->velocity = (double *)malloc(dim * sizeof(double));
+    particle->force = (double *)malloc(dim * sizeof(double));
+    ptsm_to_soa(points, npoints, dim, particle->soa, npoints);
+    free(points);
+
+    /* The particle keeps moving on the new data, a new dimension resets it at the origin, at rest. */
+    for (k=0; k<dim; k++) {
+        if (old != NULL && old->dim == dim) {
+            particle->position[k] = old->position[k];
+            particle->velocity[k] = old->velocity[k];
+        }
+        else
+            particle->position[k] = particle->velocity[k] = 0.0;
+        particle->force[k] = 0.0;
+    }
+
+    old = (PTSMParticle *)Server_swapPointer((Server *)self->server, (void **)&self->particle, particle);
+    PTSMParticle_free(old);
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+static PyObject *
+ParticleTrajectory_setVector(ParticleTrajectory *self, PyObject *arg, double *vector)
+{
+    int k, rows, dim;
+    double *values;
+
+    ASSERT_ARG_NOT_NULL
+
+    values = PTSM_readArray(arg, 1, &rows, &dim, "ParticleTrajectory");
+    if (values == NULL)
+        return NULL;
+    if (self->particle == NULL || dim != self->particle->dim) {
+        PyErr_SetString(PyExc_ValueError, "ParticleTrajectory: vector length must match the number of dimensions of the data.");
+        free(values);
+        return NULL;
+    }
+    for (k=0; k<dim; k++)
+        vector[k] = values[k];
+    free(values);
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+static PyObject *
+ParticleTrajectory_getVector(ParticleTrajectory *self, double *vector)
+{
+    int k, dim = self->particle == NULL ? 0 : self->particle->dim;
+    PyObject *list = PyList_New(dim);
+    for (k=0; k<dim; k++)
+        PyList_SET_ITEM(list, k, PyFloat_FromDouble(vector[k]));
+    return list;
+}
+
+static PyObject * ParticleTrajectory_setPosition(ParticleTrajectory *self, PyObject *arg) { return ParticleTrajectory_setVector(self, arg, self->particle == NULL ? NULL : self->particle->position); }
+static PyObject * ParticleTrajectory_setVelocity(ParticleTrajectory *self, PyObject *arg) { return ParticleTrajectory_setVector(self, arg, self->particle == NULL ? NULL : self->particle->velocity); }
+static PyObject * ParticleTrajectory_getPosition(ParticleTrajectory *self) { return ParticleTrajectory_getVector(self, self->particle == NULL ? NULL : self->particle->position); }
+static PyObject * ParticleTrajectory_getVelocity(ParticleTrajectory *self) { return ParticleTrajectory_getVector(self, self->particle == NULL ? NULL : self->particle->velocity); }
+
+static PyObject *
+ParticleTrajectory_setSigma(ParticleTrajectory *self, PyObject *arg)
+{
+	PyObject *tmp, *streamtmp;
+
+    ASSERT_ARG_NOT_NULL
+
+	int isNumber = PyNumber_Check(arg);
+
+	tmp = arg;
+	Py_INCREF(tmp);
+	Py_DECREF(self->sigma);
+	if (isNumber == 1) {
+		self->sigma = PyNumber_Float(tmp);
+        self->modebuffer[2] = 0;
+	}
+	else {
+		self->sigma = tmp;
+        streamtmp = PyObject_CallMethod((PyObject *)self->sigma, "_getStream", NULL);
+        Py_INCREF(streamtmp);
+        Py_XDECREF(self->sigma_stream);
+        self->sigma_stream = (Stream *)streamtmp;
+		self->modebuffer[2] = 1;
+	}
+
+    (*self->mode_func_ptr)(self);
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+static PyObject *
+ParticleTrajectory_setR(ParticleTrajectory *self, PyObject *arg)
+{
+	PyObject *tmp, *streamtmp;
+
+    ASSERT_ARG_NOT_NULL
+
+	int isNumber = PyNumber_Check(arg);
+
+	tmp = arg;
+	Py_INCREF(tmp);
+	Py_DECREF(self->r);
+	if (isNumber == 1) {
+		self->r = PyNumber_Float(tmp);
+        self->modebuffer[3] = 0;
+	}
+	else {
+		self->r = tmp;
+        streamtmp = PyObject_CallMethod((PyObject *)self->r, "_getStream", NULL);
+        Py_INCREF(streamtmp);
+        Py_XDECREF(self->r_stream);
+        self->r_stream = (Stream *)streamtmp;
+		self->modebuffer[3] = 1;
+	}
+
+    (*self->mode_func_ptr)(self);
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+static PyObject *
+ParticleTrajectory_setMass(ParticleTrajectory *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+	if (PyNumber_Check(arg) && PyFloat_AsDouble(arg) > 0.0) {
+		self->mass = PyFloat_AsDouble(arg);
+	}
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+static PyObject *
+ParticleTrajectory_setDt(ParticleTrajectory *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+
+	if (PyNumber_Check(arg)) {
+		self->dt = PyFloat_AsDouble(arg);
+	}
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+static PyMemberDef ParticleTrajectory_members[] = {
+    {"server", T_OBJECT_EX, offsetof(ParticleTrajectory, server), 0, "Pyo server."},
+    {"stream", T_OBJECT_EX, offsetof(ParticleTrajectory, stream), 0, "Stream object."},
+    {"sigma", T_OBJECT_EX, offsetof(ParticleTrajectory, sigma), 0, "Width of the gaussian potential."},
+    {"r", T_OBJECT_EX, offsetof(ParticleTrajectory, r), 0, "Velocity damping factor."},
+    {"mul", T_OBJECT_EX, offsetof(ParticleTrajectory, mul), 0, "Mul factor."},
+    {"add", T_OBJECT_EX, offsetof(ParticleTrajectory, add), 0, "Add factor."},
+    {NULL}  /* Sentinel */
+};
+
+static PyMethodDef ParticleTrajectory_methods[] = {
+    {"getServer", (PyCFunction)ParticleTrajectory_getServer, METH_NOARGS, "Returns server object."},
+    {"_getStream", (PyCFunction)ParticleTrajectory_getStream, METH_NOARGS, "Returns stream object."},
+    {"play", (PyCFunction)ParticleTrajectory_play, METH_VARARGS|METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+    {"out", (PyCFunction)ParticleTrajectory_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
+    {"stop", (PyCFunction)ParticleTrajectory_stop, METH_NOARGS, "Stops computing."},
+    {"setData", (PyCFunction)ParticleTrajectory_setData, METH_O, "Sets the dataset (rows x dims)."},
+    {"setPosition", (PyCFunction)ParticleTrajectory_setPosition, METH_O, "Sets the particle position."},
+    {"setVelocity", (PyCFunction)ParticleTrajectory_setVelocity, METH_O, "Sets the particle velocity."},
+    {"getPosition", (PyCFunction)ParticleTrajectory_getPosition, METH_NOARGS, "Returns the particle position."},
+    {"getVelocity", (PyCFunction)ParticleTrajectory_getVelocity, METH_NOARGS, "Returns the particle velocity."},
+    {"setSigma", (PyCFunction)ParticleTrajectory_setSigma, METH_O, "Sets the width of the gaussian potential."},
+    {"setMass", (PyCFunction)ParticleTrajectory_setMass, METH_O, "Sets the particle mass."},
+    {"setR", (PyCFunction)ParticleTrajectory_setR, METH_O, "Sets the velocity damping factor."},
+    {"setDt", (PyCFunction)ParticleTrajectory_setDt, METH_O, "Sets the integration time step."},
+    {"setMul", (PyCFunction)ParticleTrajectory_setMul, METH_O, "Sets ParticleTrajectory mul factor."},
+    {"setAdd", (PyCFunction)ParticleTrajectory_setAdd, METH_O, "Sets ParticleTrajectory add factor."},
+    {"setSub", (PyCFunction)ParticleTrajectory_setSub, METH_O, "Sets inverse add factor."},
+    {"setDiv", (PyCFunction)ParticleTrajectory_setDiv, METH_O, "Sets inverse mul factor."},
+    {NULL}  /* Sentinel */
+};
+
+static PyNumberMethods ParticleTrajectory_as_number = {
+    (binaryfunc)ParticleTrajectory_add,                      /*nb_add*/
+    (binaryfunc)ParticleTrajectory_sub,                 /*nb_subtract*/
+    (binaryfunc)ParticleTrajectory_multiply,                 /*nb_multiply*/
+    (binaryfunc)ParticleTrajectory_div,                   /*nb_divide*/
+    0,                /*nb_remainder*/
+    0,                   /*nb_divmod*/
+    0,                   /*nb_power*/
+    0,                  /*nb_neg*/
+    0,                /*nb_pos*/
+    0,                  /*(unaryfunc)array_abs*/
+    0,                    /*nb_nonzero*/
+    0,                    /*nb_invert*/
+    0,               /*nb_lshift*/
+    0,              /*nb_rshift*/
+    0,              /*nb_and*/
+    0,              /*nb_xor*/
+    0,               /*nb_or*/
+    0,                                          /*nb_coerce*/
+    0,                       /*nb_int*/
+    0,                      /*nb_long*/
+    0,                     /*nb_float*/
+    0,                       /*nb_oct*/
+    0,                       /*nb_hex*/
+    (binaryfunc)ParticleTrajectory_inplace_add,              /*inplace_add*/
+    (binaryfunc)ParticleTrajectory_inplace_sub,         /*inplace_subtract*/
+    (binaryfunc)ParticleTrajectory_inplace_multiply,         /*inplace_multiply*/
+    (binaryfunc)ParticleTrajectory_inplace_div,           /*inplace_divide*/
+    0,        /*inplace_remainder*/
+    0,           /*inplace_power*/
+    0,       /*inplace_lshift*/
+    0,      /*inplace_rshift*/
+    0,      /*inplace_and*/
+    0,      /*inplace_xor*/
+    0,       /*inplace_or*/
+    0,             /*nb_floor_divide*/
+    0,              /*nb_true_divide*/
+    0,     /*nb_inplace_floor_divide*/
+    0,      /*nb_inplace_true_divide*/
+    0,                     /* nb_index */
+};
+
+PyTypeObject ParticleTrajectoryType = {
+    PyObject_HEAD_INIT(NULL)
+    0,                         /*ob_size*/
+    "_pyo.ParticleTrajectory_base",         /*tp_name*/
+    sizeof(ParticleTrajectory),         /*tp_basicsize*/
+    0,                         /*tp_itemsize*/
+    (destructor)ParticleTrajectory_dealloc, /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    &ParticleTrajectory_as_number,             /*tp_as_number*/
+    0,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    0,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_CHECKTYPES,  /*tp_flags*/
+    "ParticleTrajectory objects. Particle trajectory sonification of a dataset.",           /* tp_doc */
+    (traverseproc)ParticleTrajectory_traverse,   /* tp_traverse */
+    (inquiry)ParticleTrajectory_clear,           /* tp_clear */
+    0,		               /* tp_richcompare */
+    0,		               /* tp_weaklistoffset */
+    0,		               /* tp_iter */
+    0,		               /* tp_iternext */
+    ParticleTrajectory_methods,             /* tp_methods */
+    ParticleTrajectory_members,             /* tp_members */
+    0,                      /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,      /* tp_init */
+    0,                         /* tp_alloc */
+    ParticleTrajectory_new,                 /* tp_new */
+};
+
+/*****************************************************
+Gets a writable, C-contiguous float64 view of `arg` with
+`ndim` dimensions. Returns -1 and sets an exception on
+failure, the view must be released by the caller on
+success.
+*****************************************************/
+static int
+PTSM_getOutputBuffer(PyObject *arg, Py_buffer *view, int ndim, const char *name)
+{
+    char fmt;
+    if (PyObject_GetBuffer(arg, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE) != 0)
+        return -1;
+    fmt = view->format == NULL ? 'B' : view->format[strlen(view->format)-1];
+    if (view->ndim != ndim || fmt != 'd' || view->itemsize != sizeof(double)) {
+        PyErr_Format(PyExc_TypeError, "%s: expected a writable %d-dimensional array of float64.", name, ndim);
+        PyBuffer_Release(view);
+        return -1;
+    }
+    return 0;
+}
+
+/* PTSMData object */
+typedef struct {
+    PyObject_HEAD
+    int npoints; /* number of data points (rows) */
+    int dim; /* number of dimensions (columns) */
+    double *soa; /* dataset, one row of npoints values per dimension */
+    int kernel;
+    ptsm_kernel_func kernel_func;
+    PtsmTree *tree; /* spatial index, built when the cutoff is enabled */
+    double cutoff; /* search radius, in sigma units, 0 means exact */
+    double *force;
+    int busy; /* dataset in use by threads running without the GIL */
+} PTSMData;
+
+#define PTSM_ASSERT_NOT_BUSY \
+    if (self->busy) { \
+        PyErr_SetString(PyExc_RuntimeError, "PTSMData: the dataset can't be modified while modes are computed."); \
+        return NULL; \
+    }
+
+/* Gaussian sum around pos, restricted to the points within cutoff * sigma if the index is enabled. */
+static double
+PTSMData_sum(PTSMData *self, const double *pos, double scale, double sigma, double *acc)
+{
+    if (self->tree != NULL && self->cutoff > 0.0)
+        return ptsm_tree_sum(self->tree, self->kernel_func, self->soa, self->npoints, pos, scale, self->cutoff * sigma, acc);
+    else
+        return (*self->kernel_func)(self->soa, self->npoints, self->dim, 0, self->npoints, pos, scale, acc);
+}
+
+static void
+PTSMData_dealloc(PTSMData* self)
+{
+    free(self->soa);
+    free(self->force);
+    ptsm_tree_free(self->tree);
+    self->ob_type->tp_free((PyObject*)self);
+}
+
+static PyObject *
+PTSMData_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyObject *datatmp=NULL;
+    PTSMData *self;
+    self = (PTSMData *)type->tp_alloc(type, 0);
+
+    self->kernel = ptsm_kernel_resolve(PTSM_KERNEL_AUTO);
+    self->kernel_func = ptsm_get_kernel(self->kernel);
+    self->tree = NULL;
+    self->cutoff = 0.0;
+    self->busy = 0;
+
+    static char *kwlist[] = {"data", "cutoff", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|d", kwlist, &datatmp, &self->cutoff)) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    if (PyObject_CallMethod((PyObject *)self, "setData", "O", datatmp) == NULL) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject *)self;
+}
+
+static PyObject *
+PTSMData_setData(PTSMData *self, PyObject *arg)
+{
+    int npoints, dim;
+    double *points;
+
+    ASSERT_ARG_NOT_NULL
+    PTSM_ASSERT_NOT_BUSY
+
+    points = PTSM_readArray(arg, 2, &npoints, &dim, "PTSMData");
+    if (points == NULL)
+        return NULL;
+
+    free(self->soa);
+    self->soa = (double *)malloc(npoints * dim * sizeof(double));
+    ptsm_to_soa(points, npoints, dim, self->soa, npoints);
+    free(points);
+    self->npoints = npoints;
+    ptsm_tree_free(self->tree);
+    self->tree = NULL;
+    if (self->cutoff > 0.0)
+        self->tree = ptsm_tree_new(self->soa, npoints, dim, npoints);
+    if (dim != self->dim) {
+        self->dim = dim;
+        self->force = (double *)realloc(self->force, dim * sizeof(double));
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject * PTSMData_getSize(PTSMData *self) { return PyInt_FromLong(self->npoints); }
+static PyObject * PTSMData_getDim(PTSMData *self) { return PyInt_FromLong(self->dim); }
+static PyObject * PTSMData_getKernel(PTSMData *self) { return PyString_FromString(ptsm_kernel_name(self->kernel)); }
+
+static PyObject *
+PTSMData_setKernel(PTSMData *self, PyObject *arg)
+{
+    int kernel;
+
+    ASSERT_ARG_NOT_NULL
+    PTSM_ASSERT_NOT_BUSY
+
+    kernel = PyInt_AsLong(arg);
+    if (kernel == -1 && PyErr_Occurred())
+        return NULL;
+    if (!ptsm_kernel_available(kernel)) {
+        PyErr_Format(PyExc_ValueError, "PTSMData: kernel '%s' is not supported by this cpu.", ptsm_kernel_name(kernel));
+        return NULL;
+    }
+    self->kernel = ptsm_kernel_resolve(kernel);
+    self->kernel_func = ptsm_get_kernel(self->kernel);
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+PTSMData_setCutoff(PTSMData *self, PyObject *arg)
+{
+    ASSERT_ARG_NOT_NULL
+    PTSM_ASSERT_NOT_BUSY
+
+    if (PyNumber_Check(arg)) {
+        self->cutoff = PyFloat_AsDouble(arg);
+        if (self->cutoff < 0.0)
+            self->cutoff = 0.0;
+        /* The index does not depend on sigma, it is built only once per dataset. */
+        if (self->cutoff > 0.0 && self->tree == NULL)
+            self->tree = ptsm_tree_new(self->soa, self->npoints, self->dim, self->npoints);
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject * PTSMData_getCutoff(PTSMData *self) { return PyFloat_FromDouble(self->cutoff); }
+
+static PyObject *
+PTSMData_potential(PTSMData *self, PyObject *args, PyObject *kwds)
+{
+    int rows, dim;
+    double sigma = 0.2, sum;
+    double *pos;
+    PyObject *postmp;
+
+    static char *kwlist[] = {"pos", "sigma", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|d", kwlist, &postmp, &sigma))
+        return NULL;
+
+    pos = PTSM_readArray(postmp, 1, &rows, &dim, "PTSMData");
+    if (pos == NULL)
+        return NULL;
+    if (dim != self->dim) {
+        PyErr_SetString(PyExc_ValueError, "PTSMData: position length must match the number of dimensions of the data.");
+        free(pos);
+        return NULL;
+    }
+    if (sigma < PTSM_MIN_SIGMA)
+        sigma = PTSM_MIN_SIGMA;
+
+    sum = PTSMData_sum(self, pos, 0.5 / (sigma * sigma), sigma, NULL);
+    free(pos);
+
+    return PyFloat_FromDouble(-sum);
+}
+
+/*****************************************************
+Integrates the particle for sig.shape[0] steps. pos and
+vel (float64, dim) are updated in place, sig receives the
+squared norm of the velocity at each step and trj, if
+not None, the position at each step (steps x dim).
+*****************************************************/
+static PyObject *
+PTSMData_integrate(PTSMData *self, PyObject *args, PyObject *kwds)
+{
+    int i, k, dim, steps;
+    double sigma = 0.25, mass = 1.0, r = 0.99, dt = 0.01;
+    double sigma2, dt_over_m, vsq;
+    double *position, *velocity, *force, *sig, *trj = NULL;
+    PyObject *postmp, *veltmp, *sigtmp, *trjtmp = Py_None;
+    Py_buffer posview, velview, sigview, trjview;
+
+    static char *kwlist[] = {"pos", "vel", "sig", "trj", "sigma", "mass", "r", "dt", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "OOO|Odddd", kwlist, &postmp, &veltmp, &sigtmp, &trjtmp, &sigma, &mass, &r, &dt))
+        return NULL;
+
+    dim = self->dim;
+    if (PTSM_getOutputBuffer(postmp, &posview, 1, "PTSMData") < 0)
+        return NULL;
+    if (PTSM_getOutputBuffer(veltmp, &velview, 1, "PTSMData") < 0) {
+        PyBuffer_Release(&posview);
+        return NULL;
+    }
+    if (PTSM_getOutputBuffer(sigtmp, &sigview, 1, "PTSMData") < 0) {
+        PyBuffer_Release(&posview);
+        PyBuffer_Release(&velview);
+        return NULL;
+    }
+    steps = (int)sigview.shape[0];
+    if (trjtmp != Py_None) {
+        if (PTSM_getOutputBuffer(trjtmp, &trjview, 2, "PTSMData") < 0) {
+            PyBuffer_Release(&posview);
+            PyBuffer_Release(&velview);
+            PyBuffer_Release(&sigview);
+            return NULL;
+        }
+        trj = (double *)trjview.buf;
+    }
+
+    if (posview.shape[0] != dim || velview.shape[0] != dim ||
+        (trj != NULL && (trjview.shape[0] != steps || trjview.shape[1] != dim))) {
+        PyErr_SetString(PyExc_ValueError, "PTSMData: pos, vel, sig and trj shapes must match the number of steps and the number of dimensions of the data.");
+        PyBuffer_Release(&posview);
+        PyBuffer_Release(&velview);
+        PyBuffer_Release(&sigview);
+        if (trj != NULL)
+            PyBuffer_Release(&trjview);
+        return NULL;
+    }
+
+    position = (double *)posview.buf;
+    velocity = (double *)velview.buf;
+    sig = (double *)sigview.buf;
+    force = self->force;
+
+    if (sigma < PTSM_MIN_SIGMA)
+        sigma = PTSM_MIN_SIGMA;
+    if (mass <= 0.0)
+        mass = 1.0;
+    sigma2 = sigma * sigma;
+    /* m = mass / sigma2, division by sigma for sigma-independent pitch. */
+    dt_over_m = dt * sigma2 / mass;
+
+    for (i=0; i<steps; i++) {
+        for (k=0; k<dim; k++)
+            force[k] = 0.0;
+        PTSMData_sum(self, position, 1.0 / sigma2, sigma, force);
+        vsq = 0.0;
+        for (k=0; k<dim; k++) {
+            velocity[k] = r * velocity[k] + force[k] / sigma2 * dt_over_m;
+            position[k] += dt * velocity[k];
+            vsq += velocity[k] * velocity[k];
+        }
+        sig[i] = vsq;
+        if (trj != NULL) {
+            for (k=0; k<dim; k++)
+                trj[i*dim+k] = position[k];
+        }
+    }
+
+    PyBuffer_Release(&posview);
+    PyBuffer_Release(&velview);
+    PyBuffer_Release(&sigview);
+    if (trj != NULL)
+        PyBuffer_Release(&trjview);
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+/*****************************************************
+Integrates many particles at once, in a single pass over
+the dataset per step. pos and vel (float64, particles x
+dim) are updated in place and sig (float64, particles x
+steps) receives the squared norm of the velocities. If
+tol is greater than 0, a particle stops as soon as the
+norm of its velocity falls below tol, its remaining sig
+values are left at 0. Returns the number of steps
+computed for each particle.
+*****************************************************/
+static PyObject *
+PTSMData_integrateBatch(PTSMData *self, PyObject *args, PyObject *kwds)
+{
+    int i, k, m, dim, steps, nparticles, nactive;
+    int *done;
+    char *active;
+    double sigma = 0.25, mass = 1.0, r = 0.99, dt = 0.01, tol = 0.0;
+    double sigma2, dt_over_m, vsq;
+    double *position, *velocity, *force, *sig, *p, *v, *f;
+    PyObject *postmp, *veltmp, *sigtmp, *list;
+    Py_buffer posview, velview, sigview;
+
+    static char *kwlist[] = {"pos", "vel", "sig", "sigma", "mass", "r", "dt", "tol", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "OOO|ddddd", kwlist, &postmp, &veltmp, &sigtmp, &sigma, &mass, &r, &dt, &tol))
+        return NULL;
+
+    dim = self->dim;
+    if (PTSM_getOutputBuffer(postmp, &posview, 2, "PTSMData") < 0)
+        return NULL;
+    if (PTSM_getOutputBuffer(veltmp, &velview, 2, "PTSMData") < 0) {
+        PyBuffer_Release(&posview);
+        return NULL;
+    }
+    if (PTSM_getOutputBuffer(sigtmp, &sigview, 2, "PTSMData") < 0) {
+        PyBuffer_Release(&posview);
+        PyBuffer_Release(&velview);
+        return NULL;
+    }
+
+    nparticles = (int)posview.shape[0];
+    steps = (int)sigview.shape[1];
+    if (posview.shape[1] != dim || velview.shape[0] != nparticles || velview.shape[1] != dim || sigview.shape[0] != nparticles) {
+        PyErr_SetString(PyExc_ValueError, "PTSMData: pos, vel and sig shapes must match the number of particles, the number of steps and the number of dimensions of the data.");
+        PyBuffer_Release(&posview);
+        PyBuffer_Release(&velview);
+        PyBuffer_Release(&sigview);
+        return NULL;
+    }
+
+    position = (double *)posview.buf;
+    velocity = (double *)velview.buf;
+    sig = (double *)sigview.buf;
+    force = (double *)malloc(nparticles * dim * sizeof(double));
+    active = (char *)malloc(nparticles * sizeof(char));
+    done = (int *)malloc(nparticles * sizeof(int));
+    for (m=0; m<nparticles; m++) {
+        active[m] = 1;
+        done[m] = steps;
+    }
+    for (i=0; i<nparticles*steps; i++)
+        sig[i] = 0.0;
+    nactive = nparticles;
+
+    if (sigma < PTSM_MIN_SIGMA)
+        sigma = PTSM_MIN_SIGMA;
+    if (mass <= 0.0)
+        mass = 1.0;
+    sigma2 = sigma * sigma;
+    /* m = mass / sigma2, division by sigma for sigma-independent pitch. */
+    dt_over_m = dt * sigma2 / mass;
+
+    for (i=0; i<steps && nactive>0; i++) {
+        for (k=0; k<nparticles*dim; k++)
+            force[k] = 0.0;
+        if (self->tree != NULL && self->cutoff > 0.0) {
+            for (m=0; m<nparticles; m++) {
+                if (active[m])
+                    PTSMData_sum(self, position + m * dim, 1.0 / sigma2, sigma, force + m * dim);
+            }
+        }
+        else
+            ptsm_batch_sum(self->kernel_func, self->soa, self->npoints, dim, 0, self->npoints,
+                           nparticles, position, active, 1.0 / sigma2, NULL, force);
+
+        for (m=0; m<nparticles; m++) {
+            if (!active[m])
+                continue;
+            p = position + m * dim;
+            v = velocity + m * dim;
+            f = force + m * dim;
+            vsq = 0.0;
+            for (k=0; k<dim; k++) {
+                v[k] = r * v[k] + f[k] / sigma2 * dt_over_m;
+                p[k] += dt * v[k];
+                vsq += v[k] * v[k];
+            }
+            sig[m*steps+i] = vsq;
+            if (vsq < tol * tol) {
+                active[m] = 0;
+                done[m] = i + 1;
+                nactive--;
+            }
+        }
+    }
+
+    list = PyList_New(nparticles);
+    for (m=0; m<nparticles; m++)
+        PyList_SET_ITEM(list, m, PyInt_FromLong(done[m]));
+
+    free(force);
+    free(active);
+    free(done);
+    PyBuffer_Release(&posview);
+    PyBuffer_Release(&velview);
+    PyBuffer_Release(&sigview);
+
+    return list;
+}
+
+/* Shared state of the mode finding threads. */
+typedef struct {
+    PTSMData *data;
+    const double *seeds;
+    double *ends; /* final position of each seed */
+    char *converged;
+    int nseeds;
+    int next; /* next seed to process, protected by lock */
+    int maxiter;
+    double sigma;
+    double dt_over_m;
+    double dt;
+    double tol;
+    pthread_mutex_t lock;
+} PTSMModeJob;
+
+/* Gradient descent (particle without inertia, r = 0) from the seeds taken in chunks. */
+static void *
+PTSMData_modeThread(void *arg)
+{
+    int i, k, s, first, last, dim;
+    double sigma2, v, vsq, tol2;
+    double *pos, *force;
+    PTSMModeJob *job = (PTSMModeJob *)arg;
+
+    dim = job->data->dim;
+    sigma2 = job->sigma * job->sigma;
+    tol2 = job->tol * job->tol;
+    force = (double *)malloc(dim * sizeof(double));
+
+    for (;;) {
+        pthread_mutex_lock(&job->lock);
+        first = job->next;
+        job->next += PTSM_MODE_CHUNK;
+        pthread_mutex_unlock(&job->lock);
+        if (first >= job->nseeds)
+            break;
+        last = (first + PTSM_MODE_CHUNK) < job->nseeds ? (first + PTSM_MODE_CHUNK) : job->nseeds;
+        for (s=first; s<last; s++) {
+            pos = job->ends + s * dim;
+            for (k=0; k<dim; k++)
+                pos[k] = job->seeds[s * dim + k];
+            job->converged[s] = 0;
+            for (i=0; i<job->maxiter; i++) {
+                for (k=0; k<dim; k++)
+                    force[k] = 0.0;
+                PTSMData_sum(job->data, pos, 1.0 / sigma2, job->sigma, force);
+                vsq = 0.0;
+                for (k=0; k<dim; k++) {
+                    v = force[k] / sigma2 * job->dt_over_m;
+                    pos[k] += job->dt * v;
+                    vsq += v * v;
+                }
+                if (vsq < tol2) {
+                    job->converged[s] = 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    free(force);
+    return NULL;
+}
+
+/*****************************************************
+Finds the local minima of the potential reached from a
+set of seeds (float64, seeds x dim), using nthreads
+threads. Converged positions closer than merge * sigma
+are merged into a single mode. Returns the tuple
+(modes, depths, basins), the list of mode positions, the
+list of their potential energy and, for every seed, the
+index of its mode (-1 if it did not converge in maxiter
+steps). The GIL is released during the computation.
+*****************************************************/
+static PyObject *
+PTSMData_findModes(PTSMData *self, PyObject *args, PyObject *kwds)
+{
+    int i, j, k, s, dim, nthreads = 1, started, nmodes = 0, maxiter = 10000;
+    int *basins;
+    double sigma = 0.25, mass = 1.0, dt = 0.1, tol = 1.0e-5, merge = 0.1;
+    double d, dsq, mergesq;
+    double *modes, *depths, *pos;
+    PyObject *seedstmp, *modelist, *depthlist, *basinlist, *row;
+    Py_buffer seedview;
+    PTSMModeJob job;
+    pthread_t *threads;
+
+    static char *kwlist[] = {"seeds", "sigma", "mass", "dt", "tol", "maxiter", "merge", "nthreads", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "O|ddddidi", kwlist, &seedstmp, &sigma, &mass, &dt, &tol, &maxiter, &merge, &nthreads))
+        return NULL;
+
+    PTSM_ASSERT_NOT_BUSY
+
+    dim = self->dim;
+    if (PyObject_GetBuffer(seedstmp, &seedview, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+        return NULL;
+    if (seedview.ndim != 2 || seedview.format == NULL || seedview.format[strlen(seedview.format)-1] != 'd' ||
+        seedview.itemsize != sizeof(double) || seedview.shape[1] != dim) {
+        PyErr_SetString(PyExc_ValueError, "PTSMData: seeds must be a 2-dimensional float64 array, one row per seed of the same length as the data rows.");
+        PyBuffer_Release(&seedview);
+        return NULL;
+    }
+
+    if (sigma < PTSM_MIN_SIGMA)
+        sigma = PTSM_MIN_SIGMA;
+    if (mass <= 0.0)
+        mass = 1.0;
+    if (nthreads < 1)
+        nthreads = 1;
+
+    job.data = self;
+    job.seeds = (const double *)seedview.buf;
+    job.nseeds = (int)seedview.shape[0];
+    job.next = 0;
+    job.maxiter = maxiter;
+    job.sigma = sigma;
+    job.dt = dt;
+    job.dt_over_m = dt * sigma * sigma / mass;
+    job.tol = tol;
+    job.ends = (double *)malloc(job.nseeds * dim * sizeof(double));
+    job.converged = (char *)malloc(job.nseeds * sizeof(char));
+    pthread_mutex_init(&job.lock, NULL);
+
+    basins = (int *)malloc(job.nseeds * sizeof(int));
+    modes = (double *)malloc(job.nseeds * dim * sizeof(double));
+    depths = (double *)malloc(job.nseeds * sizeof(double));
+    threads = (pthread_t *)malloc(nthreads * sizeof(pthread_t));
+    mergesq = merge * sigma * merge * sigma;
+
+    self->busy = 1;
+    Py_BEGIN_ALLOW_THREADS
+    for (started=0; started<nthreads; started++) {
+        if (pthread_create(&threads[started], NULL, PTSMData_modeThread, &job))
+            break;
+    }
+    /* Without all its threads, the calling thread takes the seeds left. */
+    if (started < nthreads)
+        PTSMData_modeThread(&job);
+    for (i=0; i<started; i++)
+        pthread_join(threads[i], NULL);
+
+    /* Merges the converged positions into the mode table. */
+    for (s=0; s<job.nseeds; s++) {
+        basins[s] = -1;
+        if (!job.converged[s])
+            continue;
+        pos = job.ends + s * dim;
+        for (j=0; j<nmodes; j++) {
+            dsq = 0.0;
+            for (k=0; k<dim; k++) {
+                d = pos[k] - modes[j * dim + k];
+                dsq += d * d;
+            }
+            if (dsq <= mergesq)
+                break;
+        }
+        if (j == nmodes) {
+            for (k=0; k<dim; k++)
+                modes[j * dim + k] = pos[k];
+            depths[j] = -PTSMData_sum(self, pos, 0.5 / (sigma * sigma), sigma, NULL);
+            nmodes++;
+        }
+        basins[s] = j;
+    }
+    Py_END_ALLOW_THREADS
+    self->busy = 0;
+
+    modelist = PyList_New(nmodes);
+    depthlist = PyList_New(nmodes);
+    for (j=0; j<nmodes; j++) {
+        row = PyList_New(dim);
+        for (k=0; k<dim; k++)
+            PyList_SET_ITEM(row, k, PyFloat_FromDouble(modes[j * dim + k]));
+        PyList_SET_ITEM(modelist, j, row);
+        PyList_SET_ITEM(depthlist, j, PyFloat_FromDouble(depths[j]));
+    }
+    basinlist = PyList_New(job.nseeds);
+    for (s=0; s<job.nseeds; s++)
+        PyList_SET_ITEM(basinlist, s, PyInt_FromLong(basins[s]));
+
+    pthread_mutex_destroy(&job.lock);
+    free(job.ends);
+    free(job.converged);
+    free(basins);
+    free(modes);
+    free(depths);
+    free(threads);
+    PyBuffer_Release(&seedview);
+
+    return Py_BuildValue("NNN", modelist, depthlist, basinlist);
+}
+
+static PyMethodDef PTSMData_methods[] = {
+    {"setData", (PyCFunction)PTSMData_setData, METH_O, "Sets the dataset (rows x dims)."},
+    {"getSize", (PyCFunction)PTSMData_getSize, METH_NOARGS, "Returns the number of points."},
+    {"getDim", (PyCFunction)PTSMData_getDim, METH_NOARGS, "Returns the number of dimensions."},
+    {"setKernel", (PyCFunction)PTSMData_setKernel, METH_O, "Sets the computation kernel (0 = auto, 1 = scalar, 2 = avx2, 3 = avx512)."},
+    {"getKernel", (PyCFunction)PTSMData_getKernel, METH_NOARGS, "Returns the name of the computation kernel."},
+    {"setCutoff", (PyCFunction)PTSMData_setCutoff, METH_O, "Sets the search radius, in sigma units (0 = exact)."},
+    {"getCutoff", (PyCFunction)PTSMData_getCutoff, METH_NOARGS, "Returns the search radius, in sigma units."},
+    {"potential", (PyCFunction)PTSMData_potential, METH_VARARGS|METH_KEYWORDS, "Returns the potential energy at a given position."},
+    {"integrate", (PyCFunction)PTSMData_integrate, METH_VARARGS|METH_KEYWORDS, "Integrates the trajectory of a particle in place."},
+    {"integrateBatch", (PyCFunction)PTSMData_integrateBatch, METH_VARARGS|METH_KEYWORDS, "Integrates the trajectories of many particles in place."},
+    {"findModes", (PyCFunction)PTSMData_findModes, METH_VARARGS|METH_KEYWORDS, "Finds the minima of the potential reached from a set of seeds."},
+    {NULL}  /* Sentinel */
+};
+
+PyTypeObject PTSMDataType = {
+    PyObject_HEAD_INIT(NULL)
+    0,                         /*ob_size*/
+    "_pyo.PTSMData_base",         /*tp_name*/
+    sizeof(PTSMData),         /*tp_basicsize*/
+    0,                         /*tp_itemsize*/
+    (destructor)PTSMData_dealloc, /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    0,                         /*tp_as_number*/
+    0,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    0,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,  /*tp_flags*/
+    "PTSMData objects. Dataset used for offline particle trajectory computations.",           /* tp_doc */
+    0,                         /* tp_traverse */
+    0,                         /* tp_clear */
+    0,		               /* tp_richcompare */
+    0,		               /* tp_weaklistoffset */
+    0,		               /* tp_iter */
+    0,		               /* tp_iternext */
+    PTSMData_methods,             /* tp_methods */
+    0,                         /* tp_members */
+    0,                      /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,      /* tp_init */
+    0,                         /* tp_alloc */
+    PTSMData_new,                 /* tp_new */
+};
@@ -5464,6 +5464,7 @@ Urn_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
     Urn_reset(self);
 
@@ -25,6 +25,7 @@
 #include "servermodule.h"
 #include "dummymodule.h"
 #include "sndfile.h"
+#include "sfwriter.h"
 #include "interpolation.h"
 
 /************/
@@ -36,41 +37,35 @@ typedef struct {
     PyObject *input_stream_list;
     int chnls;
     int buffering;
-    int count;
+    double queuedur;
     int listlen;
     char *recpath;
-    SNDFILE *recfile;
+    SfWriter *writer;
     SF_INFO recinfo;
     MYFLT *buffer;
 } Record;
 
 static void
 Record_process(Record *self) {
-    int i, j, chnl, offset, totlen;
+    int i, j, chnl, totlen;
     MYFLT *in;
 
-    totlen = self->chnls*self->bufsize*self->buffering;
+    totlen = self->chnls*self->bufsize;
 
-    if (self->count == self->buffering) {
-        self->count = 0;
-        for (i=0; i<totlen; i++) {
-            self->buffer[i] = 0.0;
-        }
+    for (i=0; i<totlen; i++) {
+        self->buffer[i] = 0.0;
     }
 
-    offset = self->bufsize * self->chnls * self->count;
-
     for (j=0; j<self->listlen; j++) {
         chnl = j % self->chnls;
         in = Stream_getData((Stream *)PyList_GET_ITEM(self->input_stream_list, j));
         for (i=0; i<self->bufsize; i++) {
-            self->buffer[i*self->chnls+chnl+offset] += in[i];
+            self->buffer[i*self->chnls+chnl] += in[i];
         }
     }
-    self->count++;
 
-    if (self->count == self->buffering)
-        SF_WRITE(self->recfile, self->buffer, totlen);
+    /* The file is written by the writer thread, full queue drops the buffer. */
+    SfWriter_write(self->writer, self->buffer, self->bufsize);
 }
 
 static void
@@ -109,6 +104,7 @@ Record_dealloc(Record* self)
     if (Stream_getStreamActive(self->stream))
         PyObject_CallMethod((PyObject *)self, "stop", NULL);
     pyo_DEALLOC
+    SfWriter_free(self->writer);
     free(self->buffer);
     Record_clear(self);
     self->ob_type->tp_free((PyObject*)self);
@@ -117,8 +113,9 @@ Record_dealloc(Record* self)
 static PyObject *
 Record_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    int i, buflen;
+    int i, buflen, capacity, offline;
     int fileformat = 0;
+    SNDFILE *recfile;
     int sampletype = 0;
     double quality = 0.4;
     PyObject *input_listtmp;
@@ -127,15 +124,15 @@ Record_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->chnls = 2;
     self->buffering = 4;
-    self->count = 0;
+    self->queuedur = SFWRITER_DEFAULT_QUEUE;
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Record_compute_next_data_frame);
     self->mode_func_ptr = Record_setProcMode;
 
-    static char *kwlist[] = {"input", "filename", "chnls", "fileformat", "sampletype", "buffering", "quality", NULL};
+    static char *kwlist[] = {"input", "filename", "chnls", "fileformat", "sampletype", "buffering", "quality", "queuedur", NULL};
 
-    if (! PyArg_ParseTupleAndKeywords(args, kwds, "Os|iiiid", kwlist, &input_listtmp, &self->recpath, &self->chnls, &fileformat, &sampletype, &self->buffering, &quality))
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "Os|iiiidd", kwlist, &input_listtmp, &self->recpath, &self->chnls, &fileformat, &sampletype, &self->buffering, &quality, &self->queuedur))
         Py_RETURN_NONE;
 
     Py_XDECREF(self->input_list);
@@ -203,17 +200,22 @@ Record_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     }
 
     /* Open the output file. */
-    if (! (self->recfile = sf_open(self->recpath, SFM_WRITE, &self->recinfo))) {
+    if (! (recfile = sf_open(self->recpath, SFM_WRITE, &self->recinfo))) {
         printf ("Not able to open output file %s.\n", self->recpath);
         Py_RETURN_NONE;
     }
 
     // Sets the encoding quality for FLAC and OGG compressed formats
     if (fileformat == 5 || fileformat == 7) {
-        sf_command(self->recfile, SFC_SET_VBR_ENCODING_QUALITY, &quality, sizeof(double));
+        sf_command(recfile, SFC_SET_VBR_ENCODING_QUALITY, &quality, sizeof(double));
     }
 
-    buflen = self->bufsize * self->chnls * self->buffering;
+    /* An offline server waits for the disk instead of dropping buffers. */
+    offline = ((Server *)self->server)->audio_be_type == PyoOffline || ((Server *)self->server)->audio_be_type == PyoOfflineNB;
+    capacity = (int)(self->queuedur * self->sr);
+    self->writer = SfWriter_new(recfile, self->chnls, capacity, self->bufsize * self->buffering, offline);
+
+    buflen = self->bufsize * self->chnls;
     self->buffer = (MYFLT *)realloc(self->buffer, buflen * sizeof(MYFLT));
     for (i=0; i<buflen; i++) {
         self->buffer[i] = 0.;
@@ -232,10 +234,22 @@ static PyObject * Record_getStream(Record* self) { GET_STREAM };
 static PyObject * Record_play(Record *self, PyObject *args, PyObject *kwds) { PLAY };
 static PyObject * Record_stop(Record *self)
 {
-    sf_close(self->recfile);
+    /* Stops the producer first, the buffer in flight is queued before the
+    writer drains the ring and closes the file. */
+    Stream_setStreamActive(self->stream, 0);
+    Server_waitForCallback((Server *)self->server);
+    Py_BEGIN_ALLOW_THREADS
+    SfWriter_close(self->writer);
+    Py_END_ALLOW_THREADS
     STOP
 };
 
+static PyObject *
+Record_getOverruns(Record *self)
+{
+    return PyLong_FromUnsignedLong(SfWriter_getOverruns(self->writer));
+}
+
 static PyMemberDef Record_members[] = {
 {"server", T_OBJECT_EX, offsetof(Record, server), 0, "Pyo server."},
 {"stream", T_OBJECT_EX, offsetof(Record, stream), 0, "Stream object."},
@@ -248,6 +262,7 @@ static PyMethodDef Record_methods[] = {
 {"_getStream", (PyCFunction)Record_getStream, METH_NOARGS, "Returns stream object."},
 {"play", (PyCFunction)Record_play, METH_VARARGS|METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
 {"stop", (PyCFunction)Record_stop, METH_NOARGS, "Stops computing."},
+{"getOverruns", (PyCFunction)Record_getOverruns, METH_NOARGS, "Returns the number of buffers dropped because the disk was too slow."},
 {NULL}  /* Sentinel */
 };
 
@@ -324,7 +339,7 @@ ControlRec_process(ControlRec *self) {
             }
             self->time++;
             if (self->count >= self->size)
-                PyObject_CallMethod((PyObject *)self, "stop", NULL);
+                Server_deferStop((Server *)self->server, (PyObject *)self);
         }
     }
     else {
@@ -394,6 +409,7 @@ ControlRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, ControlRec_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
     self->mode_func_ptr = ControlRec_setProcMode;
 
     static char *kwlist[] = {"input", "rate", "dur", NULL};
@@ -544,7 +560,7 @@ ControlRead_readframes_i(ControlRead *self) {
     MYFLT invmodulo = 1.0 / self->modulo;
 
     if (self->go == 0)
-        PyObject_CallMethod((PyObject *)self, "stop", NULL);
+        Server_deferStop((Server *)self->server, (PyObject *)self);
 
     for (i=0; i<self->bufsize; i++) {
         self->trigsBuffer[i] = 0.0;
@@ -700,6 +716,7 @@ ControlRead_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
     self->modulo = (int)(self->sr / self->rate);
 
@@ -1009,6 +1026,7 @@ NoteinRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, NoteinRec_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
     self->mode_func_ptr = NoteinRec_setProcMode;
 
     static char *kwlist[] = {"inputp", "inputv", NULL};
@@ -1147,7 +1165,7 @@ NoteinRead_readframes_i(NoteinRead *self) {
     long i;
 
     if (self->go == 0)
-        PyObject_CallMethod((PyObject *)self, "stop", NULL);
+        Server_deferStop((Server *)self->server, (PyObject *)self);
 
     for (i=0; i<self->bufsize; i++) {
         self->trigsBuffer[i] = 0.0;
@@ -1306,6 +1324,7 @@ NoteinRead_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
     (*self->mode_func_ptr)(self);
 
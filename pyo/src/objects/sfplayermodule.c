@@ -27,6 +27,16 @@
 #include "dummymodule.h"
 #include "sndfile.h"
 #include "interpolation.h"
+#include "sfstreamer.h"
+
+/* Sound file read by the audio thread, replaced as a whole by setSound. */
+typedef struct {
+    SfStreamer *streamer;
+    int sndSize; /* number of frames */
+    int sndSr;
+    MYFLT srScale;
+    unsigned int serial; /* a new one restarts the reading at startPos */
+} SfPlayerSound;
 
 /* SfPlayer object */
 typedef struct {
@@ -34,22 +44,24 @@ typedef struct {
     PyObject *speed;
     Stream *speed_stream;
     int modebuffer[1];
-    SNDFILE *sf;
+    SfPlayerSound *sound; /* published with Server_swapPointer */
+    unsigned int serial; /* serial of the last sound read by the audio thread */
     SF_INFO info;
     char *path;
     int loop;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
-    int sndSize; /* number of frames */
     int sndChnls;
-    int sndSr;
-    MYFLT srScale;
     MYFLT startPos;
     double pointerPos;
     MYFLT *samplesBuffer;
     MYFLT *trigsBuffer;
     TriggerStream *trig_stream;
     int init;
-    MYFLT (*interp_func_ptr)(MYFLT *, int, MYFLT, int);
+    MYFLT *readBuffer;
+    int readSize;
+    interp_block_func interp_func_ptr;
+    int *interpIndex; /* scratch buffers of the block interpolation */
+    MYFLT *interpFrac;
 } SfPlayer;
 
 MYFLT max_arr(MYFLT *a,int n)
@@ -76,28 +88,79 @@ MYFLT min_arr(MYFLT *a,int n)
     return m;
 }
 
+/* Scratch space of the readframes functions, the interleaved frames followed
+** by the de-interleaved channels. Only grows when the speed goes higher than
+** it ever was. */
+static MYFLT *
+sfplayer_read_buffer(MYFLT **buffer, int *size, int len)
+{
+    if (len > *size) {
+        *size = len * 2;
+        *buffer = (MYFLT *)realloc(*buffer, *size * sizeof(MYFLT));
+    }
+    return *buffer;
+}
+
+/* Offline servers can wait for the disk, the real-time ones never do. */
+static int
+sfplayer_is_offline(PyObject *server)
+{
+    PyoAudioBackendType type = ((Server *)server)->audio_be_type;
+    return type == PyoOffline || type == PyoOfflineNB;
+}
+
+static SfPlayerSound *
+SfPlayerSound_new(SfPlayer *self, SfStreamer *streamer, SF_INFO *info, unsigned int serial)
+{
+    SfPlayerSound *sound = (SfPlayerSound *)malloc(sizeof(SfPlayerSound));
+    sound->streamer = streamer;
+    sound->sndSize = info->frames;
+    sound->sndSr = info->samplerate;
+    sound->srScale = sound->sndSr / self->sr;
+    sound->serial = serial;
+    return sound;
+}
+
+static void
+SfPlayerSound_free(SfPlayerSound *sound)
+{
+    if (sound == NULL)
+        return;
+    SfStreamer_close(sound->streamer);
+    free(sound);
+}
+
 static void
 SfPlayer_readframes_i(SfPlayer *self) {
-    MYFLT sp, frac, bufpos, delta, startPos;
-    int i, j, totlen, buflen, shortbuflen, pad, bufindex;
+    MYFLT sp, bufpos, delta, startPos;
+    int i, j, totlen, buflen, shortbuflen, pad;
+    int *bufindex = self->interpIndex;
+    MYFLT *frac = self->interpFrac;
     sf_count_t index;
+    MYFLT *buffer, *buffer2;
+    SfPlayerSound *sound = self->sound;
+
+    if (sound->serial != self->serial) {
+        self->serial = sound->serial;
+        self->pointerPos = self->startPos;
+    }
 
     if (self->modebuffer[0] == 0)
         sp = PyFloat_AS_DOUBLE(self->speed);
     else
         sp = Stream_getData((Stream *)self->speed_stream)[0];
-    delta = MYFABS(sp) * self->srScale;
+    delta = MYFABS(sp) * sound->srScale;
 
     buflen = (int)(self->bufsize * delta + 0.5) + 64;
     totlen = self->sndChnls*buflen;
-    MYFLT buffer[totlen];
-    MYFLT buffer2[self->sndChnls][buflen];
+    buffer = sfplayer_read_buffer(&self->readBuffer, &self->readSize, totlen * 2);
+    buffer2 = buffer + totlen;
 
     if (sp > 0) { /* forward reading */
-        if (self->pointerPos >= self->sndSize) {
-            self->pointerPos -= self->sndSize - self->startPos;
+        if (self->pointerPos >= sound->sndSize) {
+            self->pointerPos -= sound->sndSize - self->startPos;
             if (self->loop == 0) {
-                PyObject_CallMethod((PyObject *)self, "stop", NULL);
+                Server_deferStop((Server *)self->server, (PyObject *)self);
                 for (i=0; i<(self->bufsize * self->sndChnls); i++) {
                     self->samplesBuffer[i] = 0.0;
                 }
@@ -108,61 +171,57 @@ SfPlayer_readframes_i(SfPlayer *self) {
             }
         }
         index = (int)self->pointerPos;
-        sf_seek(self->sf, index, SEEK_SET); /* sets position pointer in the file */
 
         /* fill a buffer with enough samples to satisfy speed reading */
         /* if not enough samples left in the file */
-        if ((index+buflen) > self->sndSize) {
-            shortbuflen = self->sndSize - index;
-            pad = (buflen-shortbuflen)*self->sndChnls;
-            SF_READ(self->sf, buffer, shortbuflen*self->sndChnls);
+        if ((index+buflen) > sound->sndSize) {
+            shortbuflen = sound->sndSize - index;
+            pad = buflen - shortbuflen;
+            SfStreamer_read(sound->streamer, index, shortbuflen, buffer);
             if (self->loop == 0) { /* with zero padding if noloop */
-                for (i=0; i<pad; i++) {
+                for (i=0; i<pad*self->sndChnls; i++) {
                     buffer[i+shortbuflen*self->sndChnls] = 0.;
                 }
             }
-            else { /* wrap around and read new samples if loop */
-                MYFLT buftemp[pad];
-                sf_seek(self->sf, (int)self->startPos, SEEK_SET);
-                SF_READ(self->sf, buftemp, pad);
-                for (i=0; i<(pad); i++) {
-                    buffer[i+shortbuflen*self->sndChnls] = buftemp[i];
-                }
-            }
+            else /* wrap around and read new samples if loop */
+                SfStreamer_read(sound->streamer, (int)self->startPos, pad, buffer + shortbuflen*self->sndChnls);
         }
         else /* without zero padding */
-            SF_READ(self->sf, buffer, totlen);
+            SfStreamer_read(sound->streamer, index, buflen, buffer);
 
         /* de-interleave samples */
         for (i=0; i<totlen; i++) {
-            buffer2[i%self->sndChnls][(int)(i/self->sndChnls)] = buffer[i];
+            buffer2[(i%self->sndChnls)*buflen + (int)(i/self->sndChnls)] = buffer[i];
         }
 
         /* fill samplesBuffer with samples */
         for (i=0; i<self->bufsize; i++) {
             self->trigsBuffer[i] = 0.0;
             bufpos = self->pointerPos - index;
-            bufindex = (int)bufpos;
-            frac = bufpos - bufindex;
-            for (j=0; j<self->sndChnls; j++) {
-                self->samplesBuffer[i+(j*self->bufsize)] = (*self->interp_func_ptr)(buffer2[j], bufindex, frac, buflen);
-            }
+            bufindex[i] = (int)bufpos;
+            frac[i] = bufpos - bufindex[i];
             self->pointerPos += delta;
         }
-        if (self->pointerPos >= self->sndSize)
+        for (j=0; j<self->sndChnls; j++) {
+            (*self->interp_func_ptr)(buffer2 + j*buflen, buflen, bufindex, frac, self->samplesBuffer + j*self->bufsize, self->bufsize);
+        }
+        if (self->pointerPos >= sound->sndSize)
             self->trigsBuffer[0] = 1.0;
+
+        SfStreamer_prefetch(sound->streamer, (sf_count_t)self->pointerPos, 1, buflen,
+                            self->loop ? (sf_count_t)self->startPos : -1, 1);
     }
     else if (sp < 0){ /* backward reading */
         startPos = self->startPos;
         if (startPos == 0.)
-            startPos = self->sndSize - 1;
+            startPos = sound->sndSize - 1;
         if (self->pointerPos == 0.0)
-            self->pointerPos = self->sndSize - 1;
+            self->pointerPos = sound->sndSize - 1;
 
         if (self->pointerPos <= 0) {
             self->pointerPos += startPos;
             if (self->loop == 0) {
-                PyObject_CallMethod((PyObject *)self, "stop", NULL);
+                Server_deferStop((Server *)self->server, (PyObject *)self);
                 for (i=0; i<(self->bufsize * self->sndChnls); i++) {
                     self->samplesBuffer[i] = 0.0;
                 }
@@ -179,37 +238,23 @@ SfPlayer_readframes_i(SfPlayer *self) {
         /* if not enough samples to read in the file */
         if ((index-buflen) < 0) {
             shortbuflen = index;
-            int pad = buflen - shortbuflen;
-            int padlen = pad*self->sndChnls;
+            pad = buflen - shortbuflen;
 
             if (self->loop == 0) { /* with zero padding if noloop */
-                for (i=0; i<padlen; i++) {
+                for (i=0; i<pad*self->sndChnls; i++) {
                     buffer[i] = 0.;
                 }
             }
-            else { /* wrap around and read new samples if loop */
-                MYFLT buftemp[padlen];
-                sf_seek(self->sf, (int)startPos-pad, SEEK_SET);
-                SF_READ(self->sf, buftemp, padlen);
-                for (i=0; i<padlen; i++) {
-                    buffer[i] = buftemp[i];
-                }
-            }
-
-            MYFLT buftemp2[shortbuflen*self->sndChnls];
-            sf_seek(self->sf, 0, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buftemp2, shortbuflen*self->sndChnls);
-            for (i=0; i<(shortbuflen*self->sndChnls); i++) {
-                buffer[i+padlen] = buftemp2[i];
-            }
+            else /* wrap around and read new samples if loop */
+                SfStreamer_read(sound->streamer, (int)startPos-pad, pad, buffer);
+            SfStreamer_read(sound->streamer, 0, shortbuflen, buffer + pad*self->sndChnls);
         }
         else /* without zero padding */
-            sf_seek(self->sf, index-buflen, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buffer, totlen);
+            SfStreamer_read(sound->streamer, index-buflen, buflen, buffer);
 
         /* de-interleave samples */
         for (i=0; i<totlen; i++) {
-            buffer2[i%self->sndChnls][(int)(i/self->sndChnls)] = buffer[i];
+            buffer2[(i%self->sndChnls)*buflen + (int)(i/self->sndChnls)] = buffer[i];
         }
 
         /* reverse arrays */
@@ -217,10 +262,11 @@ SfPlayer_readframes_i(SfPlayer *self) {
         for (i=0; i<self->sndChnls; i++) {
             int a;
             int b = buflen;
+            MYFLT *chnl = buffer2 + i*buflen;
             for (a=0; a<--b; a++) { //increment a and decrement b until they meet eachother
-                swap = buffer2[i][a];       //put what's in a into swap space
-                buffer2[i][a] = buffer2[i][b];    //put what's in b into a
-                buffer2[i][b] = swap;       //put what's in the swap (a) into b
+                swap = chnl[a];       //put what's in a into swap space
+                chnl[a] = chnl[b];    //put what's in b into a
+                chnl[b] = swap;       //put what's in the swap (a) into b
             }
         }
 
@@ -228,19 +274,22 @@ SfPlayer_readframes_i(SfPlayer *self) {
         for (i=0; i<self->bufsize; i++) {
             self->trigsBuffer[i] = 0.0;
             bufpos = index - self->pointerPos;
-            bufindex = (int)bufpos;
-            frac = bufpos - bufindex;
-            for (j=0; j<self->sndChnls; j++) {
-                self->samplesBuffer[i+(j*self->bufsize)] = (*self->interp_func_ptr)(buffer2[j], bufindex, frac, buflen);
-            }
+            bufindex[i] = (int)bufpos;
+            frac[i] = bufpos - bufindex[i];
             self->pointerPos -= delta;
         }
+        for (j=0; j<self->sndChnls; j++) {
+            (*self->interp_func_ptr)(buffer2 + j*buflen, buflen, bufindex, frac, self->samplesBuffer + j*self->bufsize, self->bufsize);
+        }
         if (self->pointerPos <= 0) {
             if (self->init == 0)
                 self->trigsBuffer[0] = 1.0;
             else
                 self->init = 0;
         }
+
+        SfStreamer_prefetch(sound->streamer, (sf_count_t)self->pointerPos, -1, buflen,
+                            self->loop ? (sf_count_t)startPos : -1, -1);
     }
     else { /* speed == 0.0 */
         for (i = 0; i < (self->bufsize*self->sndChnls); i++) {
@@ -285,8 +334,10 @@ static void
 SfPlayer_dealloc(SfPlayer* self)
 {
     pyo_DEALLOC
-    if (self->sf != NULL)
-        sf_close(self->sf);
+    free(self->interpIndex);
+    free(self->interpFrac);
+    SfPlayerSound_free(self->sound);
+    free(self->readBuffer);
     free(self->trigsBuffer);
     free(self->samplesBuffer);
     SfPlayer_clear(self);
@@ -299,6 +350,7 @@ SfPlayer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     int i;
     MYFLT offset = 0.;
     PyObject *speedtmp=NULL;
+    SfStreamer *streamer;
     SfPlayer *self;
     self = (SfPlayer *)type->tp_alloc(type, 0);
 
@@ -312,6 +364,9 @@ SfPlayer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Stream_setFunctionPtr(self->stream, SfPlayer_compute_next_data_frame);
     self->mode_func_ptr = SfPlayer_setProcMode;
 
+    self->interpIndex = (int *)realloc(self->interpIndex, self->bufsize * sizeof(int));
+    self->interpFrac = (MYFLT *)realloc(self->interpFrac, self->bufsize * sizeof(MYFLT));
+
     static char *kwlist[] = {"path", "speed", "loop", "offset", "interp", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_S__OIFI, kwlist, &self->path, &speedtmp, &self->loop, &offset, &self->interp))
@@ -325,21 +380,19 @@ SfPlayer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     (*self->mode_func_ptr)(self);
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     /* Open the sound file. */
-    self->info.format = 0;
-    self->sf = sf_open(self->path, SFM_READ, &self->info);
-    if (self->sf == NULL)
+    streamer = SfStreamer_open(self->path, &self->info, sfplayer_is_offline(self->server));
+    if (streamer == NULL)
     {
         printf("Failed to open the file.\n");
     }
-    self->sndSize = self->info.frames;
-    self->sndSr = self->info.samplerate;
+    self->sound = SfPlayerSound_new(self, streamer, &self->info, 0);
     self->sndChnls = self->info.channels;
-    self->srScale = self->sndSr / self->sr;
 
     self->samplesBuffer = (MYFLT *)realloc(self->samplesBuffer, self->bufsize * self->sndChnls * sizeof(MYFLT));
+    sfplayer_read_buffer(&self->readBuffer, &self->readSize, 2 * self->sndChnls * ((int)(self->bufsize * self->sound->srScale) + 64));
     self->trigsBuffer = (MYFLT *)realloc(self->trigsBuffer, self->bufsize * sizeof(MYFLT));
 
     for (i=0; i<self->bufsize; i++) {
@@ -348,9 +401,10 @@ SfPlayer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
-    self->startPos = offset * self->sr * self->srScale;
-    if (self->startPos < 0.0 || self->startPos >= self->sndSize)
+    self->startPos = offset * self->sr * self->sound->srScale;
+    if (self->startPos < 0.0 || self->startPos >= self->sound->sndSize)
         self->startPos = 0.0;
 
     self->pointerPos = self->startPos;
@@ -358,6 +412,28 @@ SfPlayer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     return (PyObject *)self;
 }
 
+/* Called from Python, before the stream is activated. */
+static void
+SfPlayer_seek(SfPlayer *self)
+{
+    MYFLT sp;
+    SfPlayerSound *sound = self->sound;
+
+    if (sound->streamer == NULL)
+        return;
+    if (self->modebuffer[0] == 0)
+        sp = PyFloat_AS_DOUBLE(self->speed);
+    else
+        sp = 1.0;
+    Py_BEGIN_ALLOW_THREADS
+    if (sp < 0)
+        SfStreamer_seek(sound->streamer, (sf_count_t)(self->startPos == 0. ? sound->sndSize - 1 : self->startPos), -1,
+                        (int)(self->bufsize * MYFABS(sp) * sound->srScale) + 64, 100);
+    else
+        SfStreamer_seek(sound->streamer, (sf_count_t)self->startPos, 1, (int)(self->bufsize * sp * sound->srScale) + 64, 100);
+    Py_END_ALLOW_THREADS
+}
+
 static PyObject * SfPlayer_getServer(SfPlayer* self) { GET_SERVER };
 static PyObject * SfPlayer_getStream(SfPlayer* self) { GET_STREAM };
 static PyObject * SfPlayer_getTriggerStream(SfPlayer* self) { GET_TRIGGER_STREAM };
@@ -366,6 +442,7 @@ static PyObject * SfPlayer_play(SfPlayer *self, PyObject *args, PyObject *kwds)
 {
     self->init = 1;
     self->pointerPos = self->startPos;
+    SfPlayer_seek(self);
     PLAY
 };
 
@@ -373,6 +450,7 @@ static PyObject * SfPlayer_out(SfPlayer *self, PyObject *args, PyObject *kwds)
 {
     self->init = 1;
     self->pointerPos = self->startPos;
+    SfPlayer_seek(self);
     OUT
 };
 
@@ -415,28 +493,35 @@ SfPlayer_setSound(SfPlayer *self, PyObject *arg)
     /* Need to perform a check to be sure that the new 
        sound is of the same number of channels. */
 
-    ASSERT_ARG_NOT_NULL
+    char *path;
+    SF_INFO info;
+    SfStreamer *streamer;
+    SfPlayerSound *sound;
 
-    self->path = PyString_AsString(arg);
+    ASSERT_ARG_NOT_NULL
 
-    sf_close(self->sf);
+    path = PyString_AsString(arg);
 
     /* Open the sound file. */
-    self->info.format = 0;
-    self->sf = sf_open(self->path, SFM_READ, &self->info);
-    if (self->sf == NULL)
+    streamer = SfStreamer_open(path, &info, sfplayer_is_offline(self->server));
+    if (streamer == NULL)
     {
         printf("Failed to open the file.\n");
+        Py_INCREF(Py_None);
+        return Py_None;
     }
-    self->sndSize = self->info.frames;
-    self->sndSr = self->info.samplerate;
+
+    self->path = path;
+    self->info = info;
     //self->sndChnls = self->info.channels;
-    self->srScale = self->sndSr / self->sr;
 
     //self->samplesBuffer = (MYFLT *)realloc(self->samplesBuffer, self->bufsize * self->sndChnls * sizeof(MYFLT));
 
+    /* The audio thread restarts at the beginning when it sees the new serial. */
     self->startPos = 0.0;
-    self->pointerPos = self->startPos;
+    sound = SfPlayerSound_new(self, streamer, &info, self->sound->serial + 1);
+    sound = (SfPlayerSound *)Server_swapPointer((Server *)self->server, (void **)&self->sound, sound);
+    SfPlayerSound_free(sound);
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -461,8 +546,8 @@ SfPlayer_setOffset(SfPlayer *self, PyObject *arg)
     int isNumber = PyNumber_Check(arg);
 
 	if (isNumber == 1) {
-		self->startPos = PyFloat_AsDouble(arg) * self->sr * self->srScale;
-        if (self->startPos < 0.0 || self->startPos >= self->sndSize)
+		self->startPos = PyFloat_AsDouble(arg) * self->sr * self->sound->srScale;
+        if (self->startPos < 0.0 || self->startPos >= self->sound->sndSize)
             self->startPos = 0.0;
     }
 
@@ -481,7 +566,7 @@ SfPlayer_setInterp(SfPlayer *self, PyObject *arg)
 		self->interp = PyInt_AsLong(PyNumber_Int(arg));
     }
 
-    SET_INTERP_POINTER
+    SET_INTERP_BLOCK_POINTER
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -490,6 +575,7 @@ SfPlayer_setInterp(SfPlayer *self, PyObject *arg)
 MYFLT *
 SfPlayer_getSamplesBuffer(SfPlayer *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->samplesBuffer;
 }
 
@@ -825,7 +911,7 @@ typedef struct {
     PyObject *speed;
     Stream *speed_stream;
     int modebuffer[1];
-    SNDFILE *sf;
+    SfStreamer *streamer;
     SF_INFO info;
     char *path;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
@@ -842,7 +928,11 @@ typedef struct {
     MYFLT *samplesBuffer;
     MYFLT *markers;
     int markers_size;
-    MYFLT (*interp_func_ptr)(MYFLT *, int, MYFLT, int);
+    MYFLT *readBuffer;
+    int readSize;
+    interp_block_func interp_func_ptr;
+    int *interpIndex; /* scratch buffers of the block interpolation */
+    MYFLT *interpFrac;
 } SfMarkerShuffler;
 
 /*** PROTOTYPES ***/
@@ -851,9 +941,12 @@ static void SfMarkerShuffler_chooseNewMark(SfMarkerShuffler *self, int dir);
 
 static void
 SfMarkerShuffler_readframes_i(SfMarkerShuffler *self) {
-    MYFLT sp, frac, bufpos, delta, tmp;
-    int i, j, totlen, buflen, shortbuflen, bufindex;
+    MYFLT sp, bufpos, delta, tmp;
+    int i, j, totlen, buflen, shortbuflen, pad;
+    int *bufindex = self->interpIndex;
+    MYFLT *frac = self->interpFrac;
     sf_count_t index;
+    MYFLT *buffer, *buffer2;
 
     if (self->modebuffer[0] == 0)
         sp = PyFloat_AS_DOUBLE(self->speed);
@@ -864,8 +957,8 @@ SfMarkerShuffler_readframes_i(SfMarkerShuffler *self) {
 
     buflen = (int)(self->bufsize * delta + 0.5) + 64;
     totlen = self->sndChnls*buflen;
-    MYFLT buffer[totlen];
-    MYFLT buffer2[self->sndChnls][buflen];
+    buffer = sfplayer_read_buffer(&self->readBuffer, &self->readSize, totlen * 2);
+    buffer2 = buffer + totlen;
 
     if (sp > 0) { /* reading forward */
         if (self->startPos == -1 || self->lastDir == 0) {
@@ -880,47 +973,44 @@ SfMarkerShuffler_readframes_i(SfMarkerShuffler *self) {
             self->lastDir = 1;
         }
         index = (int)self->pointerPos;
-        sf_seek(self->sf, index, SEEK_SET); /* sets position pointer in the file */
 
         /* fill a buffer with enough samples to satisfy speed reading */
         /* if not enough samples to read in the file */
         if ((index+buflen) > self->endPos) {
             shortbuflen = self->endPos - index;
-            SF_READ(self->sf, buffer, shortbuflen*self->sndChnls);
+            if (shortbuflen < 0)
+                shortbuflen = 0;
+            pad = buflen - shortbuflen;
+            SfStreamer_read(self->streamer, index, shortbuflen, buffer);
 
             /* wrap around and read new samples from new marker */
-            int pad = buflen - shortbuflen;
-            int padlen = pad*self->sndChnls;
-            MYFLT buftemp[padlen];
-            sf_seek(self->sf, (int)self->nextStartPos, SEEK_SET);
-            SF_READ(self->sf, buftemp, padlen);
-            for (i=0; i<padlen; i++) {
-                buffer[i+shortbuflen*self->sndChnls] = buftemp[i];
-            }
+            SfStreamer_read(self->streamer, (int)self->nextStartPos, pad, buffer + shortbuflen*self->sndChnls);
         }
         else /* without wraparound */
-            SF_READ(self->sf, buffer, totlen);
+            SfStreamer_read(self->streamer, index, buflen, buffer);
 
         /* de-interleave samples */
         for (i=0; i<totlen; i++) {
-            buffer2[i%self->sndChnls][(int)(i/self->sndChnls)] = buffer[i];
+            buffer2[(i%self->sndChnls)*buflen + (int)(i/self->sndChnls)] = buffer[i];
         }
 
         /* fill data with samples */
         for (i=0; i<self->bufsize; i++) {
             bufpos = self->pointerPos - index;
-            bufindex = (int)bufpos;
-            frac = bufpos - bufindex;
-            for (j=0; j<self->sndChnls; j++) {
-                self->samplesBuffer[i+(j*self->bufsize)] = (*self->interp_func_ptr)(buffer2[j], bufindex, frac, buflen);
-            }
+            bufindex[i] = (int)bufpos;
+            frac[i] = bufpos - bufindex[i];
             self->pointerPos += delta;
         }
+        for (j=0; j<self->sndChnls; j++) {
+            (*self->interp_func_ptr)(buffer2 + j*buflen, buflen, bufindex, frac, self->samplesBuffer + j*self->bufsize, self->bufsize);
+        }
         if (self->pointerPos >= self->endPos) {
             MYFLT off = self->pointerPos - self->endPos;
             SfMarkerShuffler_chooseNewMark((SfMarkerShuffler *)self, 1);
             self->pointerPos = self->startPos + off;
         }
+
+        SfStreamer_prefetch(self->streamer, (sf_count_t)self->pointerPos, 1, buflen, (sf_count_t)self->nextStartPos, 1);
     }
     else if (sp < 0) { /* reading backward */
         if (self->startPos == -1 || self->lastDir != -1) {
@@ -934,31 +1024,20 @@ SfMarkerShuffler_readframes_i(SfMarkerShuffler *self) {
         /* if not enough samples to read in the file */
         if ((index-buflen) < self->endPos) {
             shortbuflen = index - self->endPos;
-            int pad = buflen - shortbuflen;
-            int padlen = pad*self->sndChnls;
+            if (shortbuflen < 0)
+                shortbuflen = 0;
+            pad = buflen - shortbuflen;
 
             /* wrap around and read new samples from new marker */
-            MYFLT buftemp[padlen];
-            sf_seek(self->sf, (int)self->nextStartPos-pad, SEEK_SET);
-            SF_READ(self->sf, buftemp, padlen);
-            for (i=0; i<padlen; i++) {
-                buffer[i] = buftemp[i];
-            }
-
-            MYFLT buftemp2[shortbuflen*self->sndChnls];
-            sf_seek(self->sf, self->endPos, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buftemp2, shortbuflen*self->sndChnls);
-            for (i=0; i<(shortbuflen*self->sndChnls); i++) {
-                buffer[i+padlen] = buftemp2[i];
-            }
-        }
-        else { /* without wraparound */
-            sf_seek(self->sf, index-buflen, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buffer, totlen);
+            SfStreamer_read(self->streamer, (int)self->nextStartPos-pad, pad, buffer);
+            SfStreamer_read(self->streamer, self->endPos, shortbuflen, buffer + pad*self->sndChnls);
         }
+        else /* without wraparound */
+            SfStreamer_read(self->streamer, index-buflen, buflen, buffer);
+
         /* de-interleave samples */
         for (i=0; i<totlen; i++) {
-            buffer2[i%self->sndChnls][(int)(i/self->sndChnls)] = buffer[i];
+            buffer2[(i%self->sndChnls)*buflen + (int)(i/self->sndChnls)] = buffer[i];
         }
 
         /* reverse arrays */
@@ -966,28 +1045,31 @@ SfMarkerShuffler_readframes_i(SfMarkerShuffler *self) {
         for (i=0; i<self->sndChnls; i++) {
             int a;
             int b = buflen;
+            MYFLT *chnl = buffer2 + i*buflen;
             for (a=0; a<--b; a++) { //increment a and decrement b until they meet eachother
-                swap = buffer2[i][a];       //put what's in a into swap space
-                buffer2[i][a] = buffer2[i][b];    //put what's in b into a
-                buffer2[i][b] = swap;       //put what's in the swap (a) into b
+                swap = chnl[a];       //put what's in a into swap space
+                chnl[a] = chnl[b];    //put what's in b into a
+                chnl[b] = swap;       //put what's in the swap (a) into b
             }
         }
 
         /* fill stream buffer with samples */
         for (i=0; i<self->bufsize; i++) {
             bufpos = index - self->pointerPos;
-            bufindex = (int)bufpos;
-            frac = bufpos - bufindex;
-            for (j=0; j<self->sndChnls; j++) {
-                self->samplesBuffer[i+(j*self->bufsize)] = (*self->interp_func_ptr)(buffer2[j], bufindex, frac, buflen);
-            }
+            bufindex[i] = (int)bufpos;
+            frac[i] = bufpos - bufindex[i];
             self->pointerPos -= delta;
         }
+        for (j=0; j<self->sndChnls; j++) {
+            (*self->interp_func_ptr)(buffer2 + j*buflen, buflen, bufindex, frac, self->samplesBuffer + j*self->bufsize, self->bufsize);
+        }
         if (self->pointerPos <= self->endPos) {
             MYFLT off = self->endPos - self->pointerPos;
             SfMarkerShuffler_chooseNewMark((SfMarkerShuffler *)self, 0);
             self->pointerPos = self->startPos - off;
         }
+
+        SfStreamer_prefetch(self->streamer, (sf_count_t)self->pointerPos, -1, buflen, (sf_count_t)self->nextStartPos, -1);
     }
     else { /* speed == 0 */
         self->lastDir = 0;
@@ -1081,8 +1163,10 @@ static void
 SfMarkerShuffler_dealloc(SfMarkerShuffler* self)
 {
     pyo_DEALLOC
-    if (self->sf != NULL)
-        sf_close(self->sf);
+    free(self->interpIndex);
+    free(self->interpFrac);
+    SfStreamer_close(self->streamer);
+    free(self->readBuffer);
     free(self->samplesBuffer);
     free(self->markers);
     SfMarkerShuffler_clear(self);
@@ -1107,6 +1191,9 @@ SfMarkerShuffler_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Stream_setFunctionPtr(self->stream, SfMarkerShuffler_compute_next_data_frame);
     self->mode_func_ptr = SfMarkerShuffler_setProcMode;
 
+    self->interpIndex = (int *)realloc(self->interpIndex, self->bufsize * sizeof(int));
+    self->interpFrac = (MYFLT *)realloc(self->interpFrac, self->bufsize * sizeof(MYFLT));
+
     static char *kwlist[] = {"path", "markers", "speed", "interp", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "sO|Oi", kwlist, &self->path, &markerstmp, &speedtmp, &self->interp))
@@ -1120,21 +1207,11 @@ SfMarkerShuffler_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     (*self->mode_func_ptr)(self);
 
-    if (self->interp == 0)
-        self->interp = 2;
-    if (self->interp == 1)
-        self->interp_func_ptr = nointerp;
-    else if (self->interp == 2)
-        self->interp_func_ptr = linear;
-    else if (self->interp == 3)
-        self->interp_func_ptr = cosine;
-    else if (self->interp == 4)
-        self->interp_func_ptr = cubic;
+    SET_INTERP_BLOCK_POINTER
 
     /* Open the sound file. */
-    self->info.format = 0;
-    self->sf = sf_open(self->path, SFM_READ, &self->info);
-    if (self->sf == NULL)
+    self->streamer = SfStreamer_open(self->path, &self->info, sfplayer_is_offline(self->server));
+    if (self->streamer == NULL)
     {
         printf("Failed to open the file.\n");
         Py_RETURN_NONE;
@@ -1148,6 +1225,7 @@ SfMarkerShuffler_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     SfMarkerShuffler_setMarkers((SfMarkerShuffler *)self, markerstmp);
 
     self->samplesBuffer = (MYFLT *)realloc(self->samplesBuffer, self->bufsize * self->sndChnls * sizeof(MYFLT));
+    sfplayer_read_buffer(&self->readBuffer, &self->readSize, 2 * self->sndChnls * ((int)(self->bufsize * self->srScale) + 64));
 
     Server_generateSeed((Server *)self->server, SFMARKERSHUFFLER_ID);
 
@@ -1157,8 +1235,36 @@ SfMarkerShuffler_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 static PyObject * SfMarkerShuffler_getServer(SfMarkerShuffler* self) { GET_SERVER };
 static PyObject * SfMarkerShuffler_getStream(SfMarkerShuffler* self) { GET_STREAM };
 
-static PyObject * SfMarkerShuffler_play(SfMarkerShuffler *self, PyObject *args, PyObject *kwds) { PLAY };
-static PyObject * SfMarkerShuffler_out(SfMarkerShuffler *self, PyObject *args, PyObject *kwds) { OUT };
+/* Called from Python, before the stream is activated. The first marker
+** is chosen here so that its frames can be loaded in advance. */
+static void
+SfMarkerShuffler_seek(SfMarkerShuffler *self)
+{
+    if (self->streamer == NULL)
+        return;
+    if (self->startPos == -1 && (self->modebuffer[0] == 1 || PyFloat_AS_DOUBLE(self->speed) > 0)) {
+        self->lastDir = 1;
+        SfMarkerShuffler_chooseNewMark(self, 1);
+        self->pointerPos = self->startPos;
+    }
+    if (self->startPos == -1)
+        return;
+    Py_BEGIN_ALLOW_THREADS
+    SfStreamer_seek(self->streamer, (sf_count_t)self->pointerPos, self->lastDir < 0 ? -1 : 1, self->bufsize + 64, 100);
+    Py_END_ALLOW_THREADS
+}
+
+static PyObject * SfMarkerShuffler_play(SfMarkerShuffler *self, PyObject *args, PyObject *kwds)
+{
+    SfMarkerShuffler_seek(self);
+    PLAY
+};
+
+static PyObject * SfMarkerShuffler_out(SfMarkerShuffler *self, PyObject *args, PyObject *kwds)
+{
+    SfMarkerShuffler_seek(self);
+    OUT
+};
 static PyObject * SfMarkerShuffler_stop(SfMarkerShuffler *self) { STOP };
 
 static PyObject *
@@ -1203,16 +1309,7 @@ SfMarkerShuffler_setInterp(SfMarkerShuffler *self, PyObject *arg)
 		self->interp = PyInt_AsLong(PyNumber_Int(arg));
     }
 
-    if (self->interp == 0)
-        self->interp = 2;
-    if (self->interp == 1)
-        self->interp_func_ptr = nointerp;
-    else if (self->interp == 2)
-        self->interp_func_ptr = linear;
-    else if (self->interp == 3)
-        self->interp_func_ptr = cosine;
-    else if (self->interp == 4)
-        self->interp_func_ptr = cubic;
+    SET_INTERP_BLOCK_POINTER
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -1221,6 +1318,7 @@ SfMarkerShuffler_setInterp(SfMarkerShuffler *self, PyObject *arg)
 MYFLT *
 SfMarkerShuffler_getSamplesBuffer(SfMarkerShuffler *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->samplesBuffer;
 }
 
@@ -1553,7 +1651,7 @@ typedef struct {
     PyObject *mark;
     Stream *mark_stream;
     int modebuffer[2];
-    SNDFILE *sf;
+    SfStreamer *streamer;
     SF_INFO info;
     char *path;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
@@ -1571,7 +1669,11 @@ typedef struct {
     int markers_size;
     int old_mark;
     int lastDir;
-    MYFLT (*interp_func_ptr)(MYFLT *, int, MYFLT, int);
+    MYFLT *readBuffer;
+    int readSize;
+    interp_block_func interp_func_ptr;
+    int *interpIndex; /* scratch buffers of the block interpolation */
+    MYFLT *interpFrac;
 } SfMarkerLooper;
 
 /*** PROTOTYPES ***/
@@ -1580,9 +1682,12 @@ static void SfMarkerLooper_chooseNewMark(SfMarkerLooper *self, int dir);
 
 static void
 SfMarkerLooper_readframes_i(SfMarkerLooper *self) {
-    MYFLT sp, frac, bufpos, delta, tmp;
-    int i, j, totlen, buflen, shortbuflen, bufindex;
+    MYFLT sp, bufpos, delta, tmp;
+    int i, j, totlen, buflen, shortbuflen, pad;
+    int *bufindex = self->interpIndex;
+    MYFLT *frac = self->interpFrac;
     sf_count_t index;
+    MYFLT *buffer, *buffer2;
 
     if (self->modebuffer[0] == 0)
         sp = PyFloat_AS_DOUBLE(self->speed);
@@ -1593,8 +1698,8 @@ SfMarkerLooper_readframes_i(SfMarkerLooper *self) {
 
     buflen = (int)(self->bufsize * delta + 0.5) + 64;
     totlen = self->sndChnls*buflen;
-    MYFLT buffer[totlen];
-    MYFLT buffer2[self->sndChnls][buflen];
+    buffer = sfplayer_read_buffer(&self->readBuffer, &self->readSize, totlen * 2);
+    buffer2 = buffer + totlen;
 
     if (sp > 0) { /* reading forward */
         if (self->startPos == -1 || self->lastDir == 0) {
@@ -1609,47 +1714,44 @@ SfMarkerLooper_readframes_i(SfMarkerLooper *self) {
             self->lastDir = 1;
         }
         index = (int)self->pointerPos;
-        sf_seek(self->sf, index, SEEK_SET); /* sets position pointer in the file */
 
         /* fill a buffer with enough samples to satisfy speed reading */
         /* if not enough samples to read in the file */
         if ((index+buflen) > self->endPos) {
             shortbuflen = self->endPos - index;
-            SF_READ(self->sf, buffer, shortbuflen*self->sndChnls);
-
-            /* wrap around and read new samples if loop */
-            int pad = buflen - shortbuflen;
-            int padlen = pad*self->sndChnls;
-            MYFLT buftemp[padlen];
-            sf_seek(self->sf, (int)self->nextStartPos, SEEK_SET);
-            SF_READ(self->sf, buftemp, padlen);
-            for (i=0; i<(padlen); i++) {
-                buffer[i+shortbuflen*self->sndChnls] = buftemp[i];
-            }
+            if (shortbuflen < 0)
+                shortbuflen = 0;
+            pad = buflen - shortbuflen;
+            SfStreamer_read(self->streamer, index, shortbuflen, buffer);
+
+            /* wrap around and read new samples from new marker */
+            SfStreamer_read(self->streamer, (int)self->nextStartPos, pad, buffer + shortbuflen*self->sndChnls);
         }
-        else /* without zero padding */
-            SF_READ(self->sf, buffer, totlen);
+        else /* without wraparound */
+            SfStreamer_read(self->streamer, index, buflen, buffer);
 
         /* de-interleave samples */
         for (i=0; i<totlen; i++) {
-            buffer2[i%self->sndChnls][(int)(i/self->sndChnls)] = buffer[i];
+            buffer2[(i%self->sndChnls)*buflen + (int)(i/self->sndChnls)] = buffer[i];
         }
 
         /* fill data with samples */
         for (i=0; i<self->bufsize; i++) {
             bufpos = self->pointerPos - index;
-            bufindex = (int)bufpos;
-            frac = bufpos - bufindex;
-            for (j=0; j<self->sndChnls; j++) {
-                self->samplesBuffer[i+(j*self->bufsize)] = (*self->interp_func_ptr)(buffer2[j], bufindex, frac, buflen);
-            }
+            bufindex[i] = (int)bufpos;
+            frac[i] = bufpos - bufindex[i];
             self->pointerPos += delta;
         }
+        for (j=0; j<self->sndChnls; j++) {
+            (*self->interp_func_ptr)(buffer2 + j*buflen, buflen, bufindex, frac, self->samplesBuffer + j*self->bufsize, self->bufsize);
+        }
         if (self->pointerPos >= self->endPos) {
             MYFLT off = self->pointerPos - self->endPos;
             SfMarkerLooper_chooseNewMark((SfMarkerLooper *)self, 1);
             self->pointerPos = self->startPos + off;
         }
+
+        SfStreamer_prefetch(self->streamer, (sf_count_t)self->pointerPos, 1, buflen, (sf_count_t)self->nextStartPos, 1);
     }
     else if (sp < 0) { /* reading backward */
         if (self->startPos == -1 || self->lastDir != -1) {
@@ -1663,31 +1765,20 @@ SfMarkerLooper_readframes_i(SfMarkerLooper *self) {
         /* if not enough samples to read in the file */
         if ((index-buflen) < self->endPos) {
             shortbuflen = index - self->endPos;
-            int pad = buflen - shortbuflen;
-            int padlen = pad*self->sndChnls;
-
-            /* wrap around and read new samples if loop */
-            MYFLT buftemp[padlen];
-            sf_seek(self->sf, (int)self->nextStartPos-pad, SEEK_SET);
-            SF_READ(self->sf, buftemp, padlen);
-            for (i=0; i<padlen; i++) {
-                buffer[i] = buftemp[i];
-            }
+            if (shortbuflen < 0)
+                shortbuflen = 0;
+            pad = buflen - shortbuflen;
 
-            MYFLT buftemp2[shortbuflen*self->sndChnls];
-            sf_seek(self->sf, self->endPos, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buftemp2, shortbuflen*self->sndChnls);
-            for (i=0; i<(shortbuflen*self->sndChnls); i++) {
-                buffer[i+padlen] = buftemp2[i];
-            }
-        }
-        else { /* without zero padding */
-            sf_seek(self->sf, index-buflen, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buffer, totlen);
+            /* wrap around and read new samples from new marker */
+            SfStreamer_read(self->streamer, (int)self->nextStartPos-pad, pad, buffer);
+            SfStreamer_read(self->streamer, self->endPos, shortbuflen, buffer + pad*self->sndChnls);
         }
+        else /* without wraparound */
+            SfStreamer_read(self->streamer, index-buflen, buflen, buffer);
+
         /* de-interleave samples */
         for (i=0; i<totlen; i++) {
-            buffer2[i%self->sndChnls][(int)(i/self->sndChnls)] = buffer[i];
+            buffer2[(i%self->sndChnls)*buflen + (int)(i/self->sndChnls)] = buffer[i];
         }
 
         /* reverse arrays */
@@ -1695,28 +1786,31 @@ SfMarkerLooper_readframes_i(SfMarkerLooper *self) {
         for (i=0; i<self->sndChnls; i++) {
             int a;
             int b = buflen;
+            MYFLT *chnl = buffer2 + i*buflen;
             for (a=0; a<--b; a++) { //increment a and decrement b until they meet eachother
-                swap = buffer2[i][a];       //put what's in a into swap space
-                buffer2[i][a] = buffer2[i][b];    //put what's in b into a
-                buffer2[i][b] = swap;       //put what's in the swap (a) into b
+                swap = chnl[a];       //put what's in a into swap space
+                chnl[a] = chnl[b];    //put what's in b into a
+                chnl[b] = swap;       //put what's in the swap (a) into b
             }
         }
 
         /* fill stream buffer with samples */
         for (i=0; i<self->bufsize; i++) {
             bufpos = index - self->pointerPos;
-            bufindex = (int)bufpos;
-            frac = bufpos - bufindex;
-            for (j=0; j<self->sndChnls; j++) {
-                self->samplesBuffer[i+(j*self->bufsize)] = (*self->interp_func_ptr)(buffer2[j], bufindex, frac, buflen);
-            }
+            bufindex[i] = (int)bufpos;
+            frac[i] = bufpos - bufindex[i];
             self->pointerPos -= delta;
         }
+        for (j=0; j<self->sndChnls; j++) {
+            (*self->interp_func_ptr)(buffer2 + j*buflen, buflen, bufindex, frac, self->samplesBuffer + j*self->bufsize, self->bufsize);
+        }
         if (self->pointerPos <= self->endPos) {
             MYFLT off = self->endPos - self->pointerPos;
             SfMarkerLooper_chooseNewMark((SfMarkerLooper *)self, 0);
             self->pointerPos = self->startPos - off;
         }
+
+        SfStreamer_prefetch(self->streamer, (sf_count_t)self->pointerPos, -1, buflen, (sf_count_t)self->nextStartPos, -1);
     }
     else { /* speed == 0 */
         self->lastDir = 0;
@@ -1821,8 +1915,10 @@ static void
 SfMarkerLooper_dealloc(SfMarkerLooper* self)
 {
     pyo_DEALLOC
-    if (self->sf != NULL)
-        sf_close(self->sf);
+    free(self->interpIndex);
+    free(self->interpFrac);
+    SfStreamer_close(self->streamer);
+    free(self->readBuffer);
     free(self->samplesBuffer);
     free(self->markers);
     SfMarkerLooper_clear(self);
@@ -1851,6 +1947,9 @@ SfMarkerLooper_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Stream_setFunctionPtr(self->stream, SfMarkerLooper_compute_next_data_frame);
     self->mode_func_ptr = SfMarkerLooper_setProcMode;
 
+    self->interpIndex = (int *)realloc(self->interpIndex, self->bufsize * sizeof(int));
+    self->interpFrac = (MYFLT *)realloc(self->interpFrac, self->bufsize * sizeof(MYFLT));
+
     static char *kwlist[] = {"path", "markers", "speed", "mark", "interp", NULL};
 
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "sO|OOi", kwlist, &self->path, &markerstmp, &speedtmp, &marktmp, &self->interp))
@@ -1868,21 +1967,11 @@ SfMarkerLooper_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     (*self->mode_func_ptr)(self);
 
-    if (self->interp == 0)
-        self->interp = 2;
-    if (self->interp == 1)
-        self->interp_func_ptr = nointerp;
-    else if (self->interp == 2)
-        self->interp_func_ptr = linear;
-    else if (self->interp == 3)
-        self->interp_func_ptr = cosine;
-    else if (self->interp == 4)
-        self->interp_func_ptr = cubic;
+    SET_INTERP_BLOCK_POINTER
 
     /* Open the sound file. */
-    self->info.format = 0;
-    self->sf = sf_open(self->path, SFM_READ, &self->info);
-    if (self->sf == NULL)
+    self->streamer = SfStreamer_open(self->path, &self->info, sfplayer_is_offline(self->server));
+    if (self->streamer == NULL)
     {
         printf("Failed to open the file.\n");
         Py_RETURN_NONE;
@@ -1896,6 +1985,7 @@ SfMarkerLooper_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     SfMarkerLooper_setMarkers((SfMarkerLooper *)self, markerstmp);
 
     self->samplesBuffer = (MYFLT *)realloc(self->samplesBuffer, self->bufsize * self->sndChnls * sizeof(MYFLT));
+    sfplayer_read_buffer(&self->readBuffer, &self->readSize, 2 * self->sndChnls * ((int)(self->bufsize * self->srScale) + 64));
 
     Server_generateSeed((Server *)self->server, SFMARKERLOOPER_ID);
 
@@ -1905,8 +1995,36 @@ SfMarkerLooper_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 static PyObject * SfMarkerLooper_getServer(SfMarkerLooper* self) { GET_SERVER };
 static PyObject * SfMarkerLooper_getStream(SfMarkerLooper* self) { GET_STREAM };
 
-static PyObject * SfMarkerLooper_play(SfMarkerLooper *self, PyObject *args, PyObject *kwds) { PLAY };
-static PyObject * SfMarkerLooper_out(SfMarkerLooper *self, PyObject *args, PyObject *kwds) { OUT };
+/* Called from Python, before the stream is activated. The first marker
+** is chosen here so that its frames can be loaded in advance. */
+static void
+SfMarkerLooper_seek(SfMarkerLooper *self)
+{
+    if (self->streamer == NULL)
+        return;
+    if (self->startPos == -1 && (self->modebuffer[0] == 1 || PyFloat_AS_DOUBLE(self->speed) > 0)) {
+        self->lastDir = 1;
+        SfMarkerLooper_chooseNewMark(self, 1);
+        self->pointerPos = self->startPos;
+    }
+    if (self->startPos == -1)
+        return;
+    Py_BEGIN_ALLOW_THREADS
+    SfStreamer_seek(self->streamer, (sf_count_t)self->pointerPos, self->lastDir < 0 ? -1 : 1, self->bufsize + 64, 100);
+    Py_END_ALLOW_THREADS
+}
+
+static PyObject * SfMarkerLooper_play(SfMarkerLooper *self, PyObject *args, PyObject *kwds)
+{
+    SfMarkerLooper_seek(self);
+    PLAY
+};
+
+static PyObject * SfMarkerLooper_out(SfMarkerLooper *self, PyObject *args, PyObject *kwds)
+{
+    SfMarkerLooper_seek(self);
+    OUT
+};
 static PyObject * SfMarkerLooper_stop(SfMarkerLooper *self) { STOP };
 
 static PyObject *
@@ -1978,16 +2096,7 @@ SfMarkerLooper_setInterp(SfMarkerLooper *self, PyObject *arg)
 		self->interp = PyInt_AsLong(PyNumber_Int(arg));
     }
 
-    if (self->interp == 0)
-        self->interp = 2;
-    if (self->interp == 1)
-        self->interp_func_ptr = nointerp;
-    else if (self->interp == 2)
-        self->interp_func_ptr = linear;
-    else if (self->interp == 3)
-        self->interp_func_ptr = cosine;
-    else if (self->interp == 4)
-        self->interp_func_ptr = cubic;
+    SET_INTERP_BLOCK_POINTER
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -1996,6 +2105,7 @@ SfMarkerLooper_setInterp(SfMarkerLooper *self, PyObject *arg)
 MYFLT *
 SfMarkerLooper_getSamplesBuffer(SfMarkerLooper *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->samplesBuffer;
 }
 
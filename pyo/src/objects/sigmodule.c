@@ -732,10 +732,33 @@ typedef struct {
     int flag;
 } VarPort;
 
+static void
+VarPort_callFunction(PyObject *obj, double value) {
+    PyObject *tuple, *result;
+    VarPort *self = (VarPort *)obj;
+
+    if (self->callable == Py_None)
+        return;
+    if (self->arg != Py_None) {
+        tuple = PyTuple_New(1);
+        Py_INCREF(self->arg);
+        PyTuple_SET_ITEM(tuple, 0, self->arg);
+    }
+    else {
+        tuple = PyTuple_New(0);
+    }
+
+    result = PyObject_Call(self->callable, tuple, NULL);
+    Py_DECREF(tuple);
+    if (result == NULL)
+        PyErr_Print();
+    else
+        Py_DECREF(result);
+}
+
 static void
 VarPort_generates_i(VarPort *self) {
     int i;
-    PyObject *tuple, *result;
 
     if (self->value != self->lastValue) {
         self->flag = 1;
@@ -764,21 +787,8 @@ VarPort_generates_i(VarPort *self) {
 
     if (self->timeCount >= self->timeout && self->flag == 1) {
         self->flag = 0;
-        if (self->callable != Py_None) {
-            if (self->arg != Py_None) {
-                tuple = PyTuple_New(1);
-                PyTuple_SET_ITEM(tuple, 0, self->arg);
-            }
-            else {
-                tuple = PyTuple_New(0);
-            }
-
-            result = PyObject_Call(self->callable, tuple, NULL);
-            if (result == NULL) {
-                PyErr_Print();
-                return;
-            }
-        }
+        if (self->callable != Py_None)
+            Server_defer((Server *)self->server, (PyObject *)self, VarPort_callFunction, 0.0);
     }
 }
 
@@ -1121,3 +1131,362 @@ PyTypeObject VarPortType = {
     0,                         /* tp_alloc */
     VarPort_new,                 /* tp_new */
 };
+
+/*********************************************************/
+/* SigQueue - Sig changed by timestamped server events */
+/*********************************************************/
+/* Events handed by the server and not yet applied. */
+#define SIGQUEUE_SIZE 1024
+
+typedef struct {
+    double value;
+    unsigned long time;
+    long ramp;
+} SigQueueEvent;
+
+typedef struct {
+    pyo_audio_HEAD
+    MYFLT currentValue;
+    MYFLT targetValue;
+    MYFLT stepVal;
+    long rampCount; /* samples left in the current ramp */
+    SigQueueEvent *events; /* sorted by time, only used by the audio thread */
+    int count;
+    int modebuffer[2];
+} SigQueue;
+
+/* Called by the server at the start of a buffer. */
+static int
+SigQueue_insert(PyObject *obj, double value, unsigned long time, long ramp)
+{
+    int i;
+    SigQueue *self = (SigQueue *)obj;
+
+    if (self->count == SIGQUEUE_SIZE)
+        return 0;
+    /* Events of the same time are applied in the order they were posted. */
+    for (i=self->count; i>0 && self->events[i-1].time > time; i--) {
+        self->events[i] = self->events[i-1];
+    }
+    self->events[i].value = value;
+    self->events[i].time = time;
+    self->events[i].ramp = ramp;
+    self->count++;
+    return 1;
+}
+
+static void
+SigQueue_generates(SigQueue *self) {
+    int i = 0, end, first = 0;
+    unsigned long start, delta;
+    SigQueueEvent *event;
+    Server *server = (Server *)self->server;
+
+    /* Event times are counted in server samples, the buffer may be resampled. */
+    start = server->elapsedSamples;
+    while (i < self->bufsize) {
+        end = self->bufsize;
+        event = NULL;
+        if (first < self->count) {
+            delta = self->events[first].time > start ? self->events[first].time - start : 0;
+            if (delta < (unsigned long)server->bufferSize) {
+                event = &self->events[first];
+                end = (int)(delta * self->bufsize / server->bufferSize);
+            }
+        }
+        for (; i<end; i++) {
+            if (self->rampCount > 0) {
+                if (--self->rampCount == 0)
+                    self->currentValue = self->targetValue;
+                else
+                    self->currentValue += self->stepVal;
+            }
+            self->data[i] = self->currentValue;
+        }
+        if (event != NULL) {
+            self->targetValue = event->value;
+            if (event->ramp <= 0) {
+                self->currentValue = self->targetValue;
+                self->rampCount = 0;
+            }
+            else {
+                self->stepVal = (self->targetValue - self->currentValue) / event->ramp;
+                self->rampCount = event->ramp;
+            }
+            first++;
+        }
+    }
+    if (first > 0) {
+        self->count -= first;
+        memmove(self->events, self->events + first, self->count * sizeof(SigQueueEvent));
+    }
+}
+
+static void SigQueue_postprocessing_ii(SigQueue *self) { POST_PROCESSING_II };
+static void SigQueue_postprocessing_ai(SigQueue *self) { POST_PROCESSING_AI };
+static void SigQueue_postprocessing_ia(SigQueue *self) { POST_PROCESSING_IA };
+static void SigQueue_postprocessing_aa(SigQueue *self) { POST_PROCESSING_AA };
+static void SigQueue_postprocessing_ireva(SigQueue *self) { POST_PROCESSING_IREVA };
+static void SigQueue_postprocessing_areva(SigQueue *self) { POST_PROCESSING_AREVA };
+static void SigQueue_postprocessing_revai(SigQueue *self) { POST_PROCESSING_REVAI };
+static void SigQueue_postprocessing_revaa(SigQueue *self) { POST_PROCESSING_REVAA };
+static void SigQueue_postprocessing_revareva(SigQueue *self) { POST_PROCESSING_REVAREVA };
+
+static void
+SigQueue_setProcMode(SigQueue *self)
+{
+    int muladdmode;
+    muladdmode = self->modebuffer[0] + self->modebuffer[1] * 10;
+
+    self->proc_func_ptr = SigQueue_generates;
+
+    switch (muladdmode) {
+        case 0:
+            self->muladd_func_ptr = SigQueue_postprocessing_ii;
+            break;
+        case 1:
+            self->muladd_func_ptr = SigQueue_postprocessing_ai;
+            break;
+        case 2:
+            self->muladd_func_ptr = SigQueue_postprocessing_revai;
+            break;
+        case 10:
+            self->muladd_func_ptr = SigQueue_postprocessing_ia;
+            break;
+        case 11:
+            self->muladd_func_ptr = SigQueue_postprocessing_aa;
+            break;
+        case 12:
+            self->muladd_func_ptr = SigQueue_postprocessing_revaa;
+            break;
+        case 20:
+            self->muladd_func_ptr = SigQueue_postprocessing_ireva;
+            break;
+        case 21:
+            self->muladd_func_ptr = SigQueue_postprocessing_areva;
+            break;
+        case 22:
+            self->muladd_func_ptr = SigQueue_postprocessing_revareva;
+            break;
+    }
+}
+
+static void
+SigQueue_compute_next_data_frame(SigQueue *self)
+{
+    (*self->proc_func_ptr)(self);
+    (*self->muladd_func_ptr)(self);
+}
+
+static int
+SigQueue_traverse(SigQueue *self, visitproc visit, void *arg)
+{
+    pyo_VISIT
+    return 0;
+}
+
+static int
+SigQueue_clear(SigQueue *self)
+{
+    pyo_CLEAR
+    return 0;
+}
+
+static void
+SigQueue_dealloc(SigQueue* self)
+{
+    pyo_DEALLOC
+    free(self->events);
+    SigQueue_clear(self);
+    self->ob_type->tp_free((PyObject*)self);
+}
+
+static PyObject *
+SigQueue_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i;
+    MYFLT valuetmp = 0.0;
+    PyObject *multmp=NULL, *addtmp=NULL;
+    SigQueue *self;
+    self = (SigQueue *)type->tp_alloc(type, 0);
+
+    self->stepVal = 0.0;
+    self->rampCount = 0;
+    self->count = 0;
+    self->modebuffer[0] = 0;
+    self->modebuffer[1] = 0;
+
+    INIT_OBJECT_COMMON
+    Stream_setFunctionPtr(self->stream, SigQueue_compute_next_data_frame);
+    self->mode_func_ptr = SigQueue_setProcMode;
+
+    static char *kwlist[] = {"value", "mul", "add", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE__FOO, kwlist, &valuetmp, &multmp, &addtmp))
+        Py_RETURN_NONE;
+
+    if (multmp) {
+        PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
+    }
+
+    if (addtmp) {
+        PyObject_CallMethod((PyObject *)self, "setAdd", "O", addtmp);
+    }
+
+    self->events = (SigQueueEvent *)malloc(SIGQUEUE_SIZE * sizeof(SigQueueEvent));
+
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+
+    self->currentValue = self->targetValue = valuetmp;
+
+    (*self->mode_func_ptr)(self);
+
+    for(i=0; i<self->bufsize; i++) {
+        self->data[i] = self->currentValue;
+    }
+
+    return (PyObject *)self;
+}
+
+static PyObject *
+SigQueue_post(SigQueue *self, PyObject *args, PyObject *kwds)
+{
+    double value, ramp = 0.0;
+    unsigned long long time = 0;
+
+    static char *kwlist[] = {"value", "time", "ramp", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "d|Kd", kwlist, &value, &time, &ramp))
+        return NULL;
+
+    if (Server_postParam((Server *)self->server, (PyObject *)self, SigQueue_insert, value,
+                         (unsigned long)time, (long)(ramp * self->sr + 0.5)))
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+static PyObject * SigQueue_getServer(SigQueue* self) { GET_SERVER };
+static PyObject * SigQueue_getStream(SigQueue* self) { GET_STREAM };
+static PyObject * SigQueue_setMul(SigQueue *self, PyObject *arg) { SET_MUL };
+static PyObject * SigQueue_setAdd(SigQueue *self, PyObject *arg) { SET_ADD };
+static PyObject * SigQueue_setSub(SigQueue *self, PyObject *arg) { SET_SUB };
+static PyObject * SigQueue_setDiv(SigQueue *self, PyObject *arg) { SET_DIV };
+
+static PyObject * SigQueue_play(SigQueue *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * SigQueue_out(SigQueue *self, PyObject *args, PyObject *kwds) { OUT };
+static PyObject * SigQueue_stop(SigQueue *self) { STOP };
+
+static PyObject * SigQueue_multiply(SigQueue *self, PyObject *arg) { MULTIPLY };
+static PyObject * SigQueue_inplace_multiply(SigQueue *self, PyObject *arg) { INPLACE_MULTIPLY };
+static PyObject * SigQueue_add(SigQueue *self, PyObject *arg) { ADD };
+static PyObject * SigQueue_inplace_add(SigQueue *self, PyObject *arg) { INPLACE_ADD };
+static PyObject * SigQueue_sub(SigQueue *self, PyObject *arg) { SUB };
+static PyObject * SigQueue_inplace_sub(SigQueue *self, PyObject *arg) { INPLACE_SUB };
+static PyObject * SigQueue_div(SigQueue *self, PyObject *arg) { DIV };
+static PyObject * SigQueue_inplace_div(SigQueue *self, PyObject *arg) { INPLACE_DIV };
+
+static PyMemberDef SigQueue_members[] = {
+{"server", T_OBJECT_EX, offsetof(SigQueue, server), 0, "Pyo server."},
+{"stream", T_OBJECT_EX, offsetof(SigQueue, stream), 0, "Stream object."},
+{"mul", T_OBJECT_EX, offsetof(SigQueue, mul), 0, "Mul factor."},
+{"add", T_OBJECT_EX, offsetof(SigQueue, add), 0, "Add factor."},
+{NULL}  /* Sentinel */
+};
+
+static PyMethodDef SigQueue_methods[] = {
+{"getServer", (PyCFunction)SigQueue_getServer, METH_NOARGS, "Returns server object."},
+{"_getStream", (PyCFunction)SigQueue_getStream, METH_NOARGS, "Returns stream object."},
+{"play", (PyCFunction)SigQueue_play, METH_VARARGS|METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+{"out", (PyCFunction)SigQueue_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
+{"stop", (PyCFunction)SigQueue_stop, METH_NOARGS, "Stops computing."},
+{"post", (PyCFunction)SigQueue_post, METH_VARARGS|METH_KEYWORDS, "Posts a new value, at a sample time and with a ramp in seconds, to the server's queue."},
+{"setMul", (PyCFunction)SigQueue_setMul, METH_O, "Sets SigQueue mul factor."},
+{"setAdd", (PyCFunction)SigQueue_setAdd, METH_O, "Sets SigQueue add factor."},
+{"setSub", (PyCFunction)SigQueue_setSub, METH_O, "Sets inverse add factor."},
+{"setDiv", (PyCFunction)SigQueue_setDiv, METH_O, "Sets inverse mul factor."},
+{NULL}  /* Sentinel */
+};
+
+static PyNumberMethods SigQueue_as_number = {
+(binaryfunc)SigQueue_add,                      /*nb_add*/
+(binaryfunc)SigQueue_sub,                 /*nb_subtract*/
+(binaryfunc)SigQueue_multiply,                 /*nb_multiply*/
+(binaryfunc)SigQueue_div,                   /*nb_divide*/
+0,                /*nb_remainder*/
+0,                   /*nb_divmod*/
+0,                   /*nb_power*/
+0,                  /*nb_neg*/
+0,                /*nb_pos*/
+0,                  /*(unaryfunc)array_abs,*/
+0,                    /*nb_nonzero*/
+0,                    /*nb_invert*/
+0,               /*nb_lshift*/
+0,              /*nb_rshift*/
+0,              /*nb_and*/
+0,              /*nb_xor*/
+0,               /*nb_or*/
+0,                                          /*nb_coerce*/
+0,                       /*nb_int*/
+0,                      /*nb_long*/
+0,                     /*nb_float*/
+0,                       /*nb_oct*/
+0,                       /*nb_hex*/
+(binaryfunc)SigQueue_inplace_add,              /*inplace_add*/
+(binaryfunc)SigQueue_inplace_sub,         /*inplace_subtract*/
+(binaryfunc)SigQueue_inplace_multiply,         /*inplace_multiply*/
+(binaryfunc)SigQueue_inplace_div,           /*inplace_divide*/
+0,        /*inplace_remainder*/
+0,           /*inplace_power*/
+0,       /*inplace_lshift*/
+0,      /*inplace_rshift*/
+0,      /*inplace_and*/
+0,      /*inplace_xor*/
+0,       /*inplace_or*/
+0,             /*nb_floor_divide*/
+0,              /*nb_true_divide*/
+0,     /*nb_inplace_floor_divide*/
+0,      /*nb_inplace_true_divide*/
+0,                     /* nb_index */
+};
+
+PyTypeObject SigQueueType = {
+PyObject_HEAD_INIT(NULL)
+0,                         /*ob_size*/
+"_pyo.SigQueue_base",         /*tp_name*/
+sizeof(SigQueue),         /*tp_basicsize*/
+0,                         /*tp_itemsize*/
+(destructor)SigQueue_dealloc, /*tp_dealloc*/
+0,                         /*tp_print*/
+0,                         /*tp_getattr*/
+0,                         /*tp_setattr*/
+0,                         /*tp_compare*/
+0,                         /*tp_repr*/
+&SigQueue_as_number,             /*tp_as_number*/
+0,                         /*tp_as_sequence*/
+0,                         /*tp_as_mapping*/
+0,                         /*tp_hash */
+0,                         /*tp_call*/
+0,                         /*tp_str*/
+0,                         /*tp_getattro*/
+0,                         /*tp_setattro*/
+0,                         /*tp_as_buffer*/
+Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_CHECKTYPES, /*tp_flags*/
+"SigQueue objects. Signal stream changed, at the sample, by events posted to the server's queue.",           /* tp_doc */
+(traverseproc)SigQueue_traverse,   /* tp_traverse */
+(inquiry)SigQueue_clear,           /* tp_clear */
+0,		               /* tp_richcompare */
+0,		               /* tp_weaklistoffset */
+0,		               /* tp_iter */
+0,		               /* tp_iternext */
+SigQueue_methods,             /* tp_methods */
+SigQueue_members,             /* tp_members */
+0,                      /* tp_getset */
+0,                         /* tp_base */
+0,                         /* tp_dict */
+0,                         /* tp_descr_get */
+0,                         /* tp_descr_set */
+0,                         /* tp_dictoffset */
+0,      /* tp_init */
+0,                         /* tp_alloc */
+SigQueue_new,                 /* tp_new */
+};
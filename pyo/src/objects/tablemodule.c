@@ -26,6 +26,7 @@
 #include "servermodule.h"
 #include "dummymodule.h"
 #include "sndfile.h"
+#include "sndmap.h"
 #include "wind.h"
 #include "fft.h"
 
@@ -53,6 +54,15 @@ TableStream_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 MYFLT *
 TableStream_getData(TableStream *self)
 {
+    PYO_GRAPH_READ(self);
+    return (MYFLT *)self->data;
+}
+
+/* For the objects writing into the table they get from an argument. */
+MYFLT *
+TableStream_getWritableData(TableStream *self)
+{
+    PYO_GRAPH_WRITE(self);
     return (MYFLT *)self->data;
 }
 
@@ -62,6 +72,54 @@ TableStream_setData(TableStream *self, MYFLT *data)
     self->data = data;
 }
 
+static void
+TableStream_setOwner(TableStream *self, PyObject *owner)
+{
+    self->owner = owner;
+}
+
+/* A one-dimensional view of the samples, without the guard point. The table
+** can't be resized while it is exported. */
+static int
+TableStream_getbuffer(TableStream *self, Py_buffer *view, int flags)
+{
+    self->viewShape[0] = self->size;
+    self->viewStrides[0] = sizeof(MYFLT);
+    if (PyoBuffer_fillView(view, (PyObject *)self, self->data, 1, self->viewShape, self->viewStrides, 0, flags) < 0)
+        return -1;
+    self->exports++;
+    Py_XINCREF(self->owner);
+    return 0;
+}
+
+static void
+TableStream_releasebuffer(TableStream *self, Py_buffer *view)
+{
+    self->exports--;
+    Py_XDECREF(self->owner);
+}
+
+/* Returns -1, with a BufferError, if the table is exported. Called before
+** the data is resized or replaced. */
+static int
+TableStream_checkExports(TableStream *self)
+{
+    if (self->exports > 0) {
+        PyErr_SetString(PyExc_BufferError, "The table can't be resized or replaced while a buffer view of it exists.");
+        return -1;
+    }
+    return 0;
+}
+
+static PyBufferProcs TableStream_as_buffer = {
+    0, /*bf_getreadbuffer*/
+    0, /*bf_getwritebuffer*/
+    0, /*bf_getsegcount*/
+    0, /*bf_getcharbuffer*/
+    (getbufferproc)TableStream_getbuffer, /*bf_getbuffer*/
+    (releasebufferproc)TableStream_releasebuffer, /*bf_releasebuffer*/
+};
+
 int
 TableStream_getSize(TableStream *self)
 {
@@ -106,8 +164,8 @@ sizeof(TableStream), /*tp_basicsize*/
 0, /*tp_str*/
 0, /*tp_getattro*/
 0, /*tp_setattro*/
-0, /*tp_as_buffer*/
-Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, /*tp_flags*/
+&TableStream_as_buffer, /*tp_as_buffer*/
+Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_NEWBUFFER, /*tp_flags*/
 "TableStream objects. For internal use only. Must never be instantiated by the user.", /* tp_doc */
 0, /* tp_traverse */
 0, /* tp_clear */
@@ -200,8 +258,8 @@ HarmTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->amplist = PyList_New(0);
     PyList_Append(self->amplist, PyFloat_FromDouble(1.));
     self->size = 8192;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"list", "size", NULL};
 
@@ -254,6 +312,9 @@ static PyObject * HarmTable_mul(HarmTable *self, PyObject *arg) { TABLE_MUL };
 static PyObject *
 HarmTable_setSize(HarmTable *self, PyObject *value)
 {
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     if (value == NULL) {
         PyErr_SetString(PyExc_TypeError, "Cannot delete the size attribute.");
         return PyInt_FromLong(-1);
@@ -498,8 +559,8 @@ ChebyTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->amplist = PyList_New(0);
     PyList_Append(self->amplist, PyFloat_FromDouble(1.));
     self->size = 8192;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"list", "size", NULL};
 
@@ -552,6 +613,9 @@ static PyObject * ChebyTable_mul(ChebyTable *self, PyObject *arg) { TABLE_MUL };
 static PyObject *
 ChebyTable_setSize(ChebyTable *self, PyObject *value)
 {
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     if (value == NULL) {
         PyErr_SetString(PyExc_TypeError, "Cannot delete the size attribute.");
         return PyInt_FromLong(-1);
@@ -810,8 +874,8 @@ HannTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->server = PyServer_get_server();
 
     self->size = 8192;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"size", NULL};
 
@@ -858,6 +922,9 @@ static PyObject * HannTable_mul(HannTable *self, PyObject *arg) { TABLE_MUL };
 static PyObject *
 HannTable_setSize(HannTable *self, PyObject *value)
 {
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     if (value == NULL) {
         PyErr_SetString(PyExc_TypeError, "Cannot delete the size attribute.");
         return PyInt_FromLong(-1);
@@ -1038,8 +1105,8 @@ SincTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->size = 8192;
     self->freq = TWOPI;
     self->windowed = 0;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"freq", "windowed", "size", NULL};
 
@@ -1120,6 +1187,9 @@ SincTable_setWindowed(SincTable *self, PyObject *value)
 static PyObject *
 SincTable_setSize(SincTable *self, PyObject *value)
 {
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     if (value == NULL) {
         PyErr_SetString(PyExc_TypeError, "Cannot delete the size attribute.");
         return PyInt_FromLong(-1);
@@ -1274,8 +1344,8 @@ WinTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->size = 8192;
     self->type = 2;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"type", "size", NULL};
 
@@ -1322,6 +1392,9 @@ static PyObject * WinTable_mul(WinTable *self, PyObject *arg) { TABLE_MUL };
 static PyObject *
 WinTable_setSize(WinTable *self, PyObject *value)
 {
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     if (value == NULL) {
         PyErr_SetString(PyExc_TypeError, "Cannot delete the size attribute.");
         return PyInt_FromLong(-1);
@@ -1510,8 +1583,8 @@ ParaTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->server = PyServer_get_server();
 
     self->size = 8192;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"size", NULL};
 
@@ -1558,6 +1631,9 @@ static PyObject * ParaTable_mul(ParaTable *self, PyObject *arg) { TABLE_MUL };
 static PyObject *
 ParaTable_setSize(ParaTable *self, PyObject *value)
 {
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     if (value == NULL) {
         PyErr_SetString(PyExc_TypeError, "Cannot delete the size attribute.");
         return PyInt_FromLong(-1);
@@ -1748,8 +1824,8 @@ LinTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->pointslist = PyList_New(0);
     self->size = 8192;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"list", "size", NULL};
 
@@ -1807,6 +1883,9 @@ static PyObject *
 LinTable_setSize(LinTable *self, PyObject *value)
 {
     Py_ssize_t i;
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     PyObject *tup, *x2;
     int old_size, x1;
     MYFLT factor;
@@ -2076,8 +2155,8 @@ LogTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->pointslist = PyList_New(0);
     self->size = 8192;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"list", "size", NULL};
 
@@ -2135,6 +2214,9 @@ static PyObject *
 LogTable_setSize(LogTable *self, PyObject *value)
 {
     Py_ssize_t i;
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     PyObject *tup, *x2;
     int old_size, x1;
     MYFLT factor;
@@ -2382,8 +2464,8 @@ CosTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->pointslist = PyList_New(0);
     self->size = 8192;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"list", "size", NULL};
 
@@ -2441,6 +2523,9 @@ static PyObject *
 CosTable_setSize(CosTable *self, PyObject *value)
 {
     Py_ssize_t i;
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     PyObject *tup, *x2;
     int old_size, x1;
     MYFLT factor;
@@ -2712,8 +2797,8 @@ CosLogTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->pointslist = PyList_New(0);
     self->size = 8192;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"list", "size", NULL};
 
@@ -2771,6 +2856,9 @@ static PyObject *
 CosLogTable_setSize(CosLogTable *self, PyObject *value)
 {
     Py_ssize_t i;
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     PyObject *tup, *x2;
     int old_size, x1;
     MYFLT factor;
@@ -3045,8 +3133,8 @@ CurveTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->size = 8192;
     self->tension = 0.0;
     self->bias = 0.0;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"list", "tension", "bias", "size", NULL};
 
@@ -3146,6 +3234,9 @@ static PyObject *
 CurveTable_setSize(CurveTable *self, PyObject *value)
 {
     Py_ssize_t i;
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     PyObject *tup, *x2;
     int old_size, x1;
     MYFLT factor;
@@ -3419,8 +3510,8 @@ ExpTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->size = 8192;
     self->exp = 10.0;
     self->inverse = 1;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"list", "exp", "inverse", "size", NULL};
 
@@ -3520,6 +3611,9 @@ static PyObject *
 ExpTable_setSize(ExpTable *self, PyObject *value)
 {
     Py_ssize_t i;
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     PyObject *tup, *x2;
     int old_size, x1;
     MYFLT factor;
@@ -3695,15 +3789,63 @@ typedef struct {
     MYFLT stop;
     MYFLT crossfade;
     MYFLT insertPos;
+    int mapped; /* data mapped from the file, see sndmap.h */
+    char *cachedir;
+    SndMap map;
 } SndTable;
 
+/* Releases the mapped data, if any, data is then NULL. */
+static void
+SndTable_unmap(SndTable *self) {
+    if (self->map.base == NULL)
+        return;
+    SndMap_close(&self->map);
+    self->data = NULL;
+}
+
+/* Replaces the samples by new ones, prepared beforehand, then releases the
+** old ones. The readers get the data and the size separately, so a smaller
+** size is published before the data and a larger one after, each once the
+** callbacks that may have loaded the previous value are over. map is the
+** mapping of data, NULL if data was allocated. */
+static void
+SndTable_swapData(SndTable *self, MYFLT *data, int size, SndMap *map) {
+    MYFLT *old;
+    SndMap oldmap = self->map;
+    Server *server = (Server *)self->server;
+
+    if (size < self->tablestream->size) {
+        TableStream_setSize(self->tablestream, size);
+        Server_waitForCallback(server);
+    }
+    TableStream_setSamplingRate(self->tablestream, self->sndSr);
+    old = (MYFLT *)Server_swapPointer(server, (void **)&self->tablestream->data, data);
+    TableStream_setSize(self->tablestream, size);
+
+    self->data = data;
+    self->size = size;
+    if (map != NULL)
+        self->map = *map;
+    else {
+        self->map.base = NULL;
+        self->map.length = 0;
+    }
+
+    if (oldmap.base != NULL)
+        SndMap_close(&oldmap);
+    else
+        free(old);
+}
+
 static void
 SndTable_loadSound(SndTable *self) {
     SNDFILE *sf;
     SF_INFO info;
     unsigned int i, num, num_items, num_chnls, snd_size, start, stop;
     unsigned int num_count = 0;
-    MYFLT *tmp;
+    int size;
+    MYFLT *tmp, *data;
+    SndMap map;
 
     info.format = 0;
     sf = sf_open(self->path, SFM_READ, &info);
@@ -3726,14 +3868,27 @@ SndTable_loadSound(SndTable *self) {
     else
         start = (unsigned int)(self->start * self->sndSr);
 
-    self->size = stop - start;
-    num_items = self->size * num_chnls;
+    size = stop - start;
+    num_items = size * num_chnls;
+
+    if (self->mapped) {
+        map.base = NULL;
+        map.length = 0;
+        data = SndMap_open(&map, self->path, self->chnl, start, stop, self->cachedir);
+        if (data != NULL) {
+            sf_close(sf);
+            self->start = 0.0;
+            self->stop = -1.0;
+            SndTable_swapData(self, data, size, &map);
+            return;
+        }
+    }
 
     /* Allocate space for the data to be read, then read it. */
-    self->data = (MYFLT *)realloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    data = (MYFLT *)malloc((size + 1) * sizeof(MYFLT));
 
     /* For sound longer than 1 minute, load 30 sec chunks. */
-    if (self->size > (self->sndSr * 60 * num_chnls)) {
+    if (size > (self->sndSr * 60 * num_chnls)) {
         tmp = (MYFLT *)malloc(self->sndSr * 30 * num_chnls * sizeof(MYFLT));
         sf_seek(sf, start, SEEK_SET);
         num_items = self->sndSr * 30 * num_chnls;
@@ -3741,7 +3896,7 @@ SndTable_loadSound(SndTable *self) {
             num = SF_READ(sf, tmp, num_items);
             for (i=0; i<num; i++) {
                 if ((i % num_chnls) == self->chnl) {
-                    self->data[(int)(num_count++)] = tmp[i];
+                    data[(int)(num_count++)] = tmp[i];
                 }
             }
         } while (num == num_items);
@@ -3755,19 +3910,17 @@ SndTable_loadSound(SndTable *self) {
         sf_close(sf);
         for (i=0; i<num_items; i++) {
             if ((i % num_chnls) == self->chnl) {
-                self->data[(int)(i/num_chnls)] = tmp[i];
+                data[(int)(i/num_chnls)] = tmp[i];
             }
         }
     }
 
-    self->data[self->size] = self->data[0];
+    data[size] = data[0];
 
     self->start = 0.0;
     self->stop = -1.0;
     free(tmp);
-    TableStream_setSize(self->tablestream, self->size);
-    TableStream_setSamplingRate(self->tablestream, self->sndSr);
-    TableStream_setData(self->tablestream, self->data);
+    SndTable_swapData(self, data, size, NULL);
 }
 
 static void
@@ -3775,7 +3928,8 @@ SndTable_appendSound(SndTable *self) {
     SNDFILE *sf;
     SF_INFO info;
     unsigned int i, num_items, num_chnls, snd_size, start, stop, to_load_size, cross_in_samps, cross_point, index, real_index;
-    MYFLT *tmp, *tmp_data;
+    int size;
+    MYFLT *tmp, *tmp_data, *data;
     MYFLT cross_amp;
 
     info.format = 0;
@@ -3809,26 +3963,19 @@ SndTable_appendSound(SndTable *self) {
 
     /* Allocate space for the data to be read, then read it. */
     tmp = (MYFLT *)malloc(num_items * sizeof(MYFLT));
-    tmp_data = (MYFLT *)malloc(self->size * sizeof(MYFLT));
+    /* The current samples, in use until the swap. */
+    tmp_data = self->data;
 
     sf_seek(sf, start, SEEK_SET);
     SF_READ(sf, tmp, num_items);
     sf_close(sf);
 
-    if (cross_in_samps != 0) {
-        for (i=0; i<self->size; i++) {
-            tmp_data[i] = self->data[i];
-        }
-    }
-
     cross_point = self->size - cross_in_samps;
-    self->size = self->size + to_load_size - cross_in_samps;
-    self->data = (MYFLT *)realloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    size = self->size + to_load_size - cross_in_samps;
+    data = (MYFLT *)malloc((size + 1) * sizeof(MYFLT));
 
-    if (cross_in_samps != 0) {
-        for (i=0; i<cross_point; i++) {
-            self->data[i] = tmp_data[i];
-        }
+    for (i=0; i<cross_point; i++) {
+        data[i] = tmp_data[i];
     }
 
     if (self->crossfade == 0.0) {
@@ -3836,7 +3983,7 @@ SndTable_appendSound(SndTable *self) {
             if ((i % num_chnls) == self->chnl) {
                 index = (int)(i/num_chnls);
                 real_index = cross_point + index;
-                self->data[real_index] = tmp[i];
+                data[real_index] = tmp[i];
             }
         }
     }
@@ -3847,23 +3994,20 @@ SndTable_appendSound(SndTable *self) {
                 real_index = cross_point + index;
                 if (index < cross_in_samps) {
                     cross_amp = MYSQRT(index / (MYFLT)cross_in_samps);
-                    self->data[real_index] = tmp[i] * cross_amp + tmp_data[real_index] * (1. - cross_amp);
+                    data[real_index] = tmp[i] * cross_amp + tmp_data[real_index] * (1. - cross_amp);
                 }
                 else
-                    self->data[real_index] = tmp[i];
+                    data[real_index] = tmp[i];
             }
         }
     }
 
-    self->data[self->size] = self->data[0];
+    data[size] = data[0];
 
     self->start = 0.0;
     self->stop = -1.0;
     free(tmp);
-    free(tmp_data);
-    TableStream_setSize(self->tablestream, self->size);
-    TableStream_setSamplingRate(self->tablestream, self->sndSr);
-    TableStream_setData(self->tablestream, self->data);
+    SndTable_swapData(self, data, size, NULL);
 }
 
 static void
@@ -3872,7 +4016,8 @@ SndTable_prependSound(SndTable *self) {
     SF_INFO info;
     unsigned int i, num_items, num_chnls, snd_size, start, stop, to_load_size, cross_in_samps, cross_point;
     unsigned int index = 0;
-    MYFLT *tmp, *tmp_data;
+    int size;
+    MYFLT *tmp, *tmp_data, *data;
     MYFLT cross_amp;
 
     info.format = 0;
@@ -3906,25 +4051,22 @@ SndTable_prependSound(SndTable *self) {
 
     /* Allocate space for the data to be read, then read it. */
     tmp = (MYFLT *)malloc(num_items * sizeof(MYFLT));
-    tmp_data = (MYFLT *)malloc(self->size * sizeof(MYFLT));
+    /* The current samples, in use until the swap. */
+    tmp_data = self->data;
 
     sf_seek(sf, start, SEEK_SET);
     SF_READ(sf, tmp, num_items);
     sf_close(sf);
 
-    for (i=0; i<self->size; i++) {
-        tmp_data[i] = self->data[i];
-    }
-
     cross_point = to_load_size - cross_in_samps;
-    self->size = self->size + to_load_size - cross_in_samps;
-    self->data = (MYFLT *)realloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    size = self->size + to_load_size - cross_in_samps;
+    data = (MYFLT *)malloc((size + 1) * sizeof(MYFLT));
 
     if (self->crossfade == 0.0) {
         for (i=0; i<num_items; i++) {
             if ((i % num_chnls) == self->chnl) {
                 index = (int)(i/num_chnls);
-                self->data[index] = tmp[i];
+                data[index] = tmp[i];
             }
         }
 
@@ -3935,27 +4077,24 @@ SndTable_prependSound(SndTable *self) {
                 index = (int)(i/num_chnls);
                 if (index >= cross_point) {
                     cross_amp = MYSQRT((index-cross_point) / (MYFLT)cross_in_samps);
-                    self->data[index] = tmp[i] * (1. - cross_amp) + tmp_data[index - cross_point] * cross_amp;
+                    data[index] = tmp[i] * (1. - cross_amp) + tmp_data[index - cross_point] * cross_amp;
                 }
                 else
-                    self->data[index] = tmp[i];
+                    data[index] = tmp[i];
             }
         }
     }
 
-    for (i=(index+1); i<self->size; i++) {
-        self->data[i] = tmp_data[i - cross_point];
+    for (i=(index+1); i<size; i++) {
+        data[i] = tmp_data[i - cross_point];
     }
 
-    self->data[self->size] = self->data[0];
+    data[size] = data[0];
 
     self->start = 0.0;
     self->stop = -1.0;
     free(tmp);
-    free(tmp_data);
-    TableStream_setSize(self->tablestream, self->size);
-    TableStream_setSamplingRate(self->tablestream, self->sndSr);
-    TableStream_setData(self->tablestream, self->data);
+    SndTable_swapData(self, data, size, NULL);
 }
 
 static void
@@ -3966,7 +4105,8 @@ SndTable_insertSound(SndTable *self) {
     unsigned int cross_in_samps, cross_point, insert_point, index;
     unsigned int read_point = 0;
     unsigned int real_index = 0;
-    MYFLT *tmp, *tmp_data;
+    int size;
+    MYFLT *tmp, *tmp_data, *data;
     MYFLT cross_amp;
 
     info.format = 0;
@@ -4007,30 +4147,27 @@ SndTable_insertSound(SndTable *self) {
 
     /* Allocate space for the data to be read, then read it. */
     tmp = (MYFLT *)malloc(num_items * sizeof(MYFLT));
-    tmp_data = (MYFLT *)malloc(self->size * sizeof(MYFLT));
+    /* The current samples, in use until the swap. */
+    tmp_data = self->data;
 
     sf_seek(sf, start, SEEK_SET);
     SF_READ(sf, tmp, num_items);
     sf_close(sf);
 
-    for (i=0; i<self->size; i++) {
-        tmp_data[i] = self->data[i];
-    }
-
-    self->size = self->size + to_load_size - (cross_in_samps * 2);
-    self->data = (MYFLT *)realloc(self->data, (self->size + 1) * sizeof(MYFLT));
+    size = self->size + to_load_size - (cross_in_samps * 2);
+    data = (MYFLT *)malloc((size + 1) * sizeof(MYFLT));
 
     cross_point = insert_point - cross_in_samps;
 
     for (i=0; i<cross_point; i++) {
-        self->data[i] = tmp_data[i];
+        data[i] = tmp_data[i];
     }
 
     if (self->crossfade == 0.0) {
         for (i=0; i<num_items; i++) {
             if ((i % num_chnls) == self->chnl) {
                 index = (int)(i/num_chnls);
-                self->data[index+cross_point] = tmp[i];
+                data[index+cross_point] = tmp[i];
             }
         }
 
@@ -4042,34 +4179,31 @@ SndTable_insertSound(SndTable *self) {
                 real_index = index + cross_point;
                 if (index <= cross_in_samps) {
                     cross_amp = MYSQRT(index / (MYFLT)cross_in_samps);
-                    self->data[real_index] = tmp[i] * cross_amp + tmp_data[cross_point + index] * (1.0 - cross_amp);
+                    data[real_index] = tmp[i] * cross_amp + tmp_data[cross_point + index] * (1.0 - cross_amp);
                 }
                 else if (index >= (to_load_size - cross_in_samps)) {
                     cross_amp = MYSQRT((to_load_size - index) / (MYFLT)cross_in_samps);
                     read_point = cross_in_samps - (to_load_size - index) +insert_point;
-                    self->data[real_index] = tmp[i] * cross_amp + tmp_data[read_point] * (1.0 - cross_amp);
+                    data[real_index] = tmp[i] * cross_amp + tmp_data[read_point] * (1.0 - cross_amp);
                 }
                 else
-                    self->data[real_index] = tmp[i];
+                    data[real_index] = tmp[i];
             }
         }
     }
 
     read_point++;
-    for (i=(real_index+1); i<self->size; i++) {
-        self->data[i] = tmp_data[read_point];
+    for (i=(real_index+1); i<size; i++) {
+        data[i] = tmp_data[read_point];
         read_point++;
     }
 
-    self->data[self->size] = self->data[0];
+    data[size] = data[0];
 
     self->start = 0.0;
     self->stop = -1.0;
     free(tmp);
-    free(tmp_data);
-    TableStream_setSize(self->tablestream, self->size);
-    TableStream_setSamplingRate(self->tablestream, self->sndSr);
-    TableStream_setData(self->tablestream, self->data);
+    SndTable_swapData(self, data, size, NULL);
 }
 
 static int
@@ -4089,7 +4223,9 @@ SndTable_clear(SndTable *self)
 static void
 SndTable_dealloc(SndTable* self)
 {
+    SndTable_unmap(self);
     free(self->data);
+    free(self->cachedir);
     SndTable_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -4109,14 +4245,19 @@ SndTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->stop = -1.0;
     self->crossfade = 0.0;
     self->insertPos = 0.0;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
-    static char *kwlist[] = {"path", "chnl", "start", "stop", NULL};
+    char *cachedir = NULL;
 
-    if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_S_IFF, kwlist, &self->path, &self->chnl, &self->start, &self->stop))
+    static char *kwlist[] = {"path", "chnl", "start", "stop", "mapped", "cachedir", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_S_IFF "is", kwlist, &self->path, &self->chnl, &self->start, &self->stop, &self->mapped, &cachedir))
         return PyInt_FromLong(-1);
 
+    if (cachedir != NULL)
+        self->cachedir = strdup(cachedir);
+
     if (strcmp(self->path, "") == 0) {
         self->size = (int)self->sr;
         self->data = (MYFLT *)realloc(self->data, (self->size + 1) * sizeof(MYFLT));
@@ -4140,7 +4281,31 @@ SndTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
 static PyObject * SndTable_getServer(SndTable* self) { GET_SERVER };
 static PyObject * SndTable_getTableStream(SndTable* self) { GET_TABLE_STREAM };
-static PyObject * SndTable_setData(SndTable *self, PyObject *arg) { SET_TABLE_DATA };
+
+static PyObject *
+SndTable_setData(SndTable *self, PyObject *arg)
+{
+    int i, size;
+    MYFLT *data;
+
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+    if (! PyList_Check(arg)) {
+        PyErr_SetString(PyExc_TypeError, "The data must be a list of floats.");
+        return PyInt_FromLong(-1);
+    }
+    size = PyList_Size(arg);
+    data = (MYFLT *)malloc((size+1) * sizeof(MYFLT));
+    for (i=0; i<size; i++) {
+        data[i] = PyFloat_AsDouble(PyList_GET_ITEM(arg, i));
+    }
+    data[size] = data[0];
+    SndTable_swapData(self, data, size, NULL);
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyObject * SndTable_normalize(SndTable *self) { NORMALIZE };
 static PyObject * SndTable_reset(SndTable *self) { TABLE_RESET };
 static PyObject * SndTable_removeDC(SndTable *self) { REMOVE_DC };
@@ -4306,6 +4471,9 @@ SndTable_setSound(SndTable *self, PyObject *args, PyObject *kwds)
 
     MYFLT stoptmp = -1.0;
 
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_S_IFF, kwlist, &self->path, &self->chnl, &self->start, &stoptmp)) {
         Py_INCREF(Py_None);
         return Py_None;
@@ -4326,6 +4494,9 @@ SndTable_append(SndTable *self, PyObject *args, PyObject *kwds)
     MYFLT stoptmp = -1.0;
     MYFLT crosstmp = 0.0;
 
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_S_FIFF, kwlist, &self->path, &crosstmp, &self->chnl, &self->start, &stoptmp)) {
         Py_INCREF(Py_None);
         return Py_None;
@@ -4352,6 +4523,9 @@ SndTable_insert(SndTable *self, PyObject *args, PyObject *kwds)
     MYFLT crosstmp = 0.0;
     MYFLT postmp = 0.0;
 
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_S_FFIFF, kwlist, &self->path, &postmp, &crosstmp, &self->chnl, &self->start, &stoptmp)) {
         Py_INCREF(Py_None);
         return Py_None;
@@ -4380,19 +4554,23 @@ static PyObject *
 SndTable_setSize(SndTable *self, PyObject *value)
 {
     Py_ssize_t i;
+    int size;
+    MYFLT *data;
 
-    self->size = PyInt_AsLong(value);
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
 
-    self->data = (MYFLT *)realloc(self->data, (self->size+1) * sizeof(MYFLT));
+    size = PyInt_AsLong(value);
 
-    for(i=0; i<self->size; i++) {
-        self->data[i] = 0.0;
+    data = (MYFLT *)malloc((size+1) * sizeof(MYFLT));
+
+    for(i=0; i<size; i++) {
+        data[i] = 0.0;
     }
-    self->data[self->size] = 0.0;
+    data[size] = 0.0;
     self->start = 0.0;
     self->stop = -1.0;
-    TableStream_setSize(self->tablestream, self->size);
-    TableStream_setData(self->tablestream, self->data);
+    SndTable_swapData(self, data, size, NULL);
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -4514,11 +4692,13 @@ typedef struct {
     int pointer;
 } NewTable;
 
-static PyObject *
+static void
 NewTable_recordChunk(NewTable *self, MYFLT *data, int datasize)
 {
     int i;
 
+    PYO_GRAPH_WRITE(self->tablestream);
+
     if (self->feedback == 0.0) {
         for (i=0; i<datasize; i++) {
             self->data[self->pointer++] = data[i];
@@ -4538,9 +4718,6 @@ NewTable_recordChunk(NewTable *self, MYFLT *data, int datasize)
             }
         }
     }
-
-    Py_INCREF(Py_None);
-    return Py_None;
 }
 
 static int
@@ -4577,8 +4754,8 @@ NewTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->pointer = 0;
     self->feedback = 0.0;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"length", "init", "feedback", NULL};
 
@@ -4860,6 +5037,7 @@ typedef struct {
 static void
 DataTable_record(DataTable *self, int pos, MYFLT value)
 {
+    PYO_GRAPH_WRITE(self->tablestream);
     self->data[pos] = value;
 }
 
@@ -4896,8 +5074,8 @@ DataTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->server = PyServer_get_server();
 
     self->pointer = 0;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"size", "init", NULL};
 
@@ -5103,8 +5281,8 @@ AtanTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     self->size = 8192;
     self->slope = 0.5;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"slope", "size", NULL};
 
@@ -5172,6 +5350,9 @@ AtanTable_setSlope(AtanTable *self, PyObject *value)
 static PyObject *
 AtanTable_setSize(AtanTable *self, PyObject *value)
 {
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     if (value == NULL) {
         PyErr_SetString(PyExc_TypeError, "Cannot delete the size attribute.");
         return PyInt_FromLong(-1);
@@ -5421,8 +5602,8 @@ PadSynthTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->bwscl = 1.0;
     self->nharms = 64;
     self->damp = 0.7;
-
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
+    TableStream_setOwner(self->tablestream, (PyObject *)self);
 
     static char *kwlist[] = {"basefreq", "spread", "bw", "bwscl", "nharms", "damp", "size", NULL};
 
@@ -5574,6 +5755,9 @@ PadSynthTable_setSize(PadSynthTable *self, PyObject *args, PyObject *kwds)
 {
     int generate = 1;
 
+    if (TableStream_checkExports(self->tablestream) < 0)
+        return NULL;
+
     static char *kwlist[] = {"size", "generate", NULL};
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "i|i", kwlist, &self->size, &generate))
         Py_RETURN_NONE;
@@ -5710,7 +5894,7 @@ TableRec_compute_next_data_frame(TableRec *self)
 {
     int i, num, upBound;
     MYFLT val;
-    int size = PyInt_AsLong(NewTable_getSize((NewTable *)self->table));
+    int size = TableStream_getSize(((NewTable *)self->table)->tablestream);
 
     for (i=0; i<self->bufsize; i++) {
         self->trigsBuffer[i] = 0.0;
@@ -5767,6 +5951,7 @@ TableRec_compute_next_data_frame(TableRec *self)
 
 static MYFLT *
 TableRec_getTimeBuffer(TableRec *self) {
+    PYO_GRAPH_READ(self->stream);
     return self->time_buffer_streams;
 }
 
@@ -5847,8 +6032,9 @@ TableRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
-    int size = PyInt_AsLong(NewTable_getSize((NewTable *)self->table));
+    int size = TableStream_getSize(((NewTable *)self->table)->tablestream);
     if ((self->fadetime * self->sr) >= (size * 0.5))
         self->fadetime = size * 0.499 / self->sr;
     if (self->fadetime == 0.0)
@@ -5883,6 +6069,7 @@ TableRec_setTable(TableRec *self, PyObject *arg)
     Py_INCREF(tmp);
 	Py_DECREF(self->table);
     self->table = (NewTable *)tmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -6220,7 +6407,7 @@ static void
 TableMorph_alloc_memories(TableMorph *self)
 {
     int i, size;
-    size = PyInt_AsLong(NewTable_getSize((NewTable *)self->table));
+    size = TableStream_getSize(((NewTable *)self->table)->tablestream);
     self->last_size = size;
     self->buffer = (MYFLT *)realloc(self->buffer, size * sizeof(MYFLT));
     for (i=0; i<size; i++) {
@@ -6235,7 +6422,7 @@ TableMorph_compute_next_data_frame(TableMorph *self)
     MYFLT input, interp, interp1, interp2;
 
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
-    int size = PyInt_AsLong(NewTable_getSize((NewTable *)self->table));
+    int size = TableStream_getSize(((NewTable *)self->table)->tablestream);
     int len = PyList_Size(self->sources);
 
     if (size != self->last_size)
@@ -6304,6 +6491,7 @@ TableMorph_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, TableMorph_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
 
     static char *kwlist[] = {"input", "table", "sources", NULL};
 
@@ -6348,6 +6536,7 @@ TableMorph_setTable(TableMorph *self, PyObject *arg)
     Py_INCREF(tmp);
 	Py_DECREF(self->table);
     self->table = (PyObject *)tmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -6456,7 +6645,7 @@ TrigTableRec_compute_next_data_frame(TrigTableRec *self)
 {
     int i, j, num, upBound;
     MYFLT val;
-    int size = PyInt_AsLong(NewTable_getSize((NewTable *)self->table));
+    int size = TableStream_getSize(((NewTable *)self->table)->tablestream);
 
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     MYFLT *trig = Stream_getData((Stream *)self->trigger_stream);
@@ -6554,6 +6743,7 @@ TrigTableRec_compute_next_data_frame(TrigTableRec *self)
 
 static MYFLT *
 TrigTableRec_getTimeBuffer(TrigTableRec *self) {
+    PYO_GRAPH_READ(self->stream);
     return self->time_buffer_streams;
 }
 
@@ -6643,8 +6833,9 @@ TrigTableRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
-    int size = PyInt_AsLong(NewTable_getSize((NewTable *)self->table));
+    int size = TableStream_getSize(((NewTable *)self->table)->tablestream);
     if ((self->fadetime * self->sr) >= (size * 0.5))
         self->fadetime = size * 0.499 / self->sr;
     if (self->fadetime == 0.0)
@@ -6673,6 +6864,7 @@ TrigTableRec_setTable(TrigTableRec *self, PyObject *arg)
     Py_INCREF(tmp);
 	Py_DECREF(self->table);
     self->table = (NewTable *)tmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -7003,7 +7195,7 @@ static void
 TablePut_compute_next_data_frame(TablePut *self)
 {
     int i;
-    int size = PyInt_AsLong(DataTable_getSize((DataTable *)self->table));
+    int size = TableStream_getSize(((DataTable *)self->table)->tablestream);
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     for (i=0; i<self->bufsize; i++) {
@@ -7098,6 +7290,7 @@ TablePut_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
     return (PyObject *)self;
 }
@@ -7126,6 +7319,7 @@ TablePut_setTable(TablePut *self, PyObject *arg)
     Py_INCREF(tmp);
 	Py_DECREF(self->table);
     self->table = (DataTable *)tmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -7212,7 +7406,7 @@ TableWrite_compute_next_data_frame(TableWrite *self)
     PyObject *table;
 
     table = PyObject_CallMethod((PyObject *)self->table, "getTableStream", "");
-    MYFLT *tablelist = TableStream_getData((TableStream *)table);
+    MYFLT *tablelist = TableStream_getWritableData((TableStream *)table);
     int size = TableStream_getSize((TableStream *)table);
 
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
@@ -7278,6 +7472,7 @@ TableWrite_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     INIT_OBJECT_COMMON
 
     Stream_setFunctionPtr(self->stream, TableWrite_compute_next_data_frame);
+    Stream_setStreamNeedsGIL(self->stream, 1);
     Stream_setStreamActive(self->stream, 1);
 
     static char *kwlist[] = {"input", "pos", "table", "mode", NULL};
@@ -7347,6 +7542,7 @@ TableWrite_setTable(TableWrite *self, PyObject *arg)
     Py_INCREF(tmp);
 	Py_DECREF(self->table);
     self->table = (NewTable *)tmp;
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
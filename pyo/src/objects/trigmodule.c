@@ -1250,30 +1250,34 @@ typedef struct {
     PyObject *func;
 } TrigFunc;
 
+static void
+TrigFunc_callFunction(PyObject *obj, double value) {
+    PyObject *tuple, *result;
+    TrigFunc *self = (TrigFunc *)obj;
+
+    if (self->arg == Py_None)
+        tuple = PyTuple_New(0);
+    else {
+        tuple = PyTuple_New(1);
+        Py_INCREF(self->arg);
+        PyTuple_SET_ITEM(tuple, 0, self->arg);
+    }
+    result = PyObject_Call(self->func, tuple, NULL);
+    Py_DECREF(tuple);
+    if (result == NULL)
+        PyErr_Print();
+    else
+        Py_DECREF(result);
+}
+
 static void
 TrigFunc_generate(TrigFunc *self) {
     int i;
-    PyObject *tuple, *result;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
     for (i=0; i<self->bufsize; i++) {
         if (in[i] == 1) {
-            if (self->arg == Py_None) {
-                result = PyObject_Call(self->func, PyTuple_New(0), NULL);
-                if (result == NULL) {
-                    PyErr_Print();
-                    return;
-                }
-            }
-            else {
-                tuple = PyTuple_New(1);
-                PyTuple_SET_ITEM(tuple, 0, self->arg);
-                result = PyObject_Call(self->func, tuple, NULL);
-                if (result == NULL) {
-                    PyErr_Print();
-                    return;
-                }
-            }
+            Server_defer((Server *)self->server, (PyObject *)self, TrigFunc_callFunction, 0.0);
         }
     }
 }
@@ -1705,6 +1709,7 @@ TrigEnv_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
     (*self->mode_func_ptr)(self);
 
@@ -1751,6 +1756,7 @@ TrigEnv_setTable(TrigEnv *self, PyObject *arg)
 	tmp = arg;
 	Py_DECREF(self->table);
     self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    PyoGraph_resetAccesses(self->stream);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -1932,6 +1938,9 @@ typedef struct {
     double increment;
     MYFLT *targets;
     MYFLT *times;
+    MYFLT *newTargets; /* points converted by setList, taken at the next reinit */
+    MYFLT *newTimes;
+    int newListsize;
     int which;
     int flag;
     int newlist;
@@ -1940,26 +1949,41 @@ typedef struct {
     TriggerStream *trig_stream;
 } TrigLinseg;
 
+/* Called with the GIL, the audio thread only reads the converted arrays. */
 static void
 TrigLinseg_convert_pointslist(TrigLinseg *self) {
     int i;
     PyObject *tup;
 
-    self->listsize = PyList_Size(self->pointslist);
-    self->targets = (MYFLT *)realloc(self->targets, self->listsize * sizeof(MYFLT));
-    self->times = (MYFLT *)realloc(self->times, self->listsize * sizeof(MYFLT));
-    for (i=0; i<self->listsize; i++) {
+    self->newListsize = PyList_Size(self->pointslist);
+    self->newTargets = (MYFLT *)realloc(self->newTargets, self->newListsize * sizeof(MYFLT));
+    self->newTimes = (MYFLT *)realloc(self->newTimes, self->newListsize * sizeof(MYFLT));
+    for (i=0; i<self->newListsize; i++) {
         tup = PyList_GET_ITEM(self->pointslist, i);
-        self->times[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 0));
-        self->targets[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 1));
+        self->newTimes[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 0));
+        self->newTargets[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 1));
     }
 }
 
+/* Swaps in the points converted by setList, the old arrays are reused by the next conversion. */
+static void
+TrigLinseg_take_pointslist(TrigLinseg *self) {
+    MYFLT *tmp;
+
+    tmp = self->targets;
+    self->targets = self->newTargets;
+    self->newTargets = tmp;
+    tmp = self->times;
+    self->times = self->newTimes;
+    self->newTimes = tmp;
+    self->listsize = self->newListsize;
+    self->newlist = 0;
+}
+
 static void
 TrigLinseg_reinit(TrigLinseg *self) {
     if (self->newlist == 1) {
-        TrigLinseg_convert_pointslist((TrigLinseg *)self);
-        self->newlist = 0;
+        TrigLinseg_take_pointslist(self);
     }
     self->currentTime = 0.0;
     self->currentValue = self->targets[0];
@@ -2085,6 +2109,8 @@ TrigLinseg_dealloc(TrigLinseg* self)
     pyo_DEALLOC
     free(self->targets);
     free(self->times);
+    free(self->newTargets);
+    free(self->newTimes);
     free(self->trigsBuffer);
     TrigLinseg_clear(self);
     self->ob_type->tp_free((PyObject*)self);
@@ -2119,6 +2145,7 @@ TrigLinseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Py_XDECREF(self->pointslist);
     self->pointslist = pointslist;
     TrigLinseg_convert_pointslist((TrigLinseg *)self);
+    TrigLinseg_take_pointslist(self);
 
     if (multmp) {
         PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
@@ -2138,6 +2165,7 @@ TrigLinseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
     (*self->mode_func_ptr)(self);
 
@@ -2177,9 +2205,15 @@ TrigLinseg_setList(TrigLinseg *self, PyObject *value)
         return PyInt_FromLong(-1);
     }
 
+    /* Once the audio thread is out of its buffer, it can't be taking the
+    ** points converted by a previous call anymore. */
+    self->newlist = 0;
+    Server_waitForCallback((Server *)self->server);
+
     Py_INCREF(value);
     Py_DECREF(self->pointslist);
     self->pointslist = value;
+    TrigLinseg_convert_pointslist(self);
 
     self->newlist = 1;
 
@@ -2313,6 +2347,9 @@ typedef struct {
     double steps;
     MYFLT *targets;
     MYFLT *times;
+    MYFLT *newTargets; /* points converted by setList, taken at the next reinit */
+    MYFLT *newTimes;
+    int newListsize;
     int which;
     int flag;
     int newlist;
@@ -2325,26 +2362,41 @@ typedef struct {
     TriggerStream *trig_stream;
 } TrigExpseg;
 
+/* Called with the GIL, the audio thread only reads the converted arrays. */
 static void
 TrigExpseg_convert_pointslist(TrigExpseg *self) {
     int i;
     PyObject *tup;
 
-    self->listsize = PyList_Size(self->pointslist);
-    self->targets = (MYFLT *)realloc(self->targets, self->listsize * sizeof(MYFLT));
-    self->times = (MYFLT *)realloc(self->times, self->listsize * sizeof(MYFLT));
-    for (i=0; i<self->listsize; i++) {
+    self->newListsize = PyList_Size(self->pointslist);
+    self->newTargets = (MYFLT *)realloc(self->newTargets, self->newListsize * sizeof(MYFLT));
+    self->newTimes = (MYFLT *)realloc(self->newTimes, self->newListsize * sizeof(MYFLT));
+    for (i=0; i<self->newListsize; i++) {
         tup = PyList_GET_ITEM(self->pointslist, i);
-        self->times[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 0));
-        self->targets[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 1));
+        self->newTimes[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 0));
+        self->newTargets[i] = PyFloat_AsDouble(PyTuple_GET_ITEM(tup, 1));
     }
 }
 
+/* Swaps in the points converted by setList, the old arrays are reused by the next conversion. */
+static void
+TrigExpseg_take_pointslist(TrigExpseg *self) {
+    MYFLT *tmp;
+
+    tmp = self->targets;
+    self->targets = self->newTargets;
+    self->newTargets = tmp;
+    tmp = self->times;
+    self->times = self->newTimes;
+    self->newTimes = tmp;
+    self->listsize = self->newListsize;
+    self->newlist = 0;
+}
+
 static void
 TrigExpseg_reinit(TrigExpseg *self) {
     if (self->newlist == 1) {
-        TrigExpseg_convert_pointslist((TrigExpseg *)self);
-        self->newlist = 0;
+        TrigExpseg_take_pointslist(self);
     }
     self->currentTime = 0.0;
     self->currentValue = self->targets[0];
@@ -2486,6 +2538,8 @@ TrigExpseg_dealloc(TrigExpseg* self)
     pyo_DEALLOC
     free(self->targets);
     free(self->times);
+    free(self->newTargets);
+    free(self->newTimes);
     free(self->trigsBuffer);
     TrigExpseg_clear(self);
     self->ob_type->tp_free((PyObject*)self);
@@ -2522,6 +2576,7 @@ TrigExpseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Py_XDECREF(self->pointslist);
     self->pointslist = pointslist;
     TrigExpseg_convert_pointslist((TrigExpseg *)self);
+    TrigExpseg_take_pointslist(self);
 
     if (multmp) {
         PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
@@ -2541,6 +2596,7 @@ TrigExpseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
     MAKE_NEW_TRIGGER_STREAM(self->trig_stream, &TriggerStreamType, NULL);
     TriggerStream_setData(self->trig_stream, self->trigsBuffer);
+    TriggerStream_setOwner(self->trig_stream, (PyObject *)self->stream);
 
     (*self->mode_func_ptr)(self);
 
@@ -2580,9 +2636,15 @@ TrigExpseg_setList(TrigExpseg *self, PyObject *value)
         return PyInt_FromLong(-1);
     }
 
+    /* Once the audio thread is out of its buffer, it can't be taking the
+    ** points converted by a previous call anymore. */
+    self->newlist = 0;
+    Server_waitForCallback((Server *)self->server);
+
     Py_INCREF(value);
     Py_DECREF(self->pointslist);
     self->pointslist = value;
+    TrigExpseg_convert_pointslist(self);
 
     self->newlist = 1;
 
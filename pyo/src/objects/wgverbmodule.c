@@ -1386,6 +1386,7 @@ STReverb_setProcMode(STReverb *self)
 MYFLT *
 STReverb_getSamplesBuffer(STReverb *self)
 {
+    PYO_GRAPH_READ(self->stream);
     return (MYFLT *)self->buffer_streams;
 }
 